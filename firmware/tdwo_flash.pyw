@@ -1,20 +1,30 @@
-# xbox_rgb_flasher.py
-# XBOX RGB Flasher — simple Tk GUI for flashing a merged BIN to ESP32
-# - Auto-detects the first ESP32 on available serial ports
-# - User only selects the BIN and clicks "Flash"
-# - Uses esptool via "python -m esptool" (streamed output)
+# tdwo_flash.pyw
+# Type D Wireless OLED Flasher — simple Tk GUI for flashing a merged BIN to ESP32s
+# - Detects every connected ESP32 and flashes them in parallel, one esptool
+#   subprocess per port (streamed output, per-port progress)
+# - Only the partitions whose flash MD5 differs from the image are written
+#   (compressed, MD5-verified by esptool); an up-to-date board is just checked
+# - Starts at the fastest baud and steps down when a board can't keep up
+# - Optional Wi-Fi / display settings are written as the NVS partition, so
+#   the units join the network on first boot instead of starting the portal;
+#   without them nvs and otadata are left alone (saved settings survive)
 #
-# Deps: pip install esptool pyserial
+# Deps: pip install esptool pyserial  (+ esp-idf-nvs-partition-gen for settings)
 # Icon: place dc.ico in the same folder (Windows). On mac/Linux it's ignored if not found.
 
 import sys
 import os
+import re
+import csv
+import shutil
+import struct
+import tempfile
 import threading
 import queue
 import subprocess
 import tkinter as tk
 from tkinter import ttk, filedialog, messagebox
-from typing import Optional, Tuple
+from typing import List, NamedTuple, Optional, Tuple
 
 try:
     from serial.tools import list_ports
@@ -24,43 +34,239 @@ except Exception:
 
 APP_NAME = "Type D Wireless OLED Flasher"
 ICON_PATH = "dc.ico"
-DEFAULT_BAUD = "921600"   # conservative + fast enough
-FLASH_OFFSET = "0x0"      # merged image starts at 0x0
+BAUD_STEPS = ("2000000", "921600", "460800", "115200")   # tried fastest first
+MAX_PARALLEL = 8          # boards flashed at once (a USB hub shares its bandwidth)
+
+# Merged image layout: the partition table sits at 0x8000. Without one the
+# BIN is written as a single region at 0x0.
+PART_TABLE_OFFSET = 0x8000
+PART_MAGIC = b"\xaa\x50"
+NVS_DEFAULT = (0x9000, 0x5000)
+DEVICE_STATE = ("nvs", "otadata")    # not verified or written unless settings are seeded
+
+DISPLAYS = ("(keep)", "ssd1309", "us2066")                # portal "Display" choice
+
+# USB bridges found on ESP32 boards (VID): Espressif native USB, SiLabs, WCH, FTDI
+ESP_VIDS = (0x303A, 0x10C4, 0x1A86, 0x0403)
+
+# esptool output (v4 and v5 wording)
+RE_PCT = re.compile(r"Writing at 0x([0-9a-fA-F]+)")
+RE_VERIFY = re.compile(r"digest (matched|mismatch)")
+RE_HASH_OK = re.compile(r"Hash of data verified")
+NO_LINK = ("Failed to connect", "could not open port", "No serial data received",
+           "Could not open", "Permission denied", "Failed to start esptool")
+
+
+class Region(NamedTuple):
+    offset: int
+    size: int
+    name: str
+    path: str      # slice of the image on disk
+
 
 # --------------------------------------------------------------------
 # Detection
 # --------------------------------------------------------------------
-def detect_first_esp32() -> Optional[Tuple[str, str]]:
+def detect_esp32s() -> List[Tuple[str, str]]:
     """
-    Return (port, chip) for the first connected ESP chip, else None.
-    Heuristic: prefer ports that look like USB UARTs. We don't open ports here;
-    esptool will toggle boot mode automatically during flashing.
+    Return [(port, description)] for every port that looks like an ESP board.
+    Heuristic: known USB bridge VIDs or UART-ish names. We don't open ports
+    here; esptool --chip auto identifies the actual variant when flashing.
     """
     if list_ports is None:
-        return None
+        return []
 
-    ports = list(list_ports.comports())
-    if not ports:
-        return None
-
-    # Light preferencing for typical USB UARTs
-    prefer_substrings = ("usb", "uart", "wch", "silab", "cp210", "ch34", "ftdi")
-    ranked = []
-    for p in ports:
-        score = 0
+    prefer_substrings = ("usb", "uart", "wch", "silab", "cp210", "ch34", "ftdi", "espressif")
+    found = []
+    for p in list_ports.comports():
         desc = f"{p.description or ''} {p.hwid or ''}".lower()
-        for sub in prefer_substrings:
-            if sub in desc:
-                score += 1
-        ranked.append((score, p))
-    ranked.sort(key=lambda x: (-x[0], x[1].device))
+        if getattr(p, "vid", None) in ESP_VIDS or any(sub in desc for sub in prefer_substrings):
+            found.append((p.device, p.description or "ESP32-family"))
+    found.sort()
+    return found
+
+
+# --------------------------------------------------------------------
+# Image / settings
+# --------------------------------------------------------------------
+def partitions(image: bytes) -> List[Tuple[int, int, str]]:
+    """(offset, size, name) of each partition table entry, or [] if none."""
+    out = []
+    table = image[PART_TABLE_OFFSET:PART_TABLE_OFFSET + 0xC00]
+    for i in range(0, len(table) - 31, 32):
+        e = table[i:i + 32]
+        if e[:2] != PART_MAGIC:
+            break
+        _, _, off, size = struct.unpack("<BBII", e[2:12])
+        out.append((off, size, e[12:28].rstrip(b"\0").decode("ascii", "replace")))
+    return out
+
+
+def split_image(image: bytes, workdir: str, nvs: Optional[bytes]) -> List[Region]:
+    """
+    Cut the merged image at partition boundaries so each piece can be
+    compared and written on its own. 'nvs' replaces the NVS partition;
+    without it the DEVICE_STATE partitions are left out.
+    """
+    parts = sorted(p for p in partitions(image) if p[0] < len(image))
+    bounds = [(0, "boot")]
+    for off, size, name in parts:
+        if off > bounds[-1][0]:
+            bounds.append((off, name))
+        elif off == bounds[-1][0]:
+            bounds[-1] = (off, name)
+        if off + size < len(image):
+            bounds.append((off + size, "free"))
+    nvs_off = next((off for off, _, name in parts if name == "nvs"), NVS_DEFAULT[0])
+
+    regions = []
+    for i, (off, name) in enumerate(bounds):
+        end = bounds[i + 1][0] if i + 1 < len(bounds) else len(image)
+        if end <= off:
+            continue
+        if nvs is None and name in DEVICE_STATE:
+            continue
+        data = image[off:end]
+        if nvs is not None and off == nvs_off:
+            data = nvs[:len(data)].ljust(len(data), b"\xff")
+        path = os.path.join(workdir, f"{off:08x}_{name}.bin")
+        with open(path, "wb") as f:
+            f.write(data)
+        regions.append(Region(off, end - off, name, path))
+    return regions
+
+
+def nvs_size(image: bytes) -> int:
+    for off, size, name in partitions(image):
+        if name == "nvs":
+            return size
+    return NVS_DEFAULT[1]
+
+
+def build_nvs(workdir: str, size: int, ssid: str, password: str, display: str) -> bytes:
+    """
+    NVS partition with the keys the firmware reads at boot: wifi/ssid,pass
+    (skips the captive portal) and ui/display.
+    """
+    rows = [("key", "type", "encoding", "value")]
+    if ssid:
+        rows += [("wifi", "namespace", "", ""),
+                 ("ssid", "data", "string", ssid),
+                 ("pass", "data", "string", password)]
+    if display in DISPLAYS[1:]:
+        rows += [("ui", "namespace", "", ""),
+                 ("display", "data", "string", display)]
+    csv_path = os.path.join(workdir, "settings.csv")
+    bin_path = os.path.join(workdir, "settings_nvs.bin")
+    with open(csv_path, "w", newline="") as f:
+        csv.writer(f).writerows(rows)
+
+    cmd = [sys.executable, "-m", "esp_idf_nvs_partition_gen", "generate", csv_path, bin_path, hex(size)]
+    proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    if proc.returncode != 0 or not os.path.exists(bin_path):
+        raise RuntimeError("NVS generation failed (pip install esp-idf-nvs-partition-gen)\n" + proc.stdout)
+    with open(bin_path, "rb") as f:
+        return f.read()
 
-    # We don't truly know chip type until esptool talks to it; we label "ESP32-family"
-    # esptool with --chip auto will identify actual variant.
-    for _, p in ranked:
-        return (p.device, "ESP32-family")
 
-    return None
+# --------------------------------------------------------------------
+# Per-port worker (runs on its own thread; talks to the UI via a queue)
+# --------------------------------------------------------------------
+class PortJob:
+    def __init__(self, port: str, regions: List[Region], events: "queue.Queue", gate: threading.Semaphore):
+        self.port = port
+        self.regions = regions
+        self.events = events
+        self.gate = gate
+
+    def _post(self, kind: str, value=None):
+        self.events.put((kind, self.port, value))
+
+    def _esptool(self, baud: str, args: List[str], on_line=None) -> Tuple[int, str]:
+        cmd = [sys.executable, "-m", "esptool", "--chip", "auto", "--port", self.port, "--baud", baud] + args
+        self._post("log", "Running: " + " ".join(cmd) + "\n")
+        try:
+            proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                                    bufsize=1, universal_newlines=True)
+        except Exception as e:
+            return -1, f"Failed to start esptool: {e}"
+        out = []
+        try:
+            for line in proc.stdout:
+                out.append(line)
+                self._post("log", line)
+                if on_line:
+                    on_line(line)
+        finally:
+            proc.wait()
+        return proc.returncode, "".join(out)
+
+    def _changed(self, baud: str) -> Tuple[Optional[List[Region]], str]:
+        """Regions whose flash MD5 differs (None if the check didn't finish)."""
+        args = ["verify_flash"]
+        for r in self.regions:
+            args += [hex(r.offset), r.path]
+        _, out = self._esptool(baud, args)
+        results = RE_VERIFY.findall(out)
+        if len(results) != len(self.regions):
+            return None, out
+        return [r for r, res in zip(self.regions, results) if res == "mismatch"], out
+
+    def _write(self, baud: str, todo: List[Region]) -> Tuple[bool, str]:
+        total = sum(r.size for r in todo)
+        done_before = {}
+        acc = 0
+        for r in todo:
+            done_before[r.offset] = acc
+            acc += r.size
+
+        def on_line(line: str):
+            m = RE_PCT.search(line)
+            if not m:
+                return
+            addr = int(m.group(1), 16)
+            for r in todo:
+                if r.offset <= addr < r.offset + r.size:
+                    self._post("progress", 100.0 * (done_before[r.offset] + addr - r.offset) / total)
+                    return
+
+        args = ["write_flash", "-z"]
+        for r in todo:
+            args += [hex(r.offset), r.path]
+        rc, out = self._esptool(baud, args, on_line)
+        if rc == 0 and len(RE_HASH_OK.findall(out)) >= len(todo):
+            return True, out
+        return False, out
+
+    def run(self):
+        with self.gate:
+            self._post("status", "checking")
+            last = ""
+            for i, baud in enumerate(BAUD_STEPS):
+                todo, out = self._changed(baud)     # resets into the app when done
+                if todo is None:
+                    last = "flash check failed"
+                elif not todo:
+                    self._post("progress", 100.0)
+                    self._post("done", (True, f"up to date ({baud} baud)"))
+                    return
+                else:
+                    kb = sum(r.size for r in todo) // 1024
+                    names = ", ".join(r.name for r in todo)
+                    self._post("status", f"writing {names} ({kb} KB @ {baud})")
+                    ok, out = self._write(baud, todo)
+                    if ok:
+                        self._post("progress", 100.0)
+                        self._post("done", (True, f"flashed {names} @ {baud}"))
+                        return
+                    last = "write failed"
+                if any(s in out for s in NO_LINK):
+                    last = "no connection"
+                    break                                # not a speed problem
+                if i + 1 < len(BAUD_STEPS):
+                    self._post("status", f"{last}, retrying @ {BAUD_STEPS[i + 1]}")
+            self._post("done", (False, last or "failed"))
+
 
 # --------------------------------------------------------------------
 # GUI
@@ -78,14 +284,19 @@ class FlasherApp(tk.Tk):
 
         # State
         self.selected_file: Optional[str] = None
-        self.detected_port: Optional[str] = None
-        self.detected_chip: Optional[str] = None
+        self.ports: List[Tuple[str, str]] = []
+        self.rows = {}                      # port -> (progress var, status label)
+        self.events: "queue.Queue" = queue.Queue()
+        self.running = 0
+        self.failed: List[str] = []
+        self.workdir: Optional[str] = None
 
         # Build UI
         self._build_ui()
 
         # Try detection at startup
         self._detect_and_show()
+        self.after(50, self._pump)
 
     def _build_ui(self):
         root = ttk.Frame(self, padding=12)
@@ -94,10 +305,11 @@ class FlasherApp(tk.Tk):
         self.rowconfigure(0, weight=1)
         root.columnconfigure(1, weight=1)
 
-        # Row 0: Detected device (read-only)
-        ttk.Label(root, text="Detected device:").grid(row=0, column=0, sticky="w", pady=(0,6))
-        self.detect_label = ttk.Label(root, text="(none)")
-        self.detect_label.grid(row=0, column=1, sticky="w", pady=(0,6))
+        # Row 0: Detected devices, one progress row each
+        ttk.Label(root, text="Detected devices:").grid(row=0, column=0, sticky="nw", pady=(0,6))
+        self.dev_frame = ttk.Frame(root)
+        self.dev_frame.grid(row=0, column=1, sticky="ew", pady=(0,6))
+        self.dev_frame.columnconfigure(1, weight=1)
 
         # Row 1: File picker
         ttk.Label(root, text="Merged BIN file:").grid(row=1, column=0, sticky="w")
@@ -108,37 +320,62 @@ class FlasherApp(tk.Tk):
         self.file_entry.grid(row=0, column=0, sticky="ew", padx=(0,6))
         ttk.Button(pick_row, text="Browse…", command=self._browse).grid(row=0, column=1, sticky="e")
 
-        # Row 2: Actions
+        # Row 2: Optional pre-seeded settings
+        ttk.Label(root, text="Pre-set Wi-Fi:").grid(row=2, column=0, sticky="w", pady=(6,0))
+        seed_row = ttk.Frame(root)
+        seed_row.grid(row=2, column=1, sticky="ew", pady=(6,0))
+        seed_row.columnconfigure(1, weight=1)
+        seed_row.columnconfigure(3, weight=1)
+        ttk.Label(seed_row, text="SSID").grid(row=0, column=0, padx=(0,4))
+        self.ssid_entry = ttk.Entry(seed_row)
+        self.ssid_entry.grid(row=0, column=1, sticky="ew", padx=(0,6))
+        ttk.Label(seed_row, text="Password").grid(row=0, column=2, padx=(0,4))
+        self.pass_entry = ttk.Entry(seed_row, show="•")
+        self.pass_entry.grid(row=0, column=3, sticky="ew", padx=(0,6))
+        ttk.Label(seed_row, text="Display").grid(row=0, column=4, padx=(0,4))
+        self.display_box = ttk.Combobox(seed_row, values=DISPLAYS, state="readonly", width=9)
+        self.display_box.current(0)
+        self.display_box.grid(row=0, column=5)
+
+        # Row 3: Actions
         action_row = ttk.Frame(root)
-        action_row.grid(row=2, column=0, columnspan=2, pady=(10,6), sticky="ew")
+        action_row.grid(row=3, column=0, columnspan=2, pady=(10,6), sticky="ew")
         action_row.columnconfigure(0, weight=1)
-        ttk.Button(action_row, text="Flash", command=self._on_flash).grid(row=0, column=0, sticky="ew")
-        ttk.Button(action_row, text="Rescan Device", command=self._detect_and_show).grid(row=0, column=1, padx=(6,0))
+        ttk.Button(action_row, text="Flash All", command=self._on_flash).grid(row=0, column=0, sticky="ew")
+        ttk.Button(action_row, text="Rescan Devices", command=self._detect_and_show).grid(row=0, column=1, padx=(6,0))
 
-        # Row 3: Log
-        ttk.Label(root, text="Log:").grid(row=3, column=0, columnspan=2, sticky="w", pady=(10,4))
+        # Row 4: Log
+        ttk.Label(root, text="Log:").grid(row=4, column=0, columnspan=2, sticky="w", pady=(10,4))
         self.log = tk.Text(root, height=16, width=80, state="disabled")
-        self.log.grid(row=4, column=0, columnspan=2, sticky="nsew")
-        root.rowconfigure(4, weight=1)
+        self.log.grid(row=5, column=0, columnspan=2, sticky="nsew")
+        root.rowconfigure(5, weight=1)
 
         # Footer: copyright
         footer = ttk.Label(root, text="© Darkone Customs 2025", anchor="center")
-        footer.grid(row=5, column=0, columnspan=2, pady=(8,0), sticky="ew")
+        footer.grid(row=6, column=0, columnspan=2, pady=(8,0), sticky="ew")
 
     # ----------------------------------------------------------------
     # Helpers
     # ----------------------------------------------------------------
     def _detect_and_show(self):
-        res = detect_first_esp32()
-        if res:
-            self.detected_port, self.detected_chip = res
-            self._status(f"Detected {self.detected_chip} on {self.detected_port}")
-            self.detect_label.config(text=f"{self.detected_chip} @ {self.detected_port}")
-        else:
-            self.detected_port = None
-            self.detected_chip = None
-            self._status("No ESP32 detected. Connect device and click Rescan.")
-            self.detect_label.config(text="(none)")
+        if self.running:
+            return
+        self.ports = detect_esp32s()
+        for w in self.dev_frame.winfo_children():
+            w.destroy()
+        self.rows = {}
+        if not self.ports:
+            ttk.Label(self.dev_frame, text="(none)").grid(row=0, column=0, sticky="w")
+            self._status("No ESP32 detected. Connect devices and click Rescan.")
+            return
+        for i, (port, desc) in enumerate(self.ports):
+            pct = tk.DoubleVar(value=0.0)
+            ttk.Label(self.dev_frame, text=port, width=14).grid(row=i, column=0, sticky="w")
+            ttk.Progressbar(self.dev_frame, variable=pct, maximum=100).grid(row=i, column=1, sticky="ew", padx=6)
+            status = ttk.Label(self.dev_frame, text=desc, width=34)
+            status.grid(row=i, column=2, sticky="w")
+            self.rows[port] = (pct, status)
+        self._status(f"Detected {len(self.ports)} device(s): " + ", ".join(p for p, _ in self.ports))
 
     def _browse(self):
         fname = filedialog.askopenfilename(
@@ -172,24 +409,93 @@ class FlasherApp(tk.Tk):
             messagebox.showerror(APP_NAME, "Selected file does not exist.")
             return
 
-        # Ensure we have a target; if not, try detect again right now
-        if not self.detected_port:
+        # Ensure we have targets; if not, try detect again right now
+        if not self.ports:
             self._detect_and_show()
-        if not self.detected_port:
-            messagebox.showerror(APP_NAME, "No ESP32 detected. Connect device and click Rescan.")
+        if not self.ports:
+            messagebox.showerror(APP_NAME, "No ESP32 detected. Connect devices and click Rescan.")
+            return
+
+        ssid = self.ssid_entry.get()
+        display = self.display_box.get()
+        with open(path, "rb") as f:
+            image = f.read()
+        self.workdir = tempfile.mkdtemp(prefix="tdwo_")
+        try:
+            nvs = None
+            if ssid or display in DISPLAYS[1:]:
+                if not partitions(image):
+                    raise RuntimeError("This BIN has no partition table at 0x8000; settings need a merged image.")
+                nvs = build_nvs(self.workdir, nvs_size(image), ssid, self.pass_entry.get(), display)
+            regions = split_image(image, self.workdir, nvs)
+        except Exception as e:
+            self._cleanup()
+            messagebox.showerror(APP_NAME, str(e))
             return
 
         # Disable UI during flash
         self._toggle_ui(False)
-        self._append_log(f"\n=== Flashing {os.path.basename(path)} to {self.detected_port} at {FLASH_OFFSET} ===\n")
+        self._append_log(f"\n=== Flashing {os.path.basename(path)} to {len(self.ports)} device(s) ===\n")
+        for r in regions:
+            self._append_log(f"  0x{r.offset:06x} {r.size // 1024:5d} KB  {r.name}\n")
+        if nvs is not None:
+            self._append_log("  (nvs replaced with the pre-set settings)\n")
+        else:
+            self._append_log("  (nvs and otadata left as they are on the device)\n")
+
+        # One worker per port
+        gate = threading.Semaphore(MAX_PARALLEL)
+        self.running = len(self.ports)
+        self.failed = []
+        for port, _ in self.ports:
+            pct, status = self.rows[port]
+            pct.set(0.0)
+            status.config(text="waiting")
+            job = PortJob(port, regions, self.events, gate)
+            threading.Thread(target=job.run, daemon=True).start()
+
+    def _pump(self):
+        # worker events -> widgets (Tk is only touched from this thread)
+        try:
+            while True:
+                kind, port, value = self.events.get_nowait()
+                pct, status = self.rows.get(port, (None, None))
+                if kind == "log":
+                    self._append_log(f"[{port}] {value}")
+                elif kind == "progress" and pct is not None:
+                    pct.set(value)
+                elif kind == "status" and status is not None:
+                    status.config(text=value)
+                elif kind == "done":
+                    ok, msg = value
+                    if status is not None:
+                        status.config(text=msg if ok else "FAILED: " + msg)
+                    if not ok:
+                        self.failed.append(port)
+                    self.running -= 1
+                    if self.running == 0:
+                        self._all_done()
+        except queue.Empty:
+            pass
+        self.after(50, self._pump)
+
+    def _all_done(self):
+        self._cleanup()
+        if self.failed:
+            self._done_with_error("Failed on " + ", ".join(self.failed))
+        else:
+            self._append_log("\n=== Flash complete. Devices will reset. ===\n")
+            self._done_ok()
 
-        # Start worker thread
-        t = threading.Thread(target=self._flash_worker, args=(self.detected_port, path), daemon=True)
-        t.start()
+    def _cleanup(self):
+        if self.workdir:
+            shutil.rmtree(self.workdir, ignore_errors=True)
+            self.workdir = None
 
     def _toggle_ui(self, enabled: bool):
-        for w in (self.file_entry, self.log):
+        for w in (self.file_entry, self.ssid_entry, self.pass_entry, self.log):
             w.configure(state=("normal" if enabled else "disabled"))
+        self.display_box.configure(state=("readonly" if enabled else "disabled"))
         # Buttons: need to reference them explicitly
         # Find all children buttons and enable/disable
         for child in self.children.values():
@@ -202,53 +508,6 @@ class FlasherApp(tk.Tk):
             for ch in widget.children.values():
                 self._set_buttons_enabled(ch, enabled)
 
-    def _flash_worker(self, port: str, bin_path: str):
-        """
-        Run esptool in a subprocess so we can stream its output into the log.
-        """
-        # Build esptool command
-        cmd = [
-            sys.executable, "-m", "esptool",
-            "--port", port,
-            "--baud", DEFAULT_BAUD,
-            "write_flash",
-            FLASH_OFFSET, bin_path
-        ]
-
-        self._append_log("Running: " + " ".join(cmd) + "\n")
-
-        # Stream output
-        try:
-            proc = subprocess.Popen(
-                cmd,
-                stdout=subprocess.PIPE,
-                stderr=subprocess.STDOUT,
-                bufsize=1,
-                universal_newlines=True,
-            )
-        except FileNotFoundError:
-            self._done_with_error("Python not found to spawn esptool. Run this script with Python.")
-            return
-        except Exception as e:
-            self._done_with_error(f"Failed to start esptool: {e}")
-            return
-
-        # Read stdout line by line
-        try:
-            for line in proc.stdout:
-                self._append_log(line)
-        except Exception as e:
-            self._append_log(f"\n[Reader error] {e}\n")
-        finally:
-            proc.wait()
-
-        rc = proc.returncode
-        if rc == 0:
-            self._append_log("\n=== Flash complete. Device will reset. ===\n")
-            self._done_ok()
-        else:
-            self._done_with_error(f"esptool exited with code {rc}")
-
     def _done_ok(self):
         self._toggle_ui(True)
         try:
@@ -267,8 +526,8 @@ class FlasherApp(tk.Tk):
 def main():
     app = FlasherApp()
     # reasonable default size
-    app.geometry("720x520")
-    app.minsize(600, 400)
+    app.geometry("760x560")
+    app.minsize(640, 420)
     app.mainloop()
 
 if __name__ == "__main__":
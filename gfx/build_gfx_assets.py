@@ -0,0 +1,148 @@
+# build_gfx_assets.py
+# Packs the bitmaps the SSD1309 screens draw into src/gfx_assets.{h,cpp}
+# - Converted to the panel's page layout (8 px tall bytes, as in the U8g2
+#   frame buffer) and RLE'd; display.cpp decodes them straight into it
+# - Like web/build_web_assets.py, run it after editing anything here and
+#   commit the output (the Arduino build has no pre-build hook)
+#
+# Usage: python gfx/build_gfx_assets.py
+
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SRC = os.path.join(HERE, "..", "src")
+OUT_H = os.path.join(SRC, "gfx_assets.h")
+OUT_CPP = os.path.join(SRC, "gfx_assets.cpp")
+
+# (XBM-style source in gfx/, C symbol)
+BITMAPS = [
+    ("dc_logo.h", "GFX_DC_LOGO"),
+]
+
+
+# -------- C source helpers --------
+def read_text(path):
+    with open(path, "rb") as f:
+        return f.read().decode("latin-1")
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + ",".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+# -------- bitmaps --------
+def load_xbm(path):
+    text = read_text(path)
+    w = int(re.search(r"#define\s+\w*WIDTH\s+(\d+)", text, re.I).group(1))
+    h = int(re.search(r"#define\s+\w*HEIGHT\s+(\d+)", text, re.I).group(1))
+    body = text[text.index("{") + 1:text.index("}")]
+    bits = bytes(int(x, 16) for x in re.findall(r"0x[0-9a-fA-F]{1,2}", body))
+    stride = (w + 7) // 8
+    if len(bits) != stride * h:
+        sys.exit("%s: %u bytes for %ux%u" % (path, len(bits), w, h))
+    return w, h, bits, stride
+
+
+def to_pages(w, h, bits, stride):
+    """XBM (rows, LSB = left) to U8g2 buffer order (8-row pages, LSB = top)."""
+    out = bytearray()
+    for page in range((h + 7) // 8):
+        for x in range(w):
+            b = 0
+            for r in range(8):
+                y = page * 8 + r
+                if y < h and bits[y * stride + x // 8] >> (x % 8) & 1:
+                    b |= 1 << r
+            out.append(b)
+    return bytes(out)
+
+
+def rle(data):
+    """c < 0x80: c+1 literal bytes follow; c >= 0x80: next byte, c-0x7e times."""
+    out, lit, i = bytearray(), bytearray(), 0
+
+    def flush():
+        if lit:
+            out.append(len(lit) - 1)
+            out.extend(lit)
+            lit.clear()
+
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 129 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3 or (run == 2 and not lit):
+            flush()
+            out += bytes((0x7e + run, data[i]))
+            i += run
+        else:
+            lit.append(data[i])
+            i += 1
+            if len(lit) == 128:
+                flush()
+    flush()
+    return bytes(out)
+
+
+def unrle(data):
+    out, i = bytearray(), 0
+    while i < len(data):
+        c = data[i]
+        if c < 0x80:
+            out += data[i + 1:i + 2 + c]
+            i += 2 + c
+        else:
+            out += bytes([data[i + 1]]) * (c - 0x7e)
+            i += 2
+    return bytes(out)
+
+
+# -------- output --------
+def main():
+    h = [
+        "#pragma once",
+        "// Generated by gfx/build_gfx_assets.py - do not edit.",
+        "#include <Arduino.h>",
+        "",
+        "// Page-packed RLE bitmap: 'pages' rows of 8 px by 'w' columns, in U8g2",
+        "// frame buffer byte order. Control byte c < 0x80: c+1 literal bytes follow;",
+        "// c >= 0x80: the next byte repeated c-0x7e times.",
+        "struct GfxRle {",
+        "  uint8_t w, pages;",
+        "  uint16_t len;",
+        "  const uint8_t* data;",
+        "};",
+        "",
+    ]
+    cpp = [
+        "// Generated by gfx/build_gfx_assets.py - do not edit.",
+        "#include \"gfx_assets.h\"",
+        "",
+    ]
+
+    for name, sym in BITMAPS:
+        w, ht, bits, stride = load_xbm(os.path.join(HERE, name))
+        pages = to_pages(w, ht, bits, stride)
+        packed = rle(pages)
+        assert unrle(packed) == pages
+        h.append("extern const GfxRle %s;   // %s %ux%u: %u -> %u B"
+                 % (sym, name, w, ht, len(bits), len(packed)))
+        cpp.append("static const uint8_t %s_RLE[] PROGMEM = {" % sym)
+        cpp.append(c_array(packed))
+        cpp.append("};")
+        cpp.append("const GfxRle %s = { %u, %u, %u, %s_RLE };" % (sym, w, (ht + 7) // 8, len(packed), sym))
+        cpp.append("")
+        print("%-24s %ux%u %6u -> %5u B rle" % (name, w, ht, len(bits), len(packed)))
+
+    for path, lines in ((OUT_H, h), (OUT_CPP, cpp)):
+        with open(path, "w", newline="\n") as f:
+            f.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()
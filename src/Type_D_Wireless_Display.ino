@@ -1,121 +1,239 @@
 #include "wifimgr.h"
 #include "led_stat.h"
 #include "udp_typed.h"
-#include "display.h"
+#include "telemetry.h"
 #include "weather.h"
 #include "insignia.h"
+#include "i2c_bus.h"
+#include "fuel_gauge.h"
+#include "task_sched.h"
+#include "metrics.h"
+#include "ota_mgr.h"
+#include "settings.h"
+#include "mem.h"
+#include "http_pool.h"
+#include "typed_proto.h"
+#include "live.h"
+#include "history.h"
+#include "panel.h"
 
 #include <Arduino.h>
 #include <Wire.h>
-#include <U8g2lib.h>
 #include <WiFi.h>
 #include <ESPmDNS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
-// -------- Character OLED (US2066 20x4) --------
-#include "us2066.h"
-#include "us2066_view.h"
-
-// -------- OLED (Waveshare 2.42" SSD1309 I2C @ 0x3D) --------
+// -------- Display bus (the panels themselves: see panel.h) --------
 static const int PIN_SDA = 6;
 static const int PIN_SCL = 7;
-static const int PIN_RST = 9;   // SSD1309 RESET wired to GPIO 9
+static const uint32_t BUS_HZ = 400000;
+static const uint8_t  LC709203F_ADDR = 0x0B;
 
-U8G2_SSD1309_128X64_NONAME2_F_HW_I2C u8g2(U8G2_R0, /* reset = */ PIN_RST);
+static TwoWire* dispWire = &Wire;   // where the active display answered
 
-// US2066 objects
-US2066      charOled;
-US2066View  charView;
-bool        useUS2066 = false;
+// ---- bus setup: which bus each device answers on ----
+static bool probe(TwoWire* w, uint8_t addr) {
+  w->beginTransmission(addr);
+  return w->endTransmission() == 0;
+}
 
-// ---- helpers to init US2066 path ----
-static bool initUS2066() {
+// Wire always runs (gauge, shared display). Wire1 is brought up unless the
+// portal says "shared"; the display stays there only if it answers on it.
+static TwoWire* startBuses(uint8_t dispAddr) {
   Wire.begin(PIN_SDA, PIN_SCL);
-  Wire.setClock(400000);
-
-  if (!charOled.begin(&Wire, 0x3C, 20, 4)) {
-    return false; // fallback to SSD1309
+  Wire.setClock(BUS_HZ);
+  I2CBus::attach(&Wire);             // panel bursts and gauge reads may share it
+  dispWire = &Wire;
+
+  const WiFiMgr::DisplayBus pref = WiFiMgr::getDisplayBus();
+  if (pref == WiFiMgr::DisplayBus::Shared) return dispWire;
+  Wire1.begin(OLED_BUS2_SDA, OLED_BUS2_SCL);
+  Wire1.setClock(BUS_HZ);            // probe at the safe speed
+  if (probe(&Wire1, dispAddr)) {
+    dispWire = &Wire1;
+    Wire1.setClock(OLED_BUS2_HZ);
+    I2CBus::attach(&Wire1);
+    Serial.printf("[BUS] display 0x%02X on Wire1 (%d/%d) @ %lu Hz\n", dispAddr,
+                  OLED_BUS2_SDA, OLED_BUS2_SCL, (unsigned long)OLED_BUS2_HZ);
+    return dispWire;
   }
-  if (!charView.attach(&charOled)) {
-    return false; // fallback to SSD1309
-  }
-  // simple boot splash (one-time). The view owns data thereafter.
-  charView.splash("Type-D Wireless", "US2066 20x4", "Alt View Ready", "");
-  return true;
+  if (pref == WiFiMgr::DisplayBus::Separate)
+    Serial.printf("[BUS] display 0x%02X not on Wire1, using Wire\n", dispAddr);
+  Wire1.end();
+  return dispWire;
 }
 
-void setup() {
-  //Serial.begin(115200);
+// The gauge normally sits on Wire; follow it if it was wired to the display bus
+// (FuelGauge drops that bus to its 400 kHz limit for each read).
+static TwoWire* gaugeWire() {
+  if (dispWire != &Wire && !probe(&Wire, LC709203F_ADDR) && probe(dispWire, LC709203F_ADDR)) return dispWire;
+  return &Wire;                      // not found anywhere: FuelGauge keeps retrying there
+}
 
-  LedStat::begin();
-  LedStat::setStatus(LedStatus::Booting);
+// ---- boot timeline (ms since reset, 0 = not yet; under "boot" in /metrics) ----
+static uint32_t bootLogoMs = 0, bootWifiMs = 0, bootLinkMs = 0, bootFrameMs = 0;
+
+static void bootMetrics(String& out) {
+  out += "\"boot\":{\"logo_ms\":"; out += bootLogoMs;
+  out += ",\"wifi_ms\":";  out += bootWifiMs;
+  out += ",\"link_ms\":";  out += bootLinkMs;
+  out += ",\"first_frame_ms\":"; out += bootFrameMs;
+  out += '}';
+}
+
+// Radio + portal bring-up runs here while setup() initializes the display
+static void wifiInitTask(void*) {
   WiFiMgr::begin();
+  bootWifiMs = millis();
+  vTaskDelete(nullptr);
+}
+
+// ---- scheduled work (Arduino loop task) ----
+static void netTask() {
+  if (OtaMgr::active()) return;   // the update gets the radio and the bus
+  // Weather fetches on its own task; both views read Weather::isReady()/get().
+  Weather::loop();
+  // Pump UDP first so display sees the freshest packet this tick
+  // (no-op while the receiver task is running)
+  TypeDUDP::loop();
+  Telemetry::loop();      // decode once, notify views of changed fields
+  if (!bootFrameMs && Telemetry::everReceived()) {
+    bootFrameMs = millis();
+    Serial.printf("[BOOT] first telemetry at %lu ms\n", (unsigned long)bootFrameMs);
+  }
+}
 
-  // Decide active display from portal pref
-  useUS2066 = WiFiMgr::isUS2066Selected();
+static void renderTask() {
+  Metrics::Scope m(Metrics::T_DRAW);
+  Panel::render();        // update progress while OtaMgr is active, else the screens
+}
+
+// mDNS: "typeddisp.local" plus a _typed._udp service, so senders can find
+// displays and unicast to them instead of broadcasting. TXT carries the
+// socket ports, the wire protocol version, the panel and any multicast group.
+// The responder is restarted whenever the address changes, which makes it
+// announce again.
+static void mdnsAdvertise() {
+  char v[16];
+  MDNS.addService("typed", "udp", TypeDUDP::portA());
+  snprintf(v, sizeof(v), "%u", (unsigned)TypeDUDP::portA()); MDNS.addServiceTxt("typed", "udp", "main", v);
+  snprintf(v, sizeof(v), "%u", (unsigned)TypeDUDP::portB()); MDNS.addServiceTxt("typed", "udp", "ext", v);
+  snprintf(v, sizeof(v), "%u", (unsigned)TypeDUDP::portC()); MDNS.addServiceTxt("typed", "udp", "ee", v);
+  snprintf(v, sizeof(v), "%u", (unsigned)TypedProto::VERSION); MDNS.addServiceTxt("typed", "udp", "proto", v);
+  MDNS.addServiceTxt("typed", "udp", "display", Panel::name());
+  const IPAddress g = TypeDUDP::multicastGroup();
+  if ((uint32_t)g) MDNS.addServiceTxt("typed", "udp", "mcast", g.toString().c_str());
+  MDNS.addService("http", "tcp", 80);           // the portal
+}
 
-  if (useUS2066) {
-    if (!initUS2066()) {
-      useUS2066 = false; // fallback to SSD1309 below
+static void mdnsTask() {
+  static bool     mdnsStarted = false;
+  static uint32_t mdnsIp = 0;
+  const bool connected = WiFiMgr::isConnected();
+  const uint32_t ip = connected ? (uint32_t)WiFi.localIP() : 0;
+  if (mdnsStarted && ip != mdnsIp) {               // link lost or new lease
+    MDNS.end();
+    mdnsStarted = false;
+  }
+  if (connected && ip && !mdnsStarted) {
+    if (MDNS.begin("typeddisp")) {
+      mdnsAdvertise();
+      mdnsStarted = true;
+      mdnsIp = ip;
     }
   }
+}
 
-  if (!useUS2066) {
-    // ---- SSD1309 path ----
-    Wire.begin(PIN_SDA, PIN_SCL);
-    Wire.setClock(400000);
+// Battery profile dims the active panel (the Wi-Fi side is WiFiMgr's)
+static void powerTask() {
+  static int8_t dimmed = -1;
+  const int8_t want = (WiFiMgr::getPowerProfile() == WiFiMgr::PowerProfile::Battery) ? 1 : 0;
+  if (want == dimmed) return;
+  dimmed = want;
+  Panel::dim(want);
+}
 
-    pinMode(PIN_RST, OUTPUT);
-    digitalWrite(PIN_RST, LOW);
-    delay(20);
-    digitalWrite(PIN_RST, HIGH);
-    delay(250);
+struct SchedEntry { const char* name; Sched::TaskFn fn; uint32_t periodMs, budgetUs; uint8_t flags; };
+static const SchedEntry SCHED_TASKS[] = {
+  // name       fn               period  budget(us)
+  { "led",      LedStat::loop,   20,     500 },
+  { "wifi",     WiFiMgr::loop,   10,     2000 },
+  { "net",      netTask,         10,     2000,  Sched::WAKE },
+  { "render",   renderTask,      10,     8000,  Sched::WAKE },
+  { "mdns",     mdnsTask,        500,    20000 },
+  { "power",    powerTask,       1000,   1000 },
+  { "ctrl",     Panel::control,  1000,   1000 },    // reverse control
+  { "ota",      OtaMgr::loop,    50,     200 },
+  { "settings", Settings::loop,  250,    20000 },   // NVS commits are slow but rare
+  { "http",     HttpPool::prune, 1000,   2000 },
+  { "live",     Live::loop,      50,     3000 },
+  { "history",  History::loop,   250,    300 },
+};
+static_assert(sizeof(SCHED_TASKS) / sizeof(SCHED_TASKS[0]) + 2 <= SCHED_MAX_TASKS,
+              "raise SCHED_MAX_TASKS: keep room for two more tasks");
+
+static void startScheduler() {
+  for (const SchedEntry& t : SCHED_TASKS)
+    if (Sched::add(t.name, t.fn, t.periodMs, t.budgetUs, t.flags) < 0)
+      Serial.printf("[SCHED] task table full: '%s' will not run\n", t.name);
+  TypeDUDP::setRxNotify(Sched::wake);   // new packet: decode + render without waiting a period
+  Metrics::addSection(Panel::metricsJson);
+  Metrics::addSection(bootMetrics);
+  Metrics::addSection(Mem::metricsJson);
+  Metrics::addSection(HttpPool::metricsJson);
+  Metrics::addSection(Live::metricsJson);
+}
 
-    u8g2.setI2CAddress(0x3D << 1);
-    u8g2.begin();
-    u8g2.setContrast(255);
-    u8g2.setFlipMode(1); // use 0/1 as needed
+void setup() {
+  //Serial.begin(115200);
 
-    TypeDDisplay::begin(&u8g2);
-    TypeDDisplay::setHoldTimes(15000, 5000);
+  LedStat::begin();
+  LedStat::setStatus(LedStatus::Booting);
+  static const char* const NVS_NS[] = { "wifi", "ui", "weather" };
+  Settings::begin(NVS_NS, sizeof(NVS_NS) / sizeof(NVS_NS[0]));   // one NVS pass; reads are RAM from here
+  WiFiMgr::loadPrefs();
+  // the radio comes up on core 0 while the display initializes
+  if (xTaskCreatePinnedToCore(wifiInitTask, "wifi_init", 6144, nullptr, 1, nullptr, 0) != pdPASS) {
+    WiFiMgr::begin();
+    bootWifiMs = millis();
   }
 
-  Weather::begin();       // drive weather for BOTH displays (SSD1309 & US2066)
+  // Portal pref picks the panel when both backends are built; the other is the fallback
+  const Panel::Kind pref = WiFiMgr::isUS2066Selected() ? Panel::Kind::US2066 : Panel::Kind::SSD1309;
+  Panel::begin(pref, startBuses);
+  if (Panel::kind() != Panel::Kind::US2066)
+    FuelGauge::begin(gaugeWire(), /*debug=*/true);   // reads between frames, off the render path
+
+  bootLogoMs = millis();   // SSD1309 logo / US2066 splash is up
+  Serial.printf("[BOOT] display up at %lu ms\n", (unsigned long)bootLogoMs);
 
+  Weather::begin();       // one weather service for BOTH displays (SSD1309 & US2066)
+
+  TypeDUDP::useRxTask(true); // receive on core 0 so rendering never stalls the socket
+  TypeDUDP::setQueueMode(TypeDUDP::QueueMode::Coalesce); // newest MAIN/EXT/EE only
   TypeDUDP::begin();      // sockets bind on Wi-Fi connect and rebind on drops
+  Telemetry::begin();     // single decoder + snapshot shared by both views
 
   // Insignia emulator/runtime (shared across displays)
   Insignia::setServerBase("http://darkone83.myddns.me:8080/xbox, http://darkone83.myddns.me:8008/xbox/data");
-  Insignia::setFlushCacheOnBoot(true);
+  // the flash cache is dropped when the firmware changes (see Insignia), not on every boot
   Insignia::setCacheLimits(32, 128*1024, 6UL*60*60*1000UL);
   Insignia::begin(/*debug=*/true);
-}
 
-void loop() {
-  LedStat::loop();
-  WiFiMgr::loop();
+  // weather stays off the network while an update streams in
+  OtaMgr::onActive([](bool active){ Weather::setPaused(active); });
 
-  // Drive the weather state machine regardless of display type.
-  // (US2066 and SSD1309 views both read Weather::isReady()/get().)
-  Weather::loop();
-
-  // Always pump UDP first so display sees the freshest packet this tick
-  TypeDUDP::loop();
+  // link edges come from the Wi-Fi event handler instead of per-tick polling
+  WiFiMgr::onLink([](bool up){
+    if (up && !bootLinkMs) bootLinkMs = millis();
+    TypeDUDP::setLinkUp(up);
+    Insignia::setLinkUp(up);
+  });
 
-  if (useUS2066) {
-    // US2066 view ingests UDP (MAIN/EXT/EE), reads IP/RSSI, formats, and renders.
-    charView.loop();   // <- parses MAIN/EXT/EE and renders pages (incl. weather page)
-    Insignia::tick();  // <- tick AFTER view so Insignia reacts immediately if needed
-  } else {
-    // SSD1309 path (existing UI)
-    TypeDDisplay::loop();
-    Insignia::tick();  // SSD1309 timing unchanged
-  }
+  startScheduler();
+}
 
-  static bool mdnsStarted = false;
-  const bool connected = WiFiMgr::isConnected();
-  if (connected && !mdnsStarted) {
-    if (MDNS.begin("typeddisp")) {
-      mdnsStarted = true;
-    }
-  }
+void loop() {
+  Sched::run();
 }
@@ -1,78 +1,106 @@
 // display.cpp — Type-D Wireless Display (SSD1309) with ConsoleMods-based Xbox version guessing
-// Screens: MAIN / SECOND / HEALTH / WEATHER
+// Screens: MAIN / SECOND / GRAPH / HEALTH / WEATHER
 // - MAIN: rows + scrolling game quote; new quote on MAIN entry & every 60s
 //         + Battery widget on the Fan row (right-justified) if LC709203F is detected
 // - SECOND: dense info (Tray/AV/Xbox/Encoder/Serial/MAC/Region)
+// - GRAPH: CPU / ambient / fan sparklines from History (10 s samples)
 // - HEALTH: simplified, text-only (WiFi RSSI, Free memory, IP)
 // - WEATHER: icon + temp + cond, humidity, wind (Open-Meteo, keyless)
 // Inactivity policy (final):
 //   - Show ONLY the DC logo (full-screen) before first MAIN packet.
 //   - If NO packets (A/B/C) for 2 min -> show DC logo (searching).
-//   - If NO packets (A/B/C) for 5 min -> screensaver (bouncing “Sleeping...”).
+//   - If NO packets (A/B/C) for 5 min -> screensaver (bouncing “Sleeping...”, dimmed).
+//   - If NO packets (A/B/C) for 30 min -> panel off.
 //   - On any packet -> exit saver and resume.
 //   - We NEVER draw “STALE”.
 // Transitions: slide-in left/right only.
 
 #include "display.h"
 #include <U8g2lib.h>
-#include "udp_typed.h"
+#include "telemetry.h"
+#include "typed_proto.h"
+#include "oled_damage.h"
+#include "metrics.h"
+#include "history.h"
 #include <WiFi.h>
 #include <esp_system.h>
+#include <freertos/FreeRTOS.h>
 #include <Arduino.h>
 #include <ctype.h>
 #include <string.h>
 #include <math.h>          // isnan(), fabsf()
-#include <Preferences.h>
 
-// --- Boot glyph (dc_logo.h) ---
-#include "dc_logo.h"
+// --- Boot glyph (generated by gfx/build_gfx_assets.py) ---
+#include "gfx_assets.h"
 
-// --- Fuel gauge (Adafruit LC709203F) ---
-#include <Adafruit_LC709203F.h>
+// --- Fuel gauge (sampled on its own task) ---
+#include "fuel_gauge.h"
 
-// --- Weather fetch (Open-Meteo) ---
-#include <HTTPClient.h>
-#include <WiFiClientSecure.h>
-#include <ArduinoJson.h>
+// --- Weather (shared service; fetches off the UI loop) ---
+#include "weather.h"
 
 // --- Insignia 5th screen (NEW) ---
 #include "insignia.h"
 
+// --- Backend build flags (no SSD1309 backend built: this file is left out) ---
+#include "panel.h"
+#if TYPED_PANEL_U8G2
+
 namespace TypeDDisplay {
 
 // ===== Module state =====
 static U8G2* g = nullptr;
 static bool g_dbg = true;
+static bool g_latOverlay = false;
 
 // Hold times
 static uint32_t HOLD_MAIN_MS    = 15000;
 static uint32_t HOLD_SECOND_MS  =  5000;
+static uint32_t HOLD_GRAPH_MS   =  7000;
 static uint32_t HOLD_HEALTH_MS  =  5000;
 static uint32_t HOLD_WEATHER_MS =  7000;   // NEW: weather screen hold
 static uint32_t HOLD_INSIGNIA_MS= 12000;   // NEW: insignia screen hold
 
-// Draw cadence
-static const  uint32_t DRAW_INTERVAL_MS = 200;
+// Draw cadence (flushes only send changed tiles, so animated screens can run faster)
+static const  uint32_t DRAW_INTERVAL_MS      = 200;
+static const  uint32_t DRAW_INTERVAL_ANIM_MS = 50;   // MAIN ticker / INSIGNIA scroll
 static        uint32_t lastDraw = 0;
 
 // Screens
-enum class Screen : uint8_t { WAITING=0, MAIN, SECOND, HEALTH, WEATHER, INSIGNIA };
+enum class Screen : uint8_t { WAITING=0, MAIN, SECOND, GRAPH, HEALTH, WEATHER, INSIGNIA };
 static Screen   cur = Screen::WAITING;
 static uint32_t nextSwitchAt = 0;
 
 // Inactivity thresholds (ANY UDP)
 static const uint32_t NO_PACKET_LOGO_MS  = 120000UL;
 static const uint32_t NO_PACKET_SAVER_MS = 300000UL;
+static const uint32_t NO_PACKET_OFF_MS   = 1800000UL;
+
+// Frame governor: without new data a screen is only redrawn as often as
+// something on it can change. The logo is drawn once; MAIN/HEALTH/WEATHER
+// carry clocks (battery, RSSI, ages) and refresh once a second; only the
+// MAIN ticker, INSIGNIA scroll and slides run at animation rate.
+static const uint32_t REFRESH_CLOCK_MS = 1000;
+enum class Shown : uint8_t { NONE=0, LOGO, SAVER };
+static Shown    shown = Shown::NONE;
+static uint32_t shownFrame = 0;     // OledDamage::framesFlushed() when it went up
 
 // Track what we’ve ever seen
 static bool     everAnyPacket = false;
 static bool     haveMain = false;
 // Proper timestamp of last packet arrival (fixes false “Sleeping...”)
 static uint32_t lastAnyAt = 0;
+// Telemetry version mirrored into the caches / last drawn on SECOND
+static uint32_t dataVersion = 0;
+static uint32_t secondDrawnVer = UINT32_MAX;  // SECOND is static text: redraw only on change
+static uint32_t clockDrawnVer = UINT32_MAX;   // HEALTH/WEATHER: data behind the last draw
+static uint32_t clockDrawnAt = 0;
 
 // Transitions
 enum class Xition : uint8_t { NONE=0, SLIDE_IN_RIGHT, SLIDE_IN_LEFT };
 static Xition nextXition = Xition::NONE;
+static void present();   // screens call this instead of flushing directly
+static bool xfCapture = false;   // render into the buffer without flushing
 
 // ===== Data caches from UDP =====
 static struct {
@@ -99,221 +127,106 @@ static struct {
   String region;
 } EE;
 
-// ===== Fuel gauge (LC709203F) =====
-static Adafruit_LC709203F lc;
-static bool lc_ok = false;
-static bool lc_tried = false;
-static uint32_t lc_lastTry = 0;
-static const uint32_t LC_RETRY_MS = 5000;
-
-// Shown on-screen (smoothed)
-static float lc_pct = NAN;
-static float lc_v   = NAN;
-static uint32_t lc_lastRead = 0;
-static const uint32_t LC_READ_MS = 3000;
-
-// Accuracy/consistency helpers
-static uint32_t lc_ok_since = 0;            // when gauge first came up
-static const uint32_t LC_WARMUP_MS   = 1500; // initial settle window
-static int lc_warmup_reads           = 0;    // also require N good reads
-static const int LC_WARMUP_READS     = 3;
-
-static const float LC_ALPHA_P        = 0.25f; // EMA factor for percent smoothing
-static const float LC_ALPHA_V        = 0.30f; // EMA factor for voltage smoothing
-static const float LC_MAX_STEP_P     = 6.0f;  // clamp % step per sample
-static const float LC_MAX_JUMP_V     = 0.12f; // reject raw V jumps >120 mV/read
-static const float LC_MAX_JUMP_P     = 12.0f; // reject raw % jumps >12%/read
-static const float LC_BLEND_W        = 0.60f; // weight for library % vs OCV % (0..1)
-static float lc_v_filt = NAN;                // filtered voltage
-static float last_p_raw = NAN, last_v_raw = NAN;
-
-// Voltage→% (very rough LiPo curve, linear between points)
-static float pctFromVoltage(float v) {
-  if (v <= 3.30f) return 0.f;
-  if (v >= 4.20f) return 100.f;
-  struct P { float v, p; };
-  const P pts[] = { {4.20,100},{4.08,95},{3.98,90},{3.92,85},{3.86,80},{3.80,75},{3.75,70},{3.70,60},{3.65,50},{3.60,45},{3.55,35},{3.50,25},{3.45,15},{3.40,8},{3.30,0} };
-  for (size_t i=1;i<sizeof(pts)/sizeof(pts[0]);++i) if (v >= pts[i].v) {
-    const float t = (v - pts[i].v) / (pts[i-1].v - pts[i].v);
-    return pts[i].p + t * (pts[i-1].p - pts[i].p);
+// ===== Text measurement =====
+// Per-font width tables, built the first time a font is measured (two
+// getStrWidth calls per byte value). U8g2 sums the glyph advances of a
+// string but counts the drawn extent of the last glyph, so both are kept
+// and textW() matches getStrWidth() exactly without walking glyph data.
+struct FontMetrics {
+  const uint8_t* font;
+  uint8_t adv[256];     // advance (dx) per byte
+  uint8_t ext[256];     // width when the byte ends the string
+};
+static const uint8_t MAX_FONT_METRICS = 8;
+static FontMetrics fontMetrics[MAX_FONT_METRICS];
+static uint8_t fontMetricsCount = 0;
+
+static const FontMetrics& metricsFor(const uint8_t* font) {
+  for (uint8_t i = 0; i < fontMetricsCount; ++i)
+    if (fontMetrics[i].font == font) return fontMetrics[i];
+  // more fonts than slots: recycle the last one (correct, just slower)
+  FontMetrics& m = fontMetrics[fontMetricsCount < MAX_FONT_METRICS ? fontMetricsCount++ : MAX_FONT_METRICS - 1];
+  m.font = font;
+  g->setFont(font);
+  char one[2] = { 0, 0 }, two[3] = { 0, 0, 0 };
+  m.adv[0] = m.ext[0] = 0;
+  for (int c = 1; c < 256; ++c) {
+    one[0] = two[0] = two[1] = (char)c;
+    const int w1 = g->getStrWidth(one), w2 = g->getStrWidth(two);
+    m.ext[c] = (uint8_t)constrain(w1, 0, 255);
+    m.adv[c] = (uint8_t)constrain(w2 - w1, 0, 255);
   }
-  return 50.f; // shouldn't reach
+  return m;
 }
 
-static inline bool plausibleV(float v) { return (!isnan(v) && v > 3.0f && v < 5.5f); }
-static inline bool plausibleP(float p) { return (!isnan(p) && p >= 0.f  && p <= 100.f); }
-
-static void resetGaugeFilters() {
-  lc_pct = NAN;
-  lc_v = lc_v_filt = NAN;
-  last_p_raw = last_v_raw = NAN;
-  lc_warmup_reads = 0;
+// Width of s in font; also leaves font selected for the draw that follows.
+static int textW(const uint8_t* font, const char* s) {
+  const FontMetrics& m = metricsFor(font);
+  g->setFont(font);
+  if (!s || !*s) return 0;
+  int w = 0;
+  for (; s[1]; ++s) w += m.adv[(uint8_t)*s];
+  return w + m.ext[(uint8_t)*s];
 }
 
-// NOTE: We do NOT use a thermistor. No thermistor config calls are made.
-static void maybeInitGauge() {
-  if (lc_ok) return;
-  uint32_t now = millis();
-  if (lc_tried && (now - lc_lastTry < LC_RETRY_MS)) return;
-
-  lc_tried = true;
-  lc_lastTry = now;
-
-  // Uses default address 0x0B on the existing Wire bus
-  if (lc.begin()) {
-    lc_ok = true;
-    lc_ok_since = millis();
-    resetGaugeFilters();
-
-    // If you define a known pack size at build-time, it will be applied.
-    #if defined(LC709203F_APA_2200MAH)
-      lc.setPackSize(LC709203F_APA_2200MAH);
-    #elif defined(LC709203F_APA_2000MAH)
-      lc.setPackSize(LC709203F_APA_2000MAH);
-    #elif defined(LC709203F_APA_2500MAH)
-      lc.setPackSize(LC709203F_APA_2500MAH);
-    #endif
-
-    // Keep default temperature behavior (internal IC method). No thermistor used.
-
-    #ifdef LC709203F_POWER_OPERATE
-      lc.setPowerMode(LC709203F_POWER_OPERATE);
-    #endif
-    if (g_dbg) Serial.println("[DISPLAY] LC709203F detected + configured (no thermistor)");
-  } else {
-    lc_ok = false;
-    if (g_dbg) Serial.println("[DISPLAY] LC709203F not found (will retry)");
-  }
+// Fitted strings, keyed by (font, text hash, max width). Screens refit the
+// same few strings on every frame; an entry is only recomputed when its
+// text changes, and the least recently used one makes room.
+struct FitEntry {
+  const uint8_t* font = nullptr;
+  uint32_t hash = 0;
+  uint16_t len = 0;
+  int16_t  maxW = 0;
+  int16_t  w = 0;       // width of fit
+  int16_t  cx = 0;      // x offset that centers fit in maxW
+  uint32_t used = 0;
+  String   fit;         // s, or its longest prefix + "..." that fits
+};
+static const uint8_t FIT_CACHE_SIZE = 16;
+static FitEntry fitCache[FIT_CACHE_SIZE];
+static uint32_t fitClock = 0;
+
+static uint32_t fnv1a(const char* s, size_t n) {
+  uint32_t h = 2166136261u;
+  while (n--) { h ^= (uint8_t)*s++; h *= 16777619u; }
+  return h;
 }
 
-static void updateGaugeReading() {
-  if (!lc_ok) return;
-  uint32_t now = millis();
-  if (now - lc_lastRead < LC_READ_MS) return;
-  // give the IC a moment after power-up to stabilize OCV estimate
-  if (lc_ok_since && (now - lc_ok_since < LC_WARMUP_MS)) return;
-  lc_lastRead = now;
-
-  float p_raw = lc.cellPercent();  // library estimate
-  float v_raw = lc.cellVoltage();  // measured voltage
-
-  // Basic plausibility
-  if (!plausibleV(v_raw)) v_raw = NAN;
-  if (!plausibleP(p_raw)) p_raw = NAN;
-
-  // Reject sudden jumps (vs last raw)
-  if (plausibleV(v_raw) && plausibleV(last_v_raw)) {
-    if (fabsf(v_raw - last_v_raw) > LC_MAX_JUMP_V) v_raw = NAN;
-  }
-  if (plausibleP(p_raw) && plausibleP(last_p_raw)) {
-    if (fabsf(p_raw - last_p_raw) > LC_MAX_JUMP_P) p_raw = NAN;
-  }
-
-  // Update last_raw if valid
-  if (!isnan(v_raw)) last_v_raw = v_raw;
-  if (!isnan(p_raw)) last_p_raw = p_raw;
-
-  // Voltage EMA
-  if (!isnan(v_raw)) {
-    if (isnan(lc_v_filt)) lc_v_filt = v_raw;
-    else lc_v_filt += LC_ALPHA_V * (v_raw - lc_v_filt);
-    lc_v = lc_v_filt; // expose filtered V for UI/debug
-  }
-
-  // Warm-up: require a few valid samples total before showing %
-  if (lc_warmup_reads < LC_WARMUP_READS) {
-    if (!isnan(v_raw) || !isnan(p_raw)) lc_warmup_reads++;
-    if (lc_warmup_reads < LC_WARMUP_READS) return;
-  }
-
-  // Stable % estimate:
-  // - Prefer library percent when sane
-  // - Blend with OCV-derived percent from filtered voltage
-  float p_est = NAN;
-  const bool have_lib = plausibleP(p_raw);
-  const bool have_v   = plausibleV(lc_v_filt);
-  float p_ocv = have_v ? pctFromVoltage(lc_v_filt) : NAN;
-
-  if (have_lib && have_v)      p_est = LC_BLEND_W * p_raw + (1.f - LC_BLEND_W) * p_ocv;
-  else if (have_lib)           p_est = p_raw;
-  else if (have_v)             p_est = p_ocv;
-
-  // Smooth + clamp steps + monotonic guard
-  if (!isnan(p_est)) {
-    if (isnan(lc_pct)) {
-      lc_pct = p_est;
-    } else {
-      float delta = p_est - lc_pct;
-
-      // Monotonic guard: if voltage clearly falling (>30 mV step), don’t let % rise
-      if (!isnan(last_v_raw) && !isnan(lc_v_filt) && (last_v_raw - lc_v_filt) > 0.03f && delta > 0) {
-        delta = 0.f;
-      }
-
-      if (delta >  LC_MAX_STEP_P) delta =  LC_MAX_STEP_P;
-      if (delta < -LC_MAX_STEP_P) delta = -LC_MAX_STEP_P;
-      lc_pct += LC_ALPHA_P * delta;
+static const FitEntry& fitText(const uint8_t* font, const String& s, int maxW) {
+  const uint32_t h = fnv1a(s.c_str(), s.length());
+  ++fitClock;
+  FitEntry* victim = &fitCache[0];
+  for (auto& e : fitCache) {
+    if (e.font == font && e.hash == h && e.len == s.length() && e.maxW == maxW) {
+      e.used = fitClock;
+      g->setFont(font);
+      return e;
     }
-    // keep inside [0,100]
-    if (lc_pct < 0.f)   lc_pct = 0.f;
-    if (lc_pct > 100.f) lc_pct = 100.f;
+    if (e.used < victim->used) victim = &e;
   }
 
-  if (g_dbg) {
-    if (!isnan(lc_pct) && !isnan(lc_v_filt))
-      Serial.printf("[DISPLAY] batt=%.1f%% (Vf=%.3f V)%s%s\n",
-                    lc_pct, lc_v_filt,
-                    have_lib ? "" : " [no-lib%]",
-                    (have_v && have_lib ? " [blend]" : ""));
-    else if (!isnan(lc_v_filt))
-      Serial.printf("[DISPLAY] batt=--%% (Vf=%.3f V)\n", lc_v_filt);
-    else
-      Serial.printf("[DISPLAY] batt=-- (no gauge)\n");
-  }
-}
-
-// ===== WEATHER =====
-static struct {
-  bool   enabled = false;  // portal toggle
-  char   units   = 'F';    // 'F' or 'C'
-  double lat     = NAN;    // from portal or IP geolocate (stored in Preferences by portal)
-  double lon     = NAN;
-  uint32_t refresh_ms = 10UL * 60UL * 1000UL; // default 10 min
-
-  bool   ok    = false;    // we have valid data to show
-  uint32_t last_fetch = 0;
-
-  // data
-  float  temp = NAN;     // degC/degF depending on units
-  int    rh   = -1;      // %
-  float  wind = NAN;     // mph/kph approx
-  int    code = -1;      // weather_code
-  char   place[32] = {0}; // optional name (from prefs), else coords
-} W;
-
-// (load prefs) — read once at begin(); portal writes them into "weather" namespace
-static void loadWeatherPrefs() {
-  Preferences prefs;
-  if (!prefs.begin("weather", true)) return;
-
-  W.enabled = prefs.getBool("enabled", false);
-  String u = prefs.getString("units", "F");
-  W.units = (u.length() && (u[0]=='C' || u[0]=='c')) ? 'C' : 'F';
-  W.lat = prefs.getDouble("lat", NAN);
-  W.lon = prefs.getDouble("lon", NAN);
-  int refMin = prefs.getInt("refresh", 10);
-  if (refMin < 1) refMin = 1; if (refMin > 120) refMin = 120;
-  W.refresh_ms = (uint32_t)refMin * 60UL * 1000UL;
-  String nm = prefs.getString("name", "");
-  nm.toCharArray(W.place, sizeof(W.place));
-  prefs.end();
-
-  if (g_dbg) {
-    Serial.printf("[WEATHER] enabled=%d units=%c lat=%.5f lon=%.5f refresh=%lus name='%s'\n",
-                  (int)W.enabled, W.units, W.lat, W.lon, W.refresh_ms/1000UL, W.place);
+  FitEntry& e = *victim;
+  e.font = font; e.hash = h; e.len = (uint16_t)s.length(); e.maxW = (int16_t)maxW; e.used = fitClock;
+  int w = textW(font, s.c_str());
+  if (w <= maxW) {
+    e.fit = s;
+  } else {
+    // the dots end the string, so every byte before them costs its advance
+    const FontMetrics& m = metricsFor(font);
+    const int dotsW = textW(font, "...");
+    const char* p = s.c_str();
+    size_t k = 0;
+    w = dotsW;
+    while (k < s.length() && w + m.adv[(uint8_t)p[k]] <= maxW) w += m.adv[(uint8_t)p[k++]];
+    e.fit = s.substring(0, k) + "...";
   }
+  e.w  = (int16_t)w;
+  e.cx = (int16_t)((maxW - w) / 2);
+  g->setFont(font);
+  return e;
 }
 
+// ===== WEATHER (data comes from the shared Weather service) =====
 
 // choose biggest temp font that fits in maxW
 static const uint8_t* pickTempFont(const char* text, int maxW) {
@@ -323,16 +236,14 @@ static const uint8_t* pickTempFont(const char* text, int maxW) {
     u8g2_font_logisoso16_tf
   };
   for (auto f : candidates) {
-    g->setFont(f);
-    if (g->getStrWidth(text) <= maxW) return f;
+    if (textW(f, text) <= maxW) return f;
   }
   return u8g2_font_logisoso16_tf;
 }
 
 // choose best header font that fits in maxW
 static const uint8_t* pickHeaderFont(const String& s, int maxW) {
-  g->setFont(u8g2_font_6x12_tf);
-  if (g->getStrWidth(s.c_str()) <= maxW) return u8g2_font_6x12_tf;
+  if (textW(u8g2_font_6x12_tf, s.c_str()) <= maxW) return u8g2_font_6x12_tf;
   return u8g2_font_5x8_tf;
 }
 
@@ -355,63 +266,6 @@ static const char* labelForCode(int code) {
   return "—";
 }
 
-static bool fetchWeatherNow() {
-  if (!W.enabled) return false;
-  if (!WiFi.isConnected()) return false;
-  if (isnan(W.lat) || isnan(W.lon)) return false;
-
-  // Build Open-Meteo URL
-  String url = "https://api.open-meteo.com/v1/forecast?latitude=" + String(W.lat, 5) +
-               "&longitude=" + String(W.lon, 5) +
-               "&current=temperature_2m,weather_code,relative_humidity_2m,wind_speed_10m";
-  if (W.units == 'F') {
-    url += "&temperature_unit=fahrenheit&windspeed_unit=mph";
-  } else {
-    url += "&temperature_unit=celsius&windspeed_unit=kmh";
-  }
-
-  WiFiClientSecure ssl;
-  ssl.setInsecure();       // keep it simple; you can pin CA later
-  HTTPClient http;
-  http.setTimeout(4000);
-
-  if (!http.begin(ssl, url)) {
-    if (g_dbg) Serial.println("[WEATHER] http.begin failed");
-    return false;
-  }
-  int code = http.GET();
-  if (code != 200) {
-    if (g_dbg) Serial.printf("[WEATHER] GET failed: %d\n", code);
-    http.end();
-    return false;
-  }
-  String body = http.getString();
-  http.end();
-
-  // Parse small JSON
-  StaticJsonDocument<1024> doc;
-  DeserializationError err = deserializeJson(doc, body);
-  if (err) {
-    if (g_dbg) Serial.printf("[WEATHER] JSON error: %s\n", err.c_str());
-    return false;
-  }
-  JsonObject cur = doc["current"];
-  if (cur.isNull()) return false;
-
-  W.temp = cur["temperature_2m"] | NAN;
-  W.rh   = cur["relative_humidity_2m"] | -1;
-  W.wind = cur["wind_speed_10m"] | NAN;
-  W.code = cur["weather_code"] | -1;
-  W.ok   = !isnan(W.temp) && (W.code >= 0);
-  W.last_fetch = millis();
-
-  if (g_dbg) {
-    Serial.printf("[WEATHER] t=%.1f %c rh=%d%% wind=%.1f code=%d\n",
-                  W.temp, W.units, W.rh, W.wind, W.code);
-  }
-  return W.ok;
-}
-
 // ===== Quotes =====
 static const char* kQuotes[] = {
   "I don't need to get a life. I'm a gamer - I have lots of lives.",
@@ -440,9 +294,34 @@ static const int kQuoteCount = sizeof(kQuotes)/sizeof(kQuotes[0]);
 static int   qIndex = 0;
 static int   qScroll = 0;
 static uint32_t qLastStep = 0;
-static const uint32_t Q_STEP_MS = 50;
+static const uint32_t Q_STEP_MS = 50;    // 1 px per step, 20 px/s
 static const int Q_PAD = 24;
 
+// A scrolling quote is rendered once into a strip in the panel's page format
+// (one byte = 8 rows of a column). Each step ORs a window of it into the
+// ticker pages over a saved copy of what MAIN drew there, so between full
+// MAIN redraws only those tiles change (see loop()).
+static const int Q_STRIP_PAGES = 2;
+static const int Q_STRIP_MAX_W = 512;     // longest quote is ~360 px
+static uint8_t  qStrip[Q_STRIP_PAGES][Q_STRIP_MAX_W];
+static uint8_t  qBase[Q_STRIP_PAGES][128];  // ticker pages minus the ticker
+static int      qStripIdx = -1, qStripY = -1, qStripW = 0, qStripPage = 0;
+static bool     qStripLive = false;         // MAIN's ticker is drawn from the strip
+static int      qTickX = 0, qDrawnScroll = -1;
+static uint32_t mainDrawnVer = UINT32_MAX;  // like secondDrawnVer: MAIN's rows are in the buffer
+static uint32_t mainDrawnAt = 0;
+
+// The buffer (or panel) no longer holds what the screens last drew.
+static void invalidateScreens() {
+  secondDrawnVer = UINT32_MAX;
+  mainDrawnVer = UINT32_MAX;
+  clockDrawnVer = UINT32_MAX;
+  shown = Shown::NONE;
+}
+// True while the panel still shows 's' (nothing has been flushed since).
+static bool onPanel(Shown s) { return shown == s && OledDamage::framesFlushed() == shownFrame; }
+static void markShown(Shown s) { shown = s; shownFrame = OledDamage::framesFlushed(); }
+
 static uint32_t qLastChange = 0;
 static const uint32_t Q_ROTATE_MS = 60000UL;
 
@@ -462,13 +341,6 @@ static const char* trayLabel(int v) {
 static const char* encLabel(int v) {
   switch (v & 0xFF) { case 0x45: return "Conexant"; case 0x6A: return "Focus"; case 0x70: return "Xcalibur"; default: return "Unknown"; }
 }
-static const char* xboxVerFromCode(int v) {
-  switch (v & 0xFF) {
-    case 0: return "v1.0"; case 1: return "v1.1"; case 2: return "v1.2";
-    case 3: return "v1.3"; case 4: return "v1.4"; case 5: return "v1.5";
-    case 6: return "v1.6"; default: return "Not reported";
-  }
-}
 static bool av_is_hd(int v) { v &= 0xFF; return (v == 0x01) || (v == 0x02) || ((v & 0x0E) == 0x0A); }
 static const char* avLabel(int v) {
   v &= 0xFF;
@@ -500,190 +372,84 @@ static String fmtResLine() {
   return String(EXT.width) + "x" + String(EXT.height);
 }
 
-// ===== ConsoleMods serial parsing and version guess =====
-static bool parseSerialYWWFF(const String& s, int& outYear, int& outWeek, int& outFactory) {
-  int len = s.length();
-  int run = 0, end = -1;
-  for (int i = len - 1; i >= 0; --i) {
-    if (isdigit((unsigned char)s[i])) { run++; if (run == 5) { end = i + 5; break; } }
-    else run = 0;
-  }
-  if (end < 0) return false;
-  int start = end - 5;
-  int Y   = s[start] - '0';
-  int WW  = (s[start+1]-'0')*10 + (s[start+2]-'0');
-  int FF  = (s[start+3]-'0')*10 + (s[start+4]-'0');
-  if (WW < 1 || WW > 53) return false;
-  outYear = 2000 + Y; outWeek = WW; outFactory = FF;
-  return true;
-}
-static String versionFromYearWeek(int year, int week) {
-  if (year == 2001) return "v1.0";
-  if (year == 2002) { if (week <= 43) return "v1.0"; if (week <= 47) return "v1.1"; return "v1.2"; }
-  if (year == 2003) { if (week <= 8)  return "v1.2"; if (week <= 30) return "v1.3"; return "v1.4"; }
-  if (year == 2004) { if (week <= 10) return "v1.4"; if (week <= 37) return "v1.6"; return "v1.6b"; }
-  if (year >= 2005) return "v1.6b";
-  return "Not reported";
-}
-static String guessFromSerialAndEncoder(int encRaw, const String& serial) {
-  int year=0, week=0, factory=0;
-  bool ok = parseSerialYWWFF(serial, year, week, factory);
-  const int enc = (encRaw & 0xFF);
-  auto encSuggest = [&]() -> String {
-    if (enc == 0x70) return "v1.6";
-    if (enc == 0x6A) return "v1.4";
-    if (enc == 0x45) return "v1.0–1.3";
-    return "";
-  };
-  if (!ok) {
-    String e = encSuggest();
-    return e.length() ? e : "Not reported";
-  }
-  if (factory == 3)  return "v1.0"; // Hungary
-  if (factory == 2)  return (year < 2002 || (year == 2002 && week < 44)) ? "v1.0" : "v1.1"; // Mexico
-  String ywGuess = versionFromYearWeek(year, week);
-  if (enc == 0x70) { if (year >= 2004 && week >= 38) return "v1.6b"; return "v1.6"; }
-  if (enc == 0x6A) { if (ywGuess.startsWith("v1.0") || ywGuess.startsWith("v1.1") || ywGuess.startsWith("v1.2") || ywGuess.startsWith("v1.3")) return "v1.4"; }
-  if (enc == 0x45) { if (ywGuess.startsWith("v1.4") || ywGuess.startsWith("v1.6")) return "v1.3"; }
-  return ywGuess;
-}
-static String fmtXboxVersion() {
-  if (EXT.xboxver >= 0 && EXT.xboxver <= 6) return String(xboxVerFromCode(EXT.xboxver));
-  if (!EE.have || EE.serial.length() == 0) {
-    const int e = (EXT.enc & 0xFF);
-    if (e == 0x70) return "v1.6";
-    if (e == 0x6A) return "v1.4";
-    if (e == 0x45) return "v1.0–1.3";
-    return "Not reported";
+// ===== Bitmaps (gfx_assets.h) =====
+// Expands a page-packed RLE bitmap straight into the frame buffer at column
+// x, page row 'page' (y = page * 8). Covered bytes are overwritten, so icons
+// sit on whole 8 px bands; anything off-panel is clipped.
+static void drawRle(int x, int page, const GfxRle& b) {
+  uint8_t* buf = g->getBufferPtr();
+  const uint8_t* p = b.data;
+  const uint8_t* const end = b.data + b.len;
+  uint16_t i = 0;
+  const uint16_t n = (uint16_t)b.w * b.pages;
+  while (p < end && i < n) {
+    const uint8_t c = *p++;
+    const bool run = c >= 0x80;
+    uint16_t k = run ? (uint16_t)(c - 0x7E) : (uint16_t)(c + 1);
+    while (k-- && i < n) {
+      const uint8_t v = run ? *p : *p++;
+      const int cx = x + i % b.w, pg = page + i / b.w;
+      if (cx >= 0 && cx < 128 && pg >= 0 && pg < 8) buf[pg * 128 + cx] = v;
+      i++;
+    }
+    if (run) p++;
   }
-  return guessFromSerialAndEncoder(EXT.enc, EE.serial);
 }
 
 // ===== Boot glyph (full-screen) =====
 static void drawBootGlyph() {
+  invalidateScreens();
   g->clearBuffer();
-  #if defined(DC_LOGO_WIDTH) && defined(DC_LOGO_HEIGHT) && defined(DC_LOGO_BITS)
-    g->drawXBM(0, 0, DC_LOGO_WIDTH, DC_LOGO_HEIGHT, DC_LOGO_BITS);
-  #elif defined(dc_logo_width) && defined(dc_logo_height) && defined(dc_logo_bits)
-    g->drawXBM(0, 0, dc_logo_width, dc_logo_height, dc_logo_bits);
-  #elif defined(dc_logoDC_logo)
-    g->drawXBM(0, 0, 128, 64, dc_logoDC_logo);
-  #endif
-  g->sendBuffer();
+  drawRle(0, 0, GFX_DC_LOGO);
+  OledDamage::flush(g);
+  markShown(Shown::LOGO);
 }
 
-// ===== UDP ingest =====
-static void onPacket() {
-  // Drain all pending packets from the UDP ring so we never miss updates.
-  TypeDUDP::Packet pk;
-  while (TypeDUDP::next(pk)) {
-    const uint16_t dst = pk.dst_port;
-    const size_t   n   = pk.rx_len;
-
-    everAnyPacket = true;
-    lastAnyAt     = pk.ts_ms;   // use precise timestamp carried with the packet
-
-    if ((dst == UDP_TYPED_DEFAULT_PORT_A) || (n == 44)) {
-      if (n >= 44) {
-        struct __attribute__((packed)) { int32_t fan, cpu, amb; char app[32]; } m{};
-        memcpy(&m, pk.data, sizeof(m));
-        MAIN.have = true;
-        haveMain  = true;
-        MAIN.fan   = constrain(m.fan, 0, 100);
-        MAIN.cpu_c = m.cpu;
-        MAIN.amb_c = m.amb;
-        memcpy(MAIN.app, m.app, 32); MAIN.app[32] = 0;
-
-        // NEW: forward App name to Insignia
-        Insignia::onAppName(MAIN.app);
-
-        if (g_dbg) Serial.printf("[DISPLAY] MAIN fan=%d cpu=%d amb=%d app='%s'\n",
-                                 MAIN.fan, MAIN.cpu_c, MAIN.amb_c, MAIN.app);
-      }
-      continue;
-    }
-
-    if ((dst == UDP_TYPED_DEFAULT_PORT_B) || (n == 28)) {
-      if (n >= 28) {
-        struct __attribute__((packed)) { int32_t t,a,pic,xb,enc,x6,x7; } e{};
-        memcpy(&e, pk.data, sizeof(e));
-        EXT.have = true;
-        EXT.tray = e.t;
-        EXT.av   = e.a;
-        EXT.xboxver = e.xb;
-        auto looks_enc = [](int v)->bool { v&=0xFF; return v==0x45 || v==0x6A || v==0x70; };
-        int cands[3] = { e.enc, e.x6, e.x7 };
-        int enc=-1,w=0,h=0;
-        if (looks_enc(cands[0]))      { enc=cands[0]; w=cands[1]; h=cands[2]; }
-        else if (looks_enc(cands[1])) { enc=cands[1]; w=cands[0]; h=cands[2]; }
-        else if (looks_enc(cands[2])) { enc=cands[2]; w=cands[0]; h=cands[1]; }
-        else                          { enc = e.enc;  w=e.x6;     h=e.x7;     }
-        EXT.enc = enc; EXT.width = w; EXT.height = h;
-        if (g_dbg) {
-          Serial.printf("[DISPLAY] EXT tray=%d av=0x%02X xb=%d enc=0x%02X w=%d h=%d\n",
-                        EXT.tray, EXT.av & 0xFF, EXT.xboxver, EXT.enc & 0xFF, EXT.width, EXT.height);
-        }
-      }
-      continue;
-    }
-
-    if ((dst == UDP_TYPED_DEFAULT_PORT_C) || (n >= 3 && pk.data[0]=='E' && pk.data[1]=='E' && pk.data[2]==':')) {
-      String s = String(pk.data); s.trim();
-      if (s.startsWith("EE:")) {
-        EE.have = true;
-        int pos = 3;
-        while (pos < (int)s.length()) {
-          int eq = s.indexOf('=', pos); if (eq < 0) break;
-          String key = s.substring(pos, eq);
-          int bar = s.indexOf('|', eq+1);
-          String val = (bar<0) ? s.substring(eq+1) : s.substring(eq+1, bar);
-          key.trim(); val.trim();
-          if      (key.equalsIgnoreCase("SN")  || key.equalsIgnoreCase("SER")) EE.serial = val;
-          else if (key.equalsIgnoreCase("MAC"))   EE.mac    = val;
-          else if (key.equalsIgnoreCase("REG"))   EE.region = val;
-          pos = (bar<0) ? s.length() : (bar + 1);
-        }
-        if (g_dbg) {
-          Serial.printf("[DISPLAY] EE SN=%s MAC=%s REG=%s\n",
-                        EE.serial.c_str(), EE.mac.c_str(), EE.region.c_str());
-        }
-      }
-      continue;
-    }
+// ===== Telemetry ingest =====
+// Decoding lives in Telemetry; we only mirror the groups that changed into
+// the local caches the screens draw from.
+static void onTelemetry(const Telemetry::Snapshot& t, uint32_t changed, void*) {
+  if (changed & Telemetry::F_MAIN) {
+    MAIN.have  = t.haveMain;
+    haveMain   = t.haveMain;
+    MAIN.fan   = t.fan;
+    MAIN.cpu_c = t.cpu;
+    MAIN.amb_c = t.amb;
+    memcpy(MAIN.app, t.app, sizeof(MAIN.app));
+    // forward App name to Insignia
+    if (changed & Telemetry::F_APP) Insignia::onAppName(MAIN.app);
+  }
+  if (changed & Telemetry::F_EXT) {
+    EXT.have    = t.haveExt;
+    EXT.tray    = t.tray;
+    EXT.av      = t.av;
+    EXT.xboxver = t.xboxver;
+    EXT.enc     = t.enc;
+    EXT.width   = t.width;
+    EXT.height  = t.height;
   }
- }
+  if (changed & Telemetry::F_EE) {
+    EE.have   = t.haveEE;
+    EE.serial = t.serial;
+    EE.mac    = t.mac;
+    EE.region = t.region;
+  }
+  dataVersion = t.version;
+}
 
 // ===== Text helpers =====
-static String ellipsize(const String& s, int maxW) {
-  g->setFont(u8g2_font_6x12_tf);
-  int w = g->getStrWidth(s.c_str());
-  if (w <= maxW) return s;
-  String out = s;
-  const String dots = "...";
-  int dotsW = g->getStrWidth(dots.c_str());
-  while (out.length() && g->getStrWidth(out.c_str()) + dotsW > maxW) out.remove(out.length()-1);
-  return out + dots;
-}
-static void kvRow_6x12(int x, int y, const char* key, const String& val, int totalW) {
-  g->setFont(u8g2_font_6x12_tf);
+static void kvRow(const uint8_t* font, int x, int y, const char* key, const String& val, int totalW) {
+  int kw = textW(font, key);
   g->setCursor(x, y); g->print(key);
-  int kw = g->getStrWidth(key);
   int avail = totalW - kw; if (avail < 0) avail = 0;
-  String vfit = ellipsize(val, avail);
+  const String& vfit = fitText(font, val, avail).fit;
   g->setCursor(x + kw, y); g->print(vfit);
 }
+static void kvRow_6x12(int x, int y, const char* key, const String& val, int totalW) {
+  kvRow(u8g2_font_6x12_tf, x, y, key, val, totalW);
+}
 static void kvRow_5x8(int x, int y, const char* key, const String& val, int totalW) {
-  g->setFont(u8g2_font_5x8_tf);
-  g->setCursor(x, y); g->print(key);
-  int kw = g->getStrWidth(key);
-  int avail = totalW - kw; if (avail < 0) avail = 0;
-  String vfit = val;
-  const String dots = "...";
-  if (g->getStrWidth(vfit.c_str()) > avail) {
-    while (vfit.length() && g->getStrWidth((vfit + dots).c_str()) > avail) vfit.remove(vfit.length()-1);
-    vfit += dots;
-  }
-  g->setCursor(x + kw, y); g->print(vfit);
+  kvRow(u8g2_font_5x8_tf, x, y, key, val, totalW);
 }
 
 // Wi-Fi quality label from RSSI
@@ -696,7 +462,8 @@ static const char* rssiQuality(int rssiDbm) {
 
 // ===== Battery widget helper (inline on Fan row) =====
 static void drawBatteryInlineRight(int textEndX, int rowBaselineY, int rowRightX) {
-  if (!lc_ok || isnan(lc_pct)) return;
+  const float lc_pct = FuelGauge::percent();
+  if (isnan(lc_pct)) return;
   const int w = 20, h = 10, tipW = 2, pad = 2;
   int iconX = rowRightX - (w + tipW);
   int iconTop = rowBaselineY - h; if (iconTop < 0) iconTop = 0;
@@ -706,17 +473,21 @@ static void drawBatteryInlineRight(int textEndX, int rowBaselineY, int rowRightX
   int fill = (int)((innerW * constrain((int)round(lc_pct), 0, 100)) / 100);
   if (fill > 0) g->drawBox(iconX + 1, iconTop + 1, fill, h - 2);
 
-  g->setFont(u8g2_font_6x12_tf);
   String pct = String((int)round(lc_pct)) + "%";
-  int tw = g->getStrWidth(pct.c_str());
+  int tw = textW(u8g2_font_6x12_tf, pct.c_str());
   int spaceAvail = iconX - pad - textEndX;
   if (tw <= spaceAvail) { int tx = iconX - pad - tw; g->setCursor(tx, rowBaselineY); g->print(pct); }
 }
 
 // ===== Screensaver (bouncing “Sleeping...”) =====
+// Steps a few times a second at low contrast (each step is a handful of
+// tiles), then the panel is switched off altogether.
 static bool saverActive = false;
-static const uint32_t SAVER_STEP_MS = 45;
+static const uint32_t SAVER_STEP_MS = 250;
+static const uint8_t  SAVER_CONTRAST = 8;
 static uint32_t saverLastStep = 0;
+static uint8_t  contrastSet = 255;      // power profile's level (setContrast())
+static bool     panelOff = false;
 
 static const char* saverMsg = "Sleeping...";
 static int saverX = 0, saverY = 0;
@@ -725,6 +496,8 @@ static int saverW = 0, saverH = 0, saverAsc = 0;
 
 static void startScreensaver() {
   saverActive = true;
+  invalidateScreens();
+  g->setContrast(contrastSet < SAVER_CONTRAST ? contrastSet : SAVER_CONTRAST);
   g->setFont(u8g2_font_7x13B_tf);
   saverAsc = g->getAscent();
   saverH = saverAsc - g->getDescent();
@@ -740,10 +513,15 @@ static void startScreensaver() {
   saverDY = ((r & 2) ? 1 : -1);
   saverLastStep = 0;
 }
-static void stopScreensaver() { saverActive = false; }
+static void stopScreensaver() {
+  saverActive = false;
+  if (panelOff) { g->setPowerSave(0); panelOff = false; }
+  g->setContrast(contrastSet);
+}
 
 static void drawScreensaverFrame() {
   uint32_t now = millis();
+  if (now - saverLastStep < SAVER_STEP_MS && onPanel(Shown::SAVER)) return;   // nothing moved
   if (now - saverLastStep >= SAVER_STEP_MS) {
     saverLastStep = now;
     saverX += saverDX;
@@ -761,24 +539,89 @@ static void drawScreensaverFrame() {
   g->drawFrame(saverX - 2, top - 2, saverW + 4, saverH + 4);
   g->setCursor(saverX, saverY);
   g->print(saverMsg);
-  g->sendBuffer();
+  OledDamage::flush(g);
+  markShown(Shown::SAVER);
 }
 
 // ===== Screen layouts =====
-static void drawQuoteTicker(int x, int y, int w) {
+static void advanceQuote(uint32_t now, int tw) {
+  // time-based, so a late frame catches up instead of slowing the scroll
+  if (!qLastStep) { qLastStep = now; return; }
+  const uint32_t steps = (now - qLastStep) / Q_STEP_MS;
+  if (!steps) return;
+  qLastStep += steps * Q_STEP_MS;
+  const int cycle = tw + Q_PAD;
+  qScroll = (int)((qScroll + steps) % (uint32_t)cycle);
+}
+
+// Render kQuotes[qIndex] into qStrip, 128 columns at a time, through the
+// ticker pages of the frame buffer (restored afterwards).
+static void buildQuoteStrip(int y, int tw) {
+  uint8_t* buf = g->getBufferPtr();
+  qStripPage = constrain((y - 7) / 8, 0, 8 - Q_STRIP_PAGES);
+  uint8_t* pages = buf + qStripPage * 128;
+  uint8_t save[Q_STRIP_PAGES * 128];
+  memcpy(save, pages, sizeof(save));
   g->setFont(u8g2_font_5x8_tf);
+  for (int k = 0; k * 128 < tw; ++k) {
+    memset(pages, 0, sizeof(save));
+    g->setCursor(-k * 128, y); g->print(kQuotes[qIndex]);
+    const int n = min(128, tw - k * 128);
+    for (int p = 0; p < Q_STRIP_PAGES; ++p) memcpy(&qStrip[p][k * 128], pages + p * 128, n);
+  }
+  memcpy(pages, save, sizeof(save));
+  qStripIdx = qIndex; qStripY = y; qStripW = tw;
+}
+
+static void blitQuote(int origin) {
+  uint8_t* buf = g->getBufferPtr();
+  const int c0 = max(0, origin), c1 = min(128, origin + qStripW);
+  for (int p = 0; p < Q_STRIP_PAGES; ++p) {
+    uint8_t* row = buf + (qStripPage + p) * 128;
+    for (int c = c0; c < c1; ++c) row[c] |= qStrip[p][c - origin];
+  }
+}
+
+// Both copies of the looping quote at the current scroll position.
+static void blitQuoteWindow(int x) {
+  const int startX = x - qScroll;
+  blitQuote(startX);
+  const int secondX = startX + qStripW + Q_PAD;
+  if (secondX < 128) blitQuote(secondX);
+}
+
+static void drawQuoteTicker(int x, int y, int w) {
+  qStripLive = false;
   int avail = w; if (avail <= 0) return;
   const char* text = kQuotes[qIndex];
-  int tw = g->getStrWidth(text);
+  int tw = textW(u8g2_font_5x8_tf, text);
   if (tw <= avail) { g->setCursor(x, y); g->print(text); return; }
-  uint32_t now = millis();
-  if (now - qLastStep >= Q_STEP_MS) {
-    qLastStep = now; qScroll = (qScroll + 2); int cycle = tw + Q_PAD; if (cycle > 0) qScroll %= cycle;
+  advanceQuote(millis(), tw);
+  if (tw > Q_STRIP_MAX_W) {
+    int startX = x - qScroll;
+    g->setCursor(startX, y); g->print(text);
+    int secondX = startX + tw + Q_PAD;
+    if (secondX < x + avail) { g->setCursor(secondX, y); g->print(text); }
+    return;
   }
-  int startX = x - qScroll;
-  g->setCursor(startX, y); g->print(text);
-  int secondX = startX + tw + Q_PAD;
-  if (secondX < x + avail) { g->setCursor(secondX, y); g->print(text); }
+  if (qStripIdx != qIndex || qStripY != y || qStripW != tw) buildQuoteStrip(y, tw);
+  memcpy(qBase, g->getBufferPtr() + qStripPage * 128, sizeof(qBase));
+  blitQuoteWindow(x);
+  qStripLive = true;
+  qTickX = x;
+  qDrawnScroll = qScroll;
+}
+
+// Between full MAIN redraws: move the ticker only. Nothing is sent when the
+// scroll position hasn't changed.
+static void stepQuoteTicker(uint32_t now) {
+  if (!qStripLive) return;
+  advanceQuote(now, qStripW);
+  if (qScroll == qDrawnScroll) return;
+  memcpy(g->getBufferPtr() + qStripPage * 128, qBase, sizeof(qBase));
+  blitQuoteWindow(qTickX);
+  qDrawnScroll = qScroll;
+  present();
 }
 
 static void drawMainScreen(int xOffset=0) {
@@ -791,14 +634,13 @@ static void drawMainScreen(int xOffset=0) {
 
   // Fan row + battery to the right
   {
-    g->setFont(u8g2_font_6x12_tf);
     const char* key = "Fan: ";
     String val = String(MAIN.fan) + "%";
     int xKey = L + xOffset;
+    int xVal = xKey + textW(u8g2_font_6x12_tf, key);
+    int textEnd = xVal + textW(u8g2_font_6x12_tf, val.c_str());
     g->setCursor(xKey, y); g->print(key);
-    int xVal = xKey + g->getStrWidth(key);
     g->setCursor(xVal, y); g->print(val);
-    int textEnd = xVal + g->getStrWidth(val.c_str());
     drawBatteryInlineRight(textEnd, y, rowRight);
   }
   y += 12;
@@ -810,7 +652,8 @@ static void drawMainScreen(int xOffset=0) {
   kvRow_6x12(L + xOffset, y, "Res: ", fmtResLine(), RW);
 
   drawQuoteTicker(L + xOffset, 60, RW);
-  g->sendBuffer();
+  if (xOffset == 0 && !xfCapture) { mainDrawnVer = dataVersion; mainDrawnAt = millis(); }
+  present();
 }
 
 static void drawSecondScreen(int xOffset=0) {
@@ -820,13 +663,13 @@ static void drawSecondScreen(int xOffset=0) {
 
   kvRow_5x8(L + xOffset, y, "Tray: ",    EXT.have ? String(trayLabel(EXT.tray))  : String("—"), RW); y += 8;
   kvRow_5x8(L + xOffset, y, "AV: ",      EXT.have ? String(avLabel(EXT.av))      : String("—"), RW); y += 8;
-  kvRow_5x8(L + xOffset, y, "Xbox: ",    fmtXboxVersion(),                                       RW); y += 8;
+  kvRow_5x8(L + xOffset, y, "Xbox: ",    String(Telemetry::get().xbox_ver),                     RW); y += 8;
   kvRow_5x8(L + xOffset, y, "Encoder: ", EXT.have ? String(encLabel(EXT.enc))    : String("—"), RW); y += 8;
   kvRow_5x8(L + xOffset, y, "Serial: ",  EE.have ? EE.serial : String("—"), RW); y += 8;
   kvRow_5x8(L + xOffset, y, "MAC: ",     EE.have ? EE.mac    : String("—"), RW); y += 8;
   kvRow_5x8(L + xOffset, y, "Region: ",  EE.have ? EE.region : String("—"), RW);
 
-  g->sendBuffer();
+  present();
 }
 
 static void drawHealthScreen(int xOffset=0) {
@@ -836,6 +679,15 @@ static void drawHealthScreen(int xOffset=0) {
   g->setFont(u8g2_font_6x12_tf);
   g->setCursor(L + xOffset, 12); g->print("Status");
 
+  if (g_latOverlay) {
+    char lat[20];
+    snprintf(lat, sizeof(lat), "%lu/%lums",
+             (unsigned long)(Metrics::percentile(Metrics::H_LAT_PANEL, 50) / 1000),
+             (unsigned long)(Metrics::percentile(Metrics::H_LAT_PANEL, 99) / 1000));
+    g->setCursor(SCRW - L - textW(u8g2_font_5x8_tf, lat) + xOffset, 10); g->print(lat);
+    g->setFont(u8g2_font_6x12_tf);
+  }
+
   int rssi = (WiFi.status() == WL_CONNECTED) ? WiFi.RSSI() : -100;
   String wifiLine = String(rssi) + " dBm (" + rssiQuality(rssi) + ")";
   kvRow_6x12(L + xOffset, 28, "WiFi: ", wifiLine, RW);
@@ -852,27 +704,89 @@ static void drawHealthScreen(int xOffset=0) {
     kvRow_6x12(L + xOffset, 52, "IP: ", String("(disconnected)"), RW);
   }
 
-  g->sendBuffer();
+  present();
+}
+
+// Three sparkline rows (CPU / ambient / fan), newest sample at the right
+// edge. Each row scales to its own min..max, at least GRAPH_MIN_SPAN wide
+// so a steady reading doesn't turn sensor noise into a sawtooth. Gaps in
+// the history break the line.
+static const int     GRAPH_X = 32, GRAPH_W = 128 - GRAPH_X, GRAPH_ROW_H = 21;
+static const int16_t GRAPH_MIN_SPAN = 40;          // x10 fixed point: 4 C / 4 %
+
+static History::Tier graphTier() {
+  return History::count(History::T_10S) >= 2 ? History::T_10S : History::T_1S;
+}
+
+static void drawSparkline(History::Series s, int top, int xOffset) {
+  static int16_t v[GRAPH_W];
+  const History::Tier tier = graphTier();
+  const uint16_t n = History::read(tier, s, v, GRAPH_W);
+  const int h = GRAPH_ROW_H - 2;
+  const int x0 = GRAPH_X + xOffset + (GRAPH_W - n);
+
+  int16_t lo = INT16_MAX, hi = INT16_MIN + 1;
+  for (uint16_t k = 0; k < n; ++k) {
+    if (v[k] == History::GAP) continue;
+    if (v[k] < lo) lo = v[k];
+    if (v[k] > hi) hi = v[k];
+  }
+  g->drawVLine(GRAPH_X + xOffset - 2, top, h);
+  if (lo > hi) return;                              // nothing but gaps
+  if (hi - lo < GRAPH_MIN_SPAN) {
+    const int16_t mid = (int16_t)((lo + hi) / 2);
+    lo = mid - GRAPH_MIN_SPAN / 2;
+    hi = lo + GRAPH_MIN_SPAN;
+  }
+
+  int py = -1;
+  for (uint16_t k = 0; k < n; ++k) {
+    if (v[k] == History::GAP) { py = -1; continue; }
+    const int y = top + (h - 1) - (int)((int32_t)(v[k] - lo) * (h - 1) / (hi - lo));
+    const int x = x0 + k;
+    if (py < 0) g->drawPixel(x, y);
+    else        g->drawLine(x - 1, py, x, y);
+    py = y;
+  }
+}
+
+static void drawGraphScreen(int xOffset=0) {
+  static const History::Series series[3] = { History::S_CPU, History::S_AMB, History::S_FAN };
+  static const char* const     labels[3] = { "CPU", "Amb", "Fan" };
+  g->clearBuffer();
+  g->setFont(u8g2_font_5x8_tf);
+  const int L = 2;
+  for (uint8_t i = 0; i < 3; ++i) {
+    const int top = i * GRAPH_ROW_H + 1;
+    g->setCursor(L + xOffset, top + 8); g->print(labels[i]);
+    const int16_t now = History::last(series[i]);
+    char val[8] = "--";
+    if (now != History::GAP)
+      snprintf(val, sizeof(val), "%d%s", (int)lroundf(now / 10.f), series[i] == History::S_FAN ? "%" : "C");
+    g->setCursor(L + xOffset, top + 17); g->print(val);
+    drawSparkline(series[i], top, xOffset);
+  }
+  present();
 }
 
 // Text-only, icon-free weather screen for 128x64
 static void drawWeatherScreen(int xOffset /*=0*/) {
+  const Weather::Snapshot W = Weather::get();
   g->clearBuffer();
   const int Wd=128, L=2, RW=Wd - 2*L;
 
   // ---------- Header: place or coords ----------
   g->setFont(u8g2_font_6x12_tf);
-  String head = (strlen(W.place)
-                  ? String(W.place)
+  String head = (W.place.length()
+                  ? W.place
                   : (isnan(W.lat)||isnan(W.lon) ? String("Weather")
                                                 : (String(W.lat,2) + "," + String(W.lon,2))));
-  // ellipsize to available width
-  String headFit = ellipsize(head, RW);
-  int headW = g->getStrWidth(headFit.c_str());
-  int headX = L + xOffset + (RW - headW)/2;
+  // ellipsize to available width (cached until the text changes)
+  const FitEntry& headFit = fitText(u8g2_font_6x12_tf, head, RW);
+  int headX = L + xOffset + headFit.cx;
   int headY = 11;                        // baseline around row 1
   g->setCursor(headX, headY);
-  g->print(headFit);
+  g->print(headFit.fit);
 
   // ---------- Big temperature (centered) ----------
   g->setFont(u8g2_font_logisoso16_tf);   // tall but still leaves room for 3 lines total
@@ -883,7 +797,7 @@ static void drawWeatherScreen(int xOffset /*=0*/) {
   } else {
     snprintf(tbuf, sizeof(tbuf), "--%c%c", (char)0xB0, (W.units=='F'?'F':'C'));
   }
-  int tempW = g->getStrWidth(tbuf);
+  int tempW = textW(u8g2_font_logisoso16_tf, tbuf);
   int tempX = L + xOffset + (RW - tempW)/2;
   int tempY = 34;                        // visually centered under header
   g->setCursor(tempX, tempY);
@@ -891,74 +805,253 @@ static void drawWeatherScreen(int xOffset /*=0*/) {
 
   // ---------- Condition text (centered) ----------
   g->setFont(u8g2_font_6x12_tf);
-  String cond = String(labelForCode(W.code));  // falls back to "—"
-  String condFit = ellipsize(cond, RW);
-  int condW = g->getStrWidth(condFit.c_str());
-  int condX = L + xOffset + (RW - condW)/2;
+  String cond = String(labelForCode(W.wmo));  // falls back to "—"
+  const FitEntry& condFit = fitText(u8g2_font_6x12_tf, cond, RW);
+  int condX = L + xOffset + condFit.cx;
   int condY = 48;
   g->setCursor(condX, condY);
-  g->print(condFit);
+  g->print(condFit.fit);
 
   // ---------- Bottom metrics row (centered) ----------
   // Compact: "H45%  W6mph" or "H--  W--"
   g->setFont(u8g2_font_5x8_tf);
-  String hum  = (W.rh >= 0) ? (String("H") + W.rh + "%") : "H--";
+  String hum  = (W.humidity >= 0) ? (String("H") + W.humidity + "%") : "H--";
   String wind = String("W") + (isnan(W.wind) ? String("--") : String(W.wind,0)) + (W.units=='F' ? "mph" : "kmh");
 
   // Build a single line and trim if needed
   String tail = hum + "  " + wind;
   // If still too wide, drop spaces, then (rarely) truncate wind units
-  if (g->getStrWidth(tail.c_str()) > RW) {
+  if (textW(u8g2_font_5x8_tf, tail.c_str()) > RW) {
     tail = hum + " " + wind;
-    if (g->getStrWidth(tail.c_str()) > RW) {
+    if (textW(u8g2_font_5x8_tf, tail.c_str()) > RW) {
       // last resort: shorten units to a single letter
       wind = String("W") + (isnan(W.wind) ? String("--") : String(W.wind,0)) + (W.units=='F' ? "m" : "k");
       tail = hum + " " + wind;
     }
   }
-  int tailW = g->getStrWidth(tail.c_str());
+  int tailW = textW(u8g2_font_5x8_tf, tail.c_str());
   int tailX = L + xOffset + (RW - tailW)/2;
   int tailY = 61;                        // near bottom baseline
   g->setCursor(tailX, tailY);
   g->print(tail);
 
-  g->sendBuffer();
+  present();
 }
 
 
-// ===== Transitions (slide-only) =====
+// ===== Transitions (slide-only, frame-scheduled) =====
+// The target screen is rendered once into an off-screen copy of the frame
+// buffer; loop() then blits it at an eased column offset on a frame clock,
+// so UDP/Wi-Fi/LED keep running while the slide plays.
+static const uint32_t XF_DURATION_MS = 320;
+static uint32_t       xfFrameMs      = 1000 / 60;     // setTransitionFps()
+
+static struct {
+  bool     active = false;
+  int      dir    = 1;         // +1 slides in from the right, -1 from the left
+  uint32_t t0     = 0;
+  uint32_t lastFrame = 0;
+} XF;
+static uint8_t xfBuf[128 * 64 / 8];
+
+static void present() {
+  if (!xfCapture) OledDamage::flush(g);
+}
+
 static void drawWithOffsets(Screen s, int x) {
   if      (s==Screen::MAIN)     drawMainScreen(x);
   else if (s==Screen::SECOND)   drawSecondScreen(x);
+  else if (s==Screen::GRAPH)    drawGraphScreen(x);
   else if (s==Screen::HEALTH)   drawHealthScreen(x);
   else if (s==Screen::WEATHER)  drawWeatherScreen(x);
   else { // INSIGNIA fills entire frame; ignore x offset and draw directly
     Insignia::draw(g);
   }
 }
+
+// Copy the captured frame into the live buffer shifted right by 'x' columns.
+static void blitOffset(int x) {
+  uint8_t* buf = g->getBufferPtr();
+  const int W = 128, PAGES = 8;
+  memset(buf, 0, sizeof(xfBuf));
+  if (x >= W || x <= -W) return;
+  for (int p = 0; p < PAGES; ++p) {
+    uint8_t* row = buf + p * W;
+    const uint8_t* src = xfBuf + p * W;
+    if (x >= 0) memcpy(row + x, src, W - x);
+    else        memcpy(row, src - x, W + x);
+  }
+}
+
 static void doTransition(Screen to) {
+  invalidateScreens();
   // Skip slide animation for INSIGNIA -> it animates internally (scroll)
-  if (to == Screen::INSIGNIA) { Insignia::draw(g); return; }
+  if (to == Screen::INSIGNIA) { XF.active = false; Insignia::draw(g); return; }
 
   uint32_t r = (uint32_t)esp_random();
   nextXition = (r & 1) ? Xition::SLIDE_IN_RIGHT : Xition::SLIDE_IN_LEFT;
-  const int SCRW=128, step=16;
-  if (nextXition == Xition::SLIDE_IN_RIGHT) {
-    for (int x=SCRW; x>=0; x-=step) { drawWithOffsets(to, x); delay(12); }
-  } else {
-    for (int x=-SCRW; x<=0; x+=step){ drawWithOffsets(to, x); delay(12); }
+
+  xfCapture = true;
+  drawWithOffsets(to, 0);
+  xfCapture = false;
+  memcpy(xfBuf, g->getBufferPtr(), sizeof(xfBuf));
+
+  XF.active    = true;
+  XF.dir       = (nextXition == Xition::SLIDE_IN_RIGHT) ? 1 : -1;
+  XF.t0        = millis();
+  XF.lastFrame = 0;
+}
+
+// Advance the slide; returns true while it still owns the panel.
+static bool stepTransition(uint32_t now) {
+  if (!XF.active) return false;
+  if (XF.lastFrame && now - XF.lastFrame < xfFrameMs) return true;
+  XF.lastFrame = now;
+
+  float t = (float)(now - XF.t0) / (float)XF_DURATION_MS;
+  if (t > 1.f) t = 1.f;
+  const float inv  = 1.f - t;
+  const float ease = 1.f - inv * inv * inv;             // ease-out cubic
+  const int   x    = (int)lroundf(XF.dir * 128.f * (1.f - ease));
+
+  blitOffset(x);
+  OledDamage::flush(g);
+
+  if (t >= 1.f) {
+    XF.active = false;
+    nextXition = Xition::NONE;
+    lastDraw = 0;                // next loop renders the live screen
   }
+  return true;
+}
+
+// ===== Render benchmark =====
+// Draws each screen into the buffer (no flush) with the current data and
+// times it with the cycle counter. The CRC of the last frame is a cheap
+// golden image: same build inputs, same CRC. Served in /metrics as "bench".
+// INSIGNIA flushes on its own and is left out.
+struct BenchRow { const char* name; uint32_t avgNs, maxNs, crc; int32_t heapDelta; };
+static const uint8_t BENCH_SCREENS = 5;
+static BenchRow benchRows[BENCH_SCREENS];
+static uint16_t benchIters = 0;          // of the last run; 0 = never ran
+static volatile uint16_t benchReq = 0;
+static portMUX_TYPE benchMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t crc32(const uint8_t* p, size_t n) {
+  uint32_t c = 0xFFFFFFFFu;
+  while (n--) {
+    c ^= *p++;
+    for (uint8_t k = 0; k < 8; ++k) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1)));
+  }
+  return ~c;
+}
+
+static void runBench(uint16_t iters) {
+  static const Screen    screens[BENCH_SCREENS] = { Screen::MAIN, Screen::SECOND, Screen::GRAPH, Screen::HEALTH, Screen::WEATHER };
+  static const char* const names[BENCH_SCREENS] = { "main", "second", "graph", "health", "weather" };
+  const uint32_t mhz = ESP.getCpuFreqMHz();
+  const size_t   len = (size_t)g->getBufferTileWidth() * g->getBufferTileHeight() * 8;
+  BenchRow rows[BENCH_SCREENS];
+
+  xfCapture = true;
+  for (uint8_t i = 0; i < BENCH_SCREENS; ++i) {
+    uint64_t total = 0;
+    uint32_t worst = 0;
+    const int32_t heap0 = (int32_t)ESP.getFreeHeap();
+    for (uint16_t n = 0; n < iters; ++n) {
+      const uint32_t c0 = ESP.getCycleCount();
+      drawWithOffsets(screens[i], 0);
+      const uint32_t ns = (uint32_t)((uint64_t)(ESP.getCycleCount() - c0) * 1000u / mhz);
+      total += ns;
+      if (ns > worst) worst = ns;
+    }
+    rows[i] = { names[i], (uint32_t)(total / iters), worst,
+                crc32(g->getBufferPtr(), len), heap0 - (int32_t)ESP.getFreeHeap() };
+  }
+  xfCapture = false;
+
+  // the buffer no longer matches the live screen: redraw it next loop
+  lastDraw = 0;
+  invalidateScreens();
+
+  portENTER_CRITICAL(&benchMux);
+  memcpy(benchRows, rows, sizeof(rows));
+  benchIters = iters;
+  portEXIT_CRITICAL(&benchMux);
+  if (g_dbg) Serial.printf("[DISPLAY] bench x%u done\n", (unsigned)iters);
+}
+
+static void benchSection(String& out) {
+  BenchRow rows[BENCH_SCREENS];
+  portENTER_CRITICAL(&benchMux);
+  memcpy(rows, benchRows, sizeof(rows));
+  const uint16_t iters = benchIters;
+  portEXIT_CRITICAL(&benchMux);
+
+  out += "\"bench\":{\"iters\":"; out += (uint32_t)iters;
+  out += ",\"pending\":"; out += (uint32_t)benchReq;
+  for (uint8_t i = 0; iters && i < BENCH_SCREENS; ++i) {
+    char crc[9];
+    snprintf(crc, sizeof(crc), "%08lx", (unsigned long)rows[i].crc);
+    out += ",\""; out += rows[i].name; out += "\":{\"avg_ns\":"; out += rows[i].avgNs;
+    out += ",\"max_ns\":"; out += rows[i].maxNs;
+    out += ",\"heap_delta\":"; out += (long)rows[i].heapDelta;
+    out += ",\"crc\":\""; out += crc; out += "\"}";
+  }
+  out += '}';
 }
 
 // ===== API =====
+uint8_t streamsOnScreen() {
+  switch (cur) {
+    case Screen::MAIN:
+    case Screen::GRAPH:   return TypedProto::STREAM_MAIN;
+    case Screen::SECOND:  return TypedProto::STREAM_EXT | TypedProto::STREAM_EE;
+    case Screen::WAITING: return TypedProto::STREAM_MAIN | TypedProto::STREAM_EXT | TypedProto::STREAM_EE;
+    default:              return 0;       // health/weather/insignia: only the app name
+  }
+}
+
+bool idle() { return saverActive || panelOff; }
+
 void setHoldTimes(uint32_t main_ms, uint32_t second_ms) {
   HOLD_MAIN_MS   = main_ms   ? main_ms   : HOLD_MAIN_MS;
   HOLD_SECOND_MS = second_ms ? second_ms : HOLD_SECOND_MS;
 }
 void setDebug(bool on) { g_dbg = on; }
+void setTransitionFps(uint8_t fps) { xfFrameMs = fps ? (1000u / fps) : xfFrameMs; }
+void setLatencyOverlay(bool on) { g_latOverlay = on; }
+void showProgress(const char* title, uint8_t pct, const char* detail) {
+  if (!g) return;
+  if (panelOff) { g->setPowerSave(0); panelOff = false; }
+  g->clearBuffer();
+  g->setFont(u8g2_font_6x12_tf);
+  const char* t = title ? title : "";
+  g->setCursor((128 - g->getStrWidth(t)) / 2, 14); g->print(t);
+  if (pct <= 100) {
+    g->drawFrame(8, 26, 112, 12);
+    g->drawBox(10, 28, (uint8_t)(108u * pct / 100u), 8);
+  }
+  if (detail && *detail) {
+    g->setFont(u8g2_font_5x8_tf);
+    g->setCursor((128 - g->getStrWidth(detail)) / 2, 54); g->print(detail);
+  }
+  OledDamage::flush(g);
+  // whatever screen comes next has to be drawn from scratch
+  lastDraw = 0;
+  invalidateScreens();
+}
+void setContrast(uint8_t level) {
+  contrastSet = level;
+  if (!g) return;
+  if (saverActive) g->setContrast(level < SAVER_CONTRAST ? level : SAVER_CONTRAST);
+  else             g->setContrast(level);
+}
+void requestBench(uint16_t iters) { benchReq = iters ? (iters > 1000 ? 1000 : iters) : 0; }
 
 void begin(U8G2* u8) {
   g = u8;
+  OledDamage::invalidate();
   esp_fill_random(&lastDraw, sizeof(lastDraw));
   randomSeed((uint32_t)lastDraw ^ millis());
   cur = Screen::WAITING;
@@ -967,8 +1060,12 @@ void begin(U8G2* u8) {
   haveMain = false;
   lastAnyAt = 0;
 
-  // Load weather prefs once
-  loadWeatherPrefs();
+  // Mirror decoded telemetry into the screen caches
+  static int telemSub = -1;
+  if (telemSub < 0) {
+    telemSub = Telemetry::subscribe(onTelemetry, Telemetry::F_ALL);
+    Metrics::addSection(benchSection);
+  }
 
   // Start Insignia module (uses default server base)
   Insignia::begin(g_dbg);
@@ -977,14 +1074,17 @@ void begin(U8G2* u8) {
   if (g_dbg) Serial.printf("[DISPLAY] begin (waiting for UDP data)\n");
 }
 
+void showBootLogo() { if (g) drawBootGlyph(); }
+
 static Screen nextScreen(Screen s) {
-  // Insert INSIGNIA after HEALTH when active; then WEATHER; else loop as before.
+  // GRAPH once there is history; INSIGNIA after HEALTH when active; then WEATHER.
   switch (s) {
     case Screen::MAIN:     return Screen::SECOND;
-    case Screen::SECOND:   return Screen::HEALTH;
+    case Screen::SECOND:   return History::count(History::T_1S) >= 2 ? Screen::GRAPH : Screen::HEALTH;
+    case Screen::GRAPH:    return Screen::HEALTH;
     case Screen::HEALTH:   return Insignia::isActive() ? Screen::INSIGNIA
-                                                       : (W.enabled ? Screen::WEATHER : Screen::MAIN);
-    case Screen::INSIGNIA: return W.enabled ? Screen::WEATHER : Screen::MAIN;
+                                                       : (Weather::enabled() ? Screen::WEATHER : Screen::MAIN);
+    case Screen::INSIGNIA: return Weather::enabled() ? Screen::WEATHER : Screen::MAIN;
     case Screen::WEATHER:  return Screen::MAIN;
     default:               return Screen::MAIN;
   }
@@ -993,6 +1093,7 @@ static uint32_t holdFor(Screen s) {
   switch (s) {
     case Screen::MAIN:     return HOLD_MAIN_MS;
     case Screen::SECOND:   return HOLD_SECOND_MS;
+    case Screen::GRAPH:    return HOLD_GRAPH_MS;
     case Screen::HEALTH:   return HOLD_HEALTH_MS;
     case Screen::WEATHER:  return HOLD_WEATHER_MS;
     case Screen::INSIGNIA: return HOLD_INSIGNIA_MS;
@@ -1003,20 +1104,12 @@ static uint32_t holdFor(Screen s) {
 void loop() {
   if (!g) return;
 
-  // Fuel gauge maintenance (init + periodic read)
-  maybeInitGauge();
-  updateGaugeReading();
-
-  // Weather refresh cadence (non-blocking most of the time)
-  if (W.enabled) {
-    uint32_t noww = millis();
-    if (W.last_fetch == 0 || noww - W.last_fetch >= W.refresh_ms) {
-      fetchWeatherNow();
-    }
-  }
+  // Render benchmark: only between slides (they own the buffer)
+  if (benchReq && !XF.active) { const uint16_t n = benchReq; benchReq = 0; runBench(n); }
 
-  // Ingest any new UDP packets (drain ring buffer)
-  if (TypeDUDP::available()) onPacket();
+  // Packet timing comes from the shared model (Telemetry::loop() drains UDP)
+  everAnyPacket = Telemetry::everReceived();
+  lastAnyAt     = Telemetry::get().last_rx_ms;
 
   // Let Insignia advance timers regardless of current screen
   Insignia::tick();
@@ -1028,18 +1121,30 @@ void loop() {
 
   // If we've never seen ANY packet, or MAIN hasn't arrived yet, show logo
   if (!everAnyPacket || !haveMain) {
-    drawBootGlyph();
+    if (!onPanel(Shown::LOGO)) drawBootGlyph();
     return;
   }
 
   // Inactivity gating
   if (noAny5m) {
+    XF.active = false;
     if (!saverActive) startScreensaver();
+    if (now - lastAnyAt >= NO_PACKET_OFF_MS) {
+      if (!panelOff) { g->setPowerSave(1); panelOff = true; }   // no I2C until a packet
+      return;
+    }
     drawScreensaverFrame();
     return;
   }
   if (saverActive) stopScreensaver();
-  if (noAny2m) { drawBootGlyph(); return; }
+  if (noAny2m) {
+    XF.active = false;
+    if (!onPanel(Shown::LOGO)) drawBootGlyph();
+    return;
+  }
+
+  // Slide in progress: keep clocking it (I/O keeps running between frames)
+  if (stepTransition(now)) return;
 
   // Normal screen scheduler
   if (cur == Screen::WAITING) {
@@ -1054,11 +1159,15 @@ void loop() {
   if (now >= nextSwitchAt) {
     cur = nextScreen(cur);
     nextSwitchAt = now + holdFor(cur);
-    if (cur == Screen::MAIN) pickRandomQuote();
+    if (cur == Screen::MAIN) {
+      Telemetry::nextSender();   // several consoles: one per carousel pass
+      pickRandomQuote();
+    }
     if (g_dbg) {
       const char* nm =
         (cur==Screen::MAIN)?"MAIN":
         (cur==Screen::SECOND)?"SECOND":
+        (cur==Screen::GRAPH)?"GRAPH":
         (cur==Screen::HEALTH)?"HEALTH":
         (cur==Screen::WEATHER)?"WEATHER":"INSIGNIA";
       Serial.printf("[DISPLAY] switch -> %s\n", nm);
@@ -1069,14 +1178,32 @@ void loop() {
 
   if (cur == Screen::MAIN && (now - qLastChange >= Q_ROTATE_MS)) pickRandomQuote();
 
-  if (now - lastDraw >= DRAW_INTERVAL_MS) {
+  const uint32_t drawEvery = (cur == Screen::MAIN || cur == Screen::INSIGNIA) ? DRAW_INTERVAL_ANIM_MS : DRAW_INTERVAL_MS;
+  if (now - lastDraw >= drawEvery) {
     lastDraw = now;
-    if      (cur == Screen::MAIN)     drawMainScreen(0);
-    else if (cur == Screen::SECOND)   drawSecondScreen(0);
-    else if (cur == Screen::HEALTH)   drawHealthScreen(0);
-    else if (cur == Screen::WEATHER)  drawWeatherScreen(0);
+    if      (cur == Screen::MAIN)     {
+      // full redraw on new data and at the normal screen rate; the ticker moves in between
+      if (mainDrawnVer != dataVersion || now - mainDrawnAt >= REFRESH_CLOCK_MS) drawMainScreen(0);
+      else stepQuoteTicker(now);
+    }
+    else if (cur == Screen::SECOND)   { if (secondDrawnVer != dataVersion) { drawSecondScreen(0); secondDrawnVer = dataVersion; } }
+    else if (cur == Screen::GRAPH) {
+      // one new sample a second; nothing else on it moves
+      if (clockDrawnVer != History::version()) { drawGraphScreen(0); clockDrawnVer = History::version(); }
+    }
+    else if (cur == Screen::HEALTH || cur == Screen::WEATHER) {
+      const uint32_t ver = (cur == Screen::HEALTH) ? dataVersion : Weather::version();
+      if (clockDrawnVer != ver || now - clockDrawnAt >= REFRESH_CLOCK_MS) {
+        if (cur == Screen::HEALTH) drawHealthScreen(0);
+        else                       drawWeatherScreen(0);
+        clockDrawnVer = ver;
+        clockDrawnAt = now;
+      }
+    }
     else                              Insignia::draw(g);
   }
 }
 
 } // namespace TypeDDisplay
+
+#endif // TYPED_PANEL_U8G2
@@ -9,13 +9,42 @@ namespace TypeDDisplay {
 // Optional: tweak holds at runtime
 void setHoldTimes(uint32_t main_ms, uint32_t second_ms);
 
+// Slide transition frame rate (default 60; the slide itself lasts ~320 ms)
+void setTransitionFps(uint8_t fps);
+
+// [DISPLAY] log lines on Serial (on by default)
+void setDebug(bool on);
+
+// Debug: show telemetry packet -> panel latency (p50/p99 ms, see Metrics)
+// in the HEALTH screen title row. Off by default.
+void setLatencyOverlay(bool on);
+
+// Time every text screen's draw (iters each, max 1000) on the next loop();
+// results show up under "bench" in /metrics.
+void requestBench(uint16_t iters);
+
 // Attach the u8g2 instance. Does NOT draw until we have UDP data.
 void begin(U8G2* u8);
 
+// Put the boot logo up right away (setup(), before the first loop()).
+void showBootLogo();
+
 // Main pump: call this every loop() tick.
 // It pulls new UDP packets (via TypeDUDP), updates caches, and renders screens.
 void loop();
 
 bool active();
 
+// TypedProto::STREAM_* bits the current screen draws (reverse control), and
+// whether the panel is on the saver or off.
+uint8_t streamsOnScreen();
+bool idle();
+
+// Panel contrast outside the screensaver (the saver dims below it).
+void setContrast(uint8_t level);
+
+// Full-screen progress (firmware update). Takes over the panel until the
+// next loop() that draws a screen; pct > 100 hides the bar.
+void showProgress(const char* title, uint8_t pct, const char* detail);
+
 } // namespace TypeDDisplay
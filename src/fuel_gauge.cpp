@@ -0,0 +1,243 @@
+#include "fuel_gauge.h"
+#include "i2c_bus.h"
+#include <Adafruit_LC709203F.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <math.h>
+
+namespace FuelGauge {
+
+static Adafruit_LC709203F lc;
+static TwoWire* s_wire = nullptr;
+static TaskHandle_t s_task = nullptr;
+static bool s_dbg = false;
+
+static const uint32_t LC_RETRY_MS  = 5000;
+static const uint32_t LC_READ_MS   = 3000;
+static const uint32_t LC_POLL_MS   = 250;    // task wake-up; reads are LC_READ_MS apart
+static const uint32_t BUS_WAIT_MS  = 100;    // skip the round if a frame holds the bus longer
+static const uint32_t LC_MAX_HZ    = 400000; // LC709203F limit; the display's bus may run faster
+
+// Published (guarded by s_mux)
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool  pub_ok  = false;
+static float pub_pct = NAN;
+static float pub_v   = NAN;
+
+// Task-local state
+static bool lc_ok = false;
+static float lc_pct = NAN;
+static float lc_v   = NAN;
+
+// Accuracy/consistency helpers
+static uint32_t lc_ok_since = 0;            // when gauge first came up
+static const uint32_t LC_WARMUP_MS   = 1500; // initial settle window
+static int lc_warmup_reads           = 0;    // also require N good reads
+static const int LC_WARMUP_READS     = 3;
+
+static const float LC_ALPHA_P        = 0.25f; // EMA factor for percent smoothing
+static const float LC_ALPHA_V        = 0.30f; // EMA factor for voltage smoothing
+static const float LC_MAX_STEP_P     = 6.0f;  // clamp % step per sample
+static const float LC_MAX_JUMP_V     = 0.12f; // reject raw V jumps >120 mV/read
+static const float LC_MAX_JUMP_P     = 12.0f; // reject raw % jumps >12%/read
+static const float LC_BLEND_W        = 0.60f; // weight for library % vs OCV % (0..1)
+static float lc_v_filt = NAN;                // filtered voltage
+static float last_p_raw = NAN, last_v_raw = NAN;
+
+// Voltage→% (very rough LiPo curve, linear between points)
+static float pctFromVoltage(float v) {
+  if (v <= 3.30f) return 0.f;
+  if (v >= 4.20f) return 100.f;
+  struct P { float v, p; };
+  const P pts[] = { {4.20,100},{4.08,95},{3.98,90},{3.92,85},{3.86,80},{3.80,75},{3.75,70},{3.70,60},{3.65,50},{3.60,45},{3.55,35},{3.50,25},{3.45,15},{3.40,8},{3.30,0} };
+  for (size_t i=1;i<sizeof(pts)/sizeof(pts[0]);++i) if (v >= pts[i].v) {
+    const float t = (v - pts[i].v) / (pts[i-1].v - pts[i].v);
+    return pts[i].p + t * (pts[i-1].p - pts[i].p);
+  }
+  return 50.f; // shouldn't reach
+}
+
+static inline bool plausibleV(float v) { return (!isnan(v) && v > 3.0f && v < 5.5f); }
+static inline bool plausibleP(float p) { return (!isnan(p) && p >= 0.f  && p <= 100.f); }
+
+static void publish() {
+  portENTER_CRITICAL(&s_mux);
+  pub_ok = lc_ok; pub_pct = lc_pct; pub_v = lc_v;
+  portEXIT_CRITICAL(&s_mux);
+}
+
+static void resetFilters() {
+  lc_pct = NAN;
+  lc_v = lc_v_filt = NAN;
+  last_p_raw = last_v_raw = NAN;
+  lc_warmup_reads = 0;
+}
+
+// NOTE: We do NOT use a thermistor. No thermistor config calls are made.
+static bool tryInit() {
+  I2CBus::Guard bus(s_wire, BUS_WAIT_MS, LC_MAX_HZ);
+  if (!bus.ok()) return false;
+
+  // Uses default address 0x0B
+  if (!lc.begin(s_wire)) {
+    if (s_dbg) Serial.println("[GAUGE] LC709203F not found (will retry)");
+    return false;
+  }
+  // If you define a known pack size at build-time, it will be applied.
+  #if defined(LC709203F_APA_2200MAH)
+    lc.setPackSize(LC709203F_APA_2200MAH);
+  #elif defined(LC709203F_APA_2000MAH)
+    lc.setPackSize(LC709203F_APA_2000MAH);
+  #elif defined(LC709203F_APA_2500MAH)
+    lc.setPackSize(LC709203F_APA_2500MAH);
+  #endif
+
+  // Keep default temperature behavior (internal IC method). No thermistor used.
+
+  #ifdef LC709203F_POWER_OPERATE
+    lc.setPowerMode(LC709203F_POWER_OPERATE);
+  #endif
+  if (s_dbg) Serial.println("[GAUGE] LC709203F detected + configured (no thermistor)");
+  return true;
+}
+
+// One sample through the filters. Returns false if the bus wasn't free.
+static bool sampleOnce() {
+  float p_raw, v_raw;
+  {
+    I2CBus::Guard bus(s_wire, BUS_WAIT_MS, LC_MAX_HZ);
+    if (!bus.ok()) return false;
+    p_raw = lc.cellPercent();  // library estimate
+    v_raw = lc.cellVoltage();  // measured voltage
+  }
+
+  // Basic plausibility
+  if (!plausibleV(v_raw)) v_raw = NAN;
+  if (!plausibleP(p_raw)) p_raw = NAN;
+
+  // Reject sudden jumps (vs last raw)
+  if (plausibleV(v_raw) && plausibleV(last_v_raw)) {
+    if (fabsf(v_raw - last_v_raw) > LC_MAX_JUMP_V) v_raw = NAN;
+  }
+  if (plausibleP(p_raw) && plausibleP(last_p_raw)) {
+    if (fabsf(p_raw - last_p_raw) > LC_MAX_JUMP_P) p_raw = NAN;
+  }
+
+  // Update last_raw if valid
+  if (!isnan(v_raw)) last_v_raw = v_raw;
+  if (!isnan(p_raw)) last_p_raw = p_raw;
+
+  // Voltage EMA
+  if (!isnan(v_raw)) {
+    if (isnan(lc_v_filt)) lc_v_filt = v_raw;
+    else lc_v_filt += LC_ALPHA_V * (v_raw - lc_v_filt);
+    lc_v = lc_v_filt; // expose filtered V for UI/debug
+  }
+
+  // Warm-up: require a few valid samples total before showing %
+  if (lc_warmup_reads < LC_WARMUP_READS) {
+    if (!isnan(v_raw) || !isnan(p_raw)) lc_warmup_reads++;
+    if (lc_warmup_reads < LC_WARMUP_READS) return true;
+  }
+
+  // Stable % estimate:
+  // - Prefer library percent when sane
+  // - Blend with OCV-derived percent from filtered voltage
+  float p_est = NAN;
+  const bool have_lib = plausibleP(p_raw);
+  const bool have_v   = plausibleV(lc_v_filt);
+  float p_ocv = have_v ? pctFromVoltage(lc_v_filt) : NAN;
+
+  if (have_lib && have_v)      p_est = LC_BLEND_W * p_raw + (1.f - LC_BLEND_W) * p_ocv;
+  else if (have_lib)           p_est = p_raw;
+  else if (have_v)             p_est = p_ocv;
+
+  // Smooth + clamp steps + monotonic guard
+  if (!isnan(p_est)) {
+    if (isnan(lc_pct)) {
+      lc_pct = p_est;
+    } else {
+      float delta = p_est - lc_pct;
+
+      // Monotonic guard: if voltage clearly falling (>30 mV step), don’t let % rise
+      if (!isnan(last_v_raw) && !isnan(lc_v_filt) && (last_v_raw - lc_v_filt) > 0.03f && delta > 0) {
+        delta = 0.f;
+      }
+
+      if (delta >  LC_MAX_STEP_P) delta =  LC_MAX_STEP_P;
+      if (delta < -LC_MAX_STEP_P) delta = -LC_MAX_STEP_P;
+      lc_pct += LC_ALPHA_P * delta;
+    }
+    // keep inside [0,100]
+    if (lc_pct < 0.f)   lc_pct = 0.f;
+    if (lc_pct > 100.f) lc_pct = 100.f;
+  }
+
+  if (s_dbg) {
+    if (!isnan(lc_pct) && !isnan(lc_v_filt))
+      Serial.printf("[GAUGE] batt=%.1f%% (Vf=%.3f V)%s%s\n",
+                    lc_pct, lc_v_filt,
+                    have_lib ? "" : " [no-lib%]",
+                    (have_v && have_lib ? " [blend]" : ""));
+    else if (!isnan(lc_v_filt))
+      Serial.printf("[GAUGE] batt=--%% (Vf=%.3f V)\n", lc_v_filt);
+    else
+      Serial.printf("[GAUGE] batt=-- (no gauge)\n");
+  }
+  return true;
+}
+
+static void gaugeTask(void*) {
+  uint32_t lastTry = 0, lastRead = 0;
+  bool tried = false;
+  for (;;) {
+    const uint32_t now = millis();
+    if (!lc_ok) {
+      if (!tried || now - lastTry >= LC_RETRY_MS) {
+        tried = true;
+        lastTry = now;
+        if (tryInit()) {
+          lc_ok = true;
+          lc_ok_since = millis();
+          resetFilters();
+          publish();
+        }
+      }
+    } else if (now - lastRead >= LC_READ_MS &&
+               // give the IC a moment after power-up to stabilize OCV estimate
+               now - lc_ok_since >= LC_WARMUP_MS) {
+      if (sampleOnce()) { lastRead = now; publish(); }
+    }
+    vTaskDelay(pdMS_TO_TICKS(LC_POLL_MS));
+  }
+}
+
+void begin(TwoWire* w, bool debug) {
+  s_wire = w ? w : &Wire;
+  s_dbg = debug;
+  // low priority on core 0: it only ever waits for the bus
+  if (!s_task) xTaskCreatePinnedToCore(gaugeTask, "gauge", 3072, nullptr, 1, &s_task, 0);
+}
+
+bool present() {
+  portENTER_CRITICAL(&s_mux);
+  const bool ok = pub_ok;
+  portEXIT_CRITICAL(&s_mux);
+  return ok;
+}
+
+float percent() {
+  portENTER_CRITICAL(&s_mux);
+  const float p = pub_pct;
+  portEXIT_CRITICAL(&s_mux);
+  return p;
+}
+
+float voltage() {
+  portENTER_CRITICAL(&s_mux);
+  const float v = pub_v;
+  portEXIT_CRITICAL(&s_mux);
+  return v;
+}
+
+} // namespace FuelGauge
@@ -0,0 +1,22 @@
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+
+// LC709203F fuel gauge, sampled on its own task.
+//
+// Detection retries, reads and the smoothing (EMA on voltage, jump
+// rejection, library/OCV blend, step clamp) run off the render path; every
+// bus access goes through I2CBus, so reads land between display frames.
+// Views only read the published values.
+
+namespace FuelGauge {
+
+// Starts the sampling task. The bus must already be started (and attached
+// to I2CBus when it is shared).
+void begin(TwoWire* w = &Wire, bool debug = false);
+
+bool  present();      // gauge detected and configured
+float percent();      // smoothed %, NAN until warmed up or without a gauge
+float voltage();      // filtered cell voltage, NAN without a gauge
+
+} // namespace FuelGauge
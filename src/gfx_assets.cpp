@@ -0,0 +1,22 @@
+// Generated by gfx/build_gfx_assets.py - do not edit.
+#include "gfx_assets.h"
+
+static const uint8_t GFX_DC_LOGO_RLE[] PROGMEM = {
+  0xff,0x00,0xff,0x00,0x9d,0x00,0x88,0xff,0x03,0x7f,0x3f,0x1f,0x1f,0x82,0x0f,0x80,
+  0xcf,0x93,0x0f,0x81,0x4f,0x82,0x0f,0x80,0x1f,0x01,0x3f,0x7f,0x88,0xff,0xc0,0x00,
+  0x88,0xff,0x04,0xfc,0xf8,0xf0,0xf0,0xf1,0x81,0xe1,0x80,0xe7,0x82,0xe1,0x80,0xf0,
+  0x80,0xf8,0x84,0xfe,0x03,0xfc,0xf8,0xf0,0xf0,0x81,0xe1,0x0a,0xe4,0xe6,0xe4,0xe0,
+  0xe1,0xe1,0xf1,0xf0,0xf0,0xf8,0xfc,0x88,0xff,0xc0,0x00,0x80,0x79,0x80,0x49,0x80,
+  0x79,0x81,0x01,0x08,0x71,0x79,0x39,0x29,0x39,0x79,0x71,0x01,0x01,0x81,0x79,0x80,
+  0x19,0x14,0x39,0x69,0x61,0x01,0x01,0x79,0x79,0x11,0x11,0x19,0x79,0x61,0x01,0x01,
+  0x31,0x79,0x79,0x49,0x49,0x79,0x79,0x81,0x01,0x80,0x79,0x04,0x19,0x11,0x31,0x79,
+  0x79,0x81,0x01,0x80,0x79,0x80,0x59,0x01,0x51,0x40,0xaa,0x00,0x03,0x3c,0x7e,0xfe,
+  0xff,0x85,0xc3,0x81,0x00,0x80,0x7f,0x80,0xff,0x83,0xc0,0x80,0xff,0x80,0x7f,0x81,
+  0x00,0x03,0xce,0xde,0xdf,0xdf,0x81,0xdb,0x80,0xfb,0x03,0xf3,0x70,0x00,0x00,0x82,
+  0x03,0x83,0xff,0x82,0x03,0x80,0x00,0x01,0x7c,0x7e,0x81,0xff,0x81,0xc3,0x81,0xff,
+  0x01,0x7e,0x3c,0x81,0x00,0x00,0x7e,0x81,0xff,0x06,0x0f,0x0e,0x1c,0x18,0x1c,0x0c,
+  0x0e,0x82,0xff,0x82,0x00,0x03,0xce,0xde,0xdf,0xdf,0x81,0xdb,0x03,0xfb,0xf3,0x73,
+  0x70,0xff,0x00,0xff,0x00,0x88,0x00,
+};
+const GfxRle GFX_DC_LOGO = { 128, 8, 231, GFX_DC_LOGO_RLE };
+
@@ -0,0 +1,14 @@
+#pragma once
+// Generated by gfx/build_gfx_assets.py - do not edit.
+#include <Arduino.h>
+
+// Page-packed RLE bitmap: 'pages' rows of 8 px by 'w' columns, in U8g2
+// frame buffer byte order. Control byte c < 0x80: c+1 literal bytes follow;
+// c >= 0x80: the next byte repeated c-0x7e times.
+struct GfxRle {
+  uint8_t w, pages;
+  uint16_t len;
+  const uint8_t* data;
+};
+
+extern const GfxRle GFX_DC_LOGO;   // dc_logo.h 128x64: 1024 -> 231 B
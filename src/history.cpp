@@ -0,0 +1,166 @@
+#include "history.h"
+#include "telemetry.h"
+#include <freertos/FreeRTOS.h>
+#include <string.h>
+
+namespace History {
+
+static const uint16_t PERIOD_S[T_COUNT] = { 1, 10, 60 };
+static const uint8_t  RATIO[T_COUNT]    = { 1, 10, 6 };   // samples of the tier below per sample
+static const int16_t  LIMIT = 30000;                     // |value x10| kept in range of int16
+
+struct Ring {
+  int16_t  v[S_COUNT][HISTORY_LEN];     // one contiguous row per series (graphs read a row)
+  uint16_t head;                        // next write
+  uint16_t n;
+};
+struct Bucket { int32_t sum[S_COUNT]; uint8_t got[S_COUNT]; uint8_t ticks; };
+
+static Ring   s_ring[T_COUNT];
+static Bucket s_acc[T_COUNT];           // rollup of tier t-1 into t ([0] unused)
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;   // /history reads from the server task
+
+static uint32_t s_ver = 0, s_console = 0, s_at = 0;
+
+// -------- store (callers hold s_mux) --------
+static void clear() {
+  for (uint8_t t = 0; t < T_COUNT; ++t) { s_ring[t].head = 0; s_ring[t].n = 0; }
+  memset(s_acc, 0, sizeof(s_acc));
+}
+
+static void push(uint8_t t, const int16_t x[S_COUNT]) {
+  Ring& r = s_ring[t];
+  for (uint8_t s = 0; s < S_COUNT; ++s) r.v[s][r.head] = x[s];
+  if (++r.head == HISTORY_LEN) r.head = 0;
+  if (r.n < HISTORY_LEN) r.n++;
+  if (t + 1 >= T_COUNT) return;
+
+  Bucket& b = s_acc[t + 1];
+  for (uint8_t s = 0; s < S_COUNT; ++s)
+    if (x[s] != GAP) { b.sum[s] += x[s]; b.got[s]++; }
+  if (++b.ticks < RATIO[t + 1]) return;
+  int16_t y[S_COUNT];
+  for (uint8_t s = 0; s < S_COUNT; ++s) {
+    const int32_t n = b.got[s], sum = b.sum[s];
+    y[s] = n ? (int16_t)((sum + (sum >= 0 ? n / 2 : -n / 2)) / n) : GAP;
+  }
+  memset(&b, 0, sizeof(b));
+  push(t + 1, y);
+}
+
+static uint16_t copy(const Ring& r, uint8_t s, int16_t* out, uint16_t n) {
+  if (n > r.n) n = r.n;
+  uint16_t i = (uint16_t)((r.head + HISTORY_LEN - n) % HISTORY_LEN);
+  for (uint16_t k = 0; k < n; ++k) {
+    out[k] = r.v[s][i];
+    if (++i == HISTORY_LEN) i = 0;
+  }
+  return n;
+}
+
+// -------- sampling --------
+// The console to record: the pinned one, else the current one while it is
+// alive, else whichever is on screen.
+static bool follow(Telemetry::Snapshot& out) {
+  using namespace Telemetry;
+  const uint32_t pin = pinned();
+  const uint32_t want = pin ? pin : s_console;
+  for (uint8_t i = 0; want && sender(i, out); ++i)
+    if (out.ip == want && (pin || senderAlive(out))) return true;
+  if (pin) return false;                // pinned console not heard yet
+  out = get();
+  return out.ip != 0;
+}
+
+static int16_t fixed10(int32_t v) {
+  v *= 10;
+  return (int16_t)(v > LIMIT ? LIMIT : (v < -LIMIT ? -LIMIT : v));
+}
+
+void loop() {
+  const uint32_t now = millis();
+  if (!s_at) { s_at = now ? now : 1; return; }
+  uint32_t steps = (now - s_at) / 1000;
+  if (!steps) return;
+  s_at += steps * 1000;
+  if (steps > HISTORY_LEN) steps = HISTORY_LEN;   // a long stall: the 1 s tier is all one value anyway
+
+  Telemetry::Snapshot t;
+  const bool have = follow(t);
+  const uint32_t ip = have ? t.ip : (Telemetry::pinned() ? Telemetry::pinned() : s_console);
+  int16_t x[S_COUNT] = { GAP, GAP, GAP };
+  if (have && t.haveMain && Telemetry::senderAlive(t)) {
+    x[S_CPU] = fixed10(t.cpu);
+    x[S_AMB] = fixed10(t.amb);
+    x[S_FAN] = fixed10(t.fan);
+  }
+
+  portENTER_CRITICAL(&s_mux);
+  if (ip != s_console) { clear(); s_console = ip; }
+  while (steps--) push(T_1S, x);
+  portEXIT_CRITICAL(&s_mux);
+  s_ver++;
+}
+
+// -------- API --------
+uint32_t version() { return s_ver; }
+uint32_t console() { return s_console; }
+uint16_t periodS(Tier t) { return t < T_COUNT ? PERIOD_S[t] : 0; }
+
+uint16_t count(Tier t) {
+  if (t >= T_COUNT) return 0;
+  portENTER_CRITICAL(&s_mux);
+  const uint16_t n = s_ring[t].n;
+  portEXIT_CRITICAL(&s_mux);
+  return n;
+}
+
+uint16_t read(Tier t, Series s, int16_t* out, uint16_t n) {
+  if (t >= T_COUNT || s >= S_COUNT || !out) return 0;
+  portENTER_CRITICAL(&s_mux);
+  n = copy(s_ring[t], s, out, n);
+  portEXIT_CRITICAL(&s_mux);
+  return n;
+}
+
+int16_t last(Series s) {
+  int16_t v;
+  return read(T_1S, s, &v, 1) ? v : GAP;
+}
+
+static void putFixed(String& out, int16_t v) {
+  if (v == GAP) { out += "null"; return; }
+  int32_t a = v;
+  if (a < 0) { out += '-'; a = -a; }
+  out += a / 10;
+  if (a % 10) { out += '.'; out += a % 10; }
+}
+
+void json(String& out, Tier t) {
+  static const char* const SERIES[S_COUNT] = { "cpu", "amb", "fan" };
+  static const char* const TIERS[T_COUNT]  = { "1s", "10s", "1m" };
+  if (t >= T_COUNT) t = T_10S;
+
+  // one locked copy so the three series line up
+  static int16_t buf[S_COUNT][HISTORY_LEN];
+  uint16_t n;
+  uint32_t ip;
+  portENTER_CRITICAL(&s_mux);
+  n = s_ring[t].n;
+  for (uint8_t s = 0; s < S_COUNT; ++s) copy(s_ring[t], s, buf[s], n);
+  ip = s_console;
+  portEXIT_CRITICAL(&s_mux);
+
+  out.reserve(96 + (size_t)S_COUNT * n * 6);
+  out = "{\"console\":\""; out += ip ? IPAddress(ip).toString() : String();
+  out += "\",\"tier\":\""; out += TIERS[t];
+  out += "\",\"period_s\":"; out += PERIOD_S[t];
+  for (uint8_t s = 0; s < S_COUNT; ++s) {
+    out += ",\""; out += SERIES[s]; out += "\":[";
+    for (uint16_t k = 0; k < n; ++k) { if (k) out += ','; putFixed(out, buf[s][k]); }
+    out += ']';
+  }
+  out += '}';
+}
+
+} // namespace History
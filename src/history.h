@@ -0,0 +1,39 @@
+#pragma once
+#include <Arduino.h>
+
+// Telemetry history for the trend graphs: CPU / ambient temperature and fan %
+// of one console, as fixed-point samples (value x10) at three resolutions.
+//
+// sample() takes one 1 s sample; each coarser tier keeps a running sum of
+// the tier below and closes it into its own ring when full (10 x 1 s ->
+// 10 s, 6 x 10 s -> 1 min), so an append is O(1) and memory is fixed at
+// compile time whatever the uptime. Seconds with no data (no console yet,
+// sender gone quiet) are stored as GAP and left out of the rollups.
+//
+// The console followed is the pinned one, else the one on screen when the
+// previous one went quiet; switching consoles starts a fresh history.
+
+#ifndef HISTORY_LEN
+#define HISTORY_LEN 120                 // samples per tier (2 min / 20 min / 2 h)
+#endif
+
+namespace History {
+
+enum Series : uint8_t { S_CPU = 0, S_AMB, S_FAN, S_COUNT };
+enum Tier   : uint8_t { T_1S = 0, T_10S, T_1M, T_COUNT };
+static const int16_t GAP = INT16_MIN;
+
+void loop();                            // scheduler: samples on the second boundary
+uint32_t version();                     // bumps with every 1 s sample
+uint32_t console();                     // IPv4 being recorded, 0 = none
+
+uint16_t periodS(Tier t);
+uint16_t count(Tier t);                 // samples held (<= HISTORY_LEN)
+// Newest n samples of a series, oldest first; returns how many were copied.
+uint16_t read(Tier t, Series s, int16_t* out, uint16_t n);
+int16_t  last(Series s);                // newest 1 s sample, GAP if none
+
+// {"console","tier","period_s","cpu":[..],"amb":[..],"fan":[..]} for /history
+void json(String& out, Tier t);
+
+} // namespace History
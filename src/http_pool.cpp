@@ -0,0 +1,295 @@
+#include "http_pool.h"
+#include "metrics.h"
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
+#include <HTTPClient.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <string.h>
+#include <ctype.h>
+
+namespace HttpPool {
+
+static const char* USER_AGENT = "TypeD-WD/1.0";
+static const uint8_t MAX_PINS = 4;
+
+struct Slot {
+  String      host;
+  uint16_t    port = 0;
+  bool        tls = false;
+  bool        busy = false;
+  WiFiClient* cli = nullptr;    // WiFiClientSecure when tls
+  HTTPClient  http;
+  uint32_t    lastUse = 0;
+};
+
+struct Pin { const char* host; const char* pem; };
+
+static Slot    s_slots[HTTP_POOL_SLOTS];
+static Pin     s_pins[MAX_PINS];
+static uint8_t s_nPins = 0;
+static SemaphoreHandle_t s_lock = nullptr;   // slot table (not the requests)
+static portMUX_TYPE      s_initMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t s_requests = 0, s_reused = 0, s_dials = 0, s_redials = 0, s_failed = 0;
+
+struct Lock {
+  Lock() {
+    if (!s_lock) {
+      SemaphoreHandle_t m = xSemaphoreCreateMutex();
+      portENTER_CRITICAL(&s_initMux);
+      if (!s_lock) { s_lock = m; m = nullptr; }
+      portEXIT_CRITICAL(&s_initMux);
+      if (m) vSemaphoreDelete(m);
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+  }
+  ~Lock() { xSemaphoreGive(s_lock); }
+};
+
+// "http[s]://host[:port]/..." -> host, port, tls
+static bool parseUrl(const String& url, String& host, uint16_t& port, bool& tls) {
+  int p;
+  if (url.startsWith("https://"))     { tls = true;  p = 8; port = 443; }
+  else if (url.startsWith("http://")) { tls = false; p = 7; port = 80; }
+  else return false;
+  int end = url.indexOf('/', p);
+  if (end < 0) end = url.length();
+  String hp = url.substring(p, end);
+  const int at = hp.lastIndexOf('@');
+  if (at >= 0) hp = hp.substring(at + 1);
+  const int colon = hp.indexOf(':');
+  if (colon >= 0) { port = (uint16_t)hp.substring(colon + 1).toInt(); hp = hp.substring(0, colon); }
+  host = hp;
+  return host.length() > 0 && port;
+}
+
+static const char* pinFor(const String& host) {
+  for (uint8_t i = 0; i < s_nPins; ++i) if (host.equalsIgnoreCase(s_pins[i].host)) return s_pins[i].pem;
+  return nullptr;
+}
+
+static void closeSlot(Slot& s) {
+  if (s.cli) { s.cli->stop(); delete s.cli; s.cli = nullptr; }
+  s.host = String();
+  s.port = 0;
+}
+
+// The slot for host:port (or the least recently used free one, retargeted),
+// marked busy. nullptr if every slot is in use.
+static bool bound(const Slot& s, const String& host, uint16_t port, bool tls) {
+  return s.cli && s.port == port && s.tls == tls && s.host.equalsIgnoreCase(host);
+}
+
+static Slot* claim(const String& host, uint16_t port, bool tls) {
+  Lock l;
+  Slot *match = nullptr, *empty = nullptr, *oldest = nullptr;
+  for (auto& s : s_slots) {
+    if (s.busy) continue;
+    if (bound(s, host, port, tls)) { match = &s; break; }
+    if (!s.cli) { if (!empty) empty = &s; }
+    else if (!oldest || s.lastUse < oldest->lastUse) oldest = &s;
+  }
+  Slot* pick = match ? match : empty ? empty : oldest;
+  if (!pick) return nullptr;
+  if (!match) {
+    closeSlot(*pick);
+    pick->host = host;
+    pick->port = port;
+    pick->tls  = tls;
+  }
+  pick->busy = true;
+  return pick;
+}
+
+static bool ensureClient(Slot& s) {
+  if (s.cli) return true;
+  if (s.tls) {
+    WiFiClientSecure* c = new WiFiClientSecure();
+    if (!c) return false;
+    const char* pem = pinFor(s.host);
+    if (pem) c->setCACert(pem);
+    else     c->setInsecure();
+    s.cli = c;
+  } else {
+    s.cli = new WiFiClient();
+  }
+  s.http.setReuse(true);
+  s.http.setUserAgent(USER_AGENT);
+  return s.cli != nullptr;
+}
+
+// Response body straight off the socket: Content-Length bounded, chunked
+// (de-chunked here) or up to close. Reads block for the socket timeout
+// HTTPClient configured.
+class Body : public Stream {
+ public:
+  enum Mode : uint8_t { Length, Chunked, ToClose };
+  Body(Stream& in, Mode m, int32_t len) : in_(in), mode_(m), left_(len > 0 ? (uint32_t)len : 0) {
+    if (m == Length && len <= 0) end_ = true;
+  }
+
+  int read() override {
+    if (peeked_ >= 0) { const int c = peeked_; peeked_ = -1; return c; }
+    return next();
+  }
+  int peek() override {
+    if (peeked_ < 0) peeked_ = next();
+    return peeked_;
+  }
+  int available() override {
+    if (peeked_ >= 0) return 1;
+    if (end_) return 0;
+    const int n = in_.available();
+    if (mode_ == Length) return n < (int)left_ ? n : (int)left_;
+    if (mode_ == Chunked) return left_ ? (n < (int)left_ ? n : (int)left_) : 0;
+    return n;
+  }
+  size_t write(uint8_t) override { return 0; }
+
+  // Consume the rest so the socket is positioned at the next response.
+  // False if the body was cut short (the connection can't be reused).
+  bool drain() {
+    peeked_ = -1;
+    while (!end_) next();
+    return !err_;
+  }
+  bool reusable() const { return end_ && !err_ && mode_ != ToClose; }
+
+ private:
+  int rd() {
+    uint8_t b;
+    return in_.readBytes(&b, 1) == 1 ? b : -1;
+  }
+  int fail() { end_ = err_ = true; return -1; }
+
+  // "<hex>[;ext]\r\n"; 0 ends the body (trailers skipped up to the blank line)
+  bool chunkHeader() {
+    if (started_ && (rd() != '\r' || rd() != '\n')) return false;   // CRLF after the data
+    started_ = true;
+    uint32_t n = 0;
+    bool any = false;
+    int c;
+    while ((c = rd()) >= 0 && isxdigit(c)) { n = n * 16 + (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10)); any = true; }
+    while (c >= 0 && c != '\n') c = rd();
+    if (!any || c < 0) return false;
+    left_ = n;
+    if (n) return true;
+    // trailer section: lines until an empty one
+    for (;;) {
+      uint16_t len = 0;
+      while ((c = rd()) >= 0 && c != '\n') if (c != '\r') len++;
+      if (c < 0) return false;
+      if (!len) break;
+    }
+    end_ = true;
+    return true;
+  }
+
+  int next() {
+    if (end_) return -1;
+    if (mode_ == ToClose) {
+      const int c = rd();
+      if (c < 0) end_ = true;             // closed (or timed out): that's the end
+      return c;
+    }
+    if (mode_ == Chunked && !left_) {
+      if (!chunkHeader()) return fail();
+      if (end_) return -1;
+    }
+    const int c = rd();
+    if (c < 0) return fail();
+    if (--left_ == 0 && mode_ == Length) end_ = true;
+    return c;
+  }
+
+  Stream&  in_;
+  Mode     mode_;
+  uint32_t left_;
+  int      peeked_ = -1;
+  bool     end_ = false, err_ = false, started_ = false;
+};
+
+static const char* HDR_KEYS[] = { "Transfer-Encoding" };
+
+static int request(Slot& s, const String& url, uint32_t timeoutMs, BodyFn fn, void* ctx) {
+  s.http.setConnectTimeout((int32_t)timeoutMs);
+  s.http.setTimeout((uint16_t)timeoutMs);
+  if (!s.http.begin(*s.cli, url)) return HTTPC_ERROR_CONNECTION_REFUSED;
+  s.http.collectHeaders(HDR_KEYS, 1);
+  const uint32_t t0 = micros();
+  const int code = s.http.GET();
+  Metrics::sample(Metrics::H_HTTP, micros() - t0);
+  if (code == 200) {
+    const int32_t len = s.http.getSize();
+    const Body::Mode m = len >= 0 ? Body::Length
+                       : s.http.header("Transfer-Encoding").equalsIgnoreCase("chunked") ? Body::Chunked
+                       : Body::ToClose;
+    Body body(*s.cli, m, len);
+    fn(body, ctx);
+    if (!body.drain() || !body.reusable()) s.cli->stop();
+  }
+  s.http.end();                                 // keeps the socket when the server allows it
+  return code;
+}
+
+int get(const String& url, uint32_t timeoutMs, BodyFn fn, void* ctx) {
+  String host; uint16_t port; bool tls;
+  if (!parseUrl(url, host, port, tls)) return HTTPC_ERROR_CONNECTION_REFUSED;
+  Slot* s = claim(host, port, tls);
+  if (!s) return HTTPC_ERROR_CONNECTION_REFUSED;
+
+  int code = HTTPC_ERROR_CONNECTION_REFUSED;
+  bool warm = false, redial = false;
+  if (ensureClient(*s)) {
+    warm = s->cli->connected();
+    code = request(*s, url, timeoutMs, fn, ctx);
+    if (code < 0 && warm) {
+      // the server closed the idle connection under us: dial once more
+      s->cli->stop();
+      code = request(*s, url, timeoutMs, fn, ctx);
+      redial = true;
+    }
+    if (code < 0) s->cli->stop();
+  }
+  Lock l;
+  s_requests++;
+  if (warm && !redial) s_reused++; else s_dials++;
+  if (redial) s_redials++;
+  if (code < 0) s_failed++;
+  s->lastUse = millis();
+  s->busy = false;
+  return code;
+}
+
+void pin(const char* host, const char* caPem) {
+  if (!host || !caPem) return;
+  Lock l;
+  for (uint8_t i = 0; i < s_nPins; ++i)
+    if (!strcasecmp(s_pins[i].host, host)) { s_pins[i].pem = caPem; return; }
+  if (s_nPins < MAX_PINS) s_pins[s_nPins++] = Pin{ host, caPem };
+}
+
+void prune() {
+  Lock l;
+  const uint32_t now = millis();
+  for (auto& s : s_slots) {
+    if (s.busy || !s.cli || now - s.lastUse < HTTP_POOL_IDLE_MS) continue;
+    if (s.cli->connected()) s.cli->stop();       // frees the TLS context; the slot stays bound
+  }
+}
+
+void metricsJson(String& out) {
+  Lock l;
+  uint32_t open = 0;
+  for (auto& s : s_slots) if (s.busy || (s.cli && s.cli->connected())) open++;
+  out += "\"http_pool\":{\"requests\":"; out += s_requests;
+  out += ",\"reused\":";  out += s_reused;
+  out += ",\"dials\":";   out += s_dials;
+  out += ",\"redials\":"; out += s_redials;
+  out += ",\"failed\":";  out += s_failed;
+  out += ",\"open\":";    out += open;
+  out += '}';
+}
+
+} // namespace HttpPool
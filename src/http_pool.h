@@ -0,0 +1,37 @@
+#pragma once
+#include <Arduino.h>
+
+// Keep-alive HTTP(S) connections for the background fetchers.
+//
+// Each host gets a slot with its own long-lived client, so back-to-back
+// requests (geolocate, forecast, retries) reuse the open socket and pay for
+// one TLS handshake instead of one per request. A connection the server has
+// dropped is detected on use and redialled once. Idle connections are closed
+// after HTTP_POOL_IDLE_MS to hand the ~40 KB of TLS buffers back to the heap.
+//
+// HTTPS is unauthenticated unless a CA is pinned for the host (pin()).
+
+#ifndef HTTP_POOL_SLOTS
+#define HTTP_POOL_SLOTS 3
+#endif
+#ifndef HTTP_POOL_IDLE_MS
+#define HTTP_POOL_IDLE_MS 30000
+#endif
+
+namespace HttpPool {
+
+// GET url; returns the HTTP status (< 0 on transport errors). On 200 fn
+// reads the body straight off the socket (de-chunked, bounded; read() is -1
+// at the end); whatever it leaves is drained so the connection can be
+// reused. Blocking: fetch tasks only.
+typedef bool (*BodyFn)(Stream& body, void* ctx);
+int get(const String& url, uint32_t timeoutMs, BodyFn fn, void* ctx);
+
+// Verify host against caPem (kept by pointer; must outlive the pool).
+// Call before the first request to that host.
+void pin(const char* host, const char* caPem);
+
+void prune();                  // close idle connections (scheduler)
+void metricsJson(String& out); // section for /metrics
+
+} // namespace HttpPool
@@ -0,0 +1,52 @@
+#include "i2c_bus.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+namespace I2CBus {
+
+static const uint8_t MAX_BUSES = 2;     // Wire, Wire1
+
+struct Bus { TwoWire* wire; SemaphoreHandle_t mtx; };
+static Bus s_bus[MAX_BUSES];
+static uint8_t s_nBus = 0;
+static volatile uint32_t s_contended = 0;
+
+static SemaphoreHandle_t mutexFor(TwoWire* w) {
+  for (uint8_t i = 0; i < s_nBus; ++i) if (s_bus[i].wire == w) return s_bus[i].mtx;
+  return nullptr;
+}
+
+void attach(TwoWire* w) {
+  if (!w || mutexFor(w) || s_nBus >= MAX_BUSES) return;
+  SemaphoreHandle_t m = xSemaphoreCreateMutex();
+  if (!m) return;
+  s_bus[s_nBus].wire = w;
+  s_bus[s_nBus].mtx = m;
+  s_nBus++;
+}
+
+bool lock(TwoWire* w, uint32_t timeoutMs) {
+  SemaphoreHandle_t m = mutexFor(w);
+  if (!m) return true;
+  if (xSemaphoreTake(m, 0) == pdTRUE) return true;
+  s_contended++;
+  const TickType_t wait = (timeoutMs == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+  return xSemaphoreTake(m, wait) == pdTRUE;
+}
+
+void unlock(TwoWire* w) {
+  SemaphoreHandle_t m = mutexFor(w);
+  if (m) xSemaphoreGive(m);
+}
+
+uint32_t contended() { return s_contended; }
+
+uint32_t capClock(TwoWire* w, uint32_t maxHz) {
+  if (!w || !maxHz) return 0;
+  const uint32_t hz = w->getClock();
+  if (hz <= maxHz) return 0;
+  w->setClock(maxHz);
+  return hz;
+}
+
+} // namespace I2CBus
@@ -0,0 +1,53 @@
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+
+// Bus arbitration for devices that share a TwoWire.
+//
+// Wire serializes single transactions on its own, but a frame burst from the
+// display and a gauge read could still interleave at transaction
+// granularity, with the gauge landing mid-frame at the panel's raised clock.
+// Holders take the bus for a whole burst: OledAsync from the first queued
+// transfer until its queue is empty, FuelGauge for one read. Other devices
+// therefore only ever see the bus between frames and at its base clock.
+//
+// Buses that were never attach()ed are not arbitrated (lock() succeeds).
+//
+// A device slower than the bus (the gauge on the display's 1 MHz Wire1)
+// passes its limit to Guard: the clock is lowered for the hold and put back
+// before the bus is released.
+
+namespace I2CBus {
+
+// From setup(), once per bus, before any task uses it.
+void attach(TwoWire* w);
+
+bool lock(TwoWire* w, uint32_t timeoutMs = UINT32_MAX);
+void unlock(TwoWire* w);
+
+// Times the bus was already held when someone asked for it (since boot).
+uint32_t contended();
+
+// Caller holds the bus. Lowers its clock to maxHz if it runs faster and
+// returns the clock to restore, else 0 (also for maxHz = 0).
+uint32_t capClock(TwoWire* w, uint32_t maxHz);
+
+class Guard {
+ public:
+  explicit Guard(TwoWire* w, uint32_t timeoutMs = UINT32_MAX, uint32_t maxHz = 0)
+    : w_(w), ok_(lock(w, timeoutMs)), restoreHz_(ok_ ? capClock(w, maxHz) : 0) {}
+  ~Guard() {
+    if (!ok_) return;
+    if (restoreHz_) w_->setClock(restoreHz_);
+    unlock(w_);
+  }
+  bool ok() const { return ok_; }
+  Guard(const Guard&) = delete;
+  Guard& operator=(const Guard&) = delete;
+ private:
+  TwoWire* w_;
+  bool     ok_;
+  uint32_t restoreHz_;
+};
+
+} // namespace I2CBus
@@ -1,15 +1,48 @@
 #include "insignia.h"
+#include "oled_damage.h"
+#include "metrics.h"
+#include "mem.h"
 #include <HTTPClient.h>
 #include <WiFiClient.h>
 #include <ArduinoJson.h>
 #if defined(ARDUINO) || defined(ESP_PLATFORM)
   #include <WiFi.h>
   #include <FS.h>
-  #include <SPIFFS.h>
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+  #include <freertos/semphr.h>
+  #include <lwip/sockets.h>
+  #include <lwip/netdb.h>
+  #include <esp_ota_ops.h>     // esp_app_get_elf_sha256()
+  #include <fcntl.h>
+  #include <errno.h>
 #endif
 #include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <string.h>
 #include <algorithm>
 #include <time.h>
+#include <math.h>
+
+// Flash cache backend. LittleFS (default) has real directories and copes
+// with fragmentation; INSIGNIA_USE_LITTLEFS=0 builds against SPIFFS. Both
+// mount the "spiffs" partition (switching backends reformats it once).
+#ifndef INSIGNIA_USE_LITTLEFS
+#define INSIGNIA_USE_LITTLEFS 1
+#endif
+#if defined(ARDUINO) || defined(ESP_PLATFORM)
+  #if INSIGNIA_USE_LITTLEFS
+    #include <LittleFS.h>
+    #define CACHE_FS      LittleFS
+    #define CACHE_FS_NAME "LittleFS"
+  #else
+    #include <SPIFFS.h>
+    #define CACHE_FS      SPIFFS
+    #define CACHE_FS_NAME "SPIFFS"
+  #endif
+#endif
 
 namespace Insignia {
 
@@ -29,26 +62,34 @@ static bool in_list_ci(const String& s, const char* const* keys);
 static int  metric_pref(const String& key);
 static int  rankKey(const String& rs);
 static void resetRuntime(bool keepRoot=false);
-static bool resolveTitlePool();
-static bool loadGameModel(const String& titleId);
+struct ResolveOut;
+struct Model;
+static bool resolveTitlePool(const String& root, const String& app, ResolveOut& out);
+static bool loadGameModel(const String& root, const String& titleId, std::shared_ptr<const Model>& out);
+static void ramClear();
 static void maybeResolveAndLoad();
 static void ensureFS();
-static String sanitizeKey(const String& url);
-static size_t dirSize(const char* dir, size_t& files);
 static void pruneCache();
-static bool cacheWrite(const String& url, const String& body);
-static bool cacheRead(const String& url, String& out, uint32_t maxAgeMs, bool allowStaleIfNoNet);
+static uint32_t fnv1a(const String& s);
+static uint32_t fnv1a(const char* s, size_t n);
+#if defined(ARDUINO) || defined(ESP_PLATFORM)
+static File cacheOpen(const String& url, uint32_t maxAgeMs, bool allowStaleIfNoNet);
+enum class Fetch : uint8_t { Failed, Updated, NotModified };
+static Fetch httpToCache(const String& url, uint32_t timeoutMs);
+static void invalidateTitleIndex();
+#endif
 static bool httpGetTO(const String& url, String& out, uint32_t timeoutMs);
 static inline bool httpGet(const String& url, String& out);
 static void buildCandidateRoots(std::vector<String>& out);
-static void startProbingIfNeeded();
-static bool stepProbeWorkRoot();
-static int tokenOverlapScore(const std::vector<String>& qtoks, const std::vector<String>& ctoks);
-static int firstTokenBoost(const std::vector<String>& qtoks, const std::vector<String>& ctoks);
-static bool isGenericXLA(const std::vector<String>& ctoks);
-static int tokenJaccardPenaltyShort(const String& candNorm);
-static int bigramJaccardScore(const String& a, const String& b);
-static int containsBonus(const String& small, const String& big);
+static int  probeRoots(const std::vector<String>& roots);
+struct MatchText;
+static void prepText(const String& raw, MatchText& t);
+static int tokenOverlapScore(const MatchText& q, const MatchText& c);
+static int firstTokenBoost(const MatchText& q, const MatchText& c);
+static bool isGenericXLA(const MatchText& c);
+static int tokenJaccardPenaltyShort(const MatchText& cand);
+static int bigramJaccardScore(const MatchText& a, const MatchText& b);
+static int containsBonus(const MatchText& small, const MatchText& big);
 
 // =================== Config / constants ===================
 static bool g_dbg = true;
@@ -71,26 +112,36 @@ static const uint32_t MODEL_DWELL_MS = 12000;
 static const char* RANK_KEYS[]   = {"rank","#","pos","position","place", nullptr};
 static const char* NAME_KEYS[]   = {"name","player","gamertag","gamer","tag","alias","username","user","gt","account", nullptr};
 static const char* PREFER_METRIC[]= {"score","points","rating","time","best time","laps","wins","value", nullptr};
-static const int   MAX_ROWS_PER_BOARD = 0;  // unlimited
+static const int   MAX_ROWS_PER_BOARD = 64;  // best-ranked rows kept per board
+static const size_t ROW_DOC_BYTES     = 4096; // one row is parsed at a time
 
 // Networking/prefetch tuning
 static const uint32_t HTTP_TIMEOUT_MS   = 1200;
-static const uint32_t PROBE_SPACING_MS  = 200;
+static const uint32_t PROBE_TIMEOUT_MS  = 1500;   // one window for all candidates
 static const uint32_t PROBE_BACKOFF_MS  = 2000;
+static const uint32_t RETRY_BACKOFF_MS  = 2000;   // failed resolve/load
+static const uint32_t WORKER_STACK      = 8192;
 
 // Match acceptance threshold
 static const int MIN_ACCEPT_SCORE = 65;
 
 // Cache policy
+static const uint32_t TTL_SEARCH_MS = 6UL*60*60*1000UL;
+static const uint32_t TTL_BYID_MS   = 2UL*60*1000UL;   // also the RAM tier's
 #if defined(ARDUINO) || defined(ESP_PLATFORM)
 static const char* CACHE_DIR = "/insig";
+static const char* INDEX_PATH = "/titles.idx";     // compiled search.json (kept outside the pruned cache)
+static const char* INDEX_TMP  = "/titles.tmp";
+static const char* MANIFEST_PATH = "/insig/manifest";   // see CacheEntry
+static const char* MANIFEST_TMP  = "/insig/manifest.tmp";
+static const char* STAMP_PATH = "/cache.ver";     // which firmware filled the cache
+// Bump when the on-flash formats change; the build time covers everything else
+static const uint8_t CACHE_FORMAT = 2;    // 2: hashed names + manifest file
 static bool  fsReady = false;
 static bool  flushOnBoot = false;
 static size_t cacheMaxFiles = 32;
 static size_t cacheMaxBytes = 128 * 1024;
 static uint32_t cacheMaxAgeMs = 6UL*60*60*1000UL;
-static const uint32_t TTL_SEARCH_MS = 6UL*60*60*1000UL;
-static const uint32_t TTL_BYID_MS   = 2UL*60*1000UL;
 #endif
 
 // =================== Runtime state ===================
@@ -105,25 +156,98 @@ static std::vector<String> titlePool;
 static int curTitleIdx = -1;
 static uint32_t lastModelSwitch = 0;
 
-struct Row {
-  String rank, name;
-  String metric;
-  std::vector<String> extras;
+// u8g2_font_5x8_tf / 6x12_tf are fixed-cell and drawUTF8() emits one glyph
+// per code point, so on-screen width is known from the code point count.
+// Leaderboard names arrive as UTF-8; the limits count characters, not bytes.
+static const size_t LINE_CHARS = (SCR_W - 4) / 5;
+static const size_t HEAD_CHARS = SCR_W / 6;
+
+static inline bool utf8Cont(char c) { return ((uint8_t)c & 0xC0) == 0x80; }
+
+static size_t utf8Chars(const char* p, size_t n) {
+  size_t k = 0;
+  for (size_t i = 0; i < n; ++i) k += !utf8Cont(p[i]);
+  return k;
+}
+
+// Bytes taken by the first 'chars' code points (never splits a sequence).
+static size_t utf8Cut(const char* p, size_t n, size_t chars) {
+  size_t i = 0;
+  for (size_t k = 0; i < n; ++i) {
+    if (!utf8Cont(p[i]) && k++ == chars) break;
+  }
+  return i;
+}
+
+// Backing store for one model's text: NUL-terminated strings back to back,
+// addressed by offset. Identical strings are stored once.
+class TextArena {
+ public:
+  uint32_t add(const char* p, size_t n) {
+    const uint32_t h = fnv1a(p, n);
+    auto it = seen_.find(h);
+    if (it != seen_.end() && !strncmp(at(it->second), p, n) && at(it->second)[n] == 0) return it->second;
+    const uint32_t off = (uint32_t)buf_.size();
+    buf_.insert(buf_.end(), p, p + n);
+    buf_.push_back(0);
+    if (it == seen_.end()) seen_.emplace(h, off);
+    return off;
+  }
+  const char* at(uint32_t off) const { return buf_.data() + off; }
+  void seal() { buf_.shrink_to_fit(); std::unordered_map<uint32_t, uint32_t>().swap(seen_); }
+  size_t bytes() const { return buf_.capacity(); }
+
+ private:
+  std::vector<char, Mem::Bulk<char>> buf_;
+  std::unordered_map<uint32_t, uint32_t> seen_;   // hash -> offset, while building
+};
+
+// Rows are stored as their finished display line (rank, name, metric,
+// extras), already cut to the screen width.
+struct Row   { uint32_t line; };
+struct Board { uint32_t name; uint32_t first, count; };   // rows[first, first+count)
+
+typedef std::vector<Board, Mem::Bulk<Board>> BoardList;
+typedef std::vector<Row, Mem::Bulk<Row>>     RowList;
+
+// One parsed by_id file. Built on the worker, immutable once published, and
+// shared between the RAM tier and the screen. The tables are bulk (PSRAM).
+struct Model {
+  String id, title;
+  TextArena text;
+  BoardList boards;
+  RowList   rows;
+  size_t bytes = 0;                  // rough footprint, for the RAM tier budget
 };
-struct Board { String name; std::vector<Row> rows; };
-static std::vector<Board> boards;
+typedef std::shared_ptr<const Model> ModelPtr;
+static ModelPtr model;               // on screen
+static uint32_t modelVer = 0;        // bumps when 'model' is adopted or dropped
+static String   headText;            // title line, cut to width in adoptModel()
+static int      headX = 0;
 
 static int   curBoard = -1;
 static float scrollY  = 0.f;
 static uint32_t lastStep = 0;
 static uint32_t lastBoardSwitch = 0;
 static uint32_t freezeUntilMs = 0;
-static uint32_t lastFetchMs = 0;
 
-// ---- incremental probing state ----
-static std::vector<String> probeList;
-static size_t probeIdx = 0;
-static uint32_t nextProbeAt = 0;
+// Guards everything the fetch worker and the UI side share (job/result
+// queues, RAM tier). No-op until the worker exists.
+#if defined(ARDUINO) || defined(ESP_PLATFORM)
+static SemaphoreHandle_t fetchLock = nullptr;
+struct FetchLock {
+  FetchLock()  { if (fetchLock) xSemaphoreTake(fetchLock, portMAX_DELAY); }
+  ~FetchLock() { if (fetchLock) xSemaphoreGive(fetchLock); }
+};
+#else
+struct FetchLock {};
+#endif
+
+// ---- fetch worker bookkeeping (UI side) ----
+static uint32_t gen = 0;             // bumps on app change; stale results are dropped
+static bool     probeBusy = false, resolveBusy = false, loadBusy = false;
+static String   loadBusyId;
+static uint32_t nextProbeAt = 0, nextResolveAt = 0, nextLoadAt = 0;
 
 // ---- diagnostics ----
 struct MatchDiag {
@@ -134,9 +258,44 @@ struct MatchDiag {
 static std::vector<MatchDiag> lastDiag;
 static String lastQueryRaw, lastQueryNorm;
 
+struct ResolveOut {
+  String norm, fam, bestName;
+  int score = 0;
+  std::vector<String> pool;
+  std::vector<MatchDiag> diag;
+};
+
+// All HTTP runs on the fetch worker, which keeps one session so the
+// search.json → by_id requests ride a single keep-alive connection.
+static WiFiClient netClient;
+static HTTPClient netHttp;
+
+// Validators from the last 200; sent back so an unchanged body costs a 304.
+struct CacheMeta { String etag, lastMod; };
+
+static int httpStart(const String& url, uint32_t timeoutMs, const CacheMeta* cond = nullptr) {
+  netHttp.setReuse(true);
+  netHttp.setConnectTimeout((int32_t)timeoutMs);
+  netHttp.setTimeout((uint16_t)timeoutMs);
+  if (!netHttp.begin(netClient, url)) return -1;
+  if (cond) {
+    static const char* keys[] = { "ETag", "Last-Modified" };
+    netHttp.collectHeaders(keys, 2);
+    if (cond->etag.length())    netHttp.addHeader("If-None-Match", cond->etag);
+    if (cond->lastMod.length()) netHttp.addHeader("If-Modified-Since", cond->lastMod);
+  }
+  const uint32_t t0 = micros();
+  const int code = netHttp.GET();
+  Metrics::sample(Metrics::H_HTTP, micros() - t0);
+  return code;
+}
+
 // =================== Helpers ===================
+static int8_t linkState = -1;            // -1: no link events yet, poll WiFi.status()
+
 static inline bool netReady() {
 #if defined(ARDUINO) || defined(ESP_PLATFORM)
+  if (linkState >= 0) return linkState != 0;
   return WiFi.status() == WL_CONNECTED;
 #else
   return true;
@@ -289,117 +448,269 @@ static int rankKey(const String& rs){
   return val;
 }
 
-// =================== SPIFFS cache (ESP only) ===================
+// =================== Flash cache (ESP only) ===================
 #if defined(ARDUINO) || defined(ESP_PLATFORM)
-static void ensureFS() {
-  if (!fsReady) {
-    fsReady = SPIFFS.begin(true);
-    if (g_dbg) Serial.printf("[INSIGNIA] SPIFFS %s\n", fsReady ? "mounted" : "MOUNT FAIL");
-    if (fsReady && flushOnBoot) {
-      File root = SPIFFS.open("/");
-      for (File f = root.openNextFile(); f; f = root.openNextFile()) {
-        String p = f.path();
-        if (p.startsWith(CACHE_DIR)) SPIFFS.remove(p);
-      }
-      if (g_dbg) Serial.println("[INSIGNIA] cache flushed on boot");
-      flushOnBoot = false;
-    }
+// ---- manifest ----
+// One record per cached body: where it lives, its size, when it was written
+// or revalidated ('stamp'), how often it was read and its HTTP validators.
+// It is kept in RAM and persisted as MANIFEST_PATH, so mounting reads one
+// file instead of walking the directory, and the size/count limits come
+// from running totals.
+struct CacheEntry {
+  uint32_t hash;            // fnv1a(url), also the file name under CACHE_DIR
+  String   url;
+  uint32_t bytes;
+  time_t   stamp;
+  uint32_t hits;
+  String   etag, lastMod;
+};
+static std::vector<CacheEntry> manifest;
+static uint32_t manifestBytes = 0;           // sum of manifest[].bytes
+static bool     manifestDirty = false;       // stamps/hits changed since the last save
+static uint32_t manifestSavedAt = 0;
+static uint32_t lastAgeSweep = 0;
+static const uint32_t MANIFEST_SAVE_MS = 60000;   // batch stamp/hit-only updates
+static const uint32_t AGE_SWEEP_MS     = 10UL*60*1000UL;
+
+static String cachePath(uint32_t hash) {
+  char p[24];
+  snprintf(p, sizeof(p), "%s/%08lx", CACHE_DIR, (unsigned long)hash);
+  return String(p);
+}
+
+static int manifestFind(const String& url) {
+  const uint32_t h = fnv1a(url);
+  for (size_t i = 0; i < manifest.size(); ++i)
+    if (manifest[i].hash == h && manifest[i].url == url) return (int)i;
+  return -1;
+}
+
+static bool manifestSave() {
+  File f = CACHE_FS.open(MANIFEST_TMP, FILE_WRITE);
+  if (!f) return false;
+  f.print("M1\n");
+  for (auto& e : manifest) {
+    char num[48];
+    snprintf(num, sizeof(num), "%08lx\t%lu\t%ld\t%lu\t", (unsigned long)e.hash, (unsigned long)e.bytes,
+             (long)e.stamp, (unsigned long)e.hits);
+    f.print(num);
+    f.print(e.etag); f.print('\t'); f.print(e.lastMod); f.print('\t'); f.print(e.url); f.print('\n');
+  }
+  f.close();
+  CACHE_FS.remove(MANIFEST_PATH);
+  if (!CACHE_FS.rename(MANIFEST_TMP, MANIFEST_PATH)) { CACHE_FS.remove(MANIFEST_TMP); return false; }
+  manifestDirty = false;
+  manifestSavedAt = millis();
+  return true;
+}
+static void manifestTouch() {
+  manifestDirty = true;
+  if (millis() - manifestSavedAt >= MANIFEST_SAVE_MS) manifestSave();
+}
+
+static bool manifestLoad() {
+  manifest.clear();
+  manifestBytes = 0;
+  File f = CACHE_FS.open(MANIFEST_PATH, FILE_READ);
+  if (!f) return false;
+  if (f.readStringUntil('\n') != "M1") { f.close(); return false; }
+  while (f.available()) {
+    String line = f.readStringUntil('\n');
+    // hash \t bytes \t stamp \t hits \t etag \t lastMod \t url
+    int t[6], from = 0;
+    bool ok = true;
+    for (int k = 0; k < 6 && ok; ++k) { t[k] = line.indexOf('\t', from); ok = t[k] >= 0; from = t[k] + 1; }
+    if (!ok) continue;
+    CacheEntry e;
+    e.hash    = (uint32_t)strtoul(line.substring(0, t[0]).c_str(), nullptr, 16);
+    e.bytes   = (uint32_t)strtoul(line.substring(t[0] + 1, t[1]).c_str(), nullptr, 10);
+    e.stamp   = (time_t)strtol(line.substring(t[1] + 1, t[2]).c_str(), nullptr, 10);
+    e.hits    = (uint32_t)strtoul(line.substring(t[2] + 1, t[3]).c_str(), nullptr, 10);
+    e.etag    = line.substring(t[3] + 1, t[4]);
+    e.lastMod = line.substring(t[4] + 1, t[5]);
+    e.url     = line.substring(t[5] + 1);
+    if (!e.url.length() || e.hash != fnv1a(e.url)) continue;
+    manifestBytes += e.bytes;
+    manifest.push_back(std::move(e));
   }
+  f.close();
+  manifestSavedAt = millis();
+  if (g_dbg) Serial.printf("[INSIGNIA] cache manifest: %u entries, %lu B\n",
+                           (unsigned)manifest.size(), (unsigned long)manifestBytes);
+  return true;
 }
 
-static String sanitizeKey(const String& url) {
-  String k=url;
-  k.replace("://","__");
-  const char *bad="/?:&=%#";
-  for (const char* p=bad; *p; ++p) { k.replace(String(*p), "_"); }
-  if (!k.startsWith("/")) k = "/" + k;
-  return String(CACHE_DIR) + k;
+static void cacheDrop(size_t i) {
+  CACHE_FS.remove(cachePath(manifest[i].hash));
+  manifestBytes -= std::min(manifestBytes, manifest[i].bytes);
+  manifest[i] = std::move(manifest.back());     // order doesn't matter
+  manifest.pop_back();
 }
 
-static size_t dirSize(const char* dir, size_t& files) {
-  size_t bytes=0; files=0;
-  File root = SPIFFS.open("/");
-  for (File f = root.openNextFile(); f; f = root.openNextFile()) {
-    if (String(f.path()).startsWith(dir)) { bytes += f.size(); files++; }
+// The cache (bodies, manifest, compiled index) only outlives a reboot when
+// the same firmware and server list filled it; anything else wipes it once.
+// The firmware is identified by its ELF SHA-256: it follows the code, not
+// the clock of the machine that built it.
+static String cacheStamp() {
+  char v[16], elf[65];
+  snprintf(v, sizeof(v), "%u|", (unsigned)CACHE_FORMAT);
+  esp_app_get_elf_sha256(elf, sizeof(elf));
+  return String(v) + elf + "|" + BASE;
+}
+static bool stampMatches(const String& want) {
+  File f = CACHE_FS.open(STAMP_PATH, FILE_READ);
+  if (!f) return false;
+  const String have = f.readString();
+  f.close();
+  return have == want;
+}
+static void wipeCacheFiles() {
+  // collect first: removing entries while iterating a directory skips some
+  std::vector<String> doomed;
+  File dir = CACHE_FS.open(CACHE_DIR);
+  if (dir) {
+    for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+      String p = f.path();
+      if (p.startsWith(CACHE_DIR)) doomed.push_back(p);
+    }
+    dir.close();
   }
-  return bytes;
+  for (auto& p : doomed) CACHE_FS.remove(p);
+  CACHE_FS.remove(INDEX_PATH);
+  manifest.clear();
+  manifestBytes = 0;
 }
 
+// Mounted on first use (the worker's first cache lookup), not at boot.
+static void ensureFS() {
+  if (!fsReady) {
+    fsReady = CACHE_FS.begin(true);
+    if (g_dbg) Serial.printf("[INSIGNIA] %s %s\n", CACHE_FS_NAME, fsReady ? "mounted" : "MOUNT FAIL");
+    if (!fsReady) return;
+    CACHE_FS.mkdir(CACHE_DIR);
+    CACHE_FS.remove(String(CACHE_DIR) + "/.part");           // interrupted download
+    const String stamp = cacheStamp();
+    const bool sameBuild = !flushOnBoot && stampMatches(stamp);
+    if (!sameBuild || !manifestLoad()) {
+      // other firmware, forced flush, or no/unreadable manifest: start empty
+      wipeCacheFiles();
+      manifestSave();
+      File f = CACHE_FS.open(STAMP_PATH, FILE_WRITE);
+      if (f) { f.print(stamp); f.close(); }
+      if (g_dbg) Serial.println(flushOnBoot ? "[INSIGNIA] cache flushed on boot" : "[INSIGNIA] cache reset (new build or no manifest)");
+      flushOnBoot = false;
+    }
+  }
+}
+
+// Enforce the limits after a write. Count and size are running totals, so
+// the common case costs nothing; eviction (oldest stamp first) and the age
+// sweep only walk the RAM manifest.
 static void pruneCache() {
   ensureFS(); if (!fsReady) return;
-  std::vector<std::pair<String, time_t>> entries;
-  File root = SPIFFS.open("/");
-  for (File f = root.openNextFile(); f; f = root.openNextFile()) {
-    String p = f.path();
-    if (!p.startsWith(CACHE_DIR)) continue;
-    entries.emplace_back(p, f.getLastWrite());
-  }
-  time_t nowt = time(nullptr);
-  for (auto& e : entries) {
-    File f = SPIFFS.open(e.first);
-    if (!f) continue;
-    bool tooOld = (nowt>0 && e.second>0) && ((uint32_t)((nowt - e.second)*1000UL) > cacheMaxAgeMs);
-    f.close();
-    if (tooOld) SPIFFS.remove(e.first);
+  bool changed = false;
+  const time_t nowt = time(nullptr);
+  if (nowt > 0 && (!lastAgeSweep || millis() - lastAgeSweep >= AGE_SWEEP_MS)) {
+    lastAgeSweep = millis();
+    for (size_t i = 0; i < manifest.size(); ) {
+      const time_t st = manifest[i].stamp;
+      bool tooOld = st > 0 && (uint32_t)((nowt - st)*1000UL) > cacheMaxAgeMs;
+      if (tooOld) { cacheDrop(i); changed = true; } else ++i;
+    }
   }
-  size_t files=0, bytes = dirSize(CACHE_DIR, files);
-  if (files <= cacheMaxFiles && bytes <= cacheMaxBytes) return;
 
-  entries.clear();
-  root = SPIFFS.open("/");
-  for (File f = root.openNextFile(); f; f = root.openNextFile()) {
-    String p = f.path();
-    if (!p.startsWith(CACHE_DIR)) continue;
-    entries.emplace_back(p, f.getLastWrite());
+  while (!manifest.empty() && (manifest.size() > cacheMaxFiles || manifestBytes > cacheMaxBytes)) {
+    size_t oldest = 0;
+    for (size_t i = 1; i < manifest.size(); ++i) if (manifest[i].stamp < manifest[oldest].stamp) oldest = i;
+    cacheDrop(oldest);
+    changed = true;
   }
-  std::sort(entries.begin(), entries.end(),
-            [](auto& a, auto& b){ return a.second < b.second; });
+  if (changed) manifestSave();
+}
 
-  for (auto& e : entries) {
-    if (files <= cacheMaxFiles && bytes <= cacheMaxBytes) break;
-    File f = SPIFFS.open(e.first, FILE_READ);
-    size_t sz = f ? f.size() : 0;
-    if (f) f.close();
-    SPIFFS.remove(e.first);
-    if (files) files--;
-    if (bytes >= sz) bytes -= sz; else bytes = 0;
+// Open a cached body if it is younger than maxAgeMs (or at all, when stale
+// copies are acceptable). Bodies are parsed as streams, never loaded whole.
+static File cacheOpen(const String& url, uint32_t maxAgeMs, bool allowStaleIfNoNet) {
+  ensureFS(); if (!fsReady) return File();
+  const int mi = manifestFind(url);
+  if (mi < 0) return File();                  // miss: no flash access at all
+  File f = CACHE_FS.open(cachePath(manifest[mi].hash), FILE_READ);
+  if (!f) { cacheDrop(mi); manifestSave(); return File(); }
+  time_t mtime = manifest[mi].stamp;
+  time_t nowt = time(nullptr);
+  bool fresh = (mtime>0 && nowt>0 && (uint32_t)((nowt - mtime) * 1000UL) <= maxAgeMs);
+  if (fresh || allowStaleIfNoNet) {
+    manifest[mi].hits++;
+    manifestTouch();
+    return f;
   }
+  f.close();
+  return File();
 }
 
-static bool cacheWrite(const String& url, const String& body) {
-  ensureFS(); if (!fsReady) return false;
-  File f = SPIFFS.open(sanitizeKey(url), FILE_WRITE);
-  if (!f) return false;
-  size_t n = f.print(body);
+// Refresh the cache entry for url. With a cached copy and validators the
+// request is conditional; a 304 only renews the entry's stamp. A 200 streams straight
+// into the cache file (no String body), replacing the old copy only once the
+// new one arrived intact.
+static Fetch httpToCache(const String& url, uint32_t timeoutMs) {
+  ensureFS(); if (!fsReady) return Fetch::Failed;
+  CacheMeta old;
+  const int  mi = manifestFind(url);
+  if (mi >= 0) { old.etag = manifest[mi].etag; old.lastMod = manifest[mi].lastMod; }
+  const bool conditional = old.etag.length() || old.lastMod.length();
+
+  int code = httpStart(url, timeoutMs, conditional ? &old : nullptr);
+  if (code == 304 && conditional) {
+    netHttp.end();
+    manifest[mi].stamp = time(nullptr);
+    manifestTouch();
+    if (g_dbg) Serial.printf("[INSIGNIA] 304 %s\n", url.c_str());
+    return Fetch::NotModified;
+  }
+  if (code != 200) { netHttp.end(); return Fetch::Failed; }
+
+  CacheEntry e;
+  e.url     = url;
+  e.hash    = fnv1a(url);
+  e.etag    = netHttp.header("ETag");
+  e.lastMod = netHttp.header("Last-Modified");
+  e.hits    = mi >= 0 ? manifest[mi].hits : 0;
+
+  const String tmp  = String(CACHE_DIR) + "/.part";
+  File f = CACHE_FS.open(tmp, FILE_WRITE);
+  if (!f) { netHttp.end(); return Fetch::Failed; }
+  int n = netHttp.writeToStream(&f);  // de-chunks as it copies
   f.close();
+  netHttp.end();
+  if (n <= 0) { CACHE_FS.remove(tmp); return Fetch::Failed; }
+
+  // drop the old record, and any other url whose hash names the same file
+  for (size_t i = 0; i < manifest.size(); ) {
+    if (manifest[i].hash == e.hash) {
+      manifestBytes -= std::min(manifestBytes, manifest[i].bytes);
+      manifest[i] = std::move(manifest.back());
+      manifest.pop_back();
+    } else ++i;
+  }
+  const String path = cachePath(e.hash);
+  CACHE_FS.remove(path);
+  if (!CACHE_FS.rename(tmp, path)) { CACHE_FS.remove(tmp); manifestSave(); return Fetch::Failed; }
+  e.bytes = (uint32_t)n;
+  e.stamp = time(nullptr);
+  manifestBytes += e.bytes;
+  manifest.push_back(std::move(e));
+  manifestSave();
   pruneCache();
-  return n == (size_t)body.length();
-}
-
-static bool cacheRead(const String& url, String& out, uint32_t maxAgeMs, bool allowStaleIfNoNet) {
-  ensureFS(); if (!fsReady) return false;
-  String path = sanitizeKey(url);
-  File f = SPIFFS.open(path, FILE_READ);
-  if (!f) return false;
-  time_t mtime = f.getLastWrite();
-  out = f.readString(); f.close();
-  time_t nowt = time(nullptr);
-  bool fresh = (mtime>0 && nowt>0 && (uint32_t)((nowt - mtime) * 1000UL) <= maxAgeMs);
-  if (fresh) return true;
-  return allowStaleIfNoNet;
+  return Fetch::Updated;
 }
-#endif // SPIFFS
+#endif // flash cache
 
 // =================== HTTP ===================
 static bool httpGetTO(const String& url, String& out, uint32_t timeoutMs) {
-  WiFiClient client;
-  HTTPClient http;
-  http.setTimeout(timeoutMs);
-  if (!http.begin(client, url)) return false;
-  int code = http.GET();
-  if (code != 200) { http.end(); return false; }
-  out = http.getString();
-  http.end();
+  int code = httpStart(url, timeoutMs);
+  if (code != 200) { netHttp.end(); return false; }
+  out = netHttp.getString();
+  netHttp.end();
   return true;
 }
 static inline bool httpGet(const String& url, String& out) {
@@ -432,117 +743,234 @@ static void buildCandidateRoots(std::vector<String>& out) {
   }
 }
 
-static void startProbingIfNeeded() {
-  if (!probeList.empty() || WORK_ROOT.length()) return;
-  buildCandidateRoots(probeList);
-  probeIdx = 0;
-  nextProbeAt = 0;
-  if (g_dbg && !probeList.empty()) {
-    Serial.printf("[INSIGNIA] probe %u candidates\n", (unsigned)probeList.size());
-  }
+// Split "http://host[:port]/path" (the only scheme the cache fetches use).
+static bool splitHttpUrl(const String& url, String& host, uint16_t& port, String& path) {
+  if (!url.startsWith("http://")) return false;
+  int hs = 7;
+  int slash = url.indexOf('/', hs);
+  String hp = (slash < 0) ? url.substring(hs) : url.substring(hs, slash);
+  path = (slash < 0) ? String("/") : url.substring(slash);
+  int colon = hp.indexOf(':');
+  port = 80;
+  if (colon >= 0) { port = (uint16_t)hp.substring(colon + 1).toInt(); hp = hp.substring(0, colon); }
+  host = hp;
+  return host.length() > 0 && port != 0;
 }
 
-static bool stepProbeWorkRoot() {
-  if (WORK_ROOT.length()) return true;
-  if (!netReady()) return false;
-  if (probeList.empty()) startProbingIfNeeded();
-
-  const uint32_t now = millis();
-  if (now < nextProbeAt) return false;
-  nextProbeAt = now + PROBE_SPACING_MS;
+// Ask every candidate root for /data/search.json at once and return the first
+// one (in candidate order) that answers 200, or -1. A dead host costs one
+// PROBE_TIMEOUT_MS window in total instead of a timeout per candidate.
+#if defined(ARDUINO) || defined(ESP_PLATFORM)
+static int probeRoots(const std::vector<String>& roots) {
+  struct Probe {
+    int  fd = -1;
+    bool connected = false, done = false;
+    int  code = 0;
+    String req;
+    char head[16]; size_t got = 0;
+  };
+  std::vector<Probe> pr(roots.size());
+  std::vector<std::pair<String, IPAddress>> dns;     // one lookup per host
+
+  for (size_t i = 0; i < roots.size(); ++i) {
+    Probe& p = pr[i];
+    p.done = true;
+    String host, path; uint16_t port;
+    if (!splitHttpUrl(roots[i] + "/data/search.json", host, port, path)) continue;
+
+    IPAddress ip; bool have = false;
+    for (auto& d : dns) if (d.first == host) { ip = d.second; have = true; break; }
+    if (!have) {
+      if (!WiFi.hostByName(host.c_str(), ip)) ip = IPAddress((uint32_t)0);
+      dns.emplace_back(host, ip);
+    }
+    if ((uint32_t)ip == 0) continue;
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) continue;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(port);
+    sa.sin_addr.s_addr = (uint32_t)ip;
+    if (connect(fd, (sockaddr*)&sa, sizeof(sa)) < 0 && errno != EINPROGRESS) { close(fd); continue; }
+
+    p.fd = fd;
+    p.done = false;
+    p.req = "GET " + path + " HTTP/1.1\r\nHost: " + host + "\r\nConnection: close\r\n\r\n";
+  }
 
-  if (probeIdx >= probeList.size()) {
-    nextProbeAt = now + PROBE_BACKOFF_MS;
-    probeIdx = 0;
-    return false;
+  const uint32_t t0 = millis();
+  int winner = -1;
+  while (millis() - t0 < PROBE_TIMEOUT_MS) {
+    // earliest candidate decides: stop once it won or everything before a winner failed
+    winner = -1;
+    bool undecided = false;
+    for (size_t i = 0; i < pr.size(); ++i) {
+      if (!pr[i].done) { undecided = true; break; }
+      if (pr[i].code == 200) { winner = (int)i; break; }
+    }
+    if (winner >= 0 || !undecided) break;
+
+    fd_set rfds, wfds; FD_ZERO(&rfds); FD_ZERO(&wfds);
+    int maxfd = -1;
+    for (auto& p : pr) {
+      if (p.done) continue;
+      if (p.connected) FD_SET(p.fd, &rfds); else FD_SET(p.fd, &wfds);
+      if (p.fd > maxfd) maxfd = p.fd;
+    }
+    timeval tv = { 0, 50 * 1000 };
+    if (select(maxfd + 1, &rfds, &wfds, nullptr, &tv) <= 0) continue;
+
+    for (auto& p : pr) {
+      if (p.done) continue;
+      if (!p.connected && FD_ISSET(p.fd, &wfds)) {
+        int err = 0; socklen_t len = sizeof(err);
+        getsockopt(p.fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        if (err || send(p.fd, p.req.c_str(), p.req.length(), 0) != (int)p.req.length()) { p.done = true; continue; }
+        p.connected = true;
+      } else if (p.connected && FD_ISSET(p.fd, &rfds)) {
+        int n = recv(p.fd, p.head + p.got, sizeof(p.head) - 1 - p.got, 0);
+        if (n <= 0) { p.done = true; continue; }
+        p.got += n;
+        if (p.got >= 12) {                 // "HTTP/1.1 200"
+          p.head[p.got] = 0;
+          p.code = atoi(p.head + 9);
+          p.done = true;
+        }
+      }
+    }
+  }
+  for (auto& p : pr) if (p.fd >= 0) close(p.fd);
+  return winner;
+}
+#else
+static int probeRoots(const std::vector<String>& roots) {
+  for (size_t i = 0; i < roots.size(); ++i) {
+    String body;
+    if (httpGet(roots[i] + "/data/search.json", body)) return (int)i;
   }
+  return -1;
+}
+#endif
 
-  const String r = probeList[probeIdx++];
-  const String url = r + "/data/search.json";
-  String body;
+// Worker side of the root search: a cached search.json wins without network.
+static bool findWorkRoot(String& root) {
+  std::vector<String> roots;
+  buildCandidateRoots(roots);
+  if (roots.empty()) return false;
 
 #if defined(ARDUINO) || defined(ESP_PLATFORM)
-  if (cacheRead(url, body, TTL_SEARCH_MS, true)) {
-    DynamicJsonDocument tmp(512);
-    if (!deserializeJson(tmp, body)) {
-      WORK_ROOT = r;
-      if (g_dbg) Serial.printf("[INSIGNIA] WORK_ROOT via cache: %s\n", r.c_str());
-      return true;
-    }
+  for (auto& r : roots) {
+    File f = cacheOpen(r + "/data/search.json", TTL_SEARCH_MS, true);
+    if (!f) continue;
+    f.close();
+    root = r;
+    if (g_dbg) Serial.printf("[INSIGNIA] WORK_ROOT via cache: %s\n", r.c_str());
+    return true;
   }
 #endif
 
-  if (httpGet(url, body)) {
-    #if defined(ARDUINO) || defined(ESP_PLATFORM)
-      cacheWrite(url, body);
-    #endif
-    DynamicJsonDocument tmp(512);
-    if (!deserializeJson(tmp, body)) {
-      WORK_ROOT = r;
-      if (g_dbg) Serial.printf("[INSIGNIA] WORK_ROOT via net: %s\n", r.c_str());
-      return true;
-    }
+  if (g_dbg) Serial.printf("[INSIGNIA] probe %u candidates\n", (unsigned)roots.size());
+  int i = probeRoots(roots);
+  if (i < 0) return false;
+  root = roots[i];
+  if (g_dbg) Serial.printf("[INSIGNIA] WORK_ROOT via net: %s\n", root.c_str());
+  return true;
+}
+
+// ===== scoring helpers =====
+// The matcher works on MatchText: tokenize()'s tokens interned as fnv1a
+// hashes, their concatenation (normKey()) in a fixed buffer, and its
+// bigrams as an exact bitset over [a-z0-9]^2 (normKey() emits nothing else).
+// Scoring a candidate allocates nothing; scores equal the String versions.
+static const uint8_t  MT_MAX_TOKS = 24;
+static const size_t   MT_NORM_MAX = 127;        // longer norms are cut (no real title is)
+static const uint16_t BG_BITS     = 36 * 36;
+static const uint8_t  BG_WORDS    = (BG_BITS + 31) / 32;
+
+struct MatchText {
+  char     norm[MT_NORM_MAX + 1];
+  uint8_t  normLen;
+  uint8_t  nTok;
+  uint32_t tok[MT_MAX_TOKS];                    // fnv1a of each token, as tokenize() spells it
+  uint32_t bg[BG_WORDS];
+  uint16_t nBg;                                 // distinct bigrams
+};
+
+static inline uint8_t bgIndex(char c) { return c <= '9' ? (uint8_t)(c - '0') : (uint8_t)(c - 'a' + 10); }
+
+// One normaliser for both: the tokens and the norm come from tokenize().
+static void prepText(const String& raw, MatchText& t) {
+  t.normLen = 0; t.nTok = 0; t.nBg = 0;
+  memset(t.bg, 0, sizeof(t.bg));
+
+  for (const String& tok : tokenize(raw)) {
+    if (t.nTok < MT_MAX_TOKS) t.tok[t.nTok++] = fnv1a(tok.c_str(), tok.length());
+    const size_t room = MT_NORM_MAX - t.normLen;
+    const size_t k = tok.length() < room ? tok.length() : room;
+    memcpy(t.norm + t.normLen, tok.c_str(), k);
+    t.normLen = (uint8_t)(t.normLen + k);
   }
+  t.norm[t.normLen] = 0;
+
+  for (uint8_t k = 1; k < t.normLen; ++k) {
+    const uint16_t b = (uint16_t)(bgIndex(t.norm[k-1]) * 36 + bgIndex(t.norm[k]));
+    const uint32_t bit = 1u << (b & 31);
+    if (!(t.bg[b >> 5] & bit)) { t.bg[b >> 5] |= bit; t.nBg++; }
+  }
+}
+
+static bool hasToken(const MatchText& t, uint32_t h) {
+  for (uint8_t k = 0; k < t.nTok; ++k) if (t.tok[k] == h) return true;
   return false;
 }
 
-// ===== scoring helpers =====
-static int tokenOverlapScore(const std::vector<String>& qtoks, const std::vector<String>& ctoks) {
-  if (qtoks.empty() || ctoks.empty()) return 0;
+static int tokenOverlapScore(const MatchText& q, const MatchText& c) {
+  if (!q.nTok || !c.nTok) return 0;
   int matches = 0;
-  for (auto& q : qtoks) {
-    for (auto& c : ctoks) {
-      if (q == c) { matches++; break; }
-    }
-  }
+  for (uint8_t k = 0; k < q.nTok; ++k) if (hasToken(c, q.tok[k])) matches++;
   int s = matches * 12; if (s > 60) s = 60;
   return s;
 }
-static int firstTokenBoost(const std::vector<String>& qtoks, const std::vector<String>& ctoks) {
-  if (qtoks.empty() || ctoks.empty()) return 0;
-  return (qtoks.front() == ctoks.front()) ? 25 : 0;
+static int firstTokenBoost(const MatchText& q, const MatchText& c) {
+  if (!q.nTok || !c.nTok) return 0;
+  return (q.tok[0] == c.tok[0]) ? 25 : 0;
 }
-static bool isGenericXLA(const std::vector<String>& ctoks) {
-  const char* G[] = {"xbox","live","arcade", nullptr};
-  if (ctoks.empty()) return false;
-  for (auto& t : ctoks) {
-    bool ok=false; for (int i=0; G[i]; ++i) if (t==G[i]) { ok=true; break; }
-    if (!ok) return false;
-  }
+static uint32_t tokHash(const char* w) { return fnv1a(w, strlen(w)); }
+static bool isGenericXLA(const MatchText& c) {
+  static const uint32_t G[] = { tokHash("xbox"), tokHash("live"), tokHash("arcade") };
+  if (!c.nTok) return false;
+  for (uint8_t k = 0; k < c.nTok; ++k)
+    if (c.tok[k] != G[0] && c.tok[k] != G[1] && c.tok[k] != G[2]) return false;
   return true;
 }
-static int tokenJaccardPenaltyShort(const String& candNorm) {
-  if ((int)candNorm.length() <= 6) return -20;
+static int tokenJaccardPenaltyShort(const MatchText& cand) {
+  if ((int)cand.normLen <= 6) return -20;
   return 0;
 }
-static int bigramJaccardScore(const String& a, const String& b) {
-  if (!a.length() || !b.length()) return 0;
-  auto grams = [](const String& s)->std::vector<String>{
-    std::vector<String> g; g.reserve(s.length());
-    for (size_t i=1;i<s.length();++i) g.emplace_back(s.substring(i-1,i+1));
-    std::sort(g.begin(), g.end()); g.erase(std::unique(g.begin(), g.end()), g.end());
-    return g;
-  };
-  auto A = grams(a), B = grams(b);
-  size_t i=0,j=0, inter=0;
-  while (i<A.size() && j<B.size()) {
-    if (A[i]==B[j]) { inter++; i++; j++; }
-    else if (A[i]<B[j]) i++; else j++;
-  }
-  size_t uni = A.size() + B.size() - inter;
+static int bigramJaccardScore(const MatchText& a, const MatchText& b) {
+  if (!a.normLen || !b.normLen) return 0;
+  uint32_t inter = 0;
+  for (uint8_t k = 0; k < BG_WORDS; ++k) inter += __builtin_popcount(a.bg[k] & b.bg[k]);
+  const uint32_t uni = a.nBg + b.nBg - inter;
   if (uni==0) return 0;
   float jacc = (float)inter / (float)uni;
   int score = (int)(jacc * 70.0f);
   if (score<0) score=0; if (score>70) score=70;
   return score;
 }
-static int containsBonus(const String& small, const String& big) {
-  if (!small.length() || !big.length()) return 0;
-  if (big.indexOf(small) >= 0) {
+// String::indexOf semantics: an empty needle is found anywhere.
+static inline bool normContains(const MatchText& big, const MatchText& small) {
+  return strstr(big.norm, small.norm) != nullptr;
+}
+static int containsBonus(const MatchText& small, const MatchText& big) {
+  if (!small.normLen || !big.normLen) return 0;
+  if (normContains(big, small)) {
     int bonus = 15;
-    if ((int)small.length() >= 5) bonus = 18;
-    if ((int)small.length() >= 8) bonus = 22;
-    if ((int)small.length() >= 12) bonus = 25;
+    if ((int)small.normLen >= 5) bonus = 18;
+    if ((int)small.normLen >= 8) bonus = 22;
+    if ((int)small.normLen >= 12) bonus = 25;
     return bonus;
   }
   return 0;
@@ -573,382 +1001,1100 @@ static inline bool extract_str_field(const String& obj, const char* key, String&
   return true;
 }
 
-// =================== Resolve by App → build title pool ===================
-static bool resolveTitlePool() {
-  if (!netReady() && WORK_ROOT.length()==0) return false;
-  if (WORK_ROOT.length()==0) return false;
+// One search.json title as the matcher sees it.
+struct SearchEntry { String id, name, nlc, slug, fam; };
 
-  if (!curApp.length()) return false;                 // guard: need a query
-  lastQueryRaw  = curApp;
-  lastQueryNorm = normKey(curApp);
-  if (!lastQueryNorm.length()) return false;          // guard: normalized empty
+static String familyOf(const String& name, const String& slug) {
+  String fam = familyKeyFromLabel(name);
+  if (!fam.length()) fam = familyKeyFromSlug(slug);
+  return fam;
+}
 
-  String url = WORK_ROOT + "/data/search.json";
-  String body;
-#if defined(ARDUINO) || defined(ESP_PLATFORM)
-  if (!cacheRead(url, body, TTL_SEARCH_MS, false)) {
-    if (httpGet(url, body)) cacheWrite(url, body);
-    else if (!cacheRead(url, body, 0, true)) return false;
+// Walk a search.json stream one flat {...} object at a time; fn(entry) is
+// called for every object carrying a title_id.
+template <typename Fn>
+static void forEachSearchEntry(Stream& s, Fn fn) {
+  String obj; obj.reserve(256);
+  bool inObj = false, inStr = false, esc = false;
+  int c;
+  while ((c = s.read()) >= 0) {
+    if (inStr) {
+      obj += (char)c;
+      if (esc) esc = false;
+      else if (c == '\\') esc = true;
+      else if (c == '"') inStr = false;
+      continue;
+    }
+    if (c == '{') { inObj = true; obj = "{"; continue; }
+    if (!inObj) continue;
+    obj += (char)c;
+    if (c == '"') { inStr = true; continue; }
+    if (c == '}') {
+      inObj = false;
+      SearchEntry e;
+      if (!extract_str_field(obj, "title_id", e.id)) continue;
+      extract_str_field(obj, "name", e.name);
+      extract_str_field(obj, "name_lc", e.nlc);
+      extract_str_field(obj, "slug", e.slug);
+      e.fam = familyOf(e.name, e.slug);
+      fn(e);
+    } else if (obj.length() > 2048) {
+      inObj = false;                      // not a title record
+    }
   }
-#else
-  if (!httpGet(url, body)) return false;
-#endif
+}
 
-  auto qToks = tokenize(curApp);
-
-  // ------- pass 1: find best candidate with strict overlap gate -------
-  struct Best { String id,name,nlc,slug,fam; int score=0; String reason; };
-  Best best;
-
-  struct DItem { String id,name,slug; int score; String reason; };
-  DItem diags[10]; int diagN=0;
-
-  int idx = body.indexOf('{');
-  while (idx >= 0) {
-    int end = body.indexOf('}', idx);
-    if (end < 0) break;
-    String obj = body.substring(idx, end+1);
-
-    String id, name, nlc, slug;
-    if (!extract_str_field(obj, "title_id", id)) { idx = body.indexOf('{', end+1); continue; }
-    extract_str_field(obj, "name", name);
-    extract_str_field(obj, "name_lc", nlc);
-    extract_str_field(obj, "slug", slug);
-
-    String nName = normKey(name);
-    String nSlug = normKey(slug);
-    auto   tName = tokenize(name);
-    auto   tSlug = tokenize(slug);
-
-    int score = 0; String reason;
-
-    // Strong exacts
-    if (lc(name) == lc(curApp)) { score = 100; reason = "exact name"; }
-    else if (nlc.length() && nlc == lc(curApp)) { score = 98; reason = "exact name_lc"; }
-    else if (lc(slug) == lc(curApp)) { score = 95; reason = "exact slug"; }
-    else if (nName == lastQueryNorm) { score = 93; reason = "norm(name)"; }
-    else if (nSlug == lastQueryNorm) { score = 91; reason = "norm(slug)"; }
-    else {
-      int stName = tokenOverlapScore(qToks, tName) + firstTokenBoost(qToks, tName);
-      int stSlug = tokenOverlapScore(qToks, tSlug) + firstTokenBoost(qToks, tSlug);
-      int sb1 = bigramJaccardScore(lastQueryNorm, nName);
-      int sb2 = bigramJaccardScore(lastQueryNorm, nSlug);
-      int sc1 = containsBonus(lastQueryNorm, nName);
-      int sc2 = containsBonus(lastQueryNorm, nSlug);
-      int sc3 = containsBonus(nName, lastQueryNorm);
-      int sc4 = containsBonus(nSlug, lastQueryNorm);
-      score = std::max(std::max(stName, stSlug),
-                       std::max(std::max(sb1, sb2),
-                                std::max(std::max(sc1, sc2), std::max(sc3, sc4))));
-
-      // Penalize ultra-short candidate when head-token not aligned
-      if (firstTokenBoost(qToks, tName) == 0 && firstTokenBoost(qToks, tSlug) == 0) {
-        score += tokenJaccardPenaltyShort(nName);
-      }
-      // De-prefer generic "Xbox Live Arcade" etc unless user typed "xbox"
-      if (isGenericXLA(tName)) {
-        if (qToks.empty() || qToks.front() != "xbox") score -= 35;
+// Read-only Stream over a String body (no-filesystem fallback). StreamString
+// erases from the front on every read(), which is quadratic on large bodies.
+class StrStream : public Stream {
+ public:
+  explicit StrStream(const String& s) : s_(s) {}
+  int    available() override { return (int)(s_.length() - pos_); }
+  int    read() override { return pos_ < s_.length() ? (uint8_t)s_[pos_++] : -1; }
+  int    peek() override { return pos_ < s_.length() ? (uint8_t)s_[pos_] : -1; }
+  size_t write(uint8_t) override { return 0; }
+  void   rewind() { pos_ = 0; }
+ private:
+  const String& s_;
+  size_t pos_ = 0;
+};
+
+static uint32_t fnv1a(const char* s, size_t n) {
+  uint32_t h = 2166136261u;
+  for (size_t i=0;i<n;++i) { h ^= (uint8_t)s[i]; h *= 16777619u; }
+  return h;
+}
+static uint32_t fnv1a(const String& s) { return fnv1a(s.c_str(), s.length()); }
+// 64-bit set of hashed bigrams. If a is a substring of b, every bit of
+// sig(a) is also set in sig(b); the converse only says "maybe".
+static uint64_t bigramSig(const MatchText& t) {
+  uint64_t sig = 0;
+  for (size_t i=1;i<t.normLen;++i) {
+    uint32_t h = (uint8_t)t.norm[i-1] * 31u + (uint8_t)t.norm[i];
+    sig |= 1ULL << (h & 63);
+  }
+  return sig;
+}
+static inline bool sigWithin(uint64_t a, uint64_t b) { return (a & ~b) == 0; }
+
+// =================== Title index (ESP only) ===================
+// search.json is compiled once per download into a binary file:
+//   header | strings | records[count] | postings[npost]
+// strings:  id\0 name\0 name_lc\0 slug\0 fam\0 per title
+// records:  string offset, family hash, bigram signatures of norm(name/slug)
+// postings: (token hash, title) sorted by hash — the inverted token table
+// A lookup binary-searches the postings for the query tokens and scans the
+// packed signatures for containment matches; only those titles get scored.
+// Anything else would fail the overlap gate in scoreEntry() anyway.
+#if defined(ARDUINO) || defined(ESP_PLATFORM)
+static const uint32_t INDEX_MAGIC   = 0x58494454;   // "TDIX"
+static const uint16_t INDEX_VERSION = 1;
+
+struct IdxHeader {
+  uint32_t magic;
+  uint16_t version, _rsv;
+  uint32_t srcSize, srcTime;              // identifies the search.json it was built from
+  uint32_t count, npost;
+  uint32_t recOff, postOff;
+};
+struct IdxRec  { uint32_t strOff, famHash; uint64_t sigName, sigSlug; };
+struct IdxPost { uint32_t tok, title; };
+
+static File      idxFile;
+static IdxHeader idxHdr;
+
+static void invalidateTitleIndex() {
+  if (idxFile) idxFile.close();
+  ensureFS(); if (fsReady) CACHE_FS.remove(INDEX_PATH);
+}
+
+static bool buildTitleIndex(File& src) {
+  const uint32_t t0 = millis();
+  if (idxFile) idxFile.close();
+  File out = CACHE_FS.open(INDEX_TMP, FILE_WRITE);
+  if (!out) return false;
+
+  IdxHeader h = {};
+  out.write((const uint8_t*)&h, sizeof(h));        // patched at the end
+  uint32_t off = sizeof(h);
+
+  std::vector<IdxRec>  recs;
+  std::vector<IdxPost> posts;
+  std::vector<uint32_t> toks;
+  MatchText tn, ts;
+  src.seek(0);
+  forEachSearchEntry(src, [&](const SearchEntry& e) {
+    prepText(e.name, tn);
+    prepText(e.slug, ts);
+    IdxRec r;
+    r.strOff  = off;
+    r.famHash = fnv1a(e.fam);
+    r.sigName = bigramSig(tn);
+    r.sigSlug = bigramSig(ts);
+    const String* parts[] = { &e.id, &e.name, &e.nlc, &e.slug, &e.fam };
+    for (const String* p : parts) {
+      out.write((const uint8_t*)p->c_str(), p->length() + 1);
+      off += p->length() + 1;
+    }
+    const uint32_t ti = (uint32_t)recs.size();
+    recs.push_back(r);
+
+    toks.clear();
+    for (const MatchText* t : { &tn, &ts }) {
+      for (uint8_t k = 0; k < t->nTok; ++k) {
+        const uint32_t th = t->tok[k];
+        if (std::find(toks.begin(), toks.end(), th) != toks.end()) continue;
+        toks.push_back(th);
+        posts.push_back(IdxPost{th, ti});
       }
-      if (score < 0) score = 0;
     }
+  });
+
+  std::sort(posts.begin(), posts.end(), [](const IdxPost& a, const IdxPost& b) {
+    return a.tok != b.tok ? a.tok < b.tok : a.title < b.title;
+  });
+
+  h.magic   = INDEX_MAGIC;
+  h.version = INDEX_VERSION;
+  h.srcSize = (uint32_t)src.size();
+  h.srcTime = (uint32_t)src.getLastWrite();
+  h.count   = (uint32_t)recs.size();
+  h.npost   = (uint32_t)posts.size();
+  h.recOff  = off;
+  h.postOff = off + h.count * sizeof(IdxRec);
+  bool ok = true;
+  if (!recs.empty())  ok &= out.write((const uint8_t*)recs.data(),  recs.size()  * sizeof(IdxRec))  == recs.size()  * sizeof(IdxRec);
+  if (!posts.empty()) ok &= out.write((const uint8_t*)posts.data(), posts.size() * sizeof(IdxPost)) == posts.size() * sizeof(IdxPost);
+  ok &= out.seek(0);
+  ok &= out.write((const uint8_t*)&h, sizeof(h)) == sizeof(h);
+  out.close();
+
+  if (!ok || h.count == 0) { CACHE_FS.remove(INDEX_TMP); return false; }
+  CACHE_FS.remove(INDEX_PATH);
+  if (!CACHE_FS.rename(INDEX_TMP, INDEX_PATH)) { CACHE_FS.remove(INDEX_TMP); return false; }
+  if (g_dbg) Serial.printf("[INSIGNIA] title index: %u titles, %u tokens, %u ms\n",
+                           (unsigned)h.count, (unsigned)h.npost, (unsigned)(millis() - t0));
+  return true;
+}
 
-    // ---- HARD GATE: require some *semantic* overlap, not just bigrams ----
-    bool tokenOverlap = false;
-    if (!qToks.empty()) {
-      for (auto& q : qToks) {
-        for (auto& c : tName) if (q==c) { tokenOverlap=true; break; }
-        if (tokenOverlap) break;
-        for (auto& c : tSlug) if (q==c) { tokenOverlap=true; break; }
-        if (tokenOverlap) break;
-      }
+// Opens the index for 'src', compiling it first if missing or stale.
+static bool titleIndexReady(File& src) {
+  auto matches = [&]() {
+    return idxFile && idxHdr.magic == INDEX_MAGIC && idxHdr.version == INDEX_VERSION &&
+           idxHdr.srcSize == (uint32_t)src.size() && idxHdr.srcTime == (uint32_t)src.getLastWrite();
+  };
+  auto openIdx = [&]() {
+    if (idxFile) idxFile.close();
+    idxFile = CACHE_FS.open(INDEX_PATH, FILE_READ);
+    if (!idxFile || idxFile.read((uint8_t*)&idxHdr, sizeof(idxHdr)) != sizeof(idxHdr)) {
+      if (idxFile) idxFile.close();
+      idxHdr = IdxHeader{};
     }
-    bool containsEither =
-      (nName.indexOf(lastQueryNorm)>=0) || (nSlug.indexOf(lastQueryNorm)>=0) ||
-      (lastQueryNorm.indexOf(nName)>=0) || (lastQueryNorm.indexOf(nSlug)>=0);
-
-    if (!(tokenOverlap || containsEither)) {
-      // If there is no exact token overlap and neither side contains the other,
-      // we treat it as unrelated (prevents XBMC4Gamers → Pirates, etc.)
-      score = 0;
-      reason = "";
+  };
+  if (matches()) return true;
+  openIdx();
+  if (matches()) return true;
+  if (!buildTitleIndex(src)) return false;
+  openIdx();
+  return matches();
+}
+
+static bool titleIndexRec(uint32_t i, IdxRec& r) {
+  return i < idxHdr.count &&
+         idxFile.seek(idxHdr.recOff + i * sizeof(IdxRec)) &&
+         idxFile.read((uint8_t*)&r, sizeof(r)) == sizeof(r);
+}
+
+static bool titleIndexEntry(uint32_t i, SearchEntry& e) {
+  IdxRec r;
+  if (!titleIndexRec(i, r) || !idxFile.seek(r.strOff)) return false;
+  e.id   = idxFile.readStringUntil('\0');
+  e.name = idxFile.readStringUntil('\0');
+  e.nlc  = idxFile.readStringUntil('\0');
+  e.slug = idxFile.readStringUntil('\0');
+  e.fam  = idxFile.readStringUntil('\0');
+  return e.id.length() > 0;
+}
+
+// Titles sharing a token with the query, or whose norm(name/slug) may contain
+// or be contained in the query's; ascending (file) order.
+static void titleIndexCandidates(const MatchText& q, std::vector<uint32_t>& out) {
+  out.clear();
+  for (uint8_t qi = 0; qi < q.nTok; ++qi) {
+    const uint32_t th = q.tok[qi];
+    uint32_t lo = 0, hi = idxHdr.npost;            // lower_bound on tok
+    IdxPost p;
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2;
+      idxFile.seek(idxHdr.postOff + mid * sizeof(IdxPost));
+      if (idxFile.read((uint8_t*)&p, sizeof(p)) != sizeof(p)) return;
+      if (p.tok < th) lo = mid + 1; else hi = mid;
     }
+    idxFile.seek(idxHdr.postOff + lo * sizeof(IdxPost));
+    for (uint32_t k = lo; k < idxHdr.npost; ++k) {
+      if (idxFile.read((uint8_t*)&p, sizeof(p)) != sizeof(p) || p.tok != th) break;
+      out.push_back(p.title);
+    }
+  }
 
-    // record diagnostics (bounded)
-    if (score > 0 && diagN < 10) {
-      diags[diagN++] = DItem{id,name,slug,score,reason};
+  const uint64_t qs = bigramSig(q);
+  IdxRec buf[32];
+  idxFile.seek(idxHdr.recOff);
+  for (uint32_t i = 0; i < idxHdr.count; ) {
+    const uint32_t n = std::min<uint32_t>(32, idxHdr.count - i);
+    if (idxFile.read((uint8_t*)buf, n * sizeof(IdxRec)) != n * sizeof(IdxRec)) break;
+    for (uint32_t k = 0; k < n; ++k) {
+      const IdxRec& r = buf[k];
+      if (sigWithin(qs, r.sigName) || sigWithin(r.sigName, qs) ||
+          sigWithin(qs, r.sigSlug) || sigWithin(r.sigSlug, qs)) out.push_back(i + k);
     }
+    i += n;
+  }
 
-    // choose best (tie-breakers)
-    auto better = [&](const Best& A, int sc, const String& nNm, const std::vector<String>& tNm)->bool{
-      if (sc > A.score) return true;
-      if (sc < A.score) return false;
-      int da = abs((int)nNm.length() - (int)lastQueryNorm.length());
-      int db = abs((int)normKey(A.name).length() - (int)lastQueryNorm.length());
-      if (da != db) return da < db;
-      auto qT = tokenize(lastQueryRaw);
-      bool af = (!qT.empty() && !tNm.empty() && qT.front()==tNm.front());
-      bool bf = (!qT.empty() && !tokenize(A.name).empty() && qT.front()==tokenize(A.name).front());
-      if (af != bf) return af;
-      return name.length() < A.name.length();
-    };
+  std::sort(out.begin(), out.end());
+  out.erase(std::unique(out.begin(), out.end()), out.end());
+}
 
-    if (score >= MIN_ACCEPT_SCORE && (best.id.length()==0 || better(best, score, nName, tName))) {
-      best.id=id; best.name=name; best.nlc=nlc; best.slug=slug; best.score=score; best.reason=reason;
-      String fam = familyKeyFromLabel(name);
-      if (!fam.length()) fam = familyKeyFromSlug(slug);
-      best.fam = fam;
+// Every title id of family 'fam', in file order.
+static void titleIndexFamily(const String& fam, std::vector<String>& ids) {
+  const uint32_t fh = fnv1a(fam);
+  std::vector<uint32_t> hits;
+  IdxRec buf[32];
+  idxFile.seek(idxHdr.recOff);
+  for (uint32_t i = 0; i < idxHdr.count; ) {
+    const uint32_t n = std::min<uint32_t>(32, idxHdr.count - i);
+    if (idxFile.read((uint8_t*)buf, n * sizeof(IdxRec)) != n * sizeof(IdxRec)) break;
+    for (uint32_t k = 0; k < n; ++k) if (buf[k].famHash == fh) hits.push_back(i + k);
+    i += n;
+  }
+  for (uint32_t i : hits) {
+    SearchEntry e;
+    if (!titleIndexEntry(i, e) || e.fam != fam) continue;   // hash collision
+    if (std::find(ids.begin(), ids.end(), e.id) == ids.end()) ids.push_back(e.id);
+  }
+}
+#endif // title index
+
+// =================== Resolve by App → build title pool ===================
+struct MatchBest {
+  String id,name,nlc,slug,fam; int score=0; String reason;
+  uint8_t  normLen=0;                           // tie-breaker inputs, kept from its MatchText
+  bool     hasTok=false; uint32_t firstTok=0;
+};
+struct MatchDItem { String id,name,slug; int score; String reason; };
+struct MatchState {
+  String app, appLc;
+  MatchText q;
+  MatchText tName, tSlug;                       // scratch, reused for every entry
+  MatchBest best;
+  MatchDItem diags[10]; int diagN = 0;
+};
+
+// Score one title against the current query and keep the best one.
+static void scoreEntry(MatchState& m, const SearchEntry& e) {
+  const MatchText& q = m.q;
+  MatchBest& best = m.best;
+  const String& id = e.id; const String& name = e.name;
+  const String& nlc = e.nlc; const String& slug = e.slug;
+
+  MatchText& tName = m.tName;
+  MatchText& tSlug = m.tSlug;
+  prepText(name, tName);
+  prepText(slug, tSlug);
+
+  int score = 0; const char* reason = "";
+
+  // Strong exacts
+  if (name.equalsIgnoreCase(m.app)) { score = 100; reason = "exact name"; }
+  else if (nlc.length() && nlc == m.appLc) { score = 98; reason = "exact name_lc"; }
+  else if (slug.equalsIgnoreCase(m.app)) { score = 95; reason = "exact slug"; }
+  else if (!strcmp(tName.norm, q.norm)) { score = 93; reason = "norm(name)"; }
+  else if (!strcmp(tSlug.norm, q.norm)) { score = 91; reason = "norm(slug)"; }
+  else {
+    int stName = tokenOverlapScore(q, tName) + firstTokenBoost(q, tName);
+    int stSlug = tokenOverlapScore(q, tSlug) + firstTokenBoost(q, tSlug);
+    int sb1 = bigramJaccardScore(q, tName);
+    int sb2 = bigramJaccardScore(q, tSlug);
+    int sc1 = containsBonus(q, tName);
+    int sc2 = containsBonus(q, tSlug);
+    int sc3 = containsBonus(tName, q);
+    int sc4 = containsBonus(tSlug, q);
+    score = std::max(std::max(stName, stSlug),
+                     std::max(std::max(sb1, sb2),
+                              std::max(std::max(sc1, sc2), std::max(sc3, sc4))));
+
+    // Penalize ultra-short candidate when head-token not aligned
+    if (firstTokenBoost(q, tName) == 0 && firstTokenBoost(q, tSlug) == 0) {
+      score += tokenJaccardPenaltyShort(tName);
+    }
+    // De-prefer generic "Xbox Live Arcade" etc unless user typed "xbox"
+    if (isGenericXLA(tName)) {
+      static const uint32_t XBOX = tokHash("xbox");
+      if (!q.nTok || q.tok[0] != XBOX) score -= 35;
     }
+    if (score < 0) score = 0;
+  }
 
-    idx = body.indexOf('{', end+1);
+  // ---- HARD GATE: require some *semantic* overlap, not just bigrams ----
+  bool tokenOverlap = false;
+  for (uint8_t k = 0; k < q.nTok && !tokenOverlap; ++k)
+    tokenOverlap = hasToken(tName, q.tok[k]) || hasToken(tSlug, q.tok[k]);
+  bool containsEither =
+    normContains(tName, q) || normContains(tSlug, q) ||
+    normContains(q, tName) || normContains(q, tSlug);
+
+  if (!(tokenOverlap || containsEither)) {
+    // If there is no exact token overlap and neither side contains the other,
+    // we treat it as unrelated (prevents XBMC4Gamers → Pirates, etc.)
+    score = 0;
+    reason = "";
   }
 
-  if (best.id.length()==0 || best.score < MIN_ACCEPT_SCORE) {
-    if (g_dbg) {
-      Serial.printf("[INSIGNIA] No acceptable match for app='%s' norm='%s' (root=%s)\n",
-                    curApp.c_str(), lastQueryNorm.c_str(), WORK_ROOT.c_str());
-      for (int i=0;i<diagN;i++) {
-        Serial.printf("  • %-3d  %s  (slug=%s, id=%s)  [%s]\n",
-                      diags[i].score, diags[i].name.c_str(), diags[i].slug.c_str(), diags[i].id.c_str(), diags[i].reason.c_str());
-      }
-    }
-    return false;
+  // record diagnostics (bounded)
+  if (score > 0 && m.diagN < 10) {
+    m.diags[m.diagN++] = MatchDItem{id,name,slug,score,reason};
   }
 
-  // ------- pass 2: collect family mates -------
-  titlePool.clear();
-  {
-    int idx2 = body.indexOf('{');
-    while (idx2 >= 0) {
-      int end = body.indexOf('}', idx2);
-      if (end < 0) break;
-      String obj = body.substring(idx2, end+1);
-
-      String id, name, slug;
-      if (!extract_str_field(obj, "title_id", id)) { idx2 = body.indexOf('{', end+1); continue; }
-      extract_str_field(obj, "name", name);
-      extract_str_field(obj, "slug", slug);
-
-      String fam = familyKeyFromLabel(name);
-      if (!fam.length()) fam = familyKeyFromSlug(slug);
-
-      if (fam == best.fam && id.length()) {
-        if (std::find(titlePool.begin(), titlePool.end(), id) == titlePool.end()) {
-          titlePool.push_back(id);
-        }
-      }
+  // choose best (tie-breakers)
+  auto better = [&](const MatchBest& A, int sc, const MatchText& tNm)->bool{
+    if (sc > A.score) return true;
+    if (sc < A.score) return false;
+    int da = abs((int)tNm.normLen - (int)q.normLen);
+    int db = abs((int)A.normLen - (int)q.normLen);
+    if (da != db) return da < db;
+    bool af = (q.nTok && tNm.nTok && q.tok[0]==tNm.tok[0]);
+    bool bf = (q.nTok && A.hasTok && q.tok[0]==A.firstTok);
+    if (af != bf) return af;
+    return name.length() < A.name.length();
+  };
 
-      idx2 = body.indexOf('{', end+1);
-    }
+  if (score >= MIN_ACCEPT_SCORE && (best.id.length()==0 || better(best, score, tName))) {
+    best.id=id; best.name=name; best.nlc=nlc; best.slug=slug; best.score=score; best.reason=reason;
+    best.fam = e.fam;
+    best.normLen = tName.normLen;
+    best.hasTok = tName.nTok > 0;
+    best.firstTok = best.hasTok ? tName.tok[0] : 0;
   }
+}
+
+// Unindexed path: score every title in the stream.
+static void scanSearch(Stream& s, MatchState& m) {
+  forEachSearchEntry(s, [&](const SearchEntry& e) { scoreEntry(m, e); });
+}
+static void collectFamily(Stream& s, const MatchBest& best, std::vector<String>& pool) {
+  if (!best.id.length() || best.score < MIN_ACCEPT_SCORE) return;
+  forEachSearchEntry(s, [&](const SearchEntry& e) {
+    if (e.fam == best.fam && e.id.length() &&
+        std::find(pool.begin(), pool.end(), e.id) == pool.end()) pool.push_back(e.id);
+  });
+}
 
-  if (titlePool.empty()) titlePool.push_back(best.id);
+// Runs on the worker: match 'app' against root's search.json and collect the
+// family's title ids. Touches no UI state.
+static bool resolveTitlePool(const String& root, const String& app, ResolveOut& out) {
+  if (root.length()==0) return false;
 
-#if defined(ESP_PLATFORM)
-  curTitleIdx = (int)(esp_random() % titlePool.size());
-#else
-  curTitleIdx = (int)(rand() % titlePool.size());
+  if (!app.length()) return false;                    // guard: need a query
+  MatchState m;
+  m.app   = app;
+  m.appLc = lc(app);
+  prepText(app, m.q);
+  if (!m.q.normLen) return false;                     // guard: normalized empty
+  out.norm = m.q.norm;
+
+  const uint32_t t0 = millis();
+  String url = root + "/data/search.json";
+  std::vector<String>& pool = out.pool;
+
+  bool scanned = false;
+#if defined(ARDUINO) || defined(ESP_PLATFORM)
+  File src = cacheOpen(url, TTL_SEARCH_MS, false);
+  if (!src) {
+    if (httpToCache(url, HTTP_TIMEOUT_MS) == Fetch::Updated) invalidateTitleIndex();
+    src = cacheOpen(url, 0, true);
+  }
+  if (src && titleIndexReady(src)) {
+    // ------- pass 1: score titles that can pass the overlap gate -------
+    std::vector<uint32_t> cand;
+    titleIndexCandidates(m.q, cand);
+    for (uint32_t i : cand) {
+      SearchEntry e;
+      if (titleIndexEntry(i, e)) scoreEntry(m, e);
+    }
+    // ------- pass 2: collect family mates -------
+    if (m.best.id.length() && m.best.score >= MIN_ACCEPT_SCORE) titleIndexFamily(m.best.fam, pool);
+    if (g_dbg) Serial.printf("[INSIGNIA] index lookup: %d candidates, %u ms\n",
+                             (int)cand.size(), (unsigned)(millis() - t0));
+    scanned = true;
+  } else if (src) {
+    // index could not be written (flash full?): scan the cached copy
+    src.seek(0);
+    scanSearch(src, m);
+    src.seek(0);
+    collectFamily(src, m.best, pool);
+    scanned = true;
+  }
+  if (src) src.close();
 #endif
+  if (!scanned) {
+    String body;
+    if (!httpGet(url, body)) return false;
+    StrStream ss(body);
+    scanSearch(ss, m);
+    ss.rewind();
+    collectFamily(ss, m.best, pool);
+  }
 
-  haveSearch = true;
-  resolved   = true;
+  const MatchBest& best = m.best;
+  for (int i=0;i<m.diagN;i++) {
+    MatchDiag d; d.id=m.diags[i].id; d.name=m.diags[i].name; d.slug=m.diags[i].slug; d.score=m.diags[i].score; d.reason=m.diags[i].reason;
+    out.diag.push_back(std::move(d));
+  }
 
-  lastDiag.clear();
-  for (int i=0;i<diagN;i++) {
-    MatchDiag d; d.id=diags[i].id; d.name=diags[i].name; d.slug=diags[i].slug; d.score=diags[i].score; d.reason=diags[i].reason;
-    lastDiag.push_back(std::move(d));
+  if (best.id.length()==0 || best.score < MIN_ACCEPT_SCORE) {
+    if (g_dbg) {
+      Serial.printf("[INSIGNIA] No acceptable match for app='%s' norm='%s' (root=%s)\n",
+                    app.c_str(), m.q.norm, root.c_str());
+      for (auto& d : out.diag) {
+        Serial.printf("  • %-3d  %s  (slug=%s, id=%s)  [%s]\n",
+                      d.score, d.name.c_str(), d.slug.c_str(), d.id.c_str(), d.reason.c_str());
+      }
+    }
+    return false;
   }
 
+  if (pool.empty()) pool.push_back(best.id);
+  out.fam      = best.fam;
+  out.bestName = best.name;
+  out.score    = best.score;
+
   if (g_dbg) {
     Serial.printf("[INSIGNIA] pool size=%d (family='%s') query='%s' norm='%s' best='%s' score=%d\n",
-                  (int)titlePool.size(), best.fam.c_str(), curApp.c_str(), lastQueryNorm.c_str(),
+                  (int)pool.size(), best.fam.c_str(), app.c_str(), m.q.norm,
                   best.name.c_str(), best.score);
   }
   return true;
 }
 
-// =================== Load one variant model ===================
-static bool loadGameModel(const String& titleId) {
-  String url = WORK_ROOT + "/data/by_id/" + titleId + ".json";
-  String body;
-#if defined(ARDUINO) || defined(ESP_PLATFORM)
-  if (!cacheRead(url, body, TTL_BYID_MS, false)) {
-    if (httpGet(url, body)) cacheWrite(url, body);
-    else if (!cacheRead(url, body, 0, true)) return false;
-  }
-#else
-  if (!httpGet(url, body)) return false;
-#endif
+// =================== Streamed model parsing ===================
+// by_id files can be far larger than the heap. Walk the outer structure with a
+// tiny tokenizer and let ArduinoJson materialize one row at a time into a
+// small reusable document, so peak use is ROW_DOC_BYTES + the kept rows.
 
-  DynamicJsonDocument doc(1 << 16); // ~64KB
-  DeserializationError derr = deserializeJson(doc, body);
-  if (derr) {
-    if (g_dbg) Serial.printf("[INSIGNIA] JSON parse fail (%s) for %s\n", derr.c_str(), titleId.c_str());
-    return false;
+static int jsPeek(Stream& s) {
+  for (;;) {
+    int c = s.peek();
+    if (c == ' ' || c == '\n' || c == '\r' || c == '\t') { s.read(); continue; }
+    return c;
+  }
+}
+static bool jsEat(Stream& s, char c) {
+  if (jsPeek(s) != c) return false;
+  s.read();
+  return true;
+}
+// "key": — escapes are kept verbatim, the keys we match on are plain ASCII
+static bool jsKey(Stream& s, String& key) {
+  key = "";
+  if (!jsEat(s, '"')) return false;
+  for (;;) {
+    int c = s.read();
+    if (c < 0) return false;
+    if (c == '"') break;
+    if (c == '\\' && (c = s.read()) < 0) return false;
+    if (key.length() < 64) key += (char)c;
+  }
+  return jsEat(s, ':');
+}
+// Skip one value of any type without storing it.
+static bool jsSkip(Stream& s) {
+  int c = jsPeek(s);
+  if (c < 0) return false;
+  if (c != '{' && c != '[' && c != '"') {
+    while ((c = s.peek()) >= 0 && c != ',' && c != '}' && c != ']') s.read();
+    return true;
+  }
+  int depth = 0; bool inStr = false;
+  while ((c = s.read()) >= 0) {
+    if (inStr) {
+      if (c == '\\') s.read();
+      else if (c == '"') { inStr = false; if (depth == 0) return true; }
+      continue;
+    }
+    if (c == '"') inStr = true;
+    else if (c == '{' || c == '[') ++depth;
+    else if ((c == '}' || c == ']') && --depth == 0) return true;
   }
+  return false;
+}
+// Scalar value as text. Strings go through ArduinoJson (escapes/unicode);
+// bare numbers are read by hand because the parser would eat the delimiter.
+static bool jsScalar(Stream& s, JsonDocument& tmp, String& out) {
+  out = "";
+  int c = jsPeek(s);
+  if (c == '{' || c == '[') return jsSkip(s);
+  if (c == '"') {
+    if (deserializeJson(tmp, s)) return false;
+    out = j2s(tmp.as<JsonVariant>());
+    return true;
+  }
+  while ((c = s.peek()) >= 0 && c != ',' && c != '}' && c != ']' && c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+    out += (char)s.read();
+  }
+  if (out == "null") out = "";
+  return c >= 0;
+}
 
-  boards.clear(); curBoard=-1; gameTitle="";
-  gameTitle = j2s(doc["game_title"]);
+struct BoardCols {
+  std::vector<String> cols;
+  int rankIdx = -1, nameIdx = -1;
 
-  JsonArray sbs = doc["scoreboards"].as<JsonArray>();
-  if (sbs.isNull()) {
-    if (g_dbg) Serial.printf("[INSIGNIA] no scoreboards array for %s\n", titleId.c_str());
+  void index() {
+    rankIdx = nameIdx = -1;
+    for (size_t i=0;i<cols.size();++i) {
+      if (rankIdx < 0 && in_list_ci(cols[i], RANK_KEYS)) rankIdx = (int)i;
+      if (nameIdx < 0 && in_list_ci(cols[i], NAME_KEYS)) nameIdx = (int)i;
+    }
+  }
+  bool declared(const String& key) const {
+    for (auto& c : cols) if (c == key) return true;
     return false;
   }
+};
 
-  for (JsonVariant vSB : sbs) {
-    if (!vSB.is<JsonObject>()) continue;
-    JsonObject sb = vSB.as<JsonObject>();
-    Board B; B.name = j2s(sb["name"]); if (!B.name.length()) B.name = "default";
+// Parse-time shape of a board; flattened into the model by commitBoard().
+struct RowDraft {
+  String rank, name;
+  String metric;
+  std::vector<String> extras;
+};
+typedef std::vector<RowDraft, Mem::Bulk<RowDraft>> RowDraftList;
+struct BoardDraft { String name; RowDraftList rows; };
+
+// One JSON row → RowDraft. 'ordinal' (1-based position in the file) stands in
+// for a missing rank.
+static void rowFromJson(JsonVariant rv, const BoardCols& bc, int ordinal, RowDraft& row) {
+  const std::vector<String>& cols = bc.cols;
+  const int rankIdx = bc.rankIdx, nameIdx = bc.nameIdx;
+  std::vector<String> extras;
 
-    // columns
-    std::vector<String> cols;
-    if (sb["columns"].is<JsonArray>()) {
-      for (JsonVariant v : sb["columns"].as<JsonArray>()) cols.emplace_back(j2s(v));
-    }
+  if (rv.is<JsonObject>()) {
+    JsonObject r = rv.as<JsonObject>();
 
-    JsonArray rowsA = sb["rows"].as<JsonArray>();
-    if (rowsA.isNull()) continue;
+    auto val_by_col = [&](int i)->String {
+      if (i < 0 || i >= (int)cols.size()) return String();
+      return j2s(r[cols[i]]);
+    };
 
-    if (cols.empty() && rowsA.size()>0 && rowsA[0].is<JsonObject>()) {
-      JsonObject first = rowsA[0].as<JsonObject>();
-      for (JsonPair kv : first) cols.emplace_back(String(kv.key().c_str()));
+    row.rank = (rankIdx>=0) ? val_by_col(rankIdx) : String();
+    row.name = (nameIdx>=0) ? val_by_col(nameIdx) : String();
+
+    if (row.rank.isEmpty()) {
+      for (JsonPair kv : r) { if (in_list_ci(kv.key().c_str(), RANK_KEYS)) { row.rank = j2s(kv.value()); break; } }
+    }
+    if (row.name.isEmpty()) {
+      for (JsonPair kv : r) { if (in_list_ci(kv.key().c_str(), NAME_KEYS)) { row.name = j2s(kv.value()); break; } }
     }
+    if (row.rank.isEmpty()) row.rank = String(ordinal);
 
-    int nameIdx = -1, rankIdx = -1;
     for (size_t i=0;i<cols.size();++i) {
-      if (rankIdx < 0 && in_list_ci(cols[i], RANK_KEYS)) rankIdx = (int)i;
-      if (nameIdx < 0 && in_list_ci(cols[i], NAME_KEYS)) nameIdx = (int)i;
+      if ((int)i==rankIdx || (int)i==nameIdx) continue;
+      String v = val_by_col((int)i);
+      if (v.length()) extras.emplace_back(cols[i] + "=" + v);
+    }
+    for (JsonPair kv : r) {
+      String k = String(kv.key().c_str());
+      if (!k.length() || bc.declared(k)) continue;
+      String v = j2s(kv.value());
+      if (v.length()) extras.emplace_back(k + "=" + v);
     }
 
-    auto isDeclared = [&](const String& key)->bool {
-      for (auto& c : cols) if (c == key) return true;
-      return false;
+  } else if (rv.is<JsonArray>()) {
+    JsonArray arr = rv.as<JsonArray>();
+    auto val_at = [&](int i)->String {
+      if (i < 0 || i >= (int)arr.size()) return String();
+      JsonVariant v = arr[i]; return j2s(v);
     };
 
-    int pushed = 0;
-    for (JsonVariant rv : rowsA) {
-      Row row; std::vector<String> extras;
+    row.rank = (rankIdx>=0) ? val_at(rankIdx) : String(ordinal);
+    row.name = (nameIdx>=0) ? val_at(nameIdx) : String();
 
-      if (rv.is<JsonObject>()) {
-        JsonObject r = rv.as<JsonObject>();
-
-        auto val_by_col = [&](int i)->String {
-          if (i < 0 || i >= (int)cols.size()) return String();
-          return j2s(r[cols[i]]);
-        };
+    for (size_t i=0;i<cols.size();++i) {
+      if ((int)i==rankIdx || (int)i==nameIdx) continue;
+      String v = val_at((int)i);
+      if (v.length()) extras.emplace_back(cols[i] + "=" + v);
+    }
 
-        row.rank = (rankIdx>=0) ? val_by_col(rankIdx) : String();
-        row.name = (nameIdx>=0) ? val_by_col(nameIdx) : String();
+  } else {
+    row.rank = String(ordinal);
+    row.name = j2s(rv);
+  }
 
-        if (row.rank.isEmpty()) {
-          for (JsonPair kv : r) { if (in_list_ci(kv.key().c_str(), RANK_KEYS)) { row.rank = j2s(kv.value()); break; } }
-        }
-        if (row.name.isEmpty()) {
-          for (JsonPair kv : r) { if (in_list_ci(kv.key().c_str(), NAME_KEYS)) { row.name = j2s(kv.value()); break; } }
-        }
-        if (row.rank.isEmpty()) row.rank = String((int)B.rows.size() + 1);
+  // strip Rank/Name-like from extras
+  {
+    std::vector<String> cleaned; cleaned.reserve(extras.size());
+    for (auto& kv : extras) {
+      int eq = kv.indexOf('=');
+      String k = (eq>0) ? kv.substring(0,eq) : String();
+      if (!k.length()) continue;
+      if (in_list_ci(k, RANK_KEYS) || in_list_ci(k, NAME_KEYS)) continue;
+      cleaned.push_back(kv);
+    }
+    extras.swap(cleaned);
+  }
 
-        for (size_t i=0;i<cols.size();++i) {
-          if ((int)i==rankIdx || (int)i==nameIdx) continue;
-          String v = val_by_col((int)i);
-          if (v.length()) extras.emplace_back(cols[i] + "=" + v);
-        }
-        for (JsonPair kv : r) {
-          String k = String(kv.key().c_str());
-          if (!k.length() || isDeclared(k)) continue;
-          String v = j2s(kv.value());
-          if (v.length()) extras.emplace_back(k + "=" + v);
-        }
+  // choose metric
+  int bestIdx = -1, bestScore = 999;
+  for (int i=0;i<(int)extras.size();++i) {
+    int eq = extras[i].indexOf('=');
+    if (eq<=0) continue;
+    String k = extras[i].substring(0,eq);
+    int sc = metric_pref(k);
+    if (sc < bestScore) { bestScore = sc; bestIdx = i; }
+  }
+  if (bestIdx >= 0) {
+    int eq = extras[bestIdx].indexOf('=');
+    row.metric = extras[bestIdx].substring(eq+1);
+    extras.erase(extras.begin() + bestIdx);
+  } else if (!extras.empty()) {
+    int eq = extras[0].indexOf('=');
+    if (eq>0) { row.metric = extras[0].substring(eq+1); extras.erase(extras.begin()); }
+  }
 
-      } else if (rv.is<JsonArray>()) {
-        JsonArray arr = rv.as<JsonArray>();
-        auto val_at = [&](int i)->String {
-          if (i < 0 || i >= (int)arr.size()) return String();
-          JsonVariant v = arr[i]; return j2s(v);
-        };
+  row.extras = std::move(extras);
+}
 
-        row.rank = (rankIdx>=0) ? val_at(rankIdx) : String((int)B.rows.size() + 1);
-        row.name = (nameIdx>=0) ? val_at(nameIdx) : String();
+// Keep the MAX_ROWS_PER_BOARD best ranks; files are not guaranteed sorted.
+static void keepRow(RowDraftList& rows, RowDraft&& row) {
+  if (MAX_ROWS_PER_BOARD <= 0 || (int)rows.size() < MAX_ROWS_PER_BOARD) {
+    rows.push_back(std::move(row));
+    return;
+  }
+  size_t worst = 0; int worstKey = rankKey(rows[0].rank);
+  for (size_t i=1;i<rows.size();++i) {
+    int k = rankKey(rows[i].rank);
+    if (k > worstKey) { worstKey = k; worst = i; }
+  }
+  if (rankKey(row.rank) < worstKey) rows[worst] = std::move(row);
+}
 
-        for (size_t i=0;i<cols.size();++i) {
-          if ((int)i==rankIdx || (int)i==nameIdx) continue;
-          String v = val_at((int)i);
-          if (v.length()) extras.emplace_back(cols[i] + "=" + v);
+// One scoreboard object. Non-objects are skipped (B stays empty).
+static bool parseBoard(Stream& s, JsonDocument& doc, BoardDraft& B) {
+  if (jsPeek(s) != '{') return jsSkip(s);
+  s.read();
+  if (jsEat(s, '}')) return true;
+
+  BoardCols bc;
+  int seen = 0;
+  String key;
+  do {
+    if (!jsKey(s, key)) return false;
+    if (key == "name") {
+      if (!jsScalar(s, doc, B.name)) return false;
+    } else if (key == "columns" && jsPeek(s) == '[') {
+      if (deserializeJson(doc, s)) return false;
+      bc.cols.clear();
+      for (JsonVariant v : doc.as<JsonArray>()) bc.cols.emplace_back(j2s(v));
+      bc.index();
+    } else if (key == "rows" && jsPeek(s) == '[') {
+      s.read();
+      if (jsEat(s, ']')) continue;
+      do {
+        int c = jsPeek(s);
+        if (c == '{' || c == '[') {
+          if (deserializeJson(doc, s)) return false;   // oversized row: give up on the rest
+        } else {
+          String v;
+          if (!jsScalar(s, doc, v)) return false;
+          doc.clear(); doc.set(v);
+        }
+        JsonVariant rv = doc.as<JsonVariant>();
+        // no declared columns: take them from the first object row
+        if (seen == 0 && bc.cols.empty() && rv.is<JsonObject>()) {
+          for (JsonPair kv : rv.as<JsonObject>()) bc.cols.emplace_back(String(kv.key().c_str()));
+          bc.index();
         }
+        RowDraft row;
+        rowFromJson(rv, bc, ++seen, row);
+        keepRow(B.rows, std::move(row));
+      } while (jsEat(s, ','));
+      if (!jsEat(s, ']')) return false;
+    } else if (!jsSkip(s)) {
+      return false;
+    }
+  } while (jsEat(s, ','));
+  return jsEat(s, '}');
+}
 
-      } else {
-        row.rank = String((int)B.rows.size() + 1);
-        row.name = j2s(rv);
-      }
+// Sort a finished board and append it to the model as pre-cut display lines.
+static void commitBoard(Model& m, BoardDraft& B) {
+  if (B.rows.empty()) return;
+  if (!B.name.length()) B.name = "default";
+  std::sort(B.rows.begin(), B.rows.end(),
+    [](const RowDraft& a, const RowDraft& b){ return rankKey(a.rank) < rankKey(b.rank); });
+
+  Board out;
+  out.name  = m.text.add(B.name.c_str(), utf8Cut(B.name.c_str(), B.name.length(), LINE_CHARS));
+  out.first = (uint32_t)m.rows.size();
+  out.count = (uint32_t)B.rows.size();
+
+  String L;
+  for (const RowDraft& r : B.rows) {
+    L = "";
+    if (r.rank.length()) L += r.rank + ". ";
+    L += r.name.length()? r.name : String("-");   // ASCII: the 5x8 _tf font has no U+2014
+    if (r.metric.length()) L += "  " + r.metric;
+    for (size_t k=0;k<r.extras.size();++k) {
+      L += "  \xC2\xB7 " + r.extras[k];
+      if (utf8Chars(L.c_str(), L.length()) >= LINE_CHARS) break;
+    }
+    m.rows.push_back(Row{ m.text.add(L.c_str(), utf8Cut(L.c_str(), L.length(), LINE_CHARS)) });
+  }
+  m.boards.push_back(out);
+}
 
-      // strip Rank/Name-like from extras
-      {
-        std::vector<String> cleaned; cleaned.reserve(extras.size());
-        for (auto& kv : extras) {
-          int eq = kv.indexOf('=');
-          String k = (eq>0) ? kv.substring(0,eq) : String();
-          if (!k.length()) continue;
-          if (in_list_ci(k, RANK_KEYS) || in_list_ci(k, NAME_KEYS)) continue;
-          cleaned.push_back(kv);
-        }
-        extras.swap(cleaned);
-      }
+// Whole by_id document. Boards completed before a parse error are kept.
+static bool parseModel(Stream& s, Model& out, bool& sawBoards) {
+  BasicJsonDocument<Mem::JsonBulk> doc(ROW_DOC_BYTES);   // scratch: PSRAM when present
+  sawBoards = false;
+  if (!jsEat(s, '{')) return false;
+  if (jsEat(s, '}')) return true;
+
+  String key;
+  do {
+    if (!jsKey(s, key)) return false;
+    if (key == "game_title") {
+      if (!jsScalar(s, doc, out.title)) return false;
+    } else if (key == "scoreboards" && jsPeek(s) == '[') {
+      s.read();
+      sawBoards = true;
+      if (jsEat(s, ']')) continue;
+      do {
+        BoardDraft B;
+        bool ok = parseBoard(s, doc, B);
+        commitBoard(out, B);
+        if (!ok) return false;
+      } while (jsEat(s, ','));
+      if (!jsEat(s, ']')) return false;
+    } else if (!jsSkip(s)) {
+      return false;
+    }
+  } while (jsEat(s, ','));
+  return jsEat(s, '}');
+}
 
-      // choose metric
-      int bestIdx = -1, bestScore = 999;
-      for (int i=0;i<(int)extras.size();++i) {
-        int eq = extras[i].indexOf('=');
-        if (eq<=0) continue;
-        String k = extras[i].substring(0,eq);
-        int sc = metric_pref(k);
-        if (sc < bestScore) { bestScore = sc; bestIdx = i; }
-      }
-      if (bestIdx >= 0) {
-        int eq = extras[bestIdx].indexOf('=');
-        row.metric = extras[bestIdx].substring(eq+1);
-        extras.erase(extras.begin() + bestIdx);
-      } else if (!extras.empty()) {
-        int eq = extras[0].indexOf('=');
-        if (eq>0) { row.metric = extras[0].substring(eq+1); extras.erase(extras.begin()); }
-      }
+// =================== RAM tier ===================
+// Parsed models keyed by root|id, most recent first, in front of the flash
+// cache. Entries are shared read-only with the screen, so switching variants
+// is a pointer swap with no flash I/O or parsing.
+static const size_t RAM_MODELS = 4;
+static const size_t RAM_BYTES  = 64 * 1024;
+
+struct RamEntry { String key; ModelPtr m; uint32_t at; };   // at: loaded/revalidated
+static std::vector<RamEntry> ramTier;
+
+static String modelKey(const String& root, const String& id) { return root + "|" + id; }
+
+static ModelPtr ramGet(const String& key, uint32_t* ageMs = nullptr) {
+  FetchLock l;
+  for (size_t i = 0; i < ramTier.size(); ++i) {
+    if (ramTier[i].key != key) continue;
+    if (i) std::rotate(ramTier.begin(), ramTier.begin() + i, ramTier.begin() + i + 1);
+    if (ageMs) *ageMs = millis() - ramTier[0].at;
+    return ramTier[0].m;
+  }
+  return ModelPtr();
+}
+static void ramPut(const String& key, const ModelPtr& m) {
+  FetchLock l;
+  for (size_t i = 0; i < ramTier.size(); ++i) if (ramTier[i].key == key) { ramTier.erase(ramTier.begin() + i); break; }
+  ramTier.insert(ramTier.begin(), RamEntry{key, m, millis()});
+  size_t bytes = 0;
+  for (auto& e : ramTier) bytes += e.m->bytes;
+  while (ramTier.size() > 1 && (ramTier.size() > RAM_MODELS || bytes > RAM_BYTES)) {
+    bytes -= ramTier.back().m->bytes;
+    ramTier.pop_back();               // the screen may still hold it; freed when it lets go
+  }
+}
+static void ramRenew(const String& key) {
+  FetchLock l;
+  for (auto& e : ramTier) if (e.key == key) { e.at = millis(); return; }
+}
+static void ramClear() {
+  FetchLock l;
+  ramTier.clear();
+}
 
-      row.extras = std::move(extras);
-      B.rows.push_back(std::move(row));
+static size_t modelBytes(const Model& m) {
+  return sizeof(Model) + m.id.length() + m.title.length() + m.text.bytes()
+       + m.boards.capacity() * sizeof(Board) + m.rows.capacity() * sizeof(Row);
+}
 
-      ++pushed;
-      if (MAX_ROWS_PER_BOARD>0 && pushed>=MAX_ROWS_PER_BOARD) break;
-      if ((int)B.rows.size() >= 1000) break;
-    }
+// =================== Load one variant model ===================
+// Runs on the worker; the result is adopted by the UI side in adoptModel().
+static bool loadGameModel(const String& root, const String& titleId, ModelPtr& out) {
+  const String key = modelKey(root, titleId);
+  uint32_t age = 0;
+  ModelPtr hit = ramGet(key, &age);
+  if (hit && age <= TTL_BYID_MS) { out = hit; return true; }
+
+  String url = root + "/data/by_id/" + titleId + ".json";
+  std::shared_ptr<Model> m = std::make_shared<Model>();
+  bool sawBoards = false, ok = false;
 
-    if (!B.rows.empty()) {
-      std::sort(B.rows.begin(), B.rows.end(),
-        [](const Row& a, const Row& b){ return rankKey(a.rank) < rankKey(b.rank); });
-      boards.push_back(std::move(B));
+#if defined(ARDUINO) || defined(ESP_PLATFORM)
+  // Download into the cache file and parse from flash; the body never sits in RAM.
+  File f = cacheOpen(url, TTL_BYID_MS, false);
+  if (!f) {
+    Fetch fr = httpToCache(url, HTTP_TIMEOUT_MS);
+    if (hit && fr != Fetch::Updated) {
+      // unchanged (304) or offline: the parsed copy matches what flash holds
+      if (fr == Fetch::NotModified) ramRenew(key);
+      out = hit;
+      return true;
     }
+    f = cacheOpen(url, 0, true);            // fresh copy, or stale if offline
   }
+  if (f) {
+    ok = parseModel(f, *m, sawBoards);
+    f.close();
+  } else {
+    ensureFS();
+    if (fsReady) return false;
+    // no filesystem: fall back to an in-RAM body
+    String body;
+    if (!httpGet(url, body)) return false;
+    StrStream ss(body);
+    ok = parseModel(ss, *m, sawBoards);
+  }
+#else
+  String body;
+  if (!httpGet(url, body)) return false;
+  StrStream ss(body);
+  ok = parseModel(ss, *m, sawBoards);
+#endif
 
-  if (boards.empty()) {
+  if (!ok && g_dbg) Serial.printf("[INSIGNIA] JSON parse stopped early for %s (%d boards kept)\n",
+                                  titleId.c_str(), (int)m->boards.size());
+  if (!sawBoards) {
+    if (g_dbg) Serial.printf("[INSIGNIA] no scoreboards array for %s\n", titleId.c_str());
+    return false;
+  }
+  if (m->boards.empty()) {
     if (g_dbg) Serial.printf("[INSIGNIA] %s parsed but 0 usable boards\n", titleId.c_str());
     return false;
   }
 
+  m->id = titleId;
+  m->text.seal();
+  m->boards.shrink_to_fit();
+  m->rows.shrink_to_fit();
+  m->bytes = modelBytes(*m);
+  ramPut(key, m);
+  out = m;
+  return true;
+}
+
+// UI side: put a parsed model on screen.
+static void adoptModel(const ModelPtr& m) {
+  model = m;
+  gameTitle = m->title;
+  headText = gameTitle.length() ? gameTitle : curApp;
+  headText.remove(utf8Cut(headText.c_str(), headText.length(), HEAD_CHARS));
+  headX = (SCR_W - (int)utf8Chars(headText.c_str(), headText.length()) * 6) / 2; if (headX < 0) headX = 0;
+  for (size_t i = 0; i < titlePool.size(); ++i) if (titlePool[i] == m->id) { curTitleIdx = (int)i; break; }
+
 #if defined(ESP_PLATFORM)
-  curBoard = (int)(esp_random() % boards.size());
+  curBoard = (int)(esp_random() % m->boards.size());
 #else
-  curBoard = (int)(rand() % boards.size());
+  curBoard = (int)(rand() % m->boards.size());
 #endif
   lastBoardSwitch = millis();
   scrollY = 0.f;
   freezeUntilMs = lastBoardSwitch + FREEZE_MS;
   loaded = true;
   lastModelSwitch = millis();
+  modelVer++;
+
+  if (g_dbg) Serial.printf("[INSIGNIA] %s boards=%d\n", gameTitle.c_str(), (int)m->boards.size());
+}
+
+// =================== Fetch worker ===================
+// Network and flash work runs on its own task. The UI side posts jobs and
+// picks up results in tick(); jobs/results cross under fetchLock.
+enum class JobKind : uint8_t { Probe, Resolve, Load, Flush };   // Flush: flushCacheNow()
+
+struct Job {
+  JobKind  kind;
+  uint32_t gen = 0;
+  String   root, arg;         // arg: app name (Resolve) or title id (Load)
+  bool     prefetch = false;
+};
+struct Result {
+  JobKind    kind;
+  uint32_t   gen = 0;
+  bool       ok = false, prefetch = false;
+  String     root;
+  ResolveOut resolve;
+  ModelPtr   model;
+};
+
+static std::deque<Job>    jobs;
+static std::deque<Result> results;
+static volatile uint32_t  workerGen = 0;     // worker skips jobs older than this
+
+// On the worker, so it never overlaps a job that reads or writes the cache.
+static bool flushCache() {
+#if defined(ARDUINO) || defined(ESP_PLATFORM)
+  ensureFS(); if (!fsReady) return false;
+  wipeCacheFiles();
+  manifestSave();
+  invalidateTitleIndex();
+  ramClear();
+  if (g_dbg) Serial.println("[INSIGNIA] cache flushed now");
+  return true;
+#else
+  return false;
+#endif
+}
+
+static void runJob(const Job& j, Result& r) {
+  r.kind = j.kind; r.gen = j.gen; r.prefetch = j.prefetch;
+  if (!netReady() && j.kind == JobKind::Probe) return;
+  switch (j.kind) {
+    case JobKind::Probe:   r.ok = findWorkRoot(r.root); break;
+    case JobKind::Resolve: { Metrics::Scope m(Metrics::T_INSIGNIA_RESOLVE); r.ok = resolveTitlePool(j.root, j.arg, r.resolve); break; }
+    case JobKind::Load:    { Metrics::Scope m(Metrics::T_INSIGNIA_LOAD);    r.ok = loadGameModel(j.root, j.arg, r.model); break; }
+    case JobKind::Flush:   r.ok = flushCache(); break;
+  }
+}
+
+#if defined(ARDUINO) || defined(ESP_PLATFORM)
+static TaskHandle_t      fetchTask = nullptr;
+
+static void fetchWorker(void*) {
+  for (;;) {
+    Job j; bool have = false;
+    {
+      FetchLock l;
+      if (!jobs.empty()) { j = std::move(jobs.front()); jobs.pop_front(); have = true; }
+    }
+    if (!have) { ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000)); continue; }
+    if (j.kind != JobKind::Probe && j.kind != JobKind::Flush && j.gen != workerGen) continue;   // app changed meanwhile
+
+    Result r;
+    runJob(j, r);
+    FetchLock l;
+    results.push_back(std::move(r));
+  }
+}
+
+static void startWorker() {
+  if (!fetchLock) fetchLock = xSemaphoreCreateMutex();
+  if (!fetchTask) xTaskCreatePinnedToCore(fetchWorker, "insignia", WORKER_STACK, nullptr, 1, &fetchTask, 0);
+}
+#endif
 
-  if (g_dbg) Serial.printf("[INSIGNIA] %s boards=%d\n", gameTitle.c_str(), (int)boards.size());
+static void submit(Job&& j) {
+#if defined(ARDUINO) || defined(ESP_PLATFORM)
+  if (fetchTask) {
+    { FetchLock l; jobs.push_back(std::move(j)); }
+    xTaskNotifyGive(fetchTask);
+    return;
+  }
+#endif
+  Result r;                             // no worker: run inline
+  runJob(j, r);
+  results.push_back(std::move(r));
+}
+
+static void submitLoad(const String& id, bool prefetch) {
+  Job j; j.kind = JobKind::Load; j.gen = gen; j.root = WORK_ROOT; j.arg = id; j.prefetch = prefetch;
+  loadBusy = true; loadBusyId = id;
+  submit(std::move(j));
+}
+
+// Forget queued work and in-flight results for the previous app.
+static void dropPendingWork() {
+  ++gen;
+  workerGen = gen;
+  FetchLock l;
+  for (auto it = jobs.begin(); it != jobs.end(); ) {
+    if (it->kind == JobKind::Probe || it->kind == JobKind::Flush) ++it; else it = jobs.erase(it);
+  }
+}
+
+// Show id straight from the RAM tier; an old entry is refreshed behind it.
+static bool adoptFromRam(const String& id) {
+  uint32_t age = 0;
+  ModelPtr m = ramGet(modelKey(WORK_ROOT, id), &age);
+  if (!m) return false;
+  adoptModel(m);
+  if (age > TTL_BYID_MS && !loadBusy) submitLoad(id, true);
   return true;
 }
 
+static void prefetchNext() {
+  if (titlePool.size() < 2 || curTitleIdx < 0 || loadBusy) return;
+  const String& next = titlePool[(curTitleIdx + 1) % (int)titlePool.size()];
+  uint32_t age = 0;
+  if (ramGet(modelKey(WORK_ROOT, next), &age) && age <= TTL_BYID_MS) return;
+  submitLoad(next, true);
+}
+
+static void applyResults() {
+  for (;;) {
+    Result r;
+    {
+      FetchLock l;
+      if (results.empty()) return;
+      r = std::move(results.front());
+      results.pop_front();
+    }
+    const uint32_t now = millis();
+
+    if (r.kind == JobKind::Probe) {
+      probeBusy = false;
+      if (r.ok) WORK_ROOT = r.root;
+      else      nextProbeAt = now + PROBE_BACKOFF_MS;
+      continue;
+    }
+    if (r.kind == JobKind::Flush) continue;
+    if (r.gen != gen) continue;         // for a previous app
+
+    if (r.kind == JobKind::Resolve) {
+      resolveBusy = false;
+      lastDiag.swap(r.resolve.diag);
+      lastQueryNorm = r.resolve.norm;
+      if (!r.ok) { nextResolveAt = now + RETRY_BACKOFF_MS; continue; }
+      titlePool.swap(r.resolve.pool);
+#if defined(ESP_PLATFORM)
+      curTitleIdx = (int)(esp_random() % titlePool.size());
+#else
+      curTitleIdx = (int)(rand() % titlePool.size());
+#endif
+      haveSearch = true;
+      resolved   = true;
+      continue;
+    }
+
+    // Load
+    loadBusy = false;
+    if (!r.ok) { nextLoadAt = now + RETRY_BACKOFF_MS; continue; }
+    if (!r.prefetch || !loaded) {         // prefetches just sit in the RAM tier
+      adoptModel(r.model);
+      prefetchNext();
+    }
+  }
+}
+
 // =================== Public API ===================
 void setServerBase(const String& base) { BASE = base; }
+void setLinkUp(bool up) {
+  // link back: probe now rather than after the failure backoff
+  if (up && linkState != 1) nextProbeAt = millis();
+  linkState = up ? 1 : 0;
+}
 void setFlushCacheOnBoot(bool enable) {
 #if defined(ARDUINO) || defined(ESP_PLATFORM)
   flushOnBoot = enable;
@@ -957,15 +2103,8 @@ void setFlushCacheOnBoot(bool enable) {
 #endif
 }
 void flushCacheNow() {
-#if defined(ARDUINO) || defined(ESP_PLATFORM)
-  ensureFS(); if (!fsReady) return;
-  File root = SPIFFS.open("/");
-  for (File f = root.openNextFile(); f; f = root.openNextFile()) {
-    String p = f.path();
-    if (p.startsWith(CACHE_DIR)) SPIFFS.remove(p);
-  }
-  if (g_dbg) Serial.println("[INSIGNIA] cache flushed now");
-#endif
+  Job j; j.kind = JobKind::Flush;       // queued behind whatever the worker is doing
+  submit(std::move(j));
 }
 void setCacheLimits(size_t maxFiles, size_t maxBytes, uint32_t maxAgeMs) {
 #if defined(ARDUINO) || defined(ESP_PLATFORM)
@@ -977,7 +2116,8 @@ void setCacheLimits(size_t maxFiles, size_t maxBytes, uint32_t maxAgeMs) {
 
 static void resetRuntime(bool keepRoot) {
   (void)keepRoot;
-  boards.clear();
+  if (model) modelVer++;
+  model.reset();
   curBoard = -1;
   gameTitle = "";
   haveSearch = false;
@@ -991,9 +2131,10 @@ static void resetRuntime(bool keepRoot) {
   freezeUntilMs = 0;
   lastModelSwitch = 0;
 
-  probeList.clear();
-  probeIdx = 0;
-  nextProbeAt = 0;
+  resolveBusy = loadBusy = false;
+  loadBusyId = "";
+  nextResolveAt = nextLoadAt = 0;
+  dropPendingWork();
 
   lastDiag.clear();
   lastQueryRaw = "";
@@ -1002,8 +2143,10 @@ static void resetRuntime(bool keepRoot) {
 
 void begin(bool debug) {
   g_dbg = debug;
+#if defined(ARDUINO) || defined(ESP_PLATFORM)
+  startWorker();
+#endif
   resetRuntime();
-  if (netReady()) startProbingIfNeeded();
 }
 
 void onAppName(const char* app) {
@@ -1011,11 +2154,13 @@ void onAppName(const char* app) {
   if (s == curApp) return;
   curApp = s;
   resetRuntime();
-  if (curApp.length()==0) return;
-  if (netReady()) startProbingIfNeeded();
+  lastQueryRaw = curApp;
 }
 
 bool isActive() { return (curApp.length()>0) && resolved && loaded; }
+uint32_t version() { return modelVer; }
+String currentId()    { return (loaded && model) ? model->id : String(); }
+String currentTitle() { return (loaded && model) ? model->title : String(); }
 
 void dumpSearchDebug() {
   if (!g_dbg) return;
@@ -1029,16 +2174,32 @@ void dumpSearchDebug() {
 }
 
 // =================== Internals ===================
+// UI side: adopt finished work and post the next job. Never blocks.
 static void maybeResolveAndLoad() {
+  applyResults();
   const uint32_t now = millis();
-  if (now - lastFetchMs < 100) return;
-  lastFetchMs = now;
 
-  if (!WORK_ROOT.length()) { stepProbeWorkRoot(); return; }
-  if (!resolved) { resolveTitlePool(); return; }
+  if (!WORK_ROOT.length()) {
+    if (!probeBusy && netReady() && (int32_t)(now - nextProbeAt) >= 0) {
+      Job j; j.kind = JobKind::Probe;
+      probeBusy = true;
+      submit(std::move(j));
+    }
+    return;
+  }
+  if (!resolved) {
+    if (!resolveBusy && (int32_t)(now - nextResolveAt) >= 0) {
+      Job j; j.kind = JobKind::Resolve; j.gen = gen; j.root = WORK_ROOT; j.arg = curApp;
+      resolveBusy = true;
+      submit(std::move(j));
+    }
+    return;
+  }
   if (!loaded) {
     if (curTitleIdx < 0 || curTitleIdx >= (int)titlePool.size()) return;
-    loadGameModel(titlePool[curTitleIdx]);
+    const String& id = titlePool[curTitleIdx];
+    if (adoptFromRam(id)) { prefetchNext(); return; }
+    if (!loadBusy && (int32_t)(now - nextLoadAt) >= 0) submitLoad(id, false);
   }
 }
 
@@ -1055,9 +2216,11 @@ void tick() {
     scrollY += PIXELS_PER_STEP;
   }
 
+  const ModelPtr cur = model;        // adoptFromRam() below may replace 'model'
+  const BoardList& boards = cur->boards;
   if (curBoard >= 0 && curBoard < (int)boards.size()) {
     const Board& B = boards[curBoard];
-    const int last_i = (int)B.rows.size() - 1;
+    const int last_i = (int)B.count - 1;
     const int bottomBaseline = SCR_H - 2;
     const float y_last = bottomBaseline - (scrollY - last_i * (float)LINE_H);
     const float last_top = y_last - ASCENT_5x8;
@@ -1077,9 +2240,10 @@ void tick() {
       freezeUntilMs = now + FREEZE_MS;
 
       if (titlePool.size() > 1 && (now - lastModelSwitch) >= MODEL_DWELL_MS) {
-        curTitleIdx = (curTitleIdx + 1) % (int)titlePool.size();
-        loaded = false;
-        if (g_dbg) Serial.printf("[INSIGNIA] switch variant -> %s\n", titlePool[curTitleIdx].c_str());
+        // a prefetched variant swaps in from RAM; otherwise keep this one up
+        const String next = titlePool[(curTitleIdx + 1) % (int)titlePool.size()];
+        if (adoptFromRam(next) && g_dbg) Serial.printf("[INSIGNIA] switch variant -> %s\n", next.c_str());
+        prefetchNext();
       }
     }
   }
@@ -1087,49 +2251,38 @@ void tick() {
 
 // =================== Drawing ===================
 void draw(U8G2* g) {
-  if (!resolved || !loaded) return;
+  if (!resolved || !loaded || !model) return;
 
   g->clearBuffer();
 
-  String head = (gameTitle.length() ? gameTitle : curApp);
+  // lines were formatted and cut to width at load time; nothing here allocates
+  const Model& M = *model;
   g->setFont(u8g2_font_6x12_tf);
-  int w = g->getStrWidth(head.c_str());
-  int x = (SCR_W - w)/2; if (x < 0) x = 0;
-  g->setCursor(x, TOP_LINE_Y);
-  g->print(head);
+  g->drawUTF8(headX, TOP_LINE_Y, headText.c_str());
   g->drawHLine(0, RULE_Y, SCR_W);
 
   g->setFont(u8g2_font_5x8_tf);
-  const Board& B = boards[curBoard >= 0 ? curBoard : 0];
+  const Board& B = M.boards[curBoard >= 0 ? curBoard : 0];
   const int bottomBaseline = SCR_H - 2;
   const int CONTENT_BODY_TOP = CONTENT_TOP + LINE_H;
 
-  if (B.name.length()) {
-    String label = B.name;
-    while (g->getStrWidth(label.c_str()) > (SCR_W - 4) && label.length() > 1) label.remove(label.length()-1);
-    g->setCursor(2, CONTENT_TOP + ASCENT_5x8);
-    g->print(label);
-  }
+  g->drawUTF8(2, CONTENT_TOP + ASCENT_5x8, M.text.at(B.name));
 
-  for (int i=0; i<(int)B.rows.size(); ++i) {
-    String L;
-    const Row& r = B.rows[i];
-    if (r.rank.length()) L += r.rank + ". ";
-    L += r.name.length()? r.name : String("—");
-    if (r.metric.length()) L += "  " + r.metric;
-    for (size_t k=0;k<r.extras.size();++k) {
-      L += "  \xC2\xB7 " + r.extras[k];
-    }
-    while (g->getStrWidth(L.c_str()) > (SCR_W - 4) && L.length() > 1) L.remove(L.length()-1);
+  // row i sits at y = bottomBaseline - scrollY + i*LINE_H; solve the window
+  // test for i so only the rows on screen are visited
+  const float base = bottomBaseline - scrollY;
+  int i0 = (int)ceilf((CONTENT_BODY_TOP + ASCENT_5x8 - base) / (float)LINE_H);
+  int i1 = (int)floorf((SCR_H + LINE_H - base) / (float)LINE_H);
+  if (i0 < 0) i0 = 0;
+  if (i1 > (int)B.count - 1) i1 = (int)B.count - 1;
 
-    const float y = bottomBaseline - (scrollY - i*(float)LINE_H);
-    if ((y - ASCENT_5x8) >= CONTENT_BODY_TOP && y <= (SCR_H + LINE_H)) {
-      g->setCursor(2, (int)y);
-      g->print(L);
-    }
+  for (int i=i0; i<=i1; ++i) {
+    const float y = base + i*(float)LINE_H;
+    if ((y - ASCENT_5x8) < CONTENT_BODY_TOP) continue;   // float rounding at the edge
+    g->drawUTF8(2, (int)y, M.text.at(M.rows[B.first + i].line));
   }
 
-  g->sendBuffer();
+  OledDamage::flush(g);
 }
 
 uint32_t recommendedHoldMs(){ return 15000; }
@@ -9,13 +9,17 @@ void setServerBase(const String& base);
 void begin(bool debug);
 
 // OPTIONAL cache controls (match .cpp you just added)
-void setFlushCacheOnBoot(bool enable);                    // call in setup() if you want a wipe on boot
-void flushCacheNow();                                     // manual wipe
+void setFlushCacheOnBoot(bool enable);                    // wipe on every boot (default: only when the firmware changes)
+void flushCacheNow();                                     // manual wipe (runs on the fetch worker)
 void setCacheLimits(size_t maxFiles, size_t maxBytes, uint32_t maxAgeMs);
 
 // ---- runtime wiring ----
 void onAppName(const char* app);                          // pass current app/game name
+void setLinkUp(bool up);                                  // from WiFiMgr::onLink (else WiFi.status() is polled)
 bool isActive();                                          // only true after a definite match + model loaded
+uint32_t version();                                       // bumps when the title on screen changes
+String currentId();                                       // by_id of the loaded model ("" if none)
+String currentTitle();                                    // its title ("" if none)
 void tick();                                              // call every loop (advances scroll/rotation)
 void draw(U8G2* g);                                       // render when isActive() == true
 uint32_t recommendedHoldMs();                             // optional scheduler hint
@@ -31,6 +31,7 @@ void LedStat::setStatus(LedStatus status) {
         case LedStatus::WifiConnected:  setLedColor(0, RGB_BRIGHTNESS, 0); break;   // Green
         case LedStatus::WifiFailed:     setLedColor(RGB_BRIGHTNESS, 0, 0); break;   // Red
         case LedStatus::Portal:         setLedColor(16, 0, 16); break;              // Initial purple
+        case LedStatus::Updating:       setLedColor(0, 24, 24); break;              // Initial cyan
         //case LedStatus::UdpTransmit:    setLedColor(RGB_BRIGHTNESS, 40, 0); break;  // Initial orange
     }
 }
@@ -47,6 +48,13 @@ void LedStat::loop() {
                 lastBlink = now;
             }
             break;
+        case LedStatus::Updating: // Fast blinking cyan
+            if (now - lastBlink > 150) {
+                ledOn = !ledOn;
+                setLedColor(0, ledOn ? 24 : 0, ledOn ? 24 : 0); // Cyan/off
+                lastBlink = now;
+            }
+            break;
         case LedStatus::Booting: // Solid white
         case LedStatus::WifiConnected: // Solid green
         case LedStatus::WifiFailed: // Solid red
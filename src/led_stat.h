@@ -5,7 +5,8 @@ enum class LedStatus {
     Portal,
     WifiConnected,
     WifiFailed,
-    UdpTransmit
+    UdpTransmit,
+    Updating        // firmware update in progress (blinking cyan)
 };
 
 namespace LedStat {
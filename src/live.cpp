@@ -0,0 +1,163 @@
+#include "live.h"
+#include "telemetry.h"
+#include "weather.h"
+#include "insignia.h"
+#include <math.h>
+
+namespace Live {
+
+static AsyncEventSource s_events("/live");
+static bool     s_attached = false;
+static int      s_sub = -1;
+static volatile bool s_newClient = false;   // set from the server task
+
+static uint32_t s_pending = 0;              // Telemetry fields changed since the last event
+static uint32_t s_wxVer = 0, s_insVer = 0, s_console = 0;
+static uint32_t s_seq = 0, s_sentAt = 0, s_keyAt = 0;
+static uint32_t s_deltas = 0, s_keyframes = 0, s_held = 0;
+
+static void onTelemetry(const Telemetry::Snapshot&, uint32_t changed, void*) { s_pending |= changed; }
+
+// -------- JSON --------
+static void key(String& out, bool& first, const char* k) {
+  if (!first) out += ',';
+  first = false;
+  out += '"'; out += k; out += "\":";
+}
+static void num(String& out, bool& first, const char* k, int32_t v) { key(out, first, k); out += v; }
+static void flt(String& out, bool& first, const char* k, float v) {
+  key(out, first, k);
+  if (isnan(v)) out += "null"; else out += String(v, 1);
+}
+static void str(String& out, bool& first, const char* k, const char* v) {
+  key(out, first, k);
+  out += '"';
+  for (const char* p = v ? v : ""; *p; ++p) {
+    const char c = *p;
+    if (c == '"' || c == '\\') { out += '\\'; out += c; }
+    else if ((uint8_t)c < 0x20) out += ' ';
+    else out += c;
+  }
+  out += '"';
+}
+
+// fields: Telemetry F_* bits to include; the rest of the state by flag.
+static void build(String& out, uint32_t fields, bool wx, bool ins, bool console) {
+  using namespace Telemetry;
+  const Snapshot& t = get();
+  out.reserve(384);
+  out = '{';
+  bool first = true;
+  num(out, first, "seq", (int32_t)s_seq);
+  if (console) str(out, first, "console", t.ip ? IPAddress(t.ip).toString().c_str() : "");
+
+  if (fields & F_MAIN) {
+    key(out, first, "main"); out += '{';
+    bool f = true;
+    if (fields & F_FAN) num(out, f, "fan", t.fan);
+    if (fields & F_CPU) num(out, f, "cpu", t.cpu);
+    if (fields & F_AMB) num(out, f, "amb", t.amb);
+    if (fields & F_APP) str(out, f, "app", t.app);
+    out += '}';
+  }
+  if (fields & (F_EXT | F_XBOX_LBL)) {
+    key(out, first, "ext"); out += '{';
+    bool f = true;
+    if (fields & F_TRAY)     num(out, f, "tray", t.tray);
+    if (fields & F_AV)       num(out, f, "av", t.av);
+    if (fields & F_PIC)      num(out, f, "pic", t.pic);
+    if (fields & F_XBOXVER)  num(out, f, "xboxver", t.xboxver);
+    if (fields & F_ENC)      num(out, f, "enc", t.enc);
+    if (fields & F_RES)      { num(out, f, "w", t.width); num(out, f, "h", t.height); }
+    if (fields & F_XBOX_LBL) str(out, f, "xbox_ver", t.xbox_ver);
+    out += '}';
+  }
+  if (fields & F_EE) {
+    key(out, first, "ee"); out += '{';
+    bool f = true;
+    if (fields & F_SERIAL) str(out, f, "serial", t.serial);
+    if (fields & F_MAC)    str(out, f, "mac", t.mac);
+    if (fields & F_REGION) str(out, f, "region", t.region);
+    out += '}';
+  }
+  if (wx) {
+    const Weather::Snapshot w = Weather::get();
+    key(out, first, "weather"); out += '{';
+    bool f = true;
+    key(out, f, "ok"); out += w.ok ? "true" : "false";
+    if (w.ok) {
+      flt(out, f, "temp", w.temp);
+      char u[2] = { w.units, 0 };
+      str(out, f, "units", u);
+      flt(out, f, "wind", w.wind);
+      num(out, f, "humidity", w.humidity);
+      num(out, f, "wmo", w.wmo);
+      str(out, f, "text", w.text.c_str());
+      str(out, f, "place", w.place.c_str());
+    }
+    out += '}';
+  }
+  if (ins) {
+    key(out, first, "insignia"); out += '{';
+    bool f = true;
+    key(out, f, "active"); out += Insignia::isActive() ? "true" : "false";
+    str(out, f, "id", Insignia::currentId().c_str());
+    str(out, f, "title", Insignia::currentTitle().c_str());
+    out += '}';
+  }
+  out += '}';
+}
+
+// -------- API --------
+void attach(AsyncWebServer& server) {
+  if (s_attached) return;
+  s_events.onConnect([](AsyncEventSourceClient*) { s_newClient = true; });
+  server.addHandler(&s_events);
+  if (s_sub < 0) s_sub = Telemetry::subscribe(onTelemetry, Telemetry::F_ALL);
+  s_attached = true;
+}
+
+void loop() {
+  if (!s_attached) return;
+  const uint32_t now = millis();
+  const uint32_t wxVer = Weather::version(), insVer = Insignia::version(), console = Telemetry::get().ip;
+  if (!s_events.count()) {                  // nobody listening: the next client gets a keyframe
+    s_pending = 0;
+    s_wxVer = wxVer; s_insVer = insVer; s_console = console;
+    return;
+  }
+
+  const bool keyframe = s_newClient || now - s_keyAt >= LIVE_KEYFRAME_MS;
+  const bool wx = wxVer != s_wxVer, ins = insVer != s_insVer, con = console != s_console;
+  if (!keyframe && !s_pending && !wx && !ins && !con) return;
+  if (now - s_sentAt < LIVE_MIN_INTERVAL_MS) return;
+  // slow clients: hold deltas and send them merged once the queues drain
+  if (!s_newClient && s_events.avgPacketsWaiting() > LIVE_MAX_BACKLOG) { s_held++; return; }
+
+  String out;
+  ++s_seq;
+  if (keyframe) {
+    s_newClient = false;
+    build(out, Telemetry::F_ALL, true, true, true);
+    s_events.send(out.c_str(), "state", s_seq);
+    s_keyAt = now;
+    s_keyframes++;
+  } else {
+    build(out, s_pending, wx, ins, con);
+    s_events.send(out.c_str(), "delta", s_seq);
+    s_deltas++;
+  }
+  s_pending = 0;
+  s_wxVer = wxVer; s_insVer = insVer; s_console = console;
+  s_sentAt = now;
+}
+
+void metricsJson(String& out) {
+  out += "\"live\":{\"clients\":"; out += (uint32_t)(s_attached ? s_events.count() : 0);
+  out += ",\"keyframes\":"; out += s_keyframes;
+  out += ",\"deltas\":";    out += s_deltas;
+  out += ",\"held\":";      out += s_held;
+  out += '}';
+}
+
+} // namespace Live
@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+// Live state push for the viewer app and dashboards: Server-Sent Events at
+// /live, so clients subscribe once instead of polling.
+//
+// A client gets a "state" event with everything on connect, then "delta"
+// events carrying only what changed: the telemetry fields of the console on
+// screen, weather on each refresh, the Insignia title. Changes are coalesced
+// to at most one delta per LIVE_MIN_INTERVAL_MS. While clients' queues back
+// up, deltas are held back and merged. Every event has a sequence id; a
+// "state" keyframe every LIVE_KEYFRAME_MS resyncs anyone who missed a delta.
+
+#ifndef LIVE_MIN_INTERVAL_MS
+#define LIVE_MIN_INTERVAL_MS 250
+#endif
+#ifndef LIVE_KEYFRAME_MS
+#define LIVE_KEYFRAME_MS 30000
+#endif
+#ifndef LIVE_MAX_BACKLOG
+#define LIVE_MAX_BACKLOG 4              // queued events per client before deltas are held
+#endif
+
+namespace Live {
+
+void attach(AsyncWebServer& server);   // before server.begin()
+void loop();                           // scheduler: builds and sends pending deltas
+void metricsJson(String& out);         // section for /metrics
+
+} // namespace Live
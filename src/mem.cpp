@@ -0,0 +1,64 @@
+#include "mem.h"
+#include <esp_heap_caps.h>
+#include <atomic>
+#include <stdlib.h>
+
+namespace Mem {
+
+static const uint32_t BULK_CAPS = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+static const uint32_t HOT_CAPS  = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+
+static std::atomic<uint32_t> s_bulkPsram{0};     // bulk allocations placed in PSRAM
+static std::atomic<uint32_t> s_bulkInternal{0};  // ... that fell back to internal
+static std::atomic<uint32_t> s_bulkFailed{0};
+
+void* bulkAlloc(size_t n) {
+  if (!n) return nullptr;
+  void* p = psramFound() ? heap_caps_malloc(n, BULK_CAPS) : nullptr;
+  if (p) { s_bulkPsram++; return p; }
+  p = heap_caps_malloc(n, HOT_CAPS);
+  if (p) s_bulkInternal++;
+  else   s_bulkFailed++;
+  return p;
+}
+
+void* bulkRealloc(void* p, size_t n) {
+  if (!p) return bulkAlloc(n);
+  if (!n) { bulkFree(p); return nullptr; }
+  // may move the block between regions; either is fine for bulk data
+  void* q = psramFound() ? heap_caps_realloc(p, n, BULK_CAPS) : nullptr;
+  if (!q) q = heap_caps_realloc(p, n, HOT_CAPS);
+  if (!q) s_bulkFailed++;
+  return q;
+}
+
+void bulkFree(void* p) { heap_caps_free(p); }
+
+void* hotAlloc(size_t n) { return n ? heap_caps_malloc(n, HOT_CAPS) : nullptr; }
+
+// -------- metrics --------
+static void region(String& out, const char* name, uint32_t caps, bool comma) {
+  multi_heap_info_t i;
+  heap_caps_get_info(&i, caps);
+  if (comma) out += ',';
+  out += '"'; out += name; out += "\":{\"size\":";
+  out += (uint32_t)(i.total_free_bytes + i.total_allocated_bytes);
+  out += ",\"free\":";      out += (uint32_t)i.total_free_bytes;
+  out += ",\"min_free\":";  out += (uint32_t)i.minimum_free_bytes;
+  out += ",\"largest\":";   out += (uint32_t)i.largest_free_block;
+  out += ",\"blocks\":";    out += (uint32_t)i.allocated_blocks;
+  out += '}';
+}
+
+void metricsJson(String& out) {
+  out += "\"mem\":{";
+  region(out, "internal", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT, false);
+  region(out, "dma", MALLOC_CAP_DMA, true);
+  if (psramFound()) region(out, "psram", MALLOC_CAP_SPIRAM, true);
+  out += ",\"bulk\":{\"psram\":"; out += s_bulkPsram.load();
+  out += ",\"internal\":";        out += s_bulkInternal.load();
+  out += ",\"failed\":";          out += s_bulkFailed.load();
+  out += "}}";
+}
+
+} // namespace Mem
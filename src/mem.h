@@ -0,0 +1,64 @@
+#pragma once
+#include <Arduino.h>
+#include <stddef.h>
+#include <new>
+
+// Where big allocations live.
+//
+// Bulk/cold data (spare packet slots, capture rings, parsed leaderboards,
+// JSON scratch documents) goes to PSRAM when the board has it, so internal
+// SRAM stays free for what needs it: lwIP/TLS buffers, DMA, task stacks and
+// the per-frame render state (U8g2 framebuffer, damage map, ticker strips),
+// which stay static in internal RAM. Without PSRAM, or when it is full, bulk
+// allocations fall back to internal RAM and are counted.
+//
+// Per-region heap use is reported in /metrics ("mem").
+
+// Static placement. Bulk statics only land in PSRAM when the SDK was built
+// with .bss in external memory; otherwise this is empty and they stay internal.
+#if defined(CONFIG_SPIRAM_ALLOW_BSS_SEG_EXTERNAL_MEMORY) && defined(EXT_RAM_BSS_ATTR)
+#define MEM_BULK_BSS EXT_RAM_BSS_ATTR
+#elif defined(CONFIG_SPIRAM_ALLOW_BSS_SEG_EXTERNAL_MEMORY) && defined(EXT_RAM_ATTR)
+#define MEM_BULK_BSS EXT_RAM_ATTR
+#else
+#define MEM_BULK_BSS
+#endif
+
+namespace Mem {
+
+void* bulkAlloc(size_t n);                 // PSRAM first, then internal
+void* bulkRealloc(void* p, size_t n);      // keeps PSRAM blocks in PSRAM
+void  bulkFree(void* p);
+void* hotAlloc(size_t n);                  // internal 8-bit RAM only
+
+template <class T, class... A> T* bulkNew(A&&... a) {
+  void* p = bulkAlloc(sizeof(T));
+  return p ? new (p) T(static_cast<A&&>(a)...) : nullptr;
+}
+
+// STL allocator for bulk containers (std::vector<T, Mem::Bulk<T>>).
+template <class T> struct Bulk {
+  typedef T value_type;
+  Bulk() = default;
+  template <class U> Bulk(const Bulk<U>&) {}
+  T* allocate(size_t n) {
+    T* p = static_cast<T*>(bulkAlloc(n * sizeof(T)));
+    if (!p) abort();                       // as operator new would
+    return p;
+  }
+  void deallocate(T* p, size_t) { bulkFree(p); }
+  template <class U> bool operator==(const Bulk<U>&) const { return true; }
+  template <class U> bool operator!=(const Bulk<U>&) const { return false; }
+};
+
+// ArduinoJson 6 allocator: BasicJsonDocument<Mem::JsonBulk>.
+struct JsonBulk {
+  void* allocate(size_t n)              { return bulkAlloc(n); }
+  void  deallocate(void* p)             { bulkFree(p); }
+  void* reallocate(void* p, size_t n)   { return bulkRealloc(p, n); }
+};
+
+// Metrics section: per-region heap and bulk placement counters.
+void metricsJson(String& out);
+
+} // namespace Mem
@@ -0,0 +1,256 @@
+#include "metrics.h"
+#include "task_sched.h"
+#include "oled_damage.h"
+#include "oled_async.h"
+#include <freertos/FreeRTOS.h>
+#include <string.h>
+
+namespace Metrics {
+
+static const char* const TICK_NAMES[T_COUNT] = {
+  "udp_drain", "parse", "draw", "flush", "insignia_resolve", "insignia_load", "weather_fetch"
+};
+static const char* const HIST_NAMES[H_COUNT] = {
+  "i2c", "http", "lat_parse", "lat_render", "lat_panel", "net_delay", "spi"
+};
+
+// Values below 8 us get a bucket each; above that every octave [2^e, 2^(e+1))
+// splits into 4 buckets (<= 25% error). The last bucket takes everything
+// from ~16 s up.
+static const uint8_t BUCKETS = 96;
+
+struct TickStat { uint32_t n, last, max; uint64_t total; };
+struct HistStat { uint32_t n, max; uint64_t total; uint32_t b[BUCKETS]; };
+
+static TickStat s_tick[T_COUNT];
+static HistStat s_hist[H_COUNT];
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static const uint8_t MAX_SECTIONS = 8;
+static Section s_sections[MAX_SECTIONS];
+static uint8_t s_nSections = 0;
+
+static inline uint8_t bucketOf(uint32_t us) {
+  if (us < 8) return (uint8_t)us;
+  const uint32_t e = 31 - __builtin_clz(us);
+  const uint32_t b = (e - 1) * 4 + ((us >> (e - 2)) & 3);
+  return b < BUCKETS ? (uint8_t)b : BUCKETS - 1;
+}
+static inline uint32_t bucketTop(uint8_t b) {
+  if (b < 8) return b + 1;
+  const uint32_t e = b / 4 + 1, m = b % 4;
+  return (5 + m) << (e - 2);
+}
+
+void record(Tick t, uint32_t us) {
+  if (t >= T_COUNT) return;
+  portENTER_CRITICAL(&s_mux);
+  TickStat& s = s_tick[t];
+  s.n++;
+  s.last = us;
+  s.total += us;
+  if (us > s.max) s.max = us;
+  portEXIT_CRITICAL(&s_mux);
+}
+
+void sample(Hist h, uint32_t us) {
+  if (h >= H_COUNT) return;
+  const uint8_t b = bucketOf(us);
+  portENTER_CRITICAL(&s_mux);
+  HistStat& s = s_hist[h];
+  s.n++;
+  s.total += us;
+  if (us > s.max) s.max = us;
+  s.b[b]++;
+  portEXIT_CRITICAL(&s_mux);
+}
+
+static uint32_t pctOf(const HistStat& s, uint8_t pct) {
+  if (!s.n) return 0;
+  const uint64_t want = ((uint64_t)s.n * pct + 99) / 100;
+  uint64_t acc = 0;
+  for (uint8_t i = 0; i < BUCKETS; ++i) {
+    acc += s.b[i];
+    if (acc >= want) {
+      const uint32_t top = bucketTop(i);
+      return (i == BUCKETS - 1 || top > s.max) ? s.max : top;
+    }
+  }
+  return s.max;
+}
+
+uint32_t percentile(Hist h, uint8_t pct) {
+  if (h >= H_COUNT) return 0;
+  portENTER_CRITICAL(&s_mux);
+  const HistStat s = s_hist[h];
+  portEXIT_CRITICAL(&s_mux);
+  return pctOf(s, pct);
+}
+
+// -------------- end-to-end latency --------------
+static uint32_t s_latPending  = 0;   // rx time of the oldest change not yet on a frame
+static uint32_t s_latInflight = 0;   // rx time of the change on the frame being sent
+static bool     s_havePending = false, s_haveInflight = false;
+static int32_t  s_bestOffset  = 0;
+static bool     s_haveOffset  = false;
+
+void latChanged(uint32_t rxUs) {
+  const uint32_t now = micros();
+  portENTER_CRITICAL(&s_mux);
+  if (!s_havePending) { s_latPending = rxUs; s_havePending = true; }
+  portEXIT_CRITICAL(&s_mux);
+  sample(H_LAT_PARSE, now - rxUs);
+}
+
+void latFrame() {
+  const uint32_t now = micros();
+  uint32_t rx = 0;
+  bool have = false;
+  portENTER_CRITICAL(&s_mux);
+  if (s_havePending) {
+    rx = s_latPending; have = true;
+    s_havePending = false;
+    s_latInflight = rx; s_haveInflight = true;
+  }
+  portEXIT_CRITICAL(&s_mux);
+  if (have) sample(H_LAT_RENDER, now - rx);
+}
+
+void latSent() {
+  const uint32_t now = micros();
+  uint32_t rx = 0;
+  bool have = false;
+  portENTER_CRITICAL(&s_mux);
+  if (s_haveInflight) { rx = s_latInflight; have = true; s_haveInflight = false; }
+  portEXIT_CRITICAL(&s_mux);
+  if (have) sample(H_LAT_PANEL, now - rx);
+}
+
+void latSender(uint32_t senderMs, uint32_t rxMs) {
+  if (!senderMs) return;                       // sender doesn't stamp
+  const int32_t off = (int32_t)(rxMs - senderMs);
+  // a new best, or a jump of more than 10 s (sender or display rebooted)
+  if (!s_haveOffset || off < s_bestOffset || off - s_bestOffset > 10000) {
+    s_bestOffset = off;
+    s_haveOffset = true;
+  }
+  sample(H_NET_DELAY, (uint32_t)(off - s_bestOffset) * 1000UL);
+}
+
+Scope::~Scope() {
+  const uint32_t us = micros() - u0_;
+  if (us >= 1000000UL) { record(t_, us); return; }
+  const uint32_t mhz = ESP.getCpuFreqMHz();
+  record(t_, mhz ? (ESP.getCycleCount() - c0_) / mhz : us);
+}
+
+void addSection(Section fn) {
+  if (fn && s_nSections < MAX_SECTIONS) s_sections[s_nSections++] = fn;
+}
+
+void reset() {
+  portENTER_CRITICAL(&s_mux);
+  memset(s_tick, 0, sizeof(s_tick));
+  memset(s_hist, 0, sizeof(s_hist));
+  s_havePending = s_haveInflight = false;
+  portEXIT_CRITICAL(&s_mux);
+}
+
+// -------------- JSON --------------
+static void kv(String& out, const char* k, uint32_t v, bool comma = true) {
+  if (comma) out += ',';
+  out += '"'; out += k; out += "\":"; out += v;
+}
+
+void json(String& out) {
+  TickStat ticks[T_COUNT];
+  HistStat hist[H_COUNT];
+  portENTER_CRITICAL(&s_mux);
+  memcpy(ticks, s_tick, sizeof(ticks));
+  memcpy(hist, s_hist, sizeof(hist));
+  portEXIT_CRITICAL(&s_mux);
+
+  out.reserve(2048);
+  out = "{";
+  kv(out, "uptime_ms", millis(), false);
+
+  out += ",\"heap\":{";
+  kv(out, "size", ESP.getHeapSize(), false);
+  kv(out, "free", ESP.getFreeHeap());
+  kv(out, "min_free", ESP.getMinFreeHeap());
+  kv(out, "max_alloc", ESP.getMaxAllocHeap());
+  out += "},\"psram\":{";
+  kv(out, "size", ESP.getPsramSize(), false);
+  kv(out, "free", ESP.getFreePsram());
+  kv(out, "min_free", ESP.getMinFreePsram());
+  out += '}';
+
+  out += ",\"ticks\":{";
+  for (uint8_t i = 0; i < T_COUNT; ++i) {
+    const TickStat& s = ticks[i];
+    if (i) out += ',';
+    out += '"'; out += TICK_NAMES[i]; out += "\":{";
+    kv(out, "n", s.n, false);
+    kv(out, "avg_us", s.n ? (uint32_t)(s.total / s.n) : 0);
+    kv(out, "max_us", s.max);
+    kv(out, "last_us", s.last);
+    out += '}';
+  }
+  out += '}';
+
+  out += ",\"hist\":{";
+  for (uint8_t i = 0; i < H_COUNT; ++i) {
+    const HistStat& s = hist[i];
+    if (i) out += ',';
+    out += '"'; out += HIST_NAMES[i]; out += "\":{";
+    kv(out, "n", s.n, false);
+    kv(out, "avg_us", s.n ? (uint32_t)(s.total / s.n) : 0);
+    kv(out, "p50_us", pctOf(s, 50));
+    kv(out, "p99_us", pctOf(s, 99));
+    kv(out, "max_us", s.max);
+    // [upper bound us, count] for the non-empty buckets
+    out += ",\"buckets\":[";
+    bool first = true;
+    for (uint8_t b = 0; b < BUCKETS; ++b) {
+      if (!s.b[b]) continue;
+      if (!first) out += ',';
+      first = false;
+      out += '['; out += bucketTop(b); out += ','; out += s.b[b]; out += ']';
+    }
+    out += "]}";
+  }
+  out += '}';
+
+  out += ",\"sched\":{";
+  kv(out, "idle_pm", Sched::idlePermille(), false);
+  out += ",\"tasks\":[";
+  for (size_t i = 0; i < Sched::count(); ++i) {
+    Sched::TaskStats t;
+    if (!Sched::stats(i, t)) break;
+    if (i) out += ',';
+    out += "{\"name\":\""; out += t.name ? t.name : ""; out += '"';
+    kv(out, "period_ms", t.periodMs);
+    kv(out, "budget_us", t.budgetUs);
+    kv(out, "runs", t.runs);
+    kv(out, "overruns", t.overruns);
+    kv(out, "late", t.late);
+    kv(out, "avg_us", t.runs ? (uint32_t)(t.totalUs / t.runs) : 0);
+    kv(out, "max_us", t.maxUs);
+    out += '}';
+  }
+  out += "]}";
+
+  out += ",\"oled\":{";
+  kv(out, "frames", OledDamage::framesFlushed(), false);
+  kv(out, "tiles_sent", OledDamage::tilesSent());
+  kv(out, "tiles_skipped", OledDamage::tilesSkipped());
+  kv(out, "i2c_txns", OledAsync::transactions());
+  kv(out, "i2c_bytes", OledAsync::bytesSent());
+  kv(out, "queue_stalls", OledAsync::stalls());
+  out += '}';
+
+  for (uint8_t i = 0; i < s_nSections; ++i) { out += ','; s_sections[i](out); }
+  out += '}';
+}
+
+} // namespace Metrics
@@ -0,0 +1,74 @@
+#pragma once
+#include <Arduino.h>
+
+// Runtime profiling counters, served as JSON at /metrics (see WiFiMgr).
+//
+// - Ticks: cycle-counter timing of one subsystem step (count/avg/max/last).
+// - Histograms: log-bucketed latencies (I2C transactions, HTTP requests,
+//   end-to-end telemetry latency), 4 buckets per octave.
+// - Heap/PSRAM free and low-water marks, scheduler task stats and display
+//   transfer counters are read when the JSON is built.
+//
+// Recording is safe from any task; each record is a few dozen cycles.
+
+namespace Metrics {
+
+enum Tick : uint8_t {
+  T_UDP_DRAIN = 0,      // one datagram: socket read -> queued
+  T_PARSE,              // Telemetry decode of one frame
+  T_DRAW,               // render pass (view + Insignia), incl. its flush
+  T_FLUSH,              // frame/DDRAM transfer (OledDamage / US2066 flush)
+  T_INSIGNIA_RESOLVE,   // title -> id resolution on the worker
+  T_INSIGNIA_LOAD,      // by_id model load on the worker
+  T_WEATHER_FETCH,      // one weather/geo step
+  T_COUNT
+};
+
+enum Hist : uint8_t {
+  H_I2C = 0,            // one I2C transaction, us
+  H_HTTP,               // one HTTP request (connect -> response status), us
+  H_LAT_PARSE,          // telemetry: socket receive -> decoded and published
+  H_LAT_RENDER,         // telemetry: socket receive -> first frame handed to the display
+  H_LAT_PANEL,          // telemetry: socket receive -> that frame fully on the panel
+  H_NET_DELAY,          // v2 sender_ts: one-way delay above the best seen (jitter/queueing)
+  H_SPI,                // one SPI panel transfer (DMA), us
+  H_COUNT
+};
+
+void record(Tick t, uint32_t us);
+void sample(Hist h, uint32_t us);
+
+// Percentile (0..100) from a histogram; bucket upper bound, us. 0 if empty.
+uint32_t percentile(Hist h, uint8_t pct);
+
+// End-to-end telemetry latency. Telemetry reports each published change with
+// the receive time of the frame that caused it; the display drivers report
+// when a frame is handed over and when it finished transferring. Changes
+// that arrive before the next frame fold into the oldest pending one.
+void latChanged(uint32_t rxUs);
+void latFrame();
+void latSent();
+// v2 header sender_ts (sender clock, ms). Clocks aren't synced, so this
+// tracks delay relative to the smallest rx - sender offset seen.
+void latSender(uint32_t senderMs, uint32_t rxMs);
+
+// Times its scope with the CPU cycle counter (micros() past ~1 s, where the
+// 32-bit counter would wrap).
+class Scope {
+ public:
+  explicit Scope(Tick t) : t_(t), c0_(ESP.getCycleCount()), u0_(micros()) {}
+  ~Scope();
+ private:
+  Tick     t_;
+  uint32_t c0_, u0_;
+};
+
+// Extra JSON members appended by modules that own instance state
+// (e.g. the US2066 driver). fn appends "name":{...} without a leading comma.
+typedef void (*Section)(String& out);
+void addSection(Section fn);
+
+void json(String& out);
+void reset();
+
+} // namespace Metrics
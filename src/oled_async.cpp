@@ -0,0 +1,238 @@
+#include "oled_async.h"
+#include "metrics.h"
+#include "i2c_bus.h"
+#include <U8g2lib.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/message_buffer.h>
+#include <driver/spi_master.h>
+#include <driver/gpio.h>
+
+namespace OledAsync {
+
+// One message = one U8g2 transfer: [addr][control byte][payload...]. A tile
+// row is 128 data bytes; U8g2 never sends more than that per transfer.
+static const size_t MSG_MAX     = 2 + 128 + 8;
+// ~2 frames: 8 pages x (tile data + cursor commands) each, plus framing
+static const size_t QUEUE_BYTES = 2 * 8 * (MSG_MAX + 4 + 16);
+
+static TwoWire*              s_wire = nullptr;
+static spi_device_handle_t   s_spi  = nullptr;   // set: SPI transport instead of s_wire
+static int8_t                s_dcPin = -1;
+static MessageBufferHandle_t s_q    = nullptr;
+static TaskHandle_t          s_task = nullptr;
+static bool                  s_attached = false;
+
+static volatile uint32_t s_oledHz = OLED_I2C_HZ;
+static uint32_t s_baseHz = 400000;
+
+// Producer side (render task)
+static uint8_t  s_msg[MSG_MAX];
+static size_t   s_len = 0;
+static volatile uint32_t s_queued = 0, s_done = 0;   // messages (written by one side each)
+static uint32_t s_txns = 0, s_bytes = 0, s_stalls = 0;
+
+static void enqueue(size_t n) {
+  if (xMessageBufferSpacesAvailable(s_q) < n + sizeof(size_t)) s_stalls++;
+  xMessageBufferSend(s_q, s_msg, n, portMAX_DELAY);
+  s_queued++;
+}
+
+static void post() {
+  if (s_len > 1) enqueue(s_len);
+  s_len = 0;
+}
+
+static uint8_t byteCb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+  switch (msg) {
+    case U8X8_MSG_BYTE_INIT:           // Wire is started by the sketch
+    case U8X8_MSG_BYTE_SET_DC:
+      return 1;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      s_msg[0] = u8x8_GetI2CAddress(u8x8) >> 1;
+      s_len = 1;
+      return 1;
+    case U8X8_MSG_BYTE_SEND: {
+      const uint8_t* p = (const uint8_t*)arg_ptr;
+      while (arg_int--) {
+        if (s_len == MSG_MAX) {
+          // oversized transfer: continue in a new message with the same control byte
+          const uint8_t addr = s_msg[0], ctl = s_msg[1];
+          post();
+          s_msg[0] = addr; s_msg[1] = ctl; s_len = 2;
+        }
+        s_msg[s_len++] = *p++;
+      }
+      return 1;
+    }
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      post();
+      return 1;
+  }
+  return 0;
+}
+
+// SPI: one message = [payload...][D/C level]. The level goes last so the
+// payload starts word-aligned and the SPI master can DMA straight from the
+// bus task's buffer.
+static uint8_t s_spiDc = 0;
+
+static void postSpi() {
+  if (s_len) { s_msg[s_len] = s_spiDc; enqueue(s_len + 1); }
+  s_len = 0;
+}
+
+static uint8_t spiByteCb(u8x8_t*, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+  switch (msg) {
+    case U8X8_MSG_BYTE_INIT:           // bus and device set up in attachSpi()
+      return 1;
+    case U8X8_MSG_BYTE_SET_DC:
+      if (arg_int != s_spiDc) { postSpi(); s_spiDc = arg_int; }
+      return 1;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      s_len = 0;
+      return 1;
+    case U8X8_MSG_BYTE_SEND: {
+      const uint8_t* p = (const uint8_t*)arg_ptr;
+      while (arg_int--) {
+        if (s_len == MSG_MAX - 1) postSpi();   // leave room for the D/C byte
+        s_msg[s_len++] = *p++;
+      }
+      return 1;
+    }
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      postSpi();
+      return 1;
+  }
+  return 0;
+}
+
+// Consumer side (bus task)
+static void sendSpi(const uint8_t* m, size_t n) {
+  gpio_set_level((gpio_num_t)s_dcPin, m[n - 1]);
+  spi_transaction_t t = {};
+  t.length    = (n - 1) * 8;          // bits
+  t.tx_buffer = m;
+  const uint32_t t0 = micros();
+  spi_device_transmit(s_spi, &t);     // DMA; the task sleeps until it is out
+  Metrics::sample(Metrics::H_SPI, micros() - t0);
+  s_txns++;
+  s_bytes += n - 1;
+}
+
+static void sendMsg(const uint8_t* m, size_t n) {
+  const uint8_t addr = m[0], ctl = m[1];
+  const uint8_t* p = m + 2;
+  size_t left = n - 2;
+  do {
+    // longer than the Wire TX buffer: split, repeating the control byte
+    s_wire->beginTransmission(addr);
+    s_wire->write(ctl);
+    const size_t cnt = left ? s_wire->write(p, left) : 0;
+    const uint32_t t0 = micros();
+    s_wire->endTransmission();
+    Metrics::sample(Metrics::H_I2C, micros() - t0);
+    s_txns++;
+    s_bytes += cnt + 2;               // address + control + payload
+    p += cnt; left -= cnt;
+    if (left && !cnt) break;
+  } while (left);
+}
+
+static void busTask(void*) {
+  alignas(4) static uint8_t m[MSG_MAX];
+  uint32_t busHz = s_baseHz;
+  bool held = false;
+  for (;;) {
+    const size_t n = xMessageBufferReceive(s_q, m, sizeof(m), portMAX_DELAY);
+    if (s_spi) {                          // the panel has the SPI bus to itself
+      if (n >= 2) sendSpi(m, n);
+      else if (n == 1) Metrics::latSent();
+      s_done++;
+      continue;
+    }
+    // hold the bus for the whole burst; other devices get it between frames
+    if (!held) { I2CBus::lock(s_wire); held = true; }
+    const uint32_t want = s_oledHz;
+    if (busHz != want) { s_wire->setClock(want); busHz = want; }
+    if (n >= 2) sendMsg(m, n);
+    else if (n == 1) Metrics::latSent();   // frameEnd() marker
+    s_done++;
+    if (xMessageBufferIsEmpty(s_q)) {
+      if (busHz != s_baseHz) { s_wire->setClock(s_baseHz); busHz = s_baseHz; }
+      I2CBus::unlock(s_wire);
+      held = false;
+    }
+  }
+}
+
+bool attach(U8G2* g, TwoWire* w, uint32_t oledHz) {
+  if (!g || !w) return false;
+  s_wire = w;
+  s_oledHz = oledHz;
+  s_baseHz = w->getClock();
+  if (!s_q) s_q = xMessageBufferCreate(QUEUE_BYTES);
+  if (!s_q) return false;               // keep the stock synchronous callback
+  if (!s_task) xTaskCreatePinnedToCore(busTask, "oled_tx", 3072, nullptr, 2, &s_task, 0);
+  if (!s_task) return false;
+  g->getU8x8()->byte_cb = byteCb;
+  s_attached = true;
+  return true;
+}
+
+bool attachSpi(U8G2* g, const SpiPins& pins, uint32_t hz) {
+  if (!g || pins.dc < 0 || s_attached) return false;
+  spi_bus_config_t bus = {};
+  bus.mosi_io_num   = pins.mosi;
+  bus.miso_io_num   = -1;               // write-only panel
+  bus.sclk_io_num   = pins.sck;
+  bus.quadwp_io_num = -1;
+  bus.quadhd_io_num = -1;
+  bus.max_transfer_sz = MSG_MAX;
+  if (spi_bus_initialize(OLED_SPI_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK) return false;
+  spi_device_interface_config_t dev = {};
+  dev.clock_speed_hz = (int)hz;
+  dev.mode           = 0;
+  dev.spics_io_num   = pins.cs;
+  dev.queue_size     = 1;
+  if (spi_bus_add_device(OLED_SPI_HOST, &dev, &s_spi) != ESP_OK) {
+    s_spi = nullptr;
+    spi_bus_free(OLED_SPI_HOST);        // leave the bus free for a retry / the I2C path
+    return false;
+  }
+  pinMode(pins.dc, OUTPUT);
+  s_dcPin = pins.dc;
+
+  if (!s_q) s_q = xMessageBufferCreate(QUEUE_BYTES);
+  if (s_q && !s_task) xTaskCreatePinnedToCore(busTask, "oled_tx", 3072, nullptr, 2, &s_task, 0);
+  if (!s_q || !s_task) {
+    spi_bus_remove_device(s_spi);
+    spi_bus_free(OLED_SPI_HOST);
+    s_spi = nullptr;
+    s_dcPin = -1;
+    return false;
+  }
+  g->getU8x8()->byte_cb = spiByteCb;
+  s_attached = true;
+  return true;
+}
+
+void setClock(uint32_t oledHz) { s_oledHz = oledHz; }   // I2C only
+
+void frameEnd() {
+  if (!s_attached) { Metrics::latSent(); return; }
+  s_msg[0] = 0; s_len = 1;
+  xMessageBufferSend(s_q, s_msg, 1, portMAX_DELAY);
+  s_queued++;
+  s_len = 0;
+}
+
+void sync() {
+  while (s_task && s_done != s_queued) vTaskDelay(1);
+}
+
+uint32_t transactions() { return s_txns; }
+uint32_t bytesSent()    { return s_bytes; }
+uint32_t stalls()       { return s_stalls; }
+
+} // namespace OledAsync
@@ -0,0 +1,56 @@
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+
+class U8G2;
+
+// Asynchronous I2C transport for the U8g2 SSD1309 path.
+//
+// Replaces the U8g2 byte callback: each I2C transfer U8g2 issues (commands,
+// tile data) is copied into a message queue and put on the bus by a task on
+// core 0. The queue holds about two frames, so the next frame renders while
+// the previous one is still going out; the renderer only blocks when it gets
+// two frames ahead.
+//
+// The panel may run faster than the rest of the bus: the clock is raised to
+// oledHz while OLED traffic drains and put back once the queue is empty.
+// 1 MHz (Fast-mode Plus) works on most SSD1309 modules; the LC709203F on the
+// same bus is only rated for 400 kHz, hence the switch. The bus task holds
+// the I2CBus lock from the first transfer of a burst until the queue is
+// empty, so shared-bus devices are only accessed between frames.
+//
+// attachSpi() puts the same queue in front of a 4-wire SPI panel instead:
+// the bus task sets D/C and hands each transfer to the ESP-IDF SPI master,
+// which clocks it out by DMA while the task sleeps. Nothing else is on that
+// bus, so there is no locking or clock switching.
+
+#ifndef OLED_I2C_HZ
+#define OLED_I2C_HZ 400000
+#endif
+#ifndef OLED_SPI_HOST
+#define OLED_SPI_HOST SPI2_HOST
+#endif
+
+namespace OledAsync {
+
+// Call after the U8G2 constructor and before g->begin(). Wire must already be
+// started; the bus clock found at attach() is restored between OLED bursts.
+bool attach(U8G2* g, TwoWire* w = &Wire, uint32_t oledHz = OLED_I2C_HZ);
+
+// SPI instead (call either attach, once). -1 = pin not used (cs tied low).
+// false leaves U8g2's stock callback, which doesn't know these pins.
+struct SpiPins { int8_t sck, mosi, cs, dc; };
+bool attachSpi(U8G2* g, const SpiPins& pins, uint32_t hz);
+
+void setClock(uint32_t oledHz);
+void sync();                  // block until everything queued is on the wire
+// Mark the end of a frame; reported to Metrics::latSent() once the bus task
+// has sent everything before it (right away when not attached).
+void frameEnd();
+
+// Stats (since boot)
+uint32_t transactions();      // I2C / SPI transactions sent
+uint32_t bytesSent();         // bytes on the wire (incl. control bytes)
+uint32_t stalls();            // renderer waited for queue space
+
+} // namespace OledAsync
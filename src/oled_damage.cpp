@@ -0,0 +1,80 @@
+#include "oled_damage.h"
+#include "metrics.h"
+#include "oled_async.h"
+#include <U8g2lib.h>
+#include <string.h>
+
+namespace OledDamage {
+
+// Sized for 128x64 (16x8 tiles); larger buffers fall back to sendBuffer().
+static const size_t SHADOW_BYTES = 128 * 64 / 8;
+
+// Unchanged tiles between two dirty runs cheaper to resend than to split
+// the run: each updateDisplayArea() costs a few command bytes + I2C start.
+static const uint8_t MERGE_GAP_TILES = 2;
+
+static uint8_t  s_shadow[SHADOW_BYTES];
+static bool     s_valid = false;      // shadow mirrors the panel
+static uint32_t s_frames = 0, s_sent = 0, s_skipped = 0;
+
+void invalidate() { s_valid = false; }
+
+static void flushFrame(U8G2* g);
+
+void flush(U8G2* g) {
+  if (!g) return;
+  Metrics::Scope m(Metrics::T_FLUSH);
+  Metrics::latFrame();
+  flushFrame(g);
+  OledAsync::frameEnd();
+}
+
+static void flushFrame(U8G2* g) {
+  uint8_t*      buf = g->getBufferPtr();
+  const uint8_t tw  = g->getBufferTileWidth();
+  const uint8_t th  = g->getBufferTileHeight();
+  const size_t  len = (size_t)tw * th * 8;
+
+  if (len > SHADOW_BYTES) { g->sendBuffer(); return; }
+
+  if (!s_valid) {
+    g->sendBuffer();
+    memcpy(s_shadow, buf, len);
+    s_valid = true;
+    s_frames++;
+    s_sent += (uint32_t)tw * th;
+    return;
+  }
+
+  bool any = false;
+  for (uint8_t ty = 0; ty < th; ++ty) {
+    const size_t row = (size_t)ty * tw * 8;
+    int runStart = -1, runEnd = -1;     // inclusive tile range of the open run
+
+    for (uint8_t tx = 0; tx <= tw; ++tx) {
+      const bool dirty = (tx < tw) && memcmp(buf + row + tx * 8, s_shadow + row + tx * 8, 8) != 0;
+      if (dirty) {
+        if (runStart < 0) runStart = tx;
+        runEnd = tx;
+        continue;
+      }
+      if (tx < tw) s_skipped++;
+      // close the run once the clean gap is too wide (or at end of page)
+      if (runStart >= 0 && (tx == tw || tx - runEnd > MERGE_GAP_TILES)) {
+        const uint8_t w = (uint8_t)(runEnd - runStart + 1);
+        g->updateDisplayArea((uint8_t)runStart, ty, w, 1);
+        memcpy(s_shadow + row + runStart * 8, buf + row + runStart * 8, (size_t)w * 8);
+        s_sent += w;
+        any = true;
+        runStart = runEnd = -1;
+      }
+    }
+  }
+  if (any) s_frames++;
+}
+
+uint32_t framesFlushed() { return s_frames; }
+uint32_t tilesSent()     { return s_sent; }
+uint32_t tilesSkipped()  { return s_skipped; }
+
+} // namespace OledDamage
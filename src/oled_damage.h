@@ -0,0 +1,23 @@
+#pragma once
+#include <Arduino.h>
+
+class U8G2;
+
+// Damage-tracked flush for U8g2 full-buffer displays.
+//
+// Keeps a shadow of what the panel currently shows and, instead of
+// sendBuffer(), pushes only the 8x8 tiles that changed (merged into runs per
+// page) via updateDisplayArea(). A ticker line moving costs ~2 pages of
+// I2C traffic instead of the whole 1 KB frame.
+
+namespace OledDamage {
+
+void flush(U8G2* g);          // drop-in replacement for g->sendBuffer()
+void invalidate();            // next flush() sends the full frame (e.g. after panel reset)
+
+// Stats (since boot)
+uint32_t framesFlushed();     // flush() calls that sent anything
+uint32_t tilesSent();         // total 8x8 tiles transferred
+uint32_t tilesSkipped();      // tiles that matched the shadow
+
+} // namespace OledDamage
@@ -0,0 +1,359 @@
+#include "ota_mgr.h"
+#include "led_stat.h"
+#include "settings.h"
+#include "mem.h"
+#include <Update.h>
+#include <HTTPClient.h>
+#include <WiFiClientSecure.h>
+#include <mbedtls/sha256.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/stream_buffer.h>
+
+// mbedtls 2.x (IDF 4.x) spells the returning variants *_ret
+#if MBEDTLS_VERSION_NUMBER < 0x03000000
+#define sha256_starts(c)       mbedtls_sha256_starts_ret((c), 0)
+#define sha256_update(c, p, n) mbedtls_sha256_update_ret((c), (p), (n))
+#define sha256_finish(c, out)  mbedtls_sha256_finish_ret((c), (out))
+#else
+#define sha256_starts(c)       mbedtls_sha256_starts((c), 0)
+#define sha256_update(c, p, n) mbedtls_sha256_update((c), (p), (n))
+#define sha256_finish(c, out)  mbedtls_sha256_finish((c), (out))
+#endif
+
+namespace OtaMgr {
+
+static const size_t   CHUNK          = 4096;     // writer read size (one flash sector)
+static const uint32_t IDLE_TIMEOUT_MS = 15000;   // no data this long = failed transfer
+static const uint32_t URL_REBOOT_MS  = 1500;     // URL pulls restart on their own
+
+enum class Job : uint8_t { None = 0, Upload, Url };
+
+// Upload buffer: s_sb is the one the current upload uses, either s_sbSmall
+// (OTA_BUFFER_BYTES, internal, kept) or a bulk one sized for the request.
+static StreamBufferHandle_t s_sb      = nullptr;
+static StreamBufferHandle_t s_sbSmall = nullptr;
+static StreamBufferHandle_t s_sbBig   = nullptr;
+static StaticStreamBuffer_t s_sbBigCtl;
+static uint8_t*             s_sbBigMem = nullptr;   // storage behind s_sbBig
+static TaskHandle_t         s_task = nullptr;
+static portMUX_TYPE         s_mux  = portMUX_INITIALIZER_UNLOCKED;
+
+static Status        s_st;                  // guarded by s_mux
+static volatile Job  s_job = Job::None;
+static volatile bool s_inputDone = false;   // uploader sent its last chunk
+static const void* volatile s_owner = nullptr;   // request feeding the upload (web task)
+static volatile bool s_abort = false;
+static const char* volatile s_abortWhy = nullptr;  // reason for the writer, null = "aborted"
+static String        s_url;
+static char          s_want[65] = "";       // expected digest (lowercase hex) or ""
+static uint32_t      s_doneAt = 0;
+
+static void (*s_onActive)(bool) = nullptr;
+
+// -------- state helpers --------
+static void setState(State st) {
+  portENTER_CRITICAL(&s_mux);
+  s_st.state = st;
+  portEXIT_CRITICAL(&s_mux);
+}
+
+static void fail(const char* why) {
+  if (Update.isRunning()) Update.abort();
+  portENTER_CRITICAL(&s_mux);
+  s_st.state = State::Failed;
+  strlcpy(s_st.error, why ? why : "failed", sizeof(s_st.error));
+  portEXIT_CRITICAL(&s_mux);
+  Serial.printf("[OTA] failed: %s\n", why ? why : "?");
+}
+
+bool validSha256(const char* hex) {
+  if (!hex || strlen(hex) != 64) return false;
+  for (uint8_t i = 0; i < 64; ++i) if (!isxdigit((unsigned char)hex[i])) return false;
+  return true;
+}
+
+static bool claim(bool fromUrl, const char* sha256Hex) {
+  if (sha256Hex && sha256Hex[0] && !validSha256(sha256Hex)) return false;
+  portENTER_CRITICAL(&s_mux);
+  const bool busy = (s_st.state == State::Receiving || s_st.state == State::Verifying ||
+                     s_job != Job::None);
+  if (!busy) {
+    s_st = Status();
+    s_st.state = State::Receiving;
+    s_st.fromUrl = fromUrl;
+  }
+  portEXIT_CRITICAL(&s_mux);
+  if (busy) return false;
+
+  s_want[0] = '\0';
+  if (sha256Hex && sha256Hex[0]) {
+    for (uint8_t i = 0; i < 64; ++i) s_want[i] = (char)tolower((unsigned char)sha256Hex[i]);
+    s_want[64] = '\0';
+  }
+  s_inputDone = false;
+  s_abort = false;
+  s_abortWhy = nullptr;
+  return true;
+}
+
+// -------- writer task --------
+struct Writer {
+  mbedtls_sha256_context sha;
+  uint32_t lastData = 0;
+
+  bool start(size_t size) {
+    mbedtls_sha256_init(&sha);
+    sha256_starts(&sha);
+    lastData = millis();
+    if (!Update.begin(size ? size : UPDATE_SIZE_UNKNOWN)) { fail(Update.errorString()); return false; }
+    return true;
+  }
+
+  bool put(uint8_t* p, size_t n) {
+    sha256_update(&sha, p, n);
+    if (Update.write(p, n) != n) { fail(Update.errorString()); return false; }
+    lastData = millis();
+    portENTER_CRITICAL(&s_mux);
+    s_st.bytes += n;
+    portEXIT_CRITICAL(&s_mux);
+    return true;
+  }
+
+  void finish() {
+    setState(State::Verifying);
+    uint8_t d[32];
+    sha256_finish(&sha, d);
+    mbedtls_sha256_free(&sha);
+    char hex[65];
+    for (uint8_t i = 0; i < 32; ++i) snprintf(hex + i * 2, 3, "%02x", d[i]);
+    portENTER_CRITICAL(&s_mux);
+    memcpy(s_st.sha256, hex, sizeof(hex));
+    portEXIT_CRITICAL(&s_mux);
+
+    if (s_want[0] && strcmp(s_want, hex) != 0) { fail("sha256 mismatch"); return; }
+    if (!Update.end(true)) { fail(Update.errorString()); return; }
+    setState(State::Done);
+    Serial.printf("[OTA] done: %u bytes, sha256 %s\n", (unsigned)Update.progress(), hex);
+  }
+
+  void drop() { mbedtls_sha256_free(&sha); }
+};
+
+static void runUpload() {
+  static uint8_t buf[CHUNK];
+  Writer w;
+  if (!w.start(0)) { xStreamBufferReset(s_sb); return; }
+  for (;;) {
+    if (s_abort) { w.drop(); fail(s_abortWhy ? s_abortWhy : "aborted"); return; }
+    const size_t n = xStreamBufferReceive(s_sb, buf, sizeof(buf), pdMS_TO_TICKS(100));
+    if (n) { if (!w.put(buf, n)) { w.drop(); return; } continue; }
+    if (s_inputDone && xStreamBufferIsEmpty(s_sb)) break;
+    if (millis() - w.lastData > IDLE_TIMEOUT_MS) { w.drop(); fail("upload stalled"); return; }
+  }
+  w.finish();
+}
+
+static void runUrl() {
+  static uint8_t buf[CHUNK];
+  WiFiClient       plain;
+  WiFiClientSecure ssl;
+  WiFiClient*      cli = &plain;
+  if (s_url.startsWith("https://")) {
+    ssl.setInsecure();               // integrity comes from the sha256
+    cli = &ssl;
+  }
+  HTTPClient http;
+  http.setTimeout(IDLE_TIMEOUT_MS);
+  if (!http.begin(*cli, s_url)) { fail("bad url"); return; }
+  const int code = http.GET();
+  if (code != HTTP_CODE_OK) {
+    http.end();
+    char why[32];
+    snprintf(why, sizeof(why), "http %d", code);
+    fail(why);
+    return;
+  }
+  const int size = http.getSize();     // -1 when chunked
+  portENTER_CRITICAL(&s_mux);
+  s_st.total = size > 0 ? (uint32_t)size : 0;
+  portEXIT_CRITICAL(&s_mux);
+
+  Writer w;
+  if (!w.start(size > 0 ? (size_t)size : 0)) { http.end(); return; }
+  WiFiClient* in = http.getStreamPtr();
+  uint32_t got = 0;
+  while (size <= 0 || got < (uint32_t)size) {
+    if (s_abort) { w.drop(); http.end(); fail("aborted"); return; }
+    const int avail = in->available();
+    if (avail > 0) {
+      const size_t n = in->readBytes(buf, min((size_t)avail, sizeof(buf)));
+      if (n && !w.put(buf, n)) { w.drop(); http.end(); return; }
+      got += n;
+      continue;
+    }
+    if (!http.connected()) break;        // chunked: server closed at the end
+    if (millis() - w.lastData > IDLE_TIMEOUT_MS) { w.drop(); http.end(); fail("download stalled"); return; }
+    vTaskDelay(1);
+  }
+  http.end();
+  if (size > 0 && got < (uint32_t)size) { w.drop(); fail("short download"); return; }
+  w.finish();
+}
+
+static void writerTask(void*) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    const Job j = s_job;
+    if (j == Job::Upload) runUpload();
+    else if (j == Job::Url) runUrl();
+    s_job = Job::None;
+  }
+}
+
+static bool ensureTask() {
+  // flash writes + TLS: roomy stack, off the UI core
+  if (!s_task) xTaskCreatePinnedToCore(writerTask, "ota", 8192, nullptr, 2, &s_task, 0);
+  return s_task != nullptr;
+}
+
+// Drop the bulk buffer of the previous upload. Called from the web task (the
+// only one that writes into it) right after claim(), so the writer is idle
+// too; a failed upload's buffer stays until the next job or reboot.
+static void freeBigBuffer() {
+  if (!s_sbBig) return;
+  if (s_sb == s_sbBig) s_sb = nullptr;
+  vStreamBufferDelete(s_sbBig);
+  Mem::bulkFree(s_sbBigMem);
+  s_sbBig = nullptr;
+  s_sbBigMem = nullptr;
+}
+
+// The whole request when a bulk block that big is free, so the web server
+// never has to wait for flash; else the small internal buffer.
+static bool pickBuffer(uint32_t requestBytes) {
+  freeBigBuffer();
+  if (requestBytes > OTA_BUFFER_BYTES) {
+    s_sbBigMem = (uint8_t*)Mem::bulkAlloc((size_t)requestBytes + 1);
+    if (s_sbBigMem) {
+      s_sbBig = s_sb = xStreamBufferCreateStatic(requestBytes, 1, s_sbBigMem, &s_sbBigCtl);
+      return true;
+    }
+    Serial.printf("[OTA] no %u B block for the upload, using %u B\n",
+                  (unsigned)requestBytes, (unsigned)OTA_BUFFER_BYTES);
+  }
+  if (!s_sbSmall) s_sbSmall = xStreamBufferCreate(OTA_BUFFER_BYTES, 1);
+  s_sb = s_sbSmall;
+  return s_sb != nullptr;
+}
+
+static bool startJob(Job j) {
+  if (!ensureTask()) { fail("no memory"); return false; }
+  if (s_sb) xStreamBufferReset(s_sb);
+  s_job = j;
+  xTaskNotifyGive(s_task);
+  return true;
+}
+
+// -------- API --------
+bool beginUpload(const char* sha256Hex, uint32_t requestBytes, const void* owner) {
+  if (!owner || !claim(false, sha256Hex)) return false;
+  s_owner = owner;
+  if (!pickBuffer(requestBytes)) { fail("no memory"); return false; }
+  portENTER_CRITICAL(&s_mux);
+  s_st.total = requestBytes;           // multipart framing included: a close upper bound
+  portEXIT_CRITICAL(&s_mux);
+  Serial.printf("[OTA] upload started (%u B)\n", (unsigned)requestBytes);
+  return startJob(Job::Upload);
+}
+
+bool writeUpload(const void* owner, const uint8_t* data, size_t len) {
+  if (!owner || owner != s_owner) return false;
+  if (status().state != State::Receiving || s_job != Job::Upload) return false;
+  if (xStreamBufferSend(s_sb, data, len, 0) == len) return true;
+  // never wait on the web server task; a short write would corrupt the image
+  s_abortWhy = "upload overrun";
+  s_abort = true;
+  return false;
+}
+
+void endUpload(const void* owner) {
+  if (owner && owner == s_owner) s_inputDone = true;
+}
+
+bool ownsUpload(const void* owner) { return owner && owner == s_owner; }
+
+void dropUpload(const void* owner) {
+  if (!owner || owner != s_owner) return;
+  s_owner = nullptr;
+  if (s_inputDone || s_job != Job::Upload) return;
+  s_abortWhy = "upload disconnected";
+  s_abort = true;
+}
+
+bool beginUrl(const String& url, const char* sha256Hex) {
+  if (!url.startsWith("http://") && !url.startsWith("https://")) return false;
+  if (!validSha256(sha256Hex)) return false;
+  if (!claim(true, sha256Hex)) return false;
+  s_owner = nullptr;
+  freeBigBuffer();
+  s_url = url;
+  Serial.printf("[OTA] pulling %s\n", url.c_str());
+  return startJob(Job::Url);
+}
+
+void abort() { s_abort = true; }
+
+bool active() {
+  const State st = status().state;
+  return st == State::Receiving || st == State::Verifying;
+}
+
+uint8_t percent() {
+  const Status st = status();
+  if (st.state == State::Done) return 100;
+  if (!st.total) return 0;
+  return (uint8_t)min<uint32_t>(100, (uint64_t)st.bytes * 100 / st.total);
+}
+
+Status status() {
+  portENTER_CRITICAL(&s_mux);
+  const Status st = s_st;
+  portEXIT_CRITICAL(&s_mux);
+  return st;
+}
+
+void statusJson(String& out) {
+  static const char* const NAMES[] = { "idle", "receiving", "verifying", "done", "failed" };
+  const Status st = status();
+  out = "{\"state\":\""; out += NAMES[(uint8_t)st.state];
+  out += "\",\"source\":\""; out += st.fromUrl ? "url" : "upload";
+  out += "\",\"bytes\":"; out += st.bytes;
+  out += ",\"total\":";   out += st.total;
+  out += ",\"sha256\":\""; out += st.sha256;
+  out += "\",\"error\":\""; out += st.error;
+  out += "\"}";
+}
+
+void onActive(void (*cb)(bool)) { s_onActive = cb; }
+
+void loop() {
+  static bool wasActive = false;
+  const Status st = status();
+  const bool now = (st.state == State::Receiving || st.state == State::Verifying);
+  if (now != wasActive) {
+    wasActive = now;
+    if (now) LedStat::setStatus(LedStatus::Updating);
+    else     LedStat::setStatus(st.state == State::Done ? LedStatus::WifiConnected : LedStatus::WifiFailed);
+    if (now) s_doneAt = 0;
+    else if (st.state == State::Done) s_doneAt = millis();
+    if (s_onActive) s_onActive(now);
+  }
+  // nobody is left to call /reboot after a URL pull
+  if (st.state == State::Done && st.fromUrl && s_doneAt && millis() - s_doneAt >= URL_REBOOT_MS) {
+    Settings::flush();
+    ESP.restart();
+  }
+}
+
+} // namespace OtaMgr
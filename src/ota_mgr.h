@@ -0,0 +1,64 @@
+#pragma once
+#include <Arduino.h>
+
+// Firmware update pipeline shared by the browser upload (/ota) and URL pulls
+// (/ota/url).
+//
+// The image never touches Update from the web server task, and the web
+// server callbacks never wait: upload chunks go into a stream buffer sized
+// for the whole request (PSRAM when there is room, else OTA_BUFFER_BYTES)
+// and a writer task on core 0 feeds Update while hashing the image with
+// SHA-256. If an expected digest is given the image is only committed when
+// it matches; URL pulls require one. Clients follow progress on
+// /ota/status. URL pulls run entirely on the writer task.
+//
+// While an update runs, active() is true: the sketch pauses rendering and
+// network work and shows progress (see onActive()).
+
+// Upload buffer when no bulk (PSRAM) block holds the whole request.
+#ifndef OTA_BUFFER_BYTES
+#define OTA_BUFFER_BYTES (16 * 1024)
+#endif
+
+namespace OtaMgr {
+
+enum class State : uint8_t { Idle = 0, Receiving, Verifying, Done, Failed };
+
+struct Status {
+  State    state = State::Idle;
+  bool     fromUrl = false;
+  uint32_t bytes = 0;          // written to flash so far
+  uint32_t total = 0;          // expected size, 0 if unknown
+  char     sha256[65] = "";    // of the image, once complete
+  char     error[48] = "";
+};
+
+// Exactly 64 hex digits (either case).
+bool validSha256(const char* hex);
+
+// Browser upload: from the AsyncWebServer upload callback. None of these
+// block; a chunk that doesn't fit the buffer fails the upload. 'owner' is
+// the request that began it (any unique pointer): writes and the end from
+// anyone else are refused, so a second upload can't mix into the first.
+bool beginUpload(const char* sha256Hex, uint32_t requestBytes, const void* owner);  // sha256Hex: null/empty or valid
+bool writeUpload(const void* owner, const uint8_t* data, size_t len);
+void endUpload(const void* owner);
+bool ownsUpload(const void* owner);   // began the latest upload (until dropUpload)
+// The owner went away: forget it, and abort if its image wasn't complete.
+void dropUpload(const void* owner);
+
+// Pull an image over HTTP(S) on the writer task; sha256Hex is required
+// (the TLS peer is not verified, the digest is what makes it safe).
+bool beginUrl(const String& url, const char* sha256Hex);
+
+void abort();
+bool active();                                  // Receiving or Verifying
+uint8_t percent();                              // 0..100 (0 while the size is unknown)
+Status status();
+void statusJson(String& out);
+
+// Called from loop() when active() changes (pause/resume subsystems).
+void onActive(void (*cb)(bool active));
+void loop();
+
+} // namespace OtaMgr
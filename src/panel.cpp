@@ -0,0 +1,222 @@
+#include "panel.h"
+
+#if TYPED_PANEL_U8G2
+#include <U8g2lib.h>
+#include "display.h"
+#include "oled_async.h"
+#endif
+#if TYPED_PANEL_US2066
+#include "us2066.h"
+#include "us2066_view.h"
+#endif
+
+// ================= SSD1309 128x64 (Waveshare 2.42") =================
+// Both wirings run the same TypeDDisplay screens; only the transport and
+// the reset line differ.
+#if TYPED_PANEL_U8G2
+// The reset is pulsed here rather than by U8g2, whose NONAME2 timings add
+// a few hundred ms before anything is on the panel; tRES is only 3 us.
+static const uint32_t OLED_RESET_LOW_MS  = 2;
+static const uint32_t OLED_RESET_WAIT_MS = 10;
+
+template <class Impl>
+class Ssd1309Common : public PanelBackend<Impl> {
+public:
+  void prepare() {
+    pinMode(Impl::RST_PIN, OUTPUT);
+    digitalWrite(Impl::RST_PIN, LOW);
+    delay(OLED_RESET_LOW_MS);
+    digitalWrite(Impl::RST_PIN, HIGH);
+    delay(OLED_RESET_WAIT_MS);
+  }
+
+  void draw() { TypeDDisplay::loop(); }
+  void progress(const OtaMgr::Status&, uint8_t pct, const char* detail) {
+    TypeDDisplay::showProgress("Firmware update", pct, detail);
+  }
+  void contrast(bool dim) { TypeDDisplay::setContrast(dim ? 48 : 255); }
+  uint8_t streams() { return TypeDDisplay::streamsOnScreen(); }
+  bool idle() { return TypeDDisplay::idle(); }
+
+protected:
+  // after the transport is attached
+  static void screens(U8G2* g) {
+    g->begin();
+    g->setContrast(255);
+    g->setFlipMode(1); // use 0/1 as needed
+    TypeDDisplay::begin(g);
+    TypeDDisplay::showBootLogo();
+    TypeDDisplay::setHoldTimes(15000, 5000);
+  }
+};
+#endif
+
+#if TYPED_PANEL_SSD1309
+static U8G2_SSD1309_128X64_NONAME2_F_HW_I2C u8g2(U8G2_R0, /* reset = */ U8X8_PIN_NONE);
+
+class Ssd1309Panel : public Ssd1309Common<Ssd1309Panel> {
+public:
+  static const uint8_t ADDR = 0x3D;
+  static const int     RST_PIN = 9;     // SSD1309 RESET wired to GPIO 9
+  static constexpr const char* NAME = "ssd1309";
+
+  bool start(TwoWire* w) {
+#if TYPED_PANEL_SSD1309_SPI
+    // no ACK: not wired for I2C, let the SPI backend have it
+    w->beginTransmission(ADDR);
+    if (w->endTransmission() != 0) return false;
+#endif
+    u8g2.setI2CAddress(ADDR << 1);
+    // frames go out from core 0 while the next one renders; on its own bus
+    // the panel keeps OLED_BUS2_HZ as the base clock, so there is no switching
+    OledAsync::attach(&u8g2, w, w == &Wire ? OLED_I2C_HZ : OLED_BUS2_HZ);
+    screens(&u8g2);
+    return true;
+  }
+};
+static Ssd1309Panel s_ssd1309;
+#endif
+
+#if TYPED_PANEL_SSD1309_SPI
+// CS/DC/reset are driven by OledAsync and prepare(), not by U8g2
+static U8G2_SSD1309_128X64_NONAME2_F_4W_HW_SPI u8g2spi(U8G2_R0, U8X8_PIN_NONE, U8X8_PIN_NONE, U8X8_PIN_NONE);
+
+class Ssd1309SpiPanel : public Ssd1309Common<Ssd1309SpiPanel> {
+public:
+  static const uint8_t ADDR = 0x3D;     // buses still come up for the gauge
+  static const int     RST_PIN = OLED_SPI_RST;
+  static constexpr const char* NAME = "ssd1309-spi";
+
+  bool start(TwoWire*) {
+    const OledAsync::SpiPins pins = { OLED_SPI_SCK, OLED_SPI_MOSI, OLED_SPI_CS, OLED_SPI_DC };
+    if (!OledAsync::attachSpi(&u8g2spi, pins, OLED_SPI_HZ)) return false;
+    screens(&u8g2spi);
+    Serial.printf("[PANEL] warning: nothing on I2C, assuming an SSD1309 on SPI @ %lu Hz (not detected)\n",
+                  (unsigned long)OLED_SPI_HZ);
+    return true;
+  }
+};
+static Ssd1309SpiPanel s_ssd1309spi;
+#endif
+
+// ================= US2066 20x4 character OLED (I2C @ 0x3C) =================
+#if TYPED_PANEL_US2066
+static US2066     charOled;
+static US2066View charView;
+
+class Us2066Panel : public PanelBackend<Us2066Panel> {
+public:
+  static const uint8_t ADDR = 0x3C;
+  static constexpr const char* NAME = "us2066";
+
+  bool start(TwoWire* w) {
+    if (!charOled.begin(w, ADDR, 20, 4)) return false;
+    charOled.setBusyPolling(true);   // keeps the fixed guards if BF reads don't work
+    if (!charView.attach(&charOled)) return false;
+    // simple boot splash (one-time). The view owns data thereafter.
+    charView.splash("Type-D Wireless", "US2066 20x4", "Alt View Ready", "");
+    return true;
+  }
+
+  void draw() { charView.loop(); }
+  void progress(const OtaMgr::Status& st, uint8_t, const char* detail) {
+    charView.splash("Firmware update", st.fromUrl ? "(download)" : "(upload)", detail, "Do not power off");
+  }
+  void contrast(bool dim) { charOled.setContrast(dim ? 0x30 : 0xFF); }
+  uint8_t streams() { return charView.streamsOnScreen(); }
+  bool idle() { return false; }
+
+  // bus counters live on the driver instance
+  void metrics(String& out) {
+    const US2066::Stats& s = charOled.stats();
+    out += "\"us2066\":{\"txns\":"; out += s.txns;
+    out += ",\"data_txns\":";  out += s.dataTxns;
+    out += ",\"data_bytes\":"; out += s.dataBytes;
+    out += ",\"errors\":";     out += s.errors;
+    out += ",\"busy_poll\":";  out += charOled.busyPolling() ? "true" : "false";
+    out += '}';
+  }
+};
+static Us2066Panel s_us2066;
+#endif
+
+// ================= dispatch =================
+namespace Panel {
+
+static Kind s_kind = TYPED_PANEL_SSD1309 ? Kind::SSD1309
+                  : TYPED_PANEL_SSD1309_SPI ? Kind::SSD1309_SPI : Kind::US2066;
+
+#if TYPED_PANEL_SSD1309
+#define CASE_SSD1309(call) case Kind::SSD1309: s_ssd1309.call; break;
+#else
+#define CASE_SSD1309(call)
+#endif
+#if TYPED_PANEL_SSD1309_SPI
+#define CASE_SSD1309_SPI(call) case Kind::SSD1309_SPI: s_ssd1309spi.call; break;
+#else
+#define CASE_SSD1309_SPI(call)
+#endif
+#if TYPED_PANEL_US2066
+#define CASE_US2066(call) case Kind::US2066: s_us2066.call; break;
+#else
+#define CASE_US2066(call)
+#endif
+#define PANEL_CALL(call) \
+  do { switch (s_kind) { CASE_SSD1309(call) CASE_SSD1309_SPI(call) CASE_US2066(call) default: break; } } while (0)
+
+bool begin(Kind preferred, BusSetup bus) {
+#if TYPED_PANEL_US2066
+  if (preferred == Kind::US2066 || !TYPED_PANEL_U8G2) {
+    if (s_us2066.begin(bus)) { s_kind = Kind::US2066; return true; }
+    Serial.println("[PANEL] US2066 not found");
+  }
+#else
+  (void)preferred;
+#endif
+#if TYPED_PANEL_SSD1309
+  if (s_ssd1309.begin(bus)) { s_kind = Kind::SSD1309; return true; }
+#endif
+#if TYPED_PANEL_SSD1309_SPI
+  if (s_ssd1309spi.begin(bus)) { s_kind = Kind::SSD1309_SPI; return true; }
+#endif
+  return false;
+}
+
+Kind kind() { return s_kind; }
+
+const char* name() {
+  switch (s_kind) {
+#if TYPED_PANEL_SSD1309
+    case Kind::SSD1309:     return Ssd1309Panel::NAME;
+#endif
+#if TYPED_PANEL_SSD1309_SPI
+    case Kind::SSD1309_SPI: return Ssd1309SpiPanel::NAME;
+#endif
+#if TYPED_PANEL_US2066
+    case Kind::US2066:      return Us2066Panel::NAME;
+#endif
+    default:                return "";
+  }
+}
+
+bool detected() {
+#if TYPED_PANEL_SSD1309_SPI
+  if (s_kind == Kind::SSD1309_SPI) return false;
+#endif
+  return true;
+}
+
+void render()     { PANEL_CALL(render()); }
+void control()    { PANEL_CALL(control()); }
+void dim(bool on) { PANEL_CALL(dim(on)); }
+
+void metricsJson(String& out) {
+  out += "\"panel\":{\"name\":\""; out += name(); out += '"';
+  out += ",\"detected\":"; out += detected() ? "true" : "false";
+#if TYPED_PANEL_US2066
+  out += ','; s_us2066.metrics(out);
+#endif
+  out += '}';
+}
+
+} // namespace Panel
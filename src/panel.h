@@ -0,0 +1,149 @@
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+#include "ota_mgr.h"
+#include "insignia.h"
+#include "telemetry.h"
+
+// Display backends behind one pipeline.
+//
+// Decoding (Telemetry), scheduling (Sched), update progress, reverse control,
+// battery dimming and Insignia timing are the same for every panel; a
+// backend only supplies the panel-specific steps to PanelBackend<Impl>
+// (CRTP, so the calls resolve at compile time: no vtable, and inlined when
+// only one backend is built).
+//
+// TYPED_PANEL_SSD1309=0 / TYPED_PANEL_US2066=0 leave a panel out of the
+// image entirely (its driver, screens and objects); TYPED_PANEL_SSD1309_SPI=1
+// builds the SPI wiring in.
+// With a single backend the portal's display choice is ignored and nothing
+// is probed at boot.
+//
+// The SSD1309 can be wired for I2C or 4-wire SPI. SPI is write-only and has
+// no ACK to probe, so an SPI build tries I2C first and assumes SPI when
+// nothing answers at 0x3D. That also "succeeds" with no panel at all, which
+// is why it is off unless asked for.
+
+#ifndef TYPED_PANEL_SSD1309
+#define TYPED_PANEL_SSD1309 1
+#endif
+#ifndef TYPED_PANEL_SSD1309_SPI
+#define TYPED_PANEL_SSD1309_SPI 0
+#endif
+#ifndef TYPED_PANEL_US2066
+#define TYPED_PANEL_US2066 1
+#endif
+#define TYPED_PANEL_U8G2 (TYPED_PANEL_SSD1309 || TYPED_PANEL_SSD1309_SPI)   // TypeDDisplay screens
+#if !TYPED_PANEL_U8G2 && !TYPED_PANEL_US2066
+#error "enable at least one display backend (TYPED_PANEL_SSD1309 / _SSD1309_SPI / _US2066)"
+#endif
+
+// Optional second bus for the display (portal "Display Bus"): the panel gets
+// Wire1 and its own clock, the gauge keeps Wire at 400 kHz.
+#ifndef OLED_BUS2_SDA
+#define OLED_BUS2_SDA 4
+#endif
+#ifndef OLED_BUS2_SCL
+#define OLED_BUS2_SCL 5
+#endif
+#ifndef OLED_BUS2_HZ
+#define OLED_BUS2_HZ 1000000
+#endif
+
+// SSD1309 on SPI (HW SPI2 + DMA). The panel's serial clock cycle is 100 ns
+// min, so 10 MHz is the ceiling; a full frame is ~0.9 ms at 8 MHz.
+#ifndef OLED_SPI_SCK
+#define OLED_SPI_SCK 12
+#endif
+#ifndef OLED_SPI_MOSI
+#define OLED_SPI_MOSI 11
+#endif
+#ifndef OLED_SPI_CS
+#define OLED_SPI_CS 10
+#endif
+#ifndef OLED_SPI_DC
+#define OLED_SPI_DC 13
+#endif
+#ifndef OLED_SPI_RST
+#define OLED_SPI_RST 9                  // same reset line as the I2C wiring
+#endif
+#ifndef OLED_SPI_HZ
+#define OLED_SPI_HZ 8000000
+#endif
+
+// Brings up the bus(es) for a panel at 'addr'; returns the one it answers on.
+typedef TwoWire* (*BusSetup)(uint8_t addr);
+
+// Impl provides:
+//   static const uint8_t ADDR;  static const char* const NAME;
+//   bool start(TwoWire* w);                       // false: not there
+//   void draw();                                  // one render tick
+//   void progress(const OtaMgr::Status&, uint8_t pct, const char* detail);
+//   void contrast(bool dim);
+//   uint8_t streams();                            // TypedProto::STREAM_* on screen
+//   bool idle();                                  // saver / panel off
+// and may hide prepare() (before the bus comes up, e.g. a reset pulse).
+template <class Impl>
+class PanelBackend {
+public:
+  bool begin(BusSetup bus) {
+    impl().prepare();
+    return impl().start(bus(Impl::ADDR));
+  }
+
+  // Render task: update progress replaces the screens while OtaMgr is active.
+  void render() {
+    if (OtaMgr::active()) { drawProgress(); return; }
+    impl().draw();
+    Insignia::tick();     // after the view, so Insignia reacts to this frame
+  }
+
+  // Reverse control: tell each console which streams the panel needs now.
+  void control() {
+    if (OtaMgr::active()) Telemetry::control(0, true);
+    else                  Telemetry::control(impl().streams(), impl().idle());
+  }
+
+  void dim(bool on) { impl().contrast(on); }
+
+  void prepare() {}
+
+private:
+  uint32_t progressAt_  = 0;
+  uint8_t  progressPct_ = 0xFF;
+
+  void drawProgress() {
+    const uint32_t now = millis();
+    const OtaMgr::Status st = OtaMgr::status();
+    const uint8_t pct = st.total ? OtaMgr::percent() : 0xFF;   // >100: size unknown, no bar
+    if (pct == progressPct_ && now - progressAt_ < 1000) return;
+    progressAt_ = now; progressPct_ = pct;
+
+    char detail[24];
+    if (st.state == OtaMgr::State::Verifying) snprintf(detail, sizeof(detail), "Verifying...");
+    else if (st.total) snprintf(detail, sizeof(detail), "%u%%  %lu KB", (unsigned)pct, (unsigned long)(st.bytes / 1024));
+    else               snprintf(detail, sizeof(detail), "%lu KB", (unsigned long)(st.bytes / 1024));
+    impl().progress(st, pct, detail);
+  }
+
+  Impl& impl() { return static_cast<Impl&>(*this); }
+};
+
+// The backend in use. setup() calls begin(); the scheduler drives the rest.
+namespace Panel {
+
+enum class Kind : uint8_t { SSD1309 = 0, US2066, SSD1309_SPI };
+
+// Starts the preferred panel, else the others that are built. The SSD1309
+// preference covers both wirings (I2C first, then SPI).
+bool begin(Kind preferred, BusSetup bus);
+Kind kind();
+const char* name();               // "ssd1309" / "ssd1309-spi" / "us2066" (mDNS TXT, metrics)
+bool detected();                  // false for SPI: assumed, nothing answered
+
+void render();                    // scheduler: render task
+void control();                   // scheduler: about once a second
+void dim(bool on);                // battery profile
+void metricsJson(String& out);    // "panel" section for /metrics
+
+} // namespace Panel
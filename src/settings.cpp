@@ -0,0 +1,308 @@
+#include "settings.h"
+#include <Preferences.h>
+#include <nvs.h>
+#include <esp_idf_version.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <vector>
+#include <string.h>
+
+namespace Settings {
+
+struct Entry {
+  String   ns, key;
+  uint8_t  type = NVS_TYPE_ANY;   // nvs_type_t as stored
+  int64_t  num = 0;               // integer types
+  String   str;                   // NVS_TYPE_STR
+  std::vector<uint8_t> blob;      // NVS_TYPE_BLOB
+  bool     dirty = false;
+  bool     removed = false;
+};
+
+struct Sub { const char* ns; Listener fn; };
+
+static std::vector<Entry>  s_entries;
+static std::vector<String> s_loaded;      // namespaces read from NVS
+static const uint8_t MAX_SUBS = 8;
+static Sub     s_subs[MAX_SUBS];
+static uint8_t s_nSubs = 0;
+
+static SemaphoreHandle_t s_lock = nullptr;
+static portMUX_TYPE      s_initMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_firstDirtyAt = 0, s_lastPutAt = 0;
+static bool     s_pending = false;
+static uint32_t s_commits = 0;
+
+struct Lock {
+  Lock() {
+    if (!s_lock) {
+      // first user creates it; a race loser frees its copy
+      SemaphoreHandle_t m = xSemaphoreCreateMutex();
+      portENTER_CRITICAL(&s_initMux);
+      if (!s_lock) { s_lock = m; m = nullptr; }
+      portEXIT_CRITICAL(&s_initMux);
+      if (m) vSemaphoreDelete(m);
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+  }
+  ~Lock() { xSemaphoreGive(s_lock); }
+};
+
+// -------- loading --------
+static void readEntry(Preferences& p, const char* ns, const char* key, nvs_type_t type) {
+  Entry e;
+  e.ns = ns; e.key = key; e.type = (uint8_t)type;
+  switch (type) {
+    case NVS_TYPE_U8:  e.num = p.getUChar(key);   break;
+    case NVS_TYPE_I8:  e.num = p.getChar(key);    break;
+    case NVS_TYPE_U16: e.num = p.getUShort(key);  break;
+    case NVS_TYPE_I16: e.num = p.getShort(key);   break;
+    case NVS_TYPE_U32: e.num = p.getUInt(key);    break;
+    case NVS_TYPE_I32: e.num = p.getInt(key);     break;
+    case NVS_TYPE_U64: e.num = (int64_t)p.getULong64(key); break;
+    case NVS_TYPE_I64: e.num = p.getLong64(key);  break;
+    case NVS_TYPE_STR: e.str = p.getString(key);  break;
+    case NVS_TYPE_BLOB: {
+      e.blob.resize(p.getBytesLength(key));
+      if (!e.blob.empty()) p.getBytes(key, e.blob.data(), e.blob.size());
+      break;
+    }
+    default: return;
+  }
+  s_entries.push_back(std::move(e));
+}
+
+// Caller holds the lock.
+static void loadNs(const char* ns) {
+  for (auto& n : s_loaded) if (n == ns) return;
+  s_loaded.push_back(ns);
+
+  Preferences p;
+  if (!p.begin(ns, true)) return;           // namespace doesn't exist yet
+  nvs_entry_info_t info;
+#if ESP_IDF_VERSION_MAJOR >= 5
+  nvs_iterator_t it = nullptr;
+  for (esp_err_t err = nvs_entry_find(NVS_DEFAULT_PART_NAME, ns, NVS_TYPE_ANY, &it);
+       err == ESP_OK; err = nvs_entry_next(&it)) {
+    nvs_entry_info(it, &info);
+    readEntry(p, ns, info.key, info.type);
+  }
+  nvs_release_iterator(it);
+#else
+  for (nvs_iterator_t it = nvs_entry_find(NVS_DEFAULT_PART_NAME, ns, NVS_TYPE_ANY); it; it = nvs_entry_next(it)) {
+    nvs_entry_info(it, &info);
+    readEntry(p, ns, info.key, info.type);
+  }
+#endif
+  p.end();
+}
+
+// Caller holds the lock. nullptr if absent (or removed).
+static Entry* find(const char* ns, const char* key) {
+  loadNs(ns);
+  for (auto& e : s_entries)
+    if (!e.removed && e.key == key && e.ns == ns) return &e;
+  return nullptr;
+}
+
+void begin(const char* const* namespaces, size_t count) {
+  Lock l;
+  for (size_t i = 0; i < count; ++i) loadNs(namespaces[i]);
+}
+
+// -------- reads --------
+bool isKey(const char* ns, const char* key) {
+  Lock l;
+  return find(ns, key) != nullptr;
+}
+
+bool getBool(const char* ns, const char* key, bool def) {
+  Lock l;
+  const Entry* e = find(ns, key);
+  return (e && e->type == NVS_TYPE_U8) ? e->num != 0 : def;
+}
+
+int32_t getInt(const char* ns, const char* key, int32_t def) {
+  Lock l;
+  const Entry* e = find(ns, key);
+  return (e && e->type == NVS_TYPE_I32) ? (int32_t)e->num : def;
+}
+
+double getDouble(const char* ns, const char* key, double def) {
+  Lock l;
+  const Entry* e = find(ns, key);
+  if (!e || e->type != NVS_TYPE_BLOB || e->blob.size() != sizeof(double)) return def;
+  double v;
+  memcpy(&v, e->blob.data(), sizeof(v));
+  return v;
+}
+
+String getString(const char* ns, const char* key, const String& def) {
+  Lock l;
+  const Entry* e = find(ns, key);
+  return (e && e->type == NVS_TYPE_STR) ? e->str : def;
+}
+
+size_t getBytes(const char* ns, const char* key, void* out, size_t len) {
+  Lock l;
+  const Entry* e = find(ns, key);
+  if (!e || e->type != NVS_TYPE_BLOB || e->blob.size() > len) return 0;
+  memcpy(out, e->blob.data(), e->blob.size());
+  return e->blob.size();
+}
+
+// -------- writes --------
+static void notify(const char* ns, const char* key) {
+  for (uint8_t i = 0; i < s_nSubs; ++i)
+    if (!s_subs[i].ns || !strcmp(s_subs[i].ns, ns)) s_subs[i].fn(ns, key);
+}
+
+// Caller holds the lock. Returns the entry to fill; it is marked dirty.
+static Entry& slot(const char* ns, const char* key, nvs_type_t type) {
+  Entry* e = find(ns, key);
+  if (!e) {
+    // reuse a removed record that hasn't been committed yet
+    for (auto& r : s_entries) if (r.removed && r.key == key && r.ns == ns) { e = &r; break; }
+    if (!e) { s_entries.emplace_back(); e = &s_entries.back(); e->ns = ns; e->key = key; }
+  }
+  e->removed = false;
+  e->type = (uint8_t)type;
+  e->dirty = true;
+  const uint32_t now = millis();
+  if (!s_pending) { s_pending = true; s_firstDirtyAt = now; }
+  s_lastPutAt = now;
+  return *e;
+}
+
+static void putNum(const char* ns, const char* key, nvs_type_t type, int64_t v) {
+  {
+    Lock l;
+    const Entry* e = find(ns, key);
+    if (e && e->type == type && e->num == v) return;
+    slot(ns, key, type).num = v;
+  }
+  notify(ns, key);
+}
+
+static void putBlob(const char* ns, const char* key, const void* data, size_t len) {
+  {
+    Lock l;
+    const Entry* e = find(ns, key);
+    if (e && e->type == NVS_TYPE_BLOB && e->blob.size() == len && !memcmp(e->blob.data(), data, len)) return;
+    Entry& s = slot(ns, key, NVS_TYPE_BLOB);
+    s.blob.assign((const uint8_t*)data, (const uint8_t*)data + len);
+    s.str = String();
+  }
+  notify(ns, key);
+}
+
+void putBool(const char* ns, const char* key, bool v)      { putNum(ns, key, NVS_TYPE_U8, v ? 1 : 0); }
+void putInt(const char* ns, const char* key, int32_t v)    { putNum(ns, key, NVS_TYPE_I32, v); }
+void putDouble(const char* ns, const char* key, double v)  { putBlob(ns, key, &v, sizeof(v)); }
+void putBytes(const char* ns, const char* key, const void* data, size_t len) { putBlob(ns, key, data, len); }
+
+void putString(const char* ns, const char* key, const String& v) {
+  {
+    Lock l;
+    const Entry* e = find(ns, key);
+    if (e && e->type == NVS_TYPE_STR && e->str == v) return;
+    Entry& s = slot(ns, key, NVS_TYPE_STR);
+    s.str = v;
+    s.blob.clear();
+  }
+  notify(ns, key);
+}
+
+void remove(const char* ns, const char* key) {
+  {
+    Lock l;
+    Entry* e = find(ns, key);
+    if (!e) return;
+    slot(ns, key, (nvs_type_t)e->type).removed = true;
+  }
+  notify(ns, key);
+}
+
+void subscribe(const char* ns, Listener fn) {
+  if (fn && s_nSubs < MAX_SUBS) s_subs[s_nSubs++] = Sub{ ns, fn };
+}
+
+// -------- commit --------
+static esp_err_t write(nvs_handle_t h, const Entry& e) {
+  const char* k = e.key.c_str();
+  if (e.removed) {
+    const esp_err_t err = nvs_erase_key(h, k);
+    return err == ESP_ERR_NVS_NOT_FOUND ? ESP_OK : err;
+  }
+  switch (e.type) {
+    case NVS_TYPE_U8:  return nvs_set_u8(h, k, (uint8_t)e.num);
+    case NVS_TYPE_I8:  return nvs_set_i8(h, k, (int8_t)e.num);
+    case NVS_TYPE_U16: return nvs_set_u16(h, k, (uint16_t)e.num);
+    case NVS_TYPE_I16: return nvs_set_i16(h, k, (int16_t)e.num);
+    case NVS_TYPE_U32: return nvs_set_u32(h, k, (uint32_t)e.num);
+    case NVS_TYPE_I32: return nvs_set_i32(h, k, (int32_t)e.num);
+    case NVS_TYPE_U64: return nvs_set_u64(h, k, (uint64_t)e.num);
+    case NVS_TYPE_I64: return nvs_set_i64(h, k, e.num);
+    case NVS_TYPE_STR: return nvs_set_str(h, k, e.str.c_str());
+    case NVS_TYPE_BLOB: return nvs_set_blob(h, k, e.blob.data(), e.blob.size());
+    default: return ESP_OK;
+  }
+}
+
+// Caller holds the lock. One nvs_open / nvs_commit per namespace with dirty
+// keys. Keys stay dirty until their namespace committed; on any error the
+// whole store stays pending and is retried SETTINGS_DEBOUNCE_MS later.
+static void commitLocked() {
+  bool failed = false;
+  for (auto& ns : s_loaded) {
+    nvs_handle_t h = 0;
+    bool open = false;
+    esp_err_t err = ESP_OK;
+    for (auto& e : s_entries) {
+      if (!e.dirty || e.ns != ns) continue;
+      if (!open) {
+        err = nvs_open(ns.c_str(), NVS_READWRITE, &h);
+        if (err != ESP_OK) break;
+        open = true;
+      }
+      err = write(h, e);
+      if (err != ESP_OK) break;
+    }
+    if (open && err == ESP_OK) err = nvs_commit(h);
+    if (open) nvs_close(h);
+    if (err != ESP_OK) {
+      Serial.printf("[SETTINGS] commit of \"%s\" failed: %s\n", ns.c_str(), esp_err_to_name(err));
+      failed = true;
+      continue;
+    }
+    if (!open) continue;
+    for (auto& e : s_entries) if (e.dirty && e.ns == ns) e.dirty = false;
+    s_commits++;
+  }
+  for (size_t i = 0; i < s_entries.size(); ) {
+    if (s_entries[i].removed && !s_entries[i].dirty) s_entries.erase(s_entries.begin() + i);
+    else ++i;
+  }
+  if (failed) {
+    s_firstDirtyAt = s_lastPutAt = millis();   // back off one debounce period
+    return;
+  }
+  s_pending = false;
+}
+
+void loop() {
+  if (!s_pending) return;
+  const uint32_t now = millis();
+  if (now - s_lastPutAt < SETTINGS_DEBOUNCE_MS && now - s_firstDirtyAt < SETTINGS_MAX_DEFER_MS) return;
+  Lock l;
+  commitLocked();
+}
+
+void flush() {
+  Lock l;
+  if (s_pending) commitLocked();
+}
+
+uint32_t commits() { return s_commits; }
+
+} // namespace Settings
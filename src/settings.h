@@ -0,0 +1,52 @@
+#pragma once
+#include <Arduino.h>
+
+// Shared NVS settings store.
+//
+// Every namespace is read into RAM once (all of begin()'s list at boot, any
+// other on first use), reads are served from memory, and writes only touch
+// RAM: changed keys are committed together, one nvs_open/nvs_commit per
+// namespace, once writes have been quiet for SETTINGS_DEBOUNCE_MS (at most
+// SETTINGS_MAX_DEFER_MS after the first). A failed commit stays pending and
+// is retried. Writing an unchanged value is a no-op. Subscribers hear about
+// each key that actually changed.
+//
+// Types follow Preferences: bool = u8, int = i32, double = 8-byte blob.
+
+#ifndef SETTINGS_DEBOUNCE_MS
+#define SETTINGS_DEBOUNCE_MS 1500
+#endif
+#ifndef SETTINGS_MAX_DEFER_MS
+#define SETTINGS_MAX_DEFER_MS 5000
+#endif
+
+namespace Settings {
+
+// Preload namespaces (first thing in setup(); optional, loads are lazy).
+void begin(const char* const* namespaces, size_t count);
+
+bool    isKey    (const char* ns, const char* key);
+bool    getBool  (const char* ns, const char* key, bool def = false);
+int32_t getInt   (const char* ns, const char* key, int32_t def = 0);
+double  getDouble(const char* ns, const char* key, double def = NAN);
+String  getString(const char* ns, const char* key, const String& def = String());
+size_t  getBytes (const char* ns, const char* key, void* out, size_t len);   // bytes copied, 0 if absent
+
+void putBool  (const char* ns, const char* key, bool v);
+void putInt   (const char* ns, const char* key, int32_t v);
+void putDouble(const char* ns, const char* key, double v);
+void putString(const char* ns, const char* key, const String& v);
+void putBytes (const char* ns, const char* key, const void* data, size_t len);
+void remove   (const char* ns, const char* key);
+
+// Called on the writer's task after the RAM copy changed (before the NVS
+// commit). ns = nullptr subscribes to every namespace.
+typedef void (*Listener)(const char* ns, const char* key);
+void subscribe(const char* ns, Listener fn);
+
+void loop();          // commits settled writes (scheduler)
+void flush();         // commit now, e.g. right before ESP.restart()
+
+uint32_t commits();   // NVS sessions written since boot
+
+} // namespace Settings
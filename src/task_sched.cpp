@@ -0,0 +1,118 @@
+#include "task_sched.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace Sched {
+
+static const size_t   MAX_TASKS   = SCHED_MAX_TASKS;
+static const uint32_t MAX_IDLE_MS = 100;     // bound the wait so millis() wraps stay harmless
+
+struct Task {
+  TaskFn    fn = nullptr;
+  uint8_t   flags = 0;
+  uint32_t  due = 0;        // millis() deadline of the next run
+  TaskStats st;
+};
+
+static Task          s_tasks[MAX_TASKS];
+static size_t        s_n = 0;
+static TaskHandle_t  s_loop = nullptr;
+static volatile bool s_kick = false;
+
+// idle accounting over ~1 s windows
+static uint32_t s_winStart = 0, s_winIdle = 0, s_idlePm = 0;
+
+int add(const char* name, TaskFn fn, uint32_t periodMs, uint32_t budgetUs, uint8_t flags) {
+  if (!fn || s_n >= MAX_TASKS) return -1;
+  Task& t = s_tasks[s_n];
+  t.fn = fn;
+  t.flags = flags;
+  t.due = millis();
+  t.st = TaskStats();
+  t.st.name = name;
+  t.st.periodMs = periodMs;
+  t.st.budgetUs = budgetUs;
+  return (int)s_n++;
+}
+
+void wake() {
+  s_kick = true;
+  if (s_loop) xTaskNotifyGive(s_loop);
+}
+
+static void runOne(Task& t, uint32_t now) {
+  if (t.st.periodMs && now - t.due > t.st.periodMs) t.st.late++;
+  const uint32_t t0 = micros();
+  t.fn();
+  const uint32_t us = micros() - t0;
+
+  t.st.runs++;
+  t.st.lastUs = us;
+  t.st.totalUs += us;
+  if (us > t.st.maxUs) t.st.maxUs = us;
+  if (t.st.budgetUs && us > t.st.budgetUs) t.st.overruns++;
+
+  // next deadline on the period grid; after a long stall skip ahead instead
+  // of running a burst of catch-up iterations
+  t.due += t.st.periodMs;
+  const uint32_t after = millis();
+  if ((int32_t)(after - t.due) > 0) t.due = after + t.st.periodMs;
+}
+
+void run() {
+  if (!s_loop) s_loop = xTaskGetCurrentTaskHandle();
+
+  if (s_kick) {
+    s_kick = false;
+    const uint32_t now = millis();
+    for (size_t i = 0; i < s_n; ++i) if (s_tasks[i].flags & WAKE) s_tasks[i].due = now;
+  }
+
+  // earliest deadline first; each task at most once per pass
+  uint32_t ran = 0;
+  for (;;) {
+    const uint32_t now = millis();
+    int pick = -1;
+    for (size_t i = 0; i < s_n; ++i) {
+      if (ran & (1u << i)) continue;
+      if ((int32_t)(now - s_tasks[i].due) < 0) continue;
+      if (pick < 0 || (int32_t)(s_tasks[i].due - s_tasks[pick].due) < 0) pick = (int)i;
+    }
+    if (pick < 0) break;
+    ran |= 1u << pick;
+    runOne(s_tasks[pick], now);
+  }
+
+  // sleep until the nearest deadline; wake() cuts it short
+  const uint32_t now = millis();
+  uint32_t wait = MAX_IDLE_MS;
+  for (size_t i = 0; i < s_n; ++i) {
+    const int32_t d = (int32_t)(s_tasks[i].due - now);
+    if (d <= 0) { wait = 0; break; }
+    if ((uint32_t)d < wait) wait = (uint32_t)d;
+  }
+  if (wait && !s_kick) {
+    const uint32_t t0 = millis();
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+    s_winIdle += millis() - t0;
+  }
+
+  const uint32_t t = millis();
+  if (t - s_winStart >= 1000) {
+    s_idlePm = (uint32_t)((uint64_t)s_winIdle * 1000 / (t - s_winStart));
+    s_winStart = t;
+    s_winIdle = 0;
+  }
+}
+
+size_t count() { return s_n; }
+
+bool stats(size_t i, TaskStats& out) {
+  if (i >= s_n) return false;
+  out = s_tasks[i].st;
+  return true;
+}
+
+uint32_t idlePermille() { return s_idlePm; }
+
+} // namespace Sched
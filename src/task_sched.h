@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+
+// Cooperative scheduler for the Arduino loop task.
+//
+// Each task has a period and a time budget. run() executes the tasks that are
+// due, earliest deadline first, measures how long each took and then blocks
+// until the next deadline (or wake()), so the loop core idles instead of
+// spinning. Blocking work (HTTP, sockets, frame transfer) already lives on
+// its own FreeRTOS tasks on core 0; everything registered here runs on the
+// loop task (core 1).
+
+#ifndef SCHED_MAX_TASKS
+#define SCHED_MAX_TASKS 16     // task table; the sketch checks its list against it
+#endif
+
+namespace Sched {
+
+typedef void (*TaskFn)();
+
+enum : uint8_t {
+  WAKE = 1u << 0,        // becomes due immediately on wake() (e.g. new telemetry)
+};
+
+struct TaskStats {
+  const char* name = nullptr;
+  uint32_t periodMs = 0;
+  uint32_t budgetUs = 0;
+  uint32_t runs = 0;
+  uint32_t overruns = 0;   // runs longer than budgetUs
+  uint32_t late = 0;       // started more than one period after its deadline
+  uint32_t lastUs = 0, maxUs = 0;
+  uint64_t totalUs = 0;
+};
+
+// Register before the first run(). Returns the task index, or -1 when full.
+int  add(const char* name, TaskFn fn, uint32_t periodMs, uint32_t budgetUs, uint8_t flags = 0);
+
+void run();                 // call from loop()
+void wake();                // from any task: end the current idle wait early
+
+// Introspection
+size_t   count();
+bool     stats(size_t i, TaskStats& out);
+uint32_t idlePermille();    // share of loop time spent blocked, last ~1 s
+
+} // namespace Sched
@@ -0,0 +1,547 @@
+#include "telemetry.h"
+#include "udp_typed.h"
+#include "typed_proto.h"
+#include "metrics.h"
+#include <freertos/FreeRTOS.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+namespace Telemetry {
+
+// Sender table: open addressing on the IP hash, linear probing. Entries are
+// never emptied, only reused, so a probe runs until the key or a free entry.
+static const uint8_t NO_SENDER = 0xFF;
+struct Sender {
+  Snapshot snap;                 // snap.ip == 0: free
+  uint32_t changed;              // fields changed since this sender was last shown
+  TypedProto::Control ctrl;      // last control sent
+  uint32_t ctrlAt;               // millis() it went out, 0 = never
+};
+static Sender   s_tab[TELEMETRY_MAX_SENDERS];
+static uint8_t  s_nSend   = 0;
+static uint8_t  s_cur     = NO_SENDER;   // on screen
+static uint32_t s_pinned  = 0;
+static uint32_t s_verSeq  = 0;           // source of Snapshot::version
+static const Snapshot s_none;            // get() before any frame
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;   // s_tab[].snap, s_cur, s_listeners (web task)
+
+static Snapshot* s_rx     = nullptr;     // snapshot the decoders write
+static uint32_t s_changed = 0;   // accumulated by the frame being decoded
+static bool     s_ever    = false;
+static bool     s_dbg     = false;
+
+static const int MAX_LISTENERS = 4;
+static struct { Listener fn; uint32_t mask; void* user; } s_listeners[MAX_LISTENERS] = {};
+
+// -------------- sanity checks (byte-order tolerance) --------------
+static inline int32_t bswap32(int32_t v) {
+  uint32_t x = (uint32_t)v;
+  x = (x>>24) | ((x>>8)&0x0000FF00u) | ((x<<8)&0x00FF0000u) | (x<<24);
+  return (int32_t)x;
+}
+static inline bool sane_any (int32_t)  { return true; }
+static inline bool sane_fan (int32_t v){ return v>=0 && v<=100; }
+static inline bool sane_temp(int32_t v){ return v>-50 && v<120; }
+static inline bool sane_resw(int32_t v){ return v>100 && v<4097; }
+static inline bool sane_resh(int32_t v){ return v>100 && v<2161; }
+static inline bool sane_av  (int32_t v){ v&=0xFF; return v==0x00||v==0x01||v==0x02||v==0x03||v==0x04||v==0x06||v==0x07||((v&0x0E)==0x0A)||((v&0x0E)==0x0E)||((v&0x0E)==0x06)||((v&0x0E)==0x02); }
+static inline bool sane_xb  (int32_t v){ return v>=0 && v<=6; }
+static inline bool sane_enc (int32_t v){ v&=0xFF; return v==0x45||v==0x6A||v==0x70; }
+
+// Keep v if plausible, else its byte-swapped form if that is, else v.
+static inline int32_t fix(int32_t v, bool (*ok)(int32_t)) {
+  if (ok(v)) return v;
+  const int32_t w = bswap32(v);
+  return ok(w) ? w : v;
+}
+
+// -------------- change-tracked setters --------------
+static void set32(int32_t& dst, int32_t v, uint32_t bit) {
+  if (dst != v) { dst = v; s_changed |= bit; }
+}
+static void setStr(char* dst, size_t cap, const char* v, size_t n, uint32_t bit) {
+  if (n >= cap) n = cap - 1;
+  if (strncmp(dst, v, n) == 0 && dst[n] == 0) return;
+  memcpy(dst, v, n); dst[n] = 0;
+  s_changed |= bit;
+}
+static void setStr(char* dst, size_t cap, const char* v, uint32_t bit) {
+  setStr(dst, cap, v, strlen(v), bit);
+}
+
+static void applyMain(int32_t fan, int32_t cpu, int32_t amb, const char* app) {
+  if (!s_rx->haveMain) { s_rx->haveMain = true; s_changed |= F_MAIN; }
+  set32(s_rx->fan, constrain(fan, 0, 100), F_FAN);
+  set32(s_rx->cpu, cpu, F_CPU);
+  set32(s_rx->amb, amb, F_AMB);
+  if (app) setStr(s_rx->app, sizeof(s_rx->app), app, F_APP);
+}
+
+static void markExt() { if (!s_rx->haveExt) { s_rx->haveExt = true; s_changed |= F_EXT; } }
+static void markEE()  { if (!s_rx->haveEE)  { s_rx->haveEE  = true; s_changed |= F_EE;  } }
+
+// -------------- text "key=val" walker (no String churn) --------------
+// Calls fn(key, klen, val, vlen) for each pair after 'p', split on 'sep'.
+template <typename Fn>
+static void forEachKV(const char* p, const char* end, char sep, Fn fn) {
+  while (p < end) {
+    const char* eq = (const char*)memchr(p, '=', end - p);
+    if (!eq) break;
+    const char* nx = (const char*)memchr(eq + 1, sep, end - (eq + 1));
+    const char* ve = nx ? nx : end;
+    const char* k = p;  const char* ke = eq;
+    const char* v = eq + 1;
+    while (k < ke && isspace((unsigned char)*k)) k++;
+    while (ke > k && isspace((unsigned char)ke[-1])) ke--;
+    while (v < ve && isspace((unsigned char)*v)) v++;
+    while (ve > v && isspace((unsigned char)ve[-1])) ve--;
+    fn(k, (size_t)(ke - k), v, (size_t)(ve - v));
+    p = nx ? nx + 1 : end;
+  }
+}
+
+static inline bool keyIs(const char* k, size_t n, const char* lit) {
+  return strlen(lit) == n && strncasecmp(k, lit, n) == 0;
+}
+
+static int32_t parseInt(const char* v, size_t n) {
+  char tmp[16];
+  if (n >= sizeof(tmp)) n = sizeof(tmp) - 1;
+  memcpy(tmp, v, n); tmp[n] = 0;
+  return (int32_t)strtol(tmp, nullptr, 0);   // accepts 0x.. for av/enc
+}
+
+// -------------- decoders --------------
+static void decodeV2(const TypedProto::Frame& fr) {
+  if (fr.have & TypedProto::HAVE_MAIN)
+    applyMain(fr.main.fan, fr.main.cpu, fr.main.amb, fr.main.app);
+  if (fr.have & TypedProto::HAVE_EXT) {
+    markExt();
+    set32(s_rx->tray, fr.ext.tray, F_TRAY);
+    set32(s_rx->av, fr.ext.av, F_AV);
+    set32(s_rx->pic, fr.ext.pic, F_PIC);
+    set32(s_rx->xboxver, fr.ext.xb, F_XBOXVER);
+    set32(s_rx->enc, fr.ext.enc, F_ENC);
+    set32(s_rx->width, fr.ext.w, F_RES);
+    set32(s_rx->height, fr.ext.h, F_RES);
+  }
+  if (fr.have & (TypedProto::HAVE_SERIAL | TypedProto::HAVE_MAC | TypedProto::HAVE_REGION)) {
+    markEE();
+    if (fr.have & TypedProto::HAVE_SERIAL) setStr(s_rx->serial, sizeof(s_rx->serial), fr.ee.serial, F_SERIAL);
+    if (fr.have & TypedProto::HAVE_MAC)    setStr(s_rx->mac,    sizeof(s_rx->mac),    fr.ee.mac,    F_MAC);
+    if (fr.have & TypedProto::HAVE_REGION) setStr(s_rx->region, sizeof(s_rx->region), fr.ee.region, F_REGION);
+  }
+}
+
+static void decodeEEText(const char* d, size_t n) {
+  markEE();
+  forEachKV(d + 3, d + n, '|', [](const char* k, size_t kn, const char* v, size_t vn) {
+    if      (keyIs(k, kn, "SN") || keyIs(k, kn, "SER")) setStr(s_rx->serial, sizeof(s_rx->serial), v, vn, F_SERIAL);
+    else if (keyIs(k, kn, "MAC"))                      setStr(s_rx->mac,    sizeof(s_rx->mac),    v, vn, F_MAC);
+    else if (keyIs(k, kn, "REG"))                      setStr(s_rx->region, sizeof(s_rx->region), v, vn, F_REGION);
+  });
+}
+
+static void decodeMainText(const char* d, size_t n) {
+  int32_t fan = s_rx->fan, cpu = s_rx->cpu, amb = s_rx->amb;
+  char app[33]; memcpy(app, s_rx->app, sizeof(app));
+  forEachKV(d + 2, d + n, ',', [&](const char* k, size_t kn, const char* v, size_t vn) {
+    if      (keyIs(k, kn, "fan")) fan = parseInt(v, vn);
+    else if (keyIs(k, kn, "cpu")) cpu = parseInt(v, vn);
+    else if (keyIs(k, kn, "amb")) amb = parseInt(v, vn);
+    else if (keyIs(k, kn, "app")) { if (vn > 32) vn = 32; memcpy(app, v, vn); app[vn] = 0; }
+  });
+  applyMain(fan, cpu, amb, app);
+}
+
+static void decodeExtText(const char* d, size_t n) {
+  markExt();
+  forEachKV(d + 2, d + n, ',', [](const char* k, size_t kn, const char* v, size_t vn) {
+    if      (keyIs(k, kn, "av"))  set32(s_rx->av,      parseInt(v, vn), F_AV);
+    else if (keyIs(k, kn, "w"))   set32(s_rx->width,   parseInt(v, vn), F_RES);
+    else if (keyIs(k, kn, "h"))   set32(s_rx->height,  parseInt(v, vn), F_RES);
+    else if (keyIs(k, kn, "xb"))  set32(s_rx->xboxver, parseInt(v, vn), F_XBOXVER);
+    else if (keyIs(k, kn, "enc")) set32(s_rx->enc,     parseInt(v, vn), F_ENC);
+  });
+}
+
+static void decodeMainBin(const char* d) {
+  int32_t fan, cpu, amb;
+  memcpy(&fan, d+0, 4); memcpy(&cpu, d+4, 4); memcpy(&amb, d+8, 4);
+  char app[33];
+  memcpy(app, d+12, 32); app[32] = 0;
+  for (int i = 0; i < 32; i++) {
+    unsigned char u = (unsigned char)app[i];
+    if (u && (u < 0x20 || u > 0x7E)) app[i] = ' ';
+  }
+  applyMain(fix(fan, sane_fan), fix(cpu, sane_temp), fix(amb, sane_temp), app);
+}
+
+// Legacy EXT: tray, av, pic, xb, then {w, h, enc} in either "enc,w,h" or
+// "w,h,enc" order depending on the sender build. The encoder byte is the
+// only one with a recognisable value, so locate it and take w/h from the rest.
+static void decodeExtBin(const char* d) {
+  int32_t f[7];
+  memcpy(f, d, 28);
+  markExt();
+  set32(s_rx->tray,    fix(f[0], sane_any), F_TRAY);
+  set32(s_rx->av,      fix(f[1], sane_av),  F_AV);
+  set32(s_rx->pic,     fix(f[2], sane_any), F_PIC);
+  set32(s_rx->xboxver, fix(f[3], sane_xb),  F_XBOXVER);
+
+  int32_t a = fix(f[4], sane_enc), b = fix(f[5], sane_enc), c = fix(f[6], sane_enc);
+  int32_t enc, w, h;
+  if      (sane_enc(a)) { enc = a;    w = f[5]; h = f[6]; }
+  else if (sane_enc(c)) { enc = c;    w = f[4]; h = f[5]; }
+  else if (sane_enc(b)) { enc = b;    w = f[4]; h = f[6]; }
+  else if (sane_resw(fix(f[4], sane_resw)) && sane_resh(fix(f[5], sane_resh)))
+                        { enc = f[6]; w = f[4]; h = f[5]; }
+  else                  { enc = f[4]; w = f[5]; h = f[6]; }
+  set32(s_rx->enc,    enc,                  F_ENC);
+  set32(s_rx->width,  fix(w, sane_resw),    F_RES);
+  set32(s_rx->height, fix(h, sane_resh),    F_RES);
+}
+
+static void decodeFrame(const TypeDUDP::PacketView& pk) {
+  Metrics::Scope m(Metrics::T_PARSE);
+  const char*  d   = pk.data;
+  const size_t n   = pk.rx_len;
+  const uint16_t dst = pk.dst_port;
+  const uint16_t pA = TypeDUDP::portA(), pB = TypeDUDP::portB();   // as bound, not the defaults
+
+  TypedProto::Frame fr;
+  if (TypedProto::decode((const uint8_t*)d, n, fr)) {
+    if (fr.flags & TypedProto::FLAG_CONTROL) return;   // another display's control
+    decodeV2(fr);
+    Metrics::latSender(fr.sender_ts, pk.ts_ms);
+    return;
+  }
+
+  if (n >= 3 && d[0]=='E' && d[1]=='E' && d[2]==':') { decodeEEText(d, n); return; }
+  if (n >= 2 && (d[0]=='A'||d[0]=='a') && (d[1]==','||d[1]==':')) { decodeMainText(d, n); return; }
+  if (n >= 2 && (d[0]=='B'||d[0]=='b') && (d[1]==','||d[1]==':')) { decodeExtText(d, n); return; }
+
+  // Binary frames: classify by the socket they arrived on, else by size.
+  const bool isMain = (pA && dst == pA) || (dst != pB && n == 44);
+  const bool isExt  = (pB && dst == pB) || (dst != pA && n == 28);
+  if (isMain && n >= 44) { decodeMainBin(d); return; }
+  if (isExt  && n >= 28) { decodeExtBin(d);  return; }
+}
+
+// -------------- Xbox version guess (ConsoleMods) --------------
+const char* xboxVerFromCode(int v) {
+  switch (v & 0xFF) {
+    case 0: return "v1.0"; case 1: return "v1.1"; case 2: return "v1.2";
+    case 3: return "v1.3"; case 4: return "v1.4"; case 5: return "v1.5";
+    case 6: return "v1.6"; default: return "Not reported";
+  }
+}
+
+static bool parseSerialYWWFF(const char* str, int& Y, int& W, int& F) {
+  int len = (int)strlen(str), run = 0, end = -1;
+  for (int i = len - 1; i >= 0; --i) {
+    if (isdigit((unsigned char)str[i])) { if (++run == 5) { end = i + 5; break; } }
+    else run = 0;
+  }
+  if (end < 0) return false;
+  int start = end - 5;
+  Y = 2000 + (str[start] - '0');
+  W = (str[start+1]-'0')*10 + (str[start+2]-'0');
+  F = (str[start+3]-'0')*10 + (str[start+4]-'0');
+  return (W >= 1 && W <= 53);
+}
+
+static const char* versionFromYearWeek(int y, int w) {
+  if (y == 2001) return "v1.0";
+  if (y == 2002) { if (w <= 43) return "v1.0"; if (w <= 47) return "v1.1"; return "v1.2"; }
+  if (y == 2003) { if (w <= 8)  return "v1.2"; if (w <= 30) return "v1.3"; return "v1.4"; }
+  if (y == 2004) { if (w <= 10) return "v1.4"; if (w <= 37) return "v1.6"; return "v1.6b"; }
+  if (y >= 2005) return "v1.6b";
+  return "Not reported";
+}
+
+static const char* encSuggest(int enc) {
+  enc &= 0xFF;
+  if (enc == 0x70) return "v1.6";
+  if (enc == 0x6A) return "v1.4";
+  if (enc == 0x45) return "v1.0-1.3";
+  return "Not reported";
+}
+
+void guessXboxVersion(int encRaw, const char* serial, char* out, size_t cap) {
+  const char* r = nullptr;
+  int y = 0, w = 0, f = 0;
+  const int enc = (encRaw & 0xFF);
+  if (!serial || !*serial || !parseSerialYWWFF(serial, y, w, f)) {
+    r = encSuggest(encRaw);
+  } else if (f == 3) {
+    r = "v1.0";                                                     // Hungary
+  } else if (f == 2) {
+    r = (y < 2002 || (y == 2002 && w < 44)) ? "v1.0" : "v1.1";      // Mexico
+  } else {
+    const char* yw = versionFromYearWeek(y, w);
+    const bool early = !strncmp(yw, "v1.0", 4) || !strncmp(yw, "v1.1", 4) ||
+                       !strncmp(yw, "v1.2", 4) || !strncmp(yw, "v1.3", 4);
+    const bool late  = !strncmp(yw, "v1.4", 4) || !strncmp(yw, "v1.6", 4);
+    if      (enc == 0x70)          r = (y >= 2004 && w >= 38) ? "v1.6b" : "v1.6";
+    else if (enc == 0x6A && early) r = "v1.4";
+    else if (enc == 0x45 && late)  r = "v1.3";
+    else                           r = yw;
+  }
+  snprintf(out, cap, "%s", r);
+}
+
+static void updateXboxLabel() {
+  char lbl[sizeof(s_rx->xbox_ver)];
+  if (sane_xb(s_rx->xboxver)) snprintf(lbl, sizeof(lbl), "%s", xboxVerFromCode(s_rx->xboxver));
+  else                    guessXboxVersion(s_rx->enc, s_rx->serial, lbl, sizeof(lbl));
+  setStr(s_rx->xbox_ver, sizeof(s_rx->xbox_ver), lbl, F_XBOX_LBL);
+}
+
+// -------------- sender table --------------
+static inline uint8_t homeOf(uint32_t ip) {
+  return (uint8_t)(((ip * 2654435761u) >> 24) % TELEMETRY_MAX_SENDERS);
+}
+
+static uint8_t findSender(uint32_t ip) {
+  if (!ip) return NO_SENDER;
+  for (uint8_t k = 0, i = homeOf(ip); k < TELEMETRY_MAX_SENDERS; ++k, i = (i + 1) % TELEMETRY_MAX_SENDERS) {
+    if (s_tab[i].snap.ip == ip) return i;
+    if (!s_tab[i].snap.ip) break;
+  }
+  return NO_SENDER;
+}
+
+// Entry for 'ip': a free one on its probe path, else the stalest sender
+// (never the one on screen).
+static uint8_t senderFor(uint32_t ip) {
+  const uint8_t hit = findSender(ip);
+  if (hit != NO_SENDER) return hit;
+  uint8_t i = homeOf(ip), pick = NO_SENDER;
+  for (uint8_t k = 0; k < TELEMETRY_MAX_SENDERS; ++k, i = (i + 1) % TELEMETRY_MAX_SENDERS) {
+    if (!s_tab[i].snap.ip) { pick = i; break; }
+    if (i == s_cur && TELEMETRY_MAX_SENDERS > 1) continue;
+    if (pick == NO_SENDER || (int32_t)(s_tab[i].snap.last_rx_ms - s_tab[pick].snap.last_rx_ms) < 0) pick = i;
+  }
+  Sender& e = s_tab[pick];
+  if (!e.snap.ip) s_nSend++;
+  else if (s_dbg) Serial.printf("[TELEM] sender table full, evicting %s\n", IPAddress(e.snap.ip).toString().c_str());
+  portENTER_CRITICAL(&s_mux);
+  e.snap = Snapshot();
+  e.snap.ip = ip;
+  if (pick == s_cur) s_cur = NO_SENDER;
+  portEXIT_CRITICAL(&s_mux);
+  e.changed = F_ALL;
+  e.ctrlAt = 0;
+  return pick;
+}
+
+bool senderAlive(const Snapshot& t) {
+  return t.ip && t.last_rx_ms && millis() - t.last_rx_ms <= TELEMETRY_SENDER_ALIVE_MS;
+}
+
+static void notify(uint32_t changed) {
+  const Snapshot& t = get();
+  for (int i = 0; i < MAX_LISTENERS; ++i) {
+    portENTER_CRITICAL(&s_mux);            // (un)subscribe may run on another task
+    const auto l = s_listeners[i];
+    portEXIT_CRITICAL(&s_mux);
+    if (l.fn && (l.mask & changed)) l.fn(t, changed & l.mask, l.user);
+  }
+}
+
+static void show(uint8_t i) {
+  if (i == s_cur) return;
+  portENTER_CRITICAL(&s_mux);
+  s_cur = i;
+  portEXIT_CRITICAL(&s_mux);
+  if (i != NO_SENDER) s_tab[i].changed = 0;
+  if (s_dbg) Serial.printf("[TELEM] showing %s\n", i == NO_SENDER ? "-" : IPAddress(s_tab[i].snap.ip).toString().c_str());
+  notify(F_ALL);
+}
+
+// Pinned console if set; otherwise stay on the current one while it is
+// live, else take the most recently heard.
+static void pickSender() {
+  if (s_pinned) { show(findSender(s_pinned)); return; }
+  if (s_cur != NO_SENDER && senderAlive(s_tab[s_cur].snap)) return;
+  uint8_t best = s_cur;
+  for (uint8_t i = 0; i < TELEMETRY_MAX_SENDERS; ++i) {
+    const Snapshot& t = s_tab[i].snap;
+    if (!senderAlive(t)) continue;
+    if (best == NO_SENDER || (int32_t)(t.last_rx_ms - s_tab[best].snap.last_rx_ms) > 0) best = i;
+  }
+  show(best);
+}
+
+// -------------- reverse control --------------
+// Shown console: streams on screen at the sender's rate, the rest slowed
+// (MAIN keeps app changes and liveness coming). Consoles off screen and an
+// idle panel slow further. EE is static, so once it is in it is switched off.
+static const uint16_t CTRL_MAIN_BACKGROUND_MS = 2000;
+static const uint16_t CTRL_EXT_BACKGROUND_MS  = 5000;
+static const uint16_t CTRL_MAIN_OFFSCREEN_MS  = 5000;
+static const uint16_t CTRL_EXT_OFFSCREEN_MS   = 10000;
+static const uint16_t CTRL_MAIN_IDLE_MS       = 10000;
+static const uint8_t  CTRL_TTL_S              = 30;
+static const uint32_t CTRL_REFRESH_MS         = 10000;   // well inside the ttl
+
+static TypedProto::Control ratesFor(const Sender& e, bool shown, uint8_t onScreen, bool idle) {
+  using namespace TypedProto;
+  Control c;
+  c.ttl_s = CTRL_TTL_S;
+  if (idle) {
+    c.main_ms = CTRL_MAIN_IDLE_MS;
+    c.ext_ms  = RATE_OFF;
+  } else if (!shown) {
+    c.main_ms = CTRL_MAIN_OFFSCREEN_MS;
+    c.ext_ms  = CTRL_EXT_OFFSCREEN_MS;
+  } else {
+    c.main_ms = (onScreen & STREAM_MAIN) ? RATE_DEFAULT : CTRL_MAIN_BACKGROUND_MS;
+    c.ext_ms  = (onScreen & STREAM_EXT)  ? RATE_DEFAULT : CTRL_EXT_BACKGROUND_MS;
+  }
+  c.ee_ms = (e.snap.haveEE || idle) ? RATE_OFF : RATE_DEFAULT;
+  return c;
+}
+
+void control(uint8_t onScreen, bool idle) {
+  static uint32_t seq = 0;
+  const uint32_t now = millis();
+  for (uint8_t i = 0; i < TELEMETRY_MAX_SENDERS; ++i) {
+    Sender& e = s_tab[i];
+    if (!senderAlive(e.snap)) continue;
+    const TypedProto::Control c = ratesFor(e, i == s_cur, onScreen, idle);
+    if (e.ctrlAt && c == e.ctrl && now - e.ctrlAt < CTRL_REFRESH_MS) continue;
+    uint8_t buf[TypedProto::CONTROL_LEN];
+    const size_t n = TypedProto::encodeControl(c, ++seq, now, buf, sizeof(buf));
+    if (!n || !TypeDUDP::sendControl(IPAddress(e.snap.ip), buf, n)) continue;
+    if (s_dbg && !(c == e.ctrl && e.ctrlAt))
+      Serial.printf("[TELEM] %s rates main=%u ext=%u ee=%u\n", IPAddress(e.snap.ip).toString().c_str(),
+                    (unsigned)c.main_ms, (unsigned)c.ext_ms, (unsigned)c.ee_ms);
+    e.ctrl = c;
+    e.ctrlAt = now ? now : 1;
+  }
+}
+
+// -------------- API --------------
+void begin() {
+  portENTER_CRITICAL(&s_mux);
+  for (auto& e : s_tab) { e.snap = Snapshot(); e.changed = 0; e.ctrlAt = 0; }
+  s_cur = NO_SENDER;
+  portEXIT_CRITICAL(&s_mux);
+  s_nSend = 0;
+  s_rx = nullptr;
+  s_changed = 0;
+  s_ever = false;
+}
+
+void setDebug(bool on) { s_dbg = on; }
+
+void loop() {
+  uint32_t rxUs = 0;
+  bool haveRx = false;
+  uint32_t shownChanged = 0;
+  for (const TypeDUDP::PacketView* pk; (pk = TypeDUDP::peek()) != nullptr; TypeDUDP::release()) {
+    s_ever = true;
+    const uint8_t i = senderFor((uint32_t)pk->ip);
+    Sender& e = s_tab[i];
+    // decoded into a copy, published under s_mux in one go
+    Snapshot rx = e.snap;
+    s_rx = &rx;
+    rx.pkt_count++;
+    rx.last_rx_ms = pk->ts_ms;
+    s_changed = 0;
+    decodeFrame(*pk);
+    if (s_changed & (F_XBOXVER | F_ENC | F_SERIAL)) updateXboxLabel();
+    if (s_changed) rx.version = ++s_verSeq;
+    portENTER_CRITICAL(&s_mux);
+    e.snap = rx;
+    portEXIT_CRITICAL(&s_mux);
+    s_rx = nullptr;
+    if (!s_changed) continue;
+    e.changed |= s_changed;
+    if (i == s_cur) {
+      shownChanged |= s_changed;
+      if (!haveRx) { rxUs = pk->ts_us; haveRx = true; }
+    }
+    if (s_dbg) {
+      const Snapshot& t = rx;
+      const String from = IPAddress(t.ip).toString();
+      if (s_changed & F_MAIN) Serial.printf("[TELEM] %s MAIN fan=%d cpu=%d amb=%d app='%s'\n", from.c_str(),
+                                            (int)t.fan, (int)t.cpu, (int)t.amb, t.app);
+      if (s_changed & F_EXT)  Serial.printf("[TELEM] %s EXT tray=%d av=0x%02X xb=%d enc=0x%02X w=%d h=%d\n", from.c_str(),
+                                            (int)t.tray, (int)(t.av & 0xFF), (int)t.xboxver,
+                                            (int)(t.enc & 0xFF), (int)t.width, (int)t.height);
+      if (s_changed & F_EE)   Serial.printf("[TELEM] %s EE SN=%s MAC=%s REG=%s\n", from.c_str(),
+                                            t.serial, t.mac, t.region);
+    }
+  }
+  s_changed = 0;
+
+  const uint8_t was = s_cur;
+  pickSender();                          // a switch notifies F_ALL itself
+  if (s_cur != was || !shownChanged) return;
+  if (haveRx) Metrics::latChanged(rxUs);   // oldest frame that changed something
+  s_tab[s_cur].changed = 0;
+  notify(shownChanged);
+}
+
+const Snapshot& get() { return s_cur != NO_SENDER ? s_tab[s_cur].snap : s_none; }
+uint32_t version()    { return get().version; }
+bool everReceived()   { return s_ever; }
+
+uint8_t senderCount() { return s_nSend; }
+
+bool sender(uint8_t i, Snapshot& out) {
+  bool hit = false;
+  portENTER_CRITICAL(&s_mux);
+  for (uint8_t k = 0; k < TELEMETRY_MAX_SENDERS; ++k) {
+    if (!s_tab[k].snap.ip) continue;
+    if (!i--) { out = s_tab[k].snap; hit = true; break; }
+  }
+  portEXIT_CRITICAL(&s_mux);
+  return hit;
+}
+
+uint8_t senders(Snapshot* out, uint8_t cap, uint32_t* shown) {
+  uint8_t n = 0;
+  portENTER_CRITICAL(&s_mux);
+  for (uint8_t k = 0; k < TELEMETRY_MAX_SENDERS && n < cap; ++k)
+    if (s_tab[k].snap.ip) out[n++] = s_tab[k].snap;
+  if (shown) *shown = s_cur != NO_SENDER ? s_tab[s_cur].snap.ip : 0;
+  portEXIT_CRITICAL(&s_mux);
+  return n;
+}
+
+void setPinned(uint32_t ip) { s_pinned = ip; }
+uint32_t pinned()           { return s_pinned; }
+
+void nextSender() {
+  if (s_pinned) return;
+  const uint8_t from = (s_cur == NO_SENDER) ? 0 : s_cur;
+  for (uint8_t k = 1; k < TELEMETRY_MAX_SENDERS; ++k) {
+    const uint8_t i = (uint8_t)((from + k) % TELEMETRY_MAX_SENDERS);
+    if (senderAlive(s_tab[i].snap)) { show(i); return; }
+  }
+}
+
+int subscribe(Listener fn, uint32_t mask, void* user) {
+  if (!fn) return -1;
+  int h = -1;
+  portENTER_CRITICAL(&s_mux);
+  for (int i = 0; i < MAX_LISTENERS; ++i) {
+    if (!s_listeners[i].fn) { s_listeners[i] = { fn, mask, user }; h = i; break; }
+  }
+  portEXIT_CRITICAL(&s_mux);
+  return h;
+}
+
+void unsubscribe(int handle) {
+  if (handle < 0 || handle >= MAX_LISTENERS) return;
+  portENTER_CRITICAL(&s_mux);
+  s_listeners[handle] = { nullptr, 0, nullptr };
+  portEXIT_CRITICAL(&s_mux);
+}
+
+} // namespace Telemetry
@@ -0,0 +1,116 @@
+#pragma once
+#include <Arduino.h>
+
+// Shared Xbox telemetry model.
+//
+// Owns decoding of every Type-D frame (v2 TLV, legacy binary MAIN/EXT with
+// byte-order tolerance, "A:"/"B:" text, "EE:" text) and keeps one snapshot
+// that both display back-ends read. Each loop() drains TypeDUDP once, then
+// notifies subscribers with a mask of the fields that actually changed.
+//
+// Several consoles can report at once: every sender (source IP) gets its
+// own snapshot in a fixed table, and get() is the one on screen. That is
+// the pinned console if one is set, otherwise the views rotate through the
+// live ones with nextSender(). A switch notifies F_ALL.
+
+#ifndef TELEMETRY_MAX_SENDERS
+#define TELEMETRY_MAX_SENDERS 8          // table size; the stalest sender is evicted
+#endif
+#ifndef TELEMETRY_SENDER_ALIVE_MS
+#define TELEMETRY_SENDER_ALIVE_MS 60000  // a sender this quiet leaves the rotation
+#endif
+
+namespace Telemetry {
+
+// Field bits for change masks
+enum : uint32_t {
+  F_FAN      = 1u << 0,
+  F_CPU      = 1u << 1,
+  F_AMB      = 1u << 2,
+  F_APP      = 1u << 3,
+  F_TRAY     = 1u << 4,
+  F_AV       = 1u << 5,
+  F_PIC      = 1u << 6,
+  F_XBOXVER  = 1u << 7,   // SMC version code
+  F_ENC      = 1u << 8,
+  F_RES      = 1u << 9,   // width and/or height
+  F_SERIAL   = 1u << 10,
+  F_MAC      = 1u << 11,
+  F_REGION   = 1u << 12,
+  F_XBOX_LBL = 1u << 13,  // derived "Xbox: vX.Y" label
+
+  F_MAIN = F_FAN | F_CPU | F_AMB | F_APP,
+  F_EXT  = F_TRAY | F_AV | F_PIC | F_XBOXVER | F_ENC | F_RES,
+  F_EE   = F_SERIAL | F_MAC | F_REGION,
+  F_ALL  = 0xFFFFFFFFu,
+};
+
+struct Snapshot {
+  uint32_t version  = 0;     // bumps whenever any field changes (unique across senders)
+  uint32_t ip       = 0;     // sender IPv4 (IPAddress as uint32), 0 before the first frame
+  uint32_t last_rx_ms = 0;   // millis() of the newest frame (any port)
+  uint32_t pkt_count  = 0;   // frames seen from this sender
+
+  bool haveMain = false, haveExt = false, haveEE = false;
+
+  // MAIN
+  int32_t fan = 0, cpu = 0, amb = 0;
+  char    app[33] = {0};
+
+  // EXT
+  int32_t tray = -1, av = -1, pic = -1, xboxver = -1, enc = -1;
+  int32_t width = 0, height = 0;
+
+  // EE
+  char serial[24] = {0};
+  char mac[24]    = {0};
+  char region[16] = {0};
+
+  // Derived
+  char xbox_ver[16] = "Not reported";   // SMC code, else serial/encoder guess
+};
+
+// Called from loop() with the fields that changed since the last call.
+typedef void (*Listener)(const Snapshot& s, uint32_t changed, void* user);
+
+void begin();
+void loop();                                   // drain UDP, decode, notify
+void setDebug(bool on);
+
+const Snapshot& get();                         // the console on screen
+uint32_t version();
+bool everReceived();                           // any frame since begin(), any sender
+
+// Sender table. Index order is stable until a sender is evicted. get() is
+// for the loop task; other tasks copy entries with sender()/senders().
+uint8_t senderCount();                         // occupied entries
+bool sender(uint8_t i, Snapshot& out);         // copy of entry i (false past the end)
+// Copy of every occupied entry (up to cap) taken at one instant; *shown
+// gets the IP on screen (0 = none). Returns the entries written.
+uint8_t senders(Snapshot* out, uint8_t cap, uint32_t* shown = nullptr);
+bool senderAlive(const Snapshot& s);           // heard within TELEMETRY_SENDER_ALIVE_MS
+
+// Pin the display to one console (0 = rotate). Kept across begin().
+void setPinned(uint32_t ip);
+uint32_t pinned();
+// Carousel wrapped: move to the next live console (no-op when pinned or
+// when only one is live).
+void nextSender();
+
+// Returns a handle >= 0, or -1 if the listener table is full. Safe from any
+// task; listeners are called from loop().
+int  subscribe(Listener fn, uint32_t mask = F_ALL, void* user = nullptr);
+void unsubscribe(int handle);
+
+// Reverse control (TypedProto::Control, sent via TypeDUDP::sendControl).
+// Call about once a second with the streams the visible screen draws
+// (TypedProto::STREAM_* bits) and whether the panel is idle; each live
+// sender is sent the rates it is needed at when they change, and again
+// before the previous message's ttl runs out.
+void control(uint8_t onScreen, bool idle);
+
+// Xbox version helpers (ConsoleMods serial/encoder heuristics)
+const char* xboxVerFromCode(int v);
+void guessXboxVersion(int encRaw, const char* serial, char* out, size_t cap);
+
+} // namespace Telemetry
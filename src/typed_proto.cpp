@@ -0,0 +1,151 @@
+#include "typed_proto.h"
+#include <string.h>
+
+namespace TypedProto {
+
+// -------------- little-endian helpers --------------
+static inline uint32_t rd32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+static inline void wr32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint16_t rd16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static inline void wr16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+
+static void copyStr(char* dst, size_t cap, const uint8_t* src, size_t n) {
+  if (n >= cap) n = cap - 1;
+  memcpy(dst, src, n);
+  dst[n] = 0;
+}
+
+bool isV2(const uint8_t* buf, size_t len) {
+  return buf && len >= HEADER_LEN && buf[0] == MAGIC0 && buf[1] == MAGIC1 && buf[2] == VERSION;
+}
+
+bool decode(const uint8_t* buf, size_t len, Frame& out) {
+  if (!isV2(buf, len)) return false;
+
+  out.version   = buf[2];
+  out.flags     = buf[3];
+  out.seq       = rd32(buf + 4);
+  out.sender_ts = rd32(buf + 8);
+  out.have      = 0;
+
+  size_t pos = HEADER_LEN;
+  while (pos + 2 <= len) {
+    const uint8_t  type = buf[pos];
+    const uint8_t  rlen = buf[pos + 1];
+    const uint8_t* v    = buf + pos + 2;
+    if (pos + 2 + rlen > len) break;   // truncated record
+
+    switch (type) {
+      case REC_MAIN:
+        if (rlen >= 12) {
+          out.main.fan = (int32_t)rd32(v + 0);
+          out.main.cpu = (int32_t)rd32(v + 4);
+          out.main.amb = (int32_t)rd32(v + 8);
+          copyStr(out.main.app, sizeof(out.main.app), v + 12, rlen - 12);  // NUL padding ends it
+          out.have |= HAVE_MAIN;
+        }
+        break;
+      case REC_EXT:
+        if (rlen >= 28) {
+          out.ext.tray = (int32_t)rd32(v + 0);
+          out.ext.av   = (int32_t)rd32(v + 4);
+          out.ext.pic  = (int32_t)rd32(v + 8);
+          out.ext.xb   = (int32_t)rd32(v + 12);
+          out.ext.w    = (int32_t)rd32(v + 16);
+          out.ext.h    = (int32_t)rd32(v + 20);
+          out.ext.enc  = (int32_t)rd32(v + 24);
+          out.have |= HAVE_EXT;
+        }
+        break;
+      case REC_EE_SERIAL:
+        copyStr(out.ee.serial, sizeof(out.ee.serial), v, rlen); out.have |= HAVE_SERIAL; break;
+      case REC_EE_MAC:
+        copyStr(out.ee.mac, sizeof(out.ee.mac), v, rlen);       out.have |= HAVE_MAC;    break;
+      case REC_EE_REGION:
+        copyStr(out.ee.region, sizeof(out.ee.region), v, rlen); out.have |= HAVE_REGION; break;
+      default:
+        break;   // unknown record: skip
+    }
+    pos += 2 + rlen;
+  }
+  return true;
+}
+
+// -------------- encoder --------------
+static bool putRec(uint8_t* out, size_t cap, size_t& pos, uint8_t type, const uint8_t* v, size_t n) {
+  if (n > 255 || pos + 2 + n > cap) return false;
+  out[pos++] = type;
+  out[pos++] = (uint8_t)n;
+  memcpy(out + pos, v, n);
+  pos += n;
+  return true;
+}
+
+static bool putStr(uint8_t* out, size_t cap, size_t& pos, uint8_t type, const char* s, size_t max) {
+  return putRec(out, cap, pos, type, (const uint8_t*)s, strnlen(s, max));
+}
+
+size_t encode(const Frame& f, uint8_t* out, size_t cap) {
+  if (!out || cap < HEADER_LEN) return 0;
+  out[0] = MAGIC0; out[1] = MAGIC1; out[2] = VERSION; out[3] = f.flags;
+  wr32(out + 4, f.seq);
+  wr32(out + 8, f.sender_ts);
+  size_t pos = HEADER_LEN;
+
+  if (f.have & HAVE_MAIN) {
+    uint8_t v[44] = {0};
+    wr32(v + 0, (uint32_t)f.main.fan);
+    wr32(v + 4, (uint32_t)f.main.cpu);
+    wr32(v + 8, (uint32_t)f.main.amb);
+    memcpy(v + 12, f.main.app, strnlen(f.main.app, 32));
+    if (!putRec(out, cap, pos, REC_MAIN, v, sizeof(v))) return 0;
+  }
+  if (f.have & HAVE_EXT) {
+    uint8_t v[28];
+    const int32_t fld[7] = { f.ext.tray, f.ext.av, f.ext.pic, f.ext.xb, f.ext.w, f.ext.h, f.ext.enc };
+    for (int i = 0; i < 7; ++i) wr32(v + 4 * i, (uint32_t)fld[i]);
+    if (!putRec(out, cap, pos, REC_EXT, v, sizeof(v))) return 0;
+  }
+  if ((f.have & HAVE_SERIAL) && !putStr(out, cap, pos, REC_EE_SERIAL, f.ee.serial, sizeof(f.ee.serial))) return 0;
+  if ((f.have & HAVE_MAC)    && !putStr(out, cap, pos, REC_EE_MAC,    f.ee.mac,    sizeof(f.ee.mac)))    return 0;
+  if ((f.have & HAVE_REGION) && !putStr(out, cap, pos, REC_EE_REGION, f.ee.region, sizeof(f.ee.region))) return 0;
+  return pos;
+}
+
+// -------------- control --------------
+size_t encodeControl(const Control& c, uint32_t seq, uint32_t ts, uint8_t* out, size_t cap) {
+  if (!out || cap < CONTROL_LEN) return 0;
+  out[0] = MAGIC0; out[1] = MAGIC1; out[2] = VERSION; out[3] = FLAG_CONTROL;
+  wr32(out + 4, seq);
+  wr32(out + 8, ts);
+  uint8_t v[7];
+  wr16(v + 0, c.main_ms);
+  wr16(v + 2, c.ext_ms);
+  wr16(v + 4, c.ee_ms);
+  v[6] = c.ttl_s;
+  size_t pos = HEADER_LEN;
+  putRec(out, cap, pos, REC_CTRL_RATE, v, sizeof(v));
+  return pos;
+}
+
+bool decodeControl(const uint8_t* buf, size_t len, Control& out) {
+  if (!isV2(buf, len) || !(buf[3] & FLAG_CONTROL)) return false;
+  for (size_t pos = HEADER_LEN; pos + 2 <= len; pos += 2 + buf[pos + 1]) {
+    const uint8_t* v = buf + pos + 2;
+    if (pos + 2 + buf[pos + 1] > len) break;
+    if (buf[pos] != REC_CTRL_RATE || buf[pos + 1] < 7) continue;
+    out.main_ms = rd16(v + 0);
+    out.ext_ms  = rd16(v + 2);
+    out.ee_ms   = rd16(v + 4);
+    out.ttl_s   = v[6];
+    return true;
+  }
+  return false;
+}
+
+} // namespace TypedProto
@@ -0,0 +1,120 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Type-D telemetry wire format, version 2.
+//
+// One datagram carries a fixed header followed by any number of TLV records,
+// so MAIN + EXT + EE can travel in a single packet. All integers are
+// little-endian. Unknown record types are skipped, so senders may add
+// records without breaking older displays.
+//
+//   off  size  field
+//   0    2     magic 'T','D'
+//   2    1     version (2)
+//   3    1     flags (reserved, send 0)
+//   4    4     seq        (sender sequence number)
+//   8    4     sender_ts  (sender clock, ms)
+//   12   ...   records: u8 type, u8 len, len bytes of value
+//
+// Legacy frames (44 B MAIN, 28 B EXT, "EE:" text) never start with the magic
+// and are still decoded by the consumers.
+//
+// Control (display -> sender): the same header with FLAG_CONTROL set and a
+// REC_CTRL_RATE record, sent back to the source port the sender's frames
+// came from. It asks for an interval per stream; after ttl_s seconds
+// without a refresh the sender goes back to its own rates. Senders that
+// don't read control simply never see it acted on.
+
+namespace TypedProto {
+
+static const uint8_t MAGIC0     = 'T';
+static const uint8_t MAGIC1     = 'D';
+static const uint8_t VERSION    = 2;
+static const size_t  HEADER_LEN = 12;
+
+static const uint8_t FLAG_CONTROL = 0x01;   // header flags: display -> sender
+
+enum RecType : uint8_t {
+  REC_MAIN      = 0x01,   // int32 fan, cpu, amb + char app[32]      (44 B)
+  REC_EXT       = 0x02,   // int32 tray, av, pic, xb, w, h, enc       (28 B)
+  REC_EE_SERIAL = 0x10,   // string, not NUL-terminated
+  REC_EE_MAC    = 0x11,   // string
+  REC_EE_REGION = 0x12,   // string
+  REC_CTRL_RATE = 0x20,   // u16 main_ms, ext_ms, ee_ms + u8 ttl_s     (7 B)
+};
+
+// Streams, as sent on the three sockets (and as Control addresses them)
+enum : uint8_t {
+  STREAM_MAIN = 0x01,
+  STREAM_EXT  = 0x02,
+  STREAM_EE   = 0x04,
+};
+
+// Control intervals, ms
+static const uint16_t RATE_DEFAULT = 0;        // the sender's own rate
+static const uint16_t RATE_OFF     = 0xFFFF;   // not needed: don't send it
+
+struct Control {
+  uint16_t main_ms = RATE_DEFAULT;
+  uint16_t ext_ms  = RATE_DEFAULT;
+  uint16_t ee_ms   = RATE_DEFAULT;
+  uint8_t  ttl_s   = 30;
+  bool operator==(const Control& o) const {
+    return main_ms == o.main_ms && ext_ms == o.ext_ms && ee_ms == o.ee_ms && ttl_s == o.ttl_s;
+  }
+};
+
+// Bits in Frame::have
+enum : uint8_t {
+  HAVE_MAIN   = 0x01,
+  HAVE_EXT    = 0x02,
+  HAVE_SERIAL = 0x04,
+  HAVE_MAC    = 0x08,
+  HAVE_REGION = 0x10,
+};
+
+struct Main {
+  int32_t fan = 0, cpu = 0, amb = 0;
+  char    app[33] = {0};
+};
+
+struct Ext {
+  int32_t tray = -1, av = -1, pic = -1, xb = -1, w = 0, h = 0, enc = -1;
+};
+
+struct EE {
+  char serial[24] = {0};
+  char mac[24]    = {0};
+  char region[16] = {0};
+};
+
+struct Frame {
+  uint8_t  version   = 0;
+  uint8_t  flags     = 0;
+  uint32_t seq       = 0;
+  uint32_t sender_ts = 0;
+  uint8_t  have      = 0;   // HAVE_* bits for records present in this frame
+  Main     main;
+  Ext      ext;
+  EE       ee;
+};
+
+// True if the buffer starts with a v2 header (cheap check before decode()).
+bool isV2(const uint8_t* buf, size_t len);
+
+// Decode a v2 datagram. Returns false for legacy/short/malformed frames;
+// a truncated trailing record is ignored, earlier records are kept.
+bool decode(const uint8_t* buf, size_t len, Frame& out);
+
+// Encode the records flagged in f.have. Returns bytes written, 0 if 'cap'
+// is too small. Used by senders and for round-trip checks on a host build.
+size_t encode(const Frame& f, uint8_t* out, size_t cap);
+
+// Control datagrams (HEADER_LEN + 9 B). decodeControl() is for senders and
+// host checks; decode() skips the record like any unknown one.
+static const size_t CONTROL_LEN = HEADER_LEN + 2 + 7;
+size_t encodeControl(const Control& c, uint32_t seq, uint32_t ts, uint8_t* out, size_t cap);
+bool decodeControl(const uint8_t* buf, size_t len, Control& out);
+
+} // namespace TypedProto
@@ -1,6 +1,12 @@
 #include "udp_typed.h"
-#include <WiFi.h>    // for WiFi.status()
+#include "metrics.h"
+#include "mem.h"
+#include <WiFi.h>    // for WiFi.status() until setLinkUp() is used
 #include <Arduino.h> // for millis()
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
 
 namespace TypeDUDP {
 
@@ -9,35 +15,195 @@ enum class Mode : uint8_t { OFF = 0, ARMED, STARTED };
 static WiFiUDP s_udpA, s_udpB, s_udpC;
 static bool    s_udpA_on = false, s_udpB_on = false, s_udpC_on = false;
 
-// "Ever saw a packet since begin()" flag and core timing stats
-static volatile bool     s_ever     = false;
-static volatile uint32_t s_pktCount = 0;
-static volatile uint32_t s_lastSeen = 0;
+// "Ever saw a packet since begin()" flag and core timing stats.
+// Written by the receiver (task or loop), read from anywhere.
+static std::atomic<bool>     s_ever{false};
+static std::atomic<uint32_t> s_pktCount{0};
+static std::atomic<uint32_t> s_lastSeen{0};
+static std::atomic<uint32_t> s_dropped{0};
+static std::atomic<uint32_t> s_superseded{0};
 
-static Packet  s_last;                        // latest packet snapshot (legacy)
 static bool    s_debug = false;
+static std::atomic<int8_t> s_link{-1};        // -1: not told yet (poll), else 0/1
 
-static Mode    s_mode = Mode::OFF;
+static volatile Mode s_mode = Mode::OFF;
 static uint16_t s_portA = UDP_TYPED_DEFAULT_PORT_A;
 static uint16_t s_portB = UDP_TYPED_DEFAULT_PORT_B;
 static uint16_t s_portC = UDP_TYPED_DEFAULT_PORT_C;
+static QueueMode s_qmode = QueueMode::Fifo;
+static IPAddress s_mcast(UDP_TYPED_MCAST_GROUP);
+
+// -------- Receiver task (optional) --------
+static bool         s_useTask  = (UDP_TYPED_RX_TASK != 0);
+static TaskHandle_t s_task     = nullptr;
+static volatile bool s_taskStop = false;
+static void (*volatile s_rxNotify)() = nullptr;
+static portMUX_TYPE s_lastMux  = portMUX_INITIALIZER_UNLOCKED;
+
+// -------- Packet pool --------
+// Slots are reference counted: one ref for the queue entry, one for the
+// "latest packet" pointer behind last(). A slot is free when refs == 0.
+// Only the receiver takes a free slot, so a slot seen at 0 stays free
+// until the receiver claims it; consumers only ever drop refs.
+static const uint8_t NUM_SLOTS = UDP_TYPED_SMALL_SLOTS + UDP_TYPED_LARGE_SLOTS;
+static const uint8_t NO_SLOT   = 0xFF;
+
+struct Slot {
+  PacketView           v;
+  char*                buf  = nullptr;
+  uint16_t             cap  = 0;
+  std::atomic<uint8_t> refs{0};
+};
+
+// Small slots carry nearly every frame and stay in internal RAM; the large
+// overflow slots and the last() copy are bulk (PSRAM when present).
+static char    s_smallBuf[UDP_TYPED_SMALL_SLOTS][UDP_TYPED_SMALL_SLOT + 1];
+static char*   s_largeBuf = nullptr;          // LARGE_SLOTS x (MAX_PAYLOAD + 1), allocated once
+static Slot    s_slots[NUM_SLOTS];
+static volatile uint8_t s_lastSlot = NO_SLOT; // newest packet (legacy last())
+static Packet* s_lastCopy = nullptr;          // allocated on first last() call
+
+static void poolInit() {
+  if (!s_largeBuf) s_largeBuf = (char*)Mem::bulkAlloc((size_t)UDP_TYPED_LARGE_SLOTS * (UDP_TYPED_MAX_PAYLOAD + 1));
+  for (uint8_t i = 0; i < NUM_SLOTS; ++i) {
+    Slot& sl = s_slots[i];
+    sl.refs.store(0);
+    if (i < UDP_TYPED_SMALL_SLOTS) { sl.buf = s_smallBuf[i]; sl.cap = UDP_TYPED_SMALL_SLOT; }
+    else if (s_largeBuf) {
+      sl.buf = s_largeBuf + (size_t)(i - UDP_TYPED_SMALL_SLOTS) * (UDP_TYPED_MAX_PAYLOAD + 1);
+      sl.cap = UDP_TYPED_MAX_PAYLOAD;
+    } else {
+      sl.buf = nullptr; sl.cap = 0;
+      sl.refs.store(1);                       // no memory: never handed out, big frames drop
+    }
+    sl.v = PacketView();
+  }
+  s_lastSlot = NO_SLOT;
+}
+
+static inline void slotRef(uint8_t idx) {
+  if (idx < NUM_SLOTS) s_slots[idx].refs.fetch_add(1, std::memory_order_acq_rel);
+}
+static inline void slotUnref(uint8_t idx) {
+  if (idx < NUM_SLOTS) s_slots[idx].refs.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+// Smallest free slot class that fits 'len'; large slots double as overflow.
+static uint8_t slotFind(size_t len) {
+  if (len <= UDP_TYPED_SMALL_SLOT) {
+    for (uint8_t i = 0; i < UDP_TYPED_SMALL_SLOTS; ++i)
+      if (!s_slots[i].refs.load(std::memory_order_acquire)) return i;
+  }
+  for (uint8_t i = UDP_TYPED_SMALL_SLOTS; i < NUM_SLOTS; ++i)
+    if (!s_slots[i].refs.load(std::memory_order_acquire)) return i;
+  return NO_SLOT;
+}
 
-// -------- Ring buffer for packets --------
-static Packet  s_q[UDP_TYPED_QUEUE_DEPTH];
-static uint8_t s_q_head = 0;   // next write
-static uint8_t s_q_tail = 0;   // next read
+// -------- Ring buffer of slot indices (single producer / single consumer) --------
+// head is only written by the receiver, tail only by the consumer. In task
+// mode a full ring drops the NEWEST frame so the receiver never touches tail.
+static uint8_t              s_q[UDP_TYPED_QUEUE_DEPTH];
+static std::atomic<uint8_t> s_q_head{0};   // next write
+static std::atomic<uint8_t> s_q_tail{0};   // next read
 
 static inline uint8_t q_next(uint8_t v) { return (uint8_t)((v + 1) % UDP_TYPED_QUEUE_DEPTH); }
-static inline bool    q_full()  { return q_next(s_q_head) == s_q_tail; }
-static inline bool    q_empty() { return s_q_head == s_q_tail; }
+static inline bool    q_full()  {
+  return q_next(s_q_head.load(std::memory_order_relaxed)) == s_q_tail.load(std::memory_order_acquire);
+}
+static inline bool    q_empty() {
+  return s_q_head.load(std::memory_order_acquire) == s_q_tail.load(std::memory_order_relaxed);
+}
 static inline size_t  q_count() {
-  int diff = (int)s_q_head - (int)s_q_tail;
+  int diff = (int)s_q_head.load(std::memory_order_acquire) - (int)s_q_tail.load(std::memory_order_acquire);
   if (diff < 0) diff += UDP_TYPED_QUEUE_DEPTH;
   return (size_t)diff;
 }
 
+// -------- Coalesce mode: newest slot per sender and socket ("lane") --------
+// The receiver swaps a new slot in and drops the ref of the one it
+// replaces; the consumer takes a lane by swapping NO_SLOT in. Either way
+// the ref travels with the index, so no lock is needed.
+// Lane = sender group * 3 + socket (A/B/C). Groups are assigned by source
+// IP on the receiver; a new sender takes a free group or the stalest one.
+static const uint8_t NUM_PORTS = 3;
+static const uint8_t NUM_LANES = NUM_PORTS * UDP_TYPED_LANE_SENDERS;
+static std::atomic<uint8_t>  s_latest[NUM_LANES];
+static std::atomic<uint32_t> s_laneSuperseded[NUM_LANES];  // since last take
+static uint32_t              s_laneSeq[NUM_LANES];         // receiver only
+static uint32_t              s_groupIp[UDP_TYPED_LANE_SENDERS];    // receiver only, 0 = free
+static uint32_t              s_groupSeen[UDP_TYPED_LANE_SENDERS];  // receiver only, millis()
+static std::atomic<uint32_t> s_groupRet[UDP_TYPED_LANE_SENDERS];   // ip of the return port below
+static std::atomic<uint16_t> s_groupPort[UDP_TYPED_LANE_SENDERS];  // src port of its MAIN frames
+static uint8_t               s_held = NO_SLOT;              // consumer's current lane slot
+static uint8_t               s_rrLane = 0;                  // round-robin start for peek()
+
+static void lanesInit() {
+  for (uint8_t i = 0; i < NUM_LANES; ++i) {
+    s_latest[i].store(NO_SLOT);
+    s_laneSuperseded[i].store(0);
+    s_laneSeq[i] = 0;
+  }
+  for (uint8_t g = 0; g < UDP_TYPED_LANE_SENDERS; ++g) {
+    s_groupIp[g] = 0; s_groupSeen[g] = 0;
+    s_groupRet[g].store(0); s_groupPort[g].store(0);
+  }
+  s_held = NO_SLOT;
+  s_rrLane = 0;
+}
+
+static uint8_t laneGroup(uint32_t ip, uint32_t now) {
+  uint8_t g = 0;
+  while (g < UDP_TYPED_LANE_SENDERS && s_groupIp[g] != ip) ++g;
+  if (g == UDP_TYPED_LANE_SENDERS) {            // new sender: a free group, else the stalest
+    g = 0;
+    for (uint8_t k = 1; k < UDP_TYPED_LANE_SENDERS && s_groupIp[g]; ++k)
+      if (!s_groupIp[k] || (int32_t)(s_groupSeen[k] - s_groupSeen[g]) < 0) g = k;
+    s_groupIp[g] = ip;
+  }
+  s_groupSeen[g] = now;
+  return g;
+}
+
+static void lanePublish(uint8_t lane, uint8_t idx) {
+  slotRef(idx);
+  const uint8_t old = s_latest[lane].exchange(idx, std::memory_order_acq_rel);
+  if (old != NO_SLOT) {
+    slotUnref(old);
+    s_laneSuperseded[lane].fetch_add(1, std::memory_order_relaxed);
+    s_superseded.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+static size_t laneCount() {
+  size_t n = (s_held != NO_SLOT) ? 1 : 0;
+  for (uint8_t i = 0; i < NUM_LANES; ++i)
+    if (s_latest[i].load(std::memory_order_acquire) != NO_SLOT) n++;
+  return n;
+}
+
+// Inline mode only: the receiver is also the consumer, so it may move tail.
+static void queueDropOldest() {
+  const uint8_t t = s_q_tail.load(std::memory_order_relaxed);
+  slotUnref(s_q[t]);
+  s_q_tail.store(q_next(t), std::memory_order_release);
+  s_dropped++;
+}
+
+// Claim a slot for an incoming frame. Inline mode evicts the oldest queued
+// packet when the pool is exhausted; task mode simply reports no slot.
+static uint8_t slotAlloc(size_t len) {
+  uint8_t idx = slotFind(len);
+  while (idx == NO_SLOT && !s_useTask && !q_empty()) {
+    queueDropOldest();
+    if (s_debug) Serial.println("[TypeDUDP] pool full -> dropped oldest");
+    idx = slotFind(len);
+  }
+  return idx;
+}
+
 static bool wifiConnected() {
-  return WiFi.status() == WL_CONNECTED;
+  const int8_t l = s_link.load(std::memory_order_relaxed);
+  return (l < 0) ? (WiFi.status() == WL_CONNECTED) : (l != 0);
 }
 
 static inline void ipToStr(const IPAddress& ip, char* out, size_t cap) {
@@ -45,13 +211,20 @@ static inline void ipToStr(const IPAddress& ip, char* out, size_t cap) {
   snprintf(out, cap, "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
 }
 
+// Bound to INADDR_ANY either way; with a group set, also joins it.
+static bool bindSocket(WiFiUDP& udp, uint16_t port) {
+  if (!port) return false;
+  if ((uint32_t)s_mcast) return udp.beginMulticast(s_mcast, port);
+  return udp.begin(port);
+}
+
 static void bindIfReady() {
   if (s_mode != Mode::ARMED) return;
   if (!wifiConnected()) return;
 
-  s_udpA_on = s_portA ? s_udpA.begin(s_portA) : false;
-  s_udpB_on = s_portB ? s_udpB.begin(s_portB) : false;
-  s_udpC_on = s_portC ? s_udpC.begin(s_portC) : false;
+  s_udpA_on = bindSocket(s_udpA, s_portA);
+  s_udpB_on = bindSocket(s_udpB, s_portB);
+  s_udpC_on = bindSocket(s_udpC, s_portC);
 
   s_mode = Mode::STARTED;
 
@@ -60,6 +233,11 @@ static void bindIfReady() {
                   (unsigned)s_portA, s_udpA_on ? "on" : "off",
                   (unsigned)s_portB, s_udpB_on ? "on" : "off",
                   (unsigned)s_portC, s_udpC_on ? "on" : "off");
+    if ((uint32_t)s_mcast) {
+      char g[20];
+      ipToStr(s_mcast, g, sizeof(g));
+      Serial.printf("[TypeDUDP] joined multicast %s\n", g);
+    }
   }
 }
 
@@ -78,76 +256,369 @@ static void unbindIfDown() {
   }
 }
 
-// Push packet into ring; if full, drop the oldest (advance tail)
-static void queuePush(const Packet& pk) {
+static void closeSockets() {
+  if (s_udpA_on) { s_udpA.stop(); s_udpA_on = false; }
+  if (s_udpB_on) { s_udpB.stop(); s_udpB_on = false; }
+  if (s_udpC_on) { s_udpC.stop(); s_udpC_on = false; }
+}
+
+// Push slot into ring. Returns false if the frame was dropped.
+static bool queuePush(uint8_t idx) {
   if (q_full()) {
+    if (s_useTask) {
+      // consumer owns tail; drop the incoming frame instead
+      s_dropped++;
+      if (s_debug) Serial.println("[TypeDUDP] queue full -> dropped newest");
+      return false;
+    }
     // drop oldest to keep the most recent data
-    s_q_tail = q_next(s_q_tail);
+    queueDropOldest();
     if (s_debug) Serial.println("[TypeDUDP] queue full -> dropped oldest");
   }
-  s_q[s_q_head] = pk;
-  s_q_head = q_next(s_q_head);
+  const uint8_t h = s_q_head.load(std::memory_order_relaxed);
+  slotRef(idx);
+  s_q[h] = idx;
+  s_q_head.store(q_next(h), std::memory_order_release);
+  return true;
 }
 
-static void drainSocket(WiFiUDP& udp, uint16_t dst_hint) {
+// Swap the "latest packet" ref to 'idx' (NO_SLOT clears it).
+static void setLast(uint8_t idx) {
+  if (idx != NO_SLOT) slotRef(idx);
+  portENTER_CRITICAL(&s_lastMux);
+  const uint8_t old = s_lastSlot;
+  s_lastSlot = idx;
+  portEXIT_CRITICAL(&s_lastMux);
+  if (old != NO_SLOT) slotUnref(old);
+}
+
+// -------- Capture ring --------
+// Byte ring of [u32 ts][u16 dst][u16 len][payload] records. Written by the
+// receiver, read by the web handler (download) and the replay. s_capLock
+// guards the buffer, the indices and the copies; it is a mutex rather than
+// a critical section because a copy can be a whole frame (~1.5 KB).
+static const uint8_t CAP_MAGIC[8] = { 'T','D','C','A','P', 0x01, 0, 0 };
+static const size_t  CAP_HDR = 8;
+
+static uint8_t*     s_cap = nullptr;
+static size_t       s_capSize = 0, s_capHead = 0, s_capUsed = 0;
+static uint32_t     s_capFrames = 0;
+static volatile bool s_capOn = false;
+static SemaphoreHandle_t s_capLock = nullptr;
+static portMUX_TYPE s_capInitMux = portMUX_INITIALIZER_UNLOCKED;
+
+struct CapLock {
+  CapLock() {
+    if (!s_capLock) {
+      SemaphoreHandle_t m = xSemaphoreCreateMutex();
+      portENTER_CRITICAL(&s_capInitMux);
+      if (!s_capLock) { s_capLock = m; m = nullptr; }
+      portEXIT_CRITICAL(&s_capInitMux);
+      if (m) vSemaphoreDelete(m);
+    }
+    xSemaphoreTake(s_capLock, portMAX_DELAY);
+  }
+  ~CapLock() { xSemaphoreGive(s_capLock); }
+};
+
+static inline size_t capTail() { return (s_capHead + s_capSize - s_capUsed) % s_capSize; }
+
+static void capCopyIn(size_t at, const uint8_t* p, size_t n) {
+  const size_t first = min(n, s_capSize - at);
+  memcpy(s_cap + at, p, first);
+  if (n > first) memcpy(s_cap, p + first, n - first);
+}
+static void capCopyOut(size_t at, uint8_t* p, size_t n) {
+  const size_t first = min(n, s_capSize - at);
+  memcpy(p, s_cap + at, first);
+  if (n > first) memcpy(p + first, s_cap, n - first);
+}
+
+static void capRecord(const PacketView& pk) {
+  const size_t need = CAP_HDR + pk.rx_len;
+  uint8_t hdr[CAP_HDR];
+  const uint32_t ts = pk.ts_ms;
+  const uint16_t dst = pk.dst_port, len = (uint16_t)pk.rx_len;
+  memcpy(hdr, &ts, 4); memcpy(hdr + 4, &dst, 2); memcpy(hdr + 6, &len, 2);
+
+  CapLock lock;
+  if (s_capOn && need <= s_capSize) {
+    while (s_capUsed + need > s_capSize) {        // evict the oldest records
+      uint8_t old[CAP_HDR];
+      capCopyOut(capTail(), old, CAP_HDR);
+      uint16_t oldLen; memcpy(&oldLen, old + 6, 2);
+      s_capUsed -= CAP_HDR + oldLen;
+      s_capFrames--;
+    }
+    capCopyIn(s_capHead, hdr, CAP_HDR);
+    capCopyIn((s_capHead + CAP_HDR) % s_capSize, (const uint8_t*)pk.data, pk.rx_len);
+    s_capHead = (s_capHead + need) % s_capSize;
+    s_capUsed += need;
+    s_capFrames++;
+  }
+}
+
+// -------- Replay (runs in the receiver context) --------
+static volatile bool s_repOn = false;
+static bool     s_repLoop = false;
+static uint16_t s_repSpeed = 1;
+static size_t   s_repOff = 0;            // byte offset from the ring tail
+static uint32_t s_repT0 = 0, s_repWall0 = 0, s_repCount = 0;
+
+static inline uint8_t portOf(uint16_t dst) {
+  return (dst == s_portB) ? 1 : (dst == s_portC) ? 2 : 0;
+}
+
+// Publish a filled slot: stamp it, queue it, update stats.
+static void publish(uint8_t idx, size_t n, size_t clipped, const IPAddress& ip,
+                    uint16_t srcPort, uint16_t dst, uint8_t port) {
+  Slot& sl = s_slots[idx];
+  sl.buf[n] = '\0';
+
+  PacketView& pk = sl.v;
+  pk.data     = sl.buf;
+  pk.rx_len   = n;
+  pk.clipped  = clipped;
+  pk.ip       = ip;
+  pk.src_port = srcPort;
+  pk.dst_port = dst;             // reliable classification
+  pk.ts_ms    = millis();
+  pk.ts_us    = micros();
+  const uint8_t grp  = laneGroup((uint32_t)ip, pk.ts_ms);
+  const uint8_t lane = (uint8_t)(grp * NUM_PORTS + port);
+  if (srcPort && (port == 0 || s_groupRet[grp].load(std::memory_order_relaxed) != (uint32_t)ip)) {
+    s_groupPort[grp].store(srcPort, std::memory_order_relaxed);   // MAIN's port wins
+    s_groupRet[grp].store((uint32_t)ip, std::memory_order_release);
+  }
+  pk.seq      = ++s_laneSeq[lane];
+  pk.superseded = 0;             // filled in when the consumer takes it
+
+  if (s_capOn && !s_repOn) capRecord(pk);
+
+  // Enqueue for consumers (publishes the slot contents)
+  if (s_qmode == QueueMode::Coalesce) lanePublish(lane, idx);
+  else queuePush(idx);
+
+  // Update legacy stats
+  setLast(idx);
+  s_ever.store(true, std::memory_order_relaxed);
+  s_lastSeen.store(pk.ts_ms, std::memory_order_relaxed);
+  s_pktCount.fetch_add(1, std::memory_order_relaxed);
+
+  if (s_debug) {
+    char ipbuf[20];
+    ipToStr(pk.ip, ipbuf, sizeof(ipbuf));
+    Serial.printf("[TypeDUDP] %lu  src=%s:%u dst=%u  len=%u",
+                  (unsigned long)pk.ts_ms, ipbuf, (unsigned)pk.src_port,
+                  (unsigned)pk.dst_port, (unsigned)(n + clipped));
+    if (pk.clipped) Serial.printf(" (clipped %u)", (unsigned)pk.clipped);
+    Serial.print("  data=\"");
+    const char* p = pk.data;
+    size_t shown = 0;
+    while (*p && shown < 96) {
+      char c = *p++;
+      if (c >= 32 && c <= 126) Serial.write(c);
+      else if (c == '\n') Serial.print("\\n");
+      else if (c == '\r') Serial.print("\\r");
+      else if (c == '\t') Serial.print("\\t");
+      else Serial.print(".");
+      shown++;
+    }
+    if (pk.rx_len > shown) Serial.print("...");
+    Serial.println("\"");
+  }
+}
+
+static void drainSocket(WiFiUDP& udp, uint16_t dst_hint, uint8_t port) {
   // Read ALL pending packets from this socket
   int pktSize;
   while ((pktSize = udp.parsePacket()) > 0) {
-    Packet pk;
+    Metrics::Scope m(Metrics::T_UDP_DRAIN);
     size_t want = (size_t)pktSize;
+    size_t clipped = 0;
     if (want > UDP_TYPED_MAX_PAYLOAD) {
-      pk.clipped = want - UDP_TYPED_MAX_PAYLOAD;
+      clipped = want - UDP_TYPED_MAX_PAYLOAD;
       want = UDP_TYPED_MAX_PAYLOAD;
-    } else {
-      pk.clipped = 0;
     }
 
-    int n = udp.read((uint8_t*)pk.data, want);
+    // Drop the ref to 'latest' first so its slot can be recycled.
+    setLast(NO_SLOT);
+
+    const uint8_t idx = slotAlloc(want);
+    if (idx == NO_SLOT) {
+      // No slot could be recycled; discard this datagram.
+      udp.flush();
+      s_dropped++;
+      continue;
+    }
+
+    int n = udp.read((uint8_t*)s_slots[idx].buf, want);   // receive straight into the pool
     if (n < 0) n = 0;
-    pk.data[n] = '\0';
-    pk.rx_len   = (size_t)n;
-    pk.ip       = udp.remoteIP();
-    pk.src_port = udp.remotePort();
-    pk.port     = pk.src_port;     // legacy alias
-    pk.dst_port = dst_hint;        // reliable classification
-    pk.ts_ms    = millis();
-
-    // Update legacy stats
-    s_last     = pk;
-    s_ever     = true;
-    s_lastSeen = pk.ts_ms;
-    s_pktCount++;
-
-    // Enqueue for consumers
-    queuePush(pk);
-
-    if (s_debug) {
-      char ipbuf[20];
-      ipToStr(pk.ip, ipbuf, sizeof(ipbuf));
-      Serial.printf("[TypeDUDP] %lu  src=%s:%u dst=%u  len=%u",
-                    (unsigned long)pk.ts_ms, ipbuf, (unsigned)pk.src_port,
-                    (unsigned)pk.dst_port, (unsigned)pktSize);
-      if (pk.clipped) Serial.printf(" (clipped %u)", (unsigned)pk.clipped);
-      Serial.print("  data=\"");
-      const char* p = pk.data;
-      size_t shown = 0;
-      while (*p && shown < 96) {
-        char c = *p++;
-        if (c >= 32 && c <= 126) Serial.write(c);
-        else if (c == '\n') Serial.print("\\n");
-        else if (c == '\r') Serial.print("\\r");
-        else if (c == '\t') Serial.print("\\t");
-        else Serial.print(".");
-        shown++;
+    publish(idx, (size_t)n, clipped, udp.remoteIP(), udp.remotePort(), dst_hint, port);
+  }
+}
+
+// Inject every recorded frame that is due at this replay speed. Each frame
+// is read under s_capLock in one go, so captureStart() can't free the ring
+// between its header and its payload.
+static void replayStep() {
+  if (!s_repOn) return;
+  const uint32_t elapsed = (millis() - s_repWall0) * s_repSpeed;
+  for (;;) {
+    uint8_t idx = NO_SLOT;
+    size_t  n = 0;
+    uint16_t len = 0, dst = 0;
+    {
+      CapLock lock;
+      if (!s_repOn) return;                            // stopped under the lock
+      if (s_repOff + CAP_HDR > s_capUsed) {            // end of trace
+        if (!s_repLoop || !s_repCount) { s_repOn = false; return; }
+        s_repOff = 0;
+        s_repWall0 = millis();
+        return;                                        // next pass starts on the next step
       }
-      if (pk.rx_len > shown) Serial.print("...");
-      Serial.println("\"");
+      uint8_t hdr[CAP_HDR];
+      const size_t at = (capTail() + s_repOff) % s_capSize;
+      capCopyOut(at, hdr, CAP_HDR);
+      uint32_t ts;
+      memcpy(&ts, hdr, 4); memcpy(&dst, hdr + 4, 2); memcpy(&len, hdr + 6, 2);
+      if (s_repOff == 0) s_repT0 = ts;
+      if ((uint32_t)(ts - s_repT0) > elapsed) return;  // not due yet
+
+      n = min((size_t)len, (size_t)UDP_TYPED_MAX_PAYLOAD);
+      setLast(NO_SLOT);
+      idx = slotAlloc(n);
+      if (idx != NO_SLOT) capCopyOut((at + CAP_HDR) % s_capSize, (uint8_t*)s_slots[idx].buf, n);
+      s_repOff += CAP_HDR + len;
     }
+    if (idx == NO_SLOT) { s_dropped++; continue; }
+    publish(idx, n, len - n, IPAddress(127, 0, 0, 1), 0, dst, portOf(dst));
+    s_repCount++;
   }
 }
 
+// -------- Reverse control outbox --------
+// Filled from the consumer side, sent by the receiver (which owns the
+// sockets). s_ctrlMux guards the slots.
+struct CtrlMsg { uint32_t ip; uint8_t len; uint8_t buf[UDP_TYPED_CTRL_MAX]; };
+static CtrlMsg      s_ctrl[UDP_TYPED_CTRL_SLOTS];
+static std::atomic<uint32_t> s_ctrlSent{0};
+static portMUX_TYPE s_ctrlMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint16_t returnPort(uint32_t ip) {
+  for (uint8_t g = 0; g < UDP_TYPED_LANE_SENDERS; ++g)
+    if (s_groupRet[g].load(std::memory_order_acquire) == ip) return s_groupPort[g].load(std::memory_order_relaxed);
+  return 0;
+}
+
+static void controlStep() {
+  if (!s_udpA_on) return;
+  for (uint8_t i = 0; i < UDP_TYPED_CTRL_SLOTS; ++i) {
+    CtrlMsg m;
+    portENTER_CRITICAL(&s_ctrlMux);
+    m = s_ctrl[i];
+    s_ctrl[i].len = 0;
+    portEXIT_CRITICAL(&s_ctrlMux);
+    if (!m.len) continue;
+    const uint16_t port = returnPort(m.ip);
+    if (!port) continue;                      // sender evicted meanwhile
+    if (s_udpA.beginPacket(IPAddress(m.ip), port)) {
+      s_udpA.write(m.buf, m.len);
+      if (s_udpA.endPacket()) s_ctrlSent.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+static void copyOut(const PacketView& v, Packet& out) {
+  out.ts_ms    = v.ts_ms;
+  out.ip       = v.ip;
+  out.src_port = v.src_port;
+  out.port     = v.src_port;   // legacy alias
+  out.dst_port = v.dst_port;
+  out.rx_len   = v.rx_len;
+  out.clipped  = v.clipped;
+  if (v.data) memcpy(out.data, v.data, v.rx_len);
+  out.data[v.rx_len] = '\0';
+}
+
+// One receiver step: socket state transitions, then drain everything pending.
+static void rxStep() {
+  // Handle state transitions first
+  if (s_mode == Mode::ARMED) bindIfReady();
+  else if (s_mode == Mode::STARTED) unbindIfDown();
+
+  // Drain all sockets when running
+  if (s_mode == Mode::STARTED) {
+    if (s_udpA_on) drainSocket(s_udpA, s_portA, 0);
+    if (s_udpB_on) drainSocket(s_udpB, s_portB, 1);
+    if (s_udpC_on) drainSocket(s_udpC, s_portC, 2);
+    controlStep();
+  }
+  replayStep();
+}
+
+static void rxTask(void*) {
+  while (!s_taskStop) {
+    const uint32_t before = s_pktCount.load(std::memory_order_relaxed);
+    rxStep();
+    void (*notify)() = s_rxNotify;
+    if (notify && s_pktCount.load(std::memory_order_relaxed) != before) notify();
+    vTaskDelay(pdMS_TO_TICKS(UDP_TYPED_RX_POLL_MS));
+  }
+  closeSockets();
+  s_task = nullptr;
+  vTaskDelete(nullptr);
+}
+
+static void startTask() {
+  if (s_task) return;
+  s_taskStop = false;
+  xTaskCreatePinnedToCore(rxTask, "typed_rx", UDP_TYPED_RX_STACK, nullptr,
+                          UDP_TYPED_RX_PRIO, &s_task, UDP_TYPED_RX_CORE);
+  if (s_debug) Serial.printf("[TypeDUDP] rx task %s on core %d\n",
+                             s_task ? "started" : "FAILED", (int)UDP_TYPED_RX_CORE);
+  if (!s_task) s_useTask = false;   // fall back to polling from loop()
+}
+
+static void stopTask() {
+  if (!s_task) return;
+  s_taskStop = true;
+  for (int i = 0; i < 100 && s_task; ++i) vTaskDelay(pdMS_TO_TICKS(2));
+}
+
 // ---------- API ----------
+void useRxTask(bool enable) {
+  if (s_mode != Mode::OFF) return;   // only selectable while stopped
+  s_useTask = enable;
+}
+
+bool rxTaskActive() { return s_task != nullptr; }
+
+void setRxNotify(void (*fn)()) { s_rxNotify = fn; }
+
+void setLinkUp(bool up) { s_link.store(up ? 1 : 0, std::memory_order_relaxed); }
+
+void setMulticastGroup(const IPAddress& group) {
+  if (s_mode != Mode::OFF) return;   // only selectable while stopped
+  s_mcast = group;
+}
+
+IPAddress multicastGroup() { return s_mcast; }
+
+uint16_t portA() { return s_portA; }
+uint16_t portB() { return s_portB; }
+uint16_t portC() { return s_portC; }
+
+void setQueueMode(QueueMode m) {
+  if (s_mode != Mode::OFF) return;   // only selectable while stopped
+  s_qmode = m;
+}
+
+QueueMode queueMode() { return s_qmode; }
+
 void begin(uint16_t portA, uint16_t portB, uint16_t portC) {
+  stopTask();
+
   // Store desired ports; do NOT bind yet unless Wi-Fi is already connected.
   s_portA = portA;
   s_portB = portB;
@@ -156,38 +627,43 @@ void begin(uint16_t portA, uint16_t portB, uint16_t portC) {
   s_ever     = false;
   s_pktCount = 0;
   s_lastSeen = 0;
-  s_last     = Packet(); // reset
-
-  // reset queue
-  s_q_head = s_q_tail = 0;
+  s_dropped  = 0;
+  s_superseded = 0;
+  s_ctrlSent = 0;
+  portENTER_CRITICAL(&s_ctrlMux);
+  for (auto& m : s_ctrl) m.len = 0;
+  portEXIT_CRITICAL(&s_ctrlMux);
+
+  // reset pool + queue
+  poolInit();
+  s_q_head = 0;
+  s_q_tail = 0;
+  lanesInit();
 
   s_mode = Mode::ARMED;
-  if (wifiConnected()) {
-    bindIfReady();
-  } else if (s_debug) {
-    Serial.println("[TypeDUDP] armed (waiting for Wi-Fi)");
+  if (s_useTask) {
+    startTask();                 // task binds once Wi-Fi is up
+  }
+  if (!s_useTask) {
+    if (wifiConnected()) {
+      bindIfReady();
+    } else if (s_debug) {
+      Serial.println("[TypeDUDP] armed (waiting for Wi-Fi)");
+    }
   }
 }
 
 void end() {
-  if (s_udpA_on) { s_udpA.stop(); s_udpA_on = false; }
-  if (s_udpB_on) { s_udpB.stop(); s_udpB_on = false; }
-  if (s_udpC_on) { s_udpC.stop(); s_udpC_on = false; }
+  stopTask();
+  closeSockets();
   s_mode = Mode::OFF;
   if (s_debug) Serial.println("[TypeDUDP] stopped");
 }
 
 void loop() {
-  // Handle state transitions first
-  if (s_mode == Mode::ARMED) bindIfReady();
-  else if (s_mode == Mode::STARTED) unbindIfDown();
-
-  // Drain all sockets when running
-  if (s_mode == Mode::STARTED) {
-    if (s_udpA_on) drainSocket(s_udpA, s_portA);
-    if (s_udpB_on) drainSocket(s_udpB, s_portB);
-    if (s_udpC_on) drainSocket(s_udpC, s_portC);
-  }
+  // In task mode the receiver runs on its own core; nothing to pump here.
+  if (s_task) return;
+  rxStep();
 }
 
 void setDebug(bool enable) {
@@ -198,38 +674,190 @@ void setDebug(bool enable) {
 bool debugEnabled() { return s_debug; }
 
 // NEW: pending packets in the queue (use this in loops)
-bool hasPacket() { return !q_empty(); }
+bool hasPacket() { return available(); }
 
 // NEW: retain the old meaning — have we ever seen any packet since begin()?
-bool everReceived() { return s_ever; }
+bool everReceived() { return s_ever.load(std::memory_order_relaxed); }
 
-uint32_t lastSeenMs() { return s_lastSeen; }
+uint32_t lastSeenMs() { return s_lastSeen.load(std::memory_order_relaxed); }
 
 bool isAlive(uint32_t timeout_ms) {
-  uint32_t now = millis();
-  return s_lastSeen != 0 && (uint32_t)(now - s_lastSeen) <= timeout_ms;
+  uint32_t now  = millis();
+  uint32_t seen = s_lastSeen.load(std::memory_order_relaxed);
+  return seen != 0 && (uint32_t)(now - seen) <= timeout_ms;
 }
 
-uint32_t packetCount() { return s_pktCount; }
+uint32_t packetCount() { return s_pktCount.load(std::memory_order_relaxed); }
 
 bool armed()   { return s_mode == Mode::ARMED; }
 bool started() { return s_mode == Mode::STARTED; }
 
-const Packet& last() { return s_last; }
+const Packet& last() {
+  if (!s_lastCopy) s_lastCopy = Mem::bulkNew<Packet>();
+  if (!s_lastCopy) s_lastCopy = new Packet();
+  // Pin the newest slot so the receiver cannot recycle it mid-copy.
+  portENTER_CRITICAL(&s_lastMux);
+  const uint8_t idx = s_lastSlot;
+  if (idx != NO_SLOT) slotRef(idx);
+  portEXIT_CRITICAL(&s_lastMux);
+  if (idx != NO_SLOT) {
+    copyOut(s_slots[idx].v, *s_lastCopy);
+    slotUnref(idx);
+  }
+  return *s_lastCopy;
+}
+
+uint32_t droppedCount() { return s_dropped.load(std::memory_order_relaxed); }
+
+uint32_t supersededCount() { return s_superseded.load(std::memory_order_relaxed); }
+
+// -------- Reverse control --------
+bool sendControl(const IPAddress& ip, const uint8_t* msg, size_t len) {
+  const uint32_t a = (uint32_t)ip;
+  if (!a || !msg || !len || len > UDP_TYPED_CTRL_MAX || !returnPort(a)) return false;
+  bool ok = false;
+  portENTER_CRITICAL(&s_ctrlMux);
+  CtrlMsg* slot = nullptr;
+  for (auto& m : s_ctrl) if (m.len && m.ip == a) { slot = &m; break; }
+  if (!slot) for (auto& m : s_ctrl) if (!m.len) { slot = &m; break; }
+  if (slot) {
+    slot->ip = a;
+    slot->len = (uint8_t)len;
+    memcpy(slot->buf, msg, len);
+    ok = true;
+  }
+  portEXIT_CRITICAL(&s_ctrlMux);
+  return ok;
+}
+
+uint32_t controlSent() { return s_ctrlSent.load(std::memory_order_relaxed); }
+
+// -------- Capture / replay --------
+bool captureStart(size_t bytes) {
+  if (!psramFound() && bytes > UDP_TYPED_CAPTURE_BYTES_IRAM) bytes = UDP_TYPED_CAPTURE_BYTES_IRAM;
+  if (bytes < CAP_HDR + UDP_TYPED_MAX_PAYLOAD) bytes = CAP_HDR + UDP_TYPED_MAX_PAYLOAD;
+
+  uint8_t* old = nullptr;
+  {
+    CapLock lock;                      // a replay step in flight finishes first
+    s_repOn = false;
+    s_capOn = false;
+    if (s_capSize != bytes) { old = s_cap; s_cap = nullptr; s_capSize = 0; }
+    s_capHead = s_capUsed = 0;
+    s_capFrames = 0;
+  }
+  Mem::bulkFree(old);
+
+  if (!s_cap) {
+    uint8_t* p = (uint8_t*)Mem::bulkAlloc(bytes);
+    if (!p) {
+      if (s_debug) Serial.printf("[TypeDUDP] capture: %u B alloc failed\n", (unsigned)bytes);
+      return false;
+    }
+    CapLock lock;
+    s_cap = p; s_capSize = bytes;
+  }
+  s_capOn = true;
+  if (s_debug) Serial.printf("[TypeDUDP] capture on (%u B ring)\n", (unsigned)bytes);
+  return true;
+}
+
+void captureStop() { s_capOn = false; }
+bool capturing()   { return s_capOn; }
+
+uint32_t captureFrames() {
+  CapLock lock;
+  return s_capFrames;
+}
+
+size_t captureSize() {
+  CapLock lock;
+  return s_cap ? CAP_HDR + s_capUsed : 0;
+}
+
+size_t captureRead(size_t offset, uint8_t* dst, size_t cap) {
+  size_t got = 0;
+  while (got < cap && offset < CAP_HDR) dst[got++] = CAP_MAGIC[offset++];
+  CapLock lock;
+  if (s_cap && offset - CAP_HDR < s_capUsed) {
+    const size_t n = min(cap - got, s_capUsed - (offset - CAP_HDR));
+    capCopyOut((capTail() + offset - CAP_HDR) % s_capSize, dst + got, n);
+    got += n;
+  }
+  return got;
+}
+
+bool replayStart(uint16_t speedX, bool loop) {
+  {
+    CapLock lock;
+    if (!s_capFrames) return false;
+    s_capOn = false;                   // the trace must hold still while it plays
+    s_repSpeed = speedX ? (speedX > 100 ? 100 : speedX) : 1;
+    s_repLoop  = loop;
+    s_repOff   = 0;
+    s_repCount = 0;
+    s_repWall0 = millis();
+    s_repOn    = true;
+  }
+  if (s_debug) Serial.printf("[TypeDUDP] replay x%u%s\n", (unsigned)s_repSpeed, loop ? " (loop)" : "");
+  return true;
+}
+
+void replayStop()       { s_repOn = false; }
+bool replaying()        { return s_repOn; }
+uint32_t replayedCount() { return s_repCount; }
 
 // -------- Queue API --------
-bool available() { return !q_empty(); }
+bool available() {
+  if (s_qmode == QueueMode::Coalesce) return laneCount() != 0;
+  return !q_empty();
+}
 
-size_t pendingCount() { return q_count(); }
+size_t pendingCount() {
+  if (s_qmode == QueueMode::Coalesce) return laneCount();
+  return q_count();
+}
 
 bool next(Packet& out) {
-  if (q_empty()) return false;
-  out = s_q[s_q_tail];
-  s_q_tail = q_next(s_q_tail);
+  const PacketView* v = peek();
+  if (!v) return false;
+  copyOut(*v, out);
+  release();
   return true;
 }
 
-// Optional convenience: drop any queued backlog
-void flush() { s_q_tail = s_q_head; }
+const PacketView* peek() {
+  if (s_qmode == QueueMode::Coalesce) {
+    if (s_held == NO_SLOT) {
+      // Take the next dirty lane, rotating so no sender or port can starve the others.
+      for (uint8_t k = 0; k < NUM_LANES && s_held == NO_SLOT; ++k) {
+        const uint8_t lane = (uint8_t)((s_rrLane + k) % NUM_LANES);
+        const uint8_t idx  = s_latest[lane].exchange(NO_SLOT, std::memory_order_acq_rel);
+        if (idx == NO_SLOT) continue;
+        s_held = idx;
+        s_rrLane = (uint8_t)((lane + 1) % NUM_LANES);
+        s_slots[idx].v.superseded = s_laneSuperseded[lane].exchange(0, std::memory_order_relaxed);
+      }
+      if (s_held == NO_SLOT) return nullptr;
+    }
+    return &s_slots[s_held].v;
+  }
+  if (q_empty()) return nullptr;
+  return &s_slots[s_q[s_q_tail.load(std::memory_order_relaxed)]].v;
+}
+
+void release() {
+  if (s_qmode == QueueMode::Coalesce) {
+    if (s_held != NO_SLOT) { slotUnref(s_held); s_held = NO_SLOT; }
+    return;
+  }
+  if (q_empty()) return;
+  const uint8_t t = s_q_tail.load(std::memory_order_relaxed);
+  slotUnref(s_q[t]);
+  s_q_tail.store(q_next(t), std::memory_order_release);
+}
+
+// Drop any queued backlog
+void flush() { while (peek()) release(); }
 
 } // namespace TypeDUDP
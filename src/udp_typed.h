@@ -17,12 +17,79 @@
 #define UDP_TYPED_DEFAULT_PORT_C 50506  // EEPROM text
 #endif
 
+// Optional IPv4 multicast group joined (IGMP) on all three sockets, so one
+// sender can feed several displays. 0.0.0.0 = unicast/broadcast only.
+#ifndef UDP_TYPED_MCAST_GROUP
+#define UDP_TYPED_MCAST_GROUP 0, 0, 0, 0
+#endif
+
 #ifndef UDP_TYPED_QUEUE_DEPTH
 #define UDP_TYPED_QUEUE_DEPTH 12        // ring buffer size for incoming packets
 #endif
 
+// Coalesce mode keeps one lane per socket for each of this many senders
+// (source IPs); past that the least recently heard sender's lanes are reused.
+#ifndef UDP_TYPED_LANE_SENDERS
+#define UDP_TYPED_LANE_SENDERS 4
+#endif
+
+// Packet pool: frames are received straight into a pooled slot sized for them.
+// MAIN (44 B), EXT (28 B) and EE text all fit a small slot; only oversized
+// datagrams take one of the few MAX_PAYLOAD slots.
+#ifndef UDP_TYPED_SMALL_SLOT
+#define UDP_TYPED_SMALL_SLOT 128        // payload bytes per small slot
+#endif
+#ifndef UDP_TYPED_SMALL_SLOTS
+#define UDP_TYPED_SMALL_SLOTS 16        // number of small slots
+#endif
+#ifndef UDP_TYPED_LARGE_SLOTS
+#define UDP_TYPED_LARGE_SLOTS 2         // number of MAX_PAYLOAD slots
+#endif
+
+// Receiver task: when enabled, sockets are bound and drained on a dedicated
+// task (pinned next to the Wi-Fi stack) and loop() becomes a no-op. The
+// consumer side (peek/release/next) stays on the Arduino loop task.
+#ifndef UDP_TYPED_RX_TASK
+#define UDP_TYPED_RX_TASK 0             // default mode; see useRxTask()
+#endif
+#ifndef UDP_TYPED_RX_CORE
+#define UDP_TYPED_RX_CORE 0             // PRO core (Arduino loop runs on 1)
+#endif
+#ifndef UDP_TYPED_RX_STACK
+#define UDP_TYPED_RX_STACK 4096
+#endif
+#ifndef UDP_TYPED_RX_PRIO
+#define UDP_TYPED_RX_PRIO 3
+#endif
+#ifndef UDP_TYPED_RX_POLL_MS
+#define UDP_TYPED_RX_POLL_MS 2          // socket poll period inside the task
+#endif
+
+// Reverse control: largest message, pending messages (one per sender).
+#ifndef UDP_TYPED_CTRL_MAX
+#define UDP_TYPED_CTRL_MAX 32
+#endif
+#ifndef UDP_TYPED_CTRL_SLOTS
+#define UDP_TYPED_CTRL_SLOTS UDP_TYPED_LANE_SENDERS
+#endif
+
+// Capture ring (record incoming frames for replay/download). PSRAM is used
+// when present; without it the ring is capped at the internal-RAM size.
+#ifndef UDP_TYPED_CAPTURE_BYTES
+#define UDP_TYPED_CAPTURE_BYTES (256 * 1024)
+#endif
+#ifndef UDP_TYPED_CAPTURE_BYTES_IRAM
+#define UDP_TYPED_CAPTURE_BYTES_IRAM (16 * 1024)
+#endif
+
 namespace TypeDUDP {
 
+// Queue policy. Fifo keeps every frame in arrival order (up to QUEUE_DEPTH).
+// Coalesce keeps only the newest frame per sender and local port: MAIN/EXT/EE
+// are state snapshots, so a consumer sees at most one frame per console and
+// port per drain.
+enum class QueueMode : uint8_t { Fifo = 0, Coalesce };
+
 struct Packet {
   uint32_t   ts_ms = 0;                 // millis() when received
   IPAddress  ip;                         // sender IP
@@ -34,13 +101,51 @@ struct Packet {
   char       data[UDP_TYPED_MAX_PAYLOAD + 1]; // payload (NUL-terminated)
 };
 
+// Zero-copy view of a pooled packet. 'data' points into the pool and stays
+// valid until release() is called for this packet.
+struct PacketView {
+  uint32_t    ts_ms = 0;                // millis() when received
+  uint32_t    ts_us = 0;                // micros() when received (latency tracking)
+  IPAddress   ip;                       // sender IP
+  uint16_t    src_port = 0;             // sender source port (remotePort)
+  uint16_t    dst_port = 0;             // local socket port we received on
+  size_t      rx_len = 0;               // bytes actually stored
+  size_t      clipped = 0;              // bytes dropped if > MAX_PAYLOAD
+  const char* data = nullptr;           // payload (NUL-terminated)
+  uint32_t    seq = 0;                  // per-lane (sender + port) receive sequence (1, 2, ...)
+  uint32_t    superseded = 0;           // Coalesce: newer frames replaced older ones N times
+};
+
 // Lifecycle
 void begin(uint16_t portA = UDP_TYPED_DEFAULT_PORT_A,
            uint16_t portB = UDP_TYPED_DEFAULT_PORT_B,
            uint16_t portC = UDP_TYPED_DEFAULT_PORT_C);
 
 void end();
-void loop();
+void loop();                             // polls sockets (no-op when the rx task runs)
+
+// Link state from the connection manager (WiFiMgr::onLink). Until the first
+// call, sockets follow WiFi.status() polled on every receiver step.
+void setLinkUp(bool up);
+
+// Receiver task (select before begin())
+void useRxTask(bool enable);
+bool rxTaskActive();
+void setRxNotify(void (*fn)());          // rx task: called after a drain that queued packets
+
+// Multicast group (select before begin(); 0.0.0.0 turns it off).
+// Unicast and broadcast frames are still received on the same sockets.
+void setMulticastGroup(const IPAddress& group);
+IPAddress multicastGroup();
+
+// Local ports given to begin() (0 = that socket is disabled)
+uint16_t portA();
+uint16_t portB();
+uint16_t portC();
+
+// Queue policy (select before begin())
+void setQueueMode(QueueMode m);
+QueueMode queueMode();
 
 // Debug control
 void setDebug(bool enable);
@@ -55,12 +160,51 @@ uint32_t packetCount();                  // total packets since begin()
 bool armed();                            // armed (waiting for Wi-Fi)
 bool started();                          // sockets are bound
 
-// Legacy: latest packet snapshot (updated on every receive)
+// Legacy: latest packet snapshot (copied out of the pool on demand)
 const Packet& last();
 
 // ---------- New queue API (recommended) ----------
 bool available();                        // any packets queued?
 size_t pendingCount();                   // number of packets waiting
-bool next(Packet& out);                  // pop oldest queued packet into 'out'
+bool next(Packet& out);                  // pop oldest queued packet into 'out' (copies)
+
+// ---------- Zero-copy queue API ----------
+const PacketView* peek();                // oldest queued packet, parsed in place (nullptr if empty)
+void release();                          // pop the packet returned by peek()
+void flush();                            // drop any queued backlog
+uint32_t droppedCount();                 // packets lost to a full queue/pool since begin()
+                                         // (task mode drops the newest frame when full)
+uint32_t supersededCount();              // Coalesce: frames replaced before being read
+
+// ---------- Reverse control ----------
+// Queue a datagram (e.g. TypedProto::encodeControl) for the sender at 'ip'.
+// The receiver sends it from the primary socket to the source port that
+// sender's MAIN frames last came from, so no sender-side config is needed.
+// One message per sender is held; a newer one replaces it. False if the
+// sender hasn't been heard (no return port yet), the message is too big or
+// every slot is taken.
+bool sendControl(const IPAddress& ip, const uint8_t* msg, size_t len);
+uint32_t controlSent();                  // datagrams actually sent since begin()
+
+// ---------- Capture / replay ----------
+// Capture records every received frame (ts_ms, dst_port, payload) into a RAM
+// ring; the oldest records are dropped when it fills. Replay feeds the
+// recorded frames back through the queue as if they had just arrived
+// (ip 127.0.0.1, src_port 0), at speedX times the original pace, from the
+// receiver context. Nothing is recorded while a replay runs.
+//
+// Trace format (captureRead): "TDCAP\x01\0\0", then per frame
+// [u32 ts_ms][u16 dst_port][u16 len][payload], little-endian.
+bool captureStart(size_t bytes = UDP_TYPED_CAPTURE_BYTES);  // (re)allocates and clears
+void captureStop();
+bool capturing();
+uint32_t captureFrames();                // frames held
+size_t captureSize();                    // serialized trace size, bytes
+size_t captureRead(size_t offset, uint8_t* dst, size_t cap);  // stop capture first
+
+bool replayStart(uint16_t speedX = 1, bool loop = false);   // false if nothing captured
+void replayStop();
+bool replaying();
+uint32_t replayedCount();                // frames injected by the current/last replay
 
 } // namespace TypeDUDP
@@ -1,4 +1,7 @@
 #include "us2066.h"
+#include "metrics.h"
+#include "panel.h"     // TYPED_PANEL_* build flags
+#if TYPED_PANEL_US2066
 
 // Notes / References:
 // - US2066 uses I2C control prefix: 0x00 for command, 0x40 for data.
@@ -9,13 +12,19 @@
 
 US2066::US2066()
 : _wire(&Wire), _addr(US2066_DEFAULT_ADDR), _cols(20), _rows(4)
-{}
+{
+  _blank();
+  _shadowOk = false;
+}
 
 bool US2066::begin(TwoWire* w, uint8_t i2c_addr, uint8_t cols, uint8_t rows) {
   _wire = w ? w : &Wire;
   _addr = i2c_addr;
-  _cols = cols;
-  _rows = rows;
+  _cols = (cols && cols <= MAX_COLS) ? cols : MAX_COLS;
+  _rows = (rows && rows <= MAX_ROWS) ? rows : MAX_ROWS;
+  _shadowOk = false;
+  _addrAC = -1;
+  resetStats();
 
   // quick ping so we can early-out if not present
   if (!ping()) return false;
@@ -29,49 +38,117 @@ bool US2066::ping() const {
   return (_wire->endTransmission() == 0);
 }
 
-void US2066::_delayShort() { delayMicroseconds(40); }
-void US2066::_delayLong()  { delay(2); } // clear/home needs >1.52ms
+void US2066::_settle(uint32_t us) {
+  if (!_poll) {
+    if (us >= 1000) delay((us + 999) / 1000); else delayMicroseconds(us);
+    return;
+  }
+  _busyFrom = micros();
+  _busyUs   = us;
+}
+
+bool US2066::_readStatus(uint8_t& bfac) {
+  _wire->beginTransmission(_addr);
+  _wire->write(CB_CMD);
+  _stats.txns++;
+  if (_wire->endTransmission(false) != 0) { _stats.errors++; return false; }
+  if (_wire->requestFrom(_addr, (uint8_t)1) != 1 || !_wire->available()) { _stats.errors++; return false; }
+  bfac = (uint8_t)_wire->read();
+  return true;
+}
+
+void US2066::_ready() {
+  if (!_busyUs) return;
+  // The gap since the command (formatting, other work) usually covers the
+  // short guard already. Only poll when the remainder outlasts a BF read.
+  const uint32_t BF_READ_US = 100;
+  for (;;) {
+    const uint32_t gone = micros() - _busyFrom;
+    if (gone >= _busyUs) break;
+    const uint32_t left = _busyUs - gone;
+    uint8_t st;
+    if (left <= BF_READ_US || !_poll) { delayMicroseconds(left); break; }
+    if (!_readStatus(st)) { _poll = false; continue; }   // reads unsupported: fixed guards from now on
+    if (!(st & 0x80)) break;
+  }
+  _busyUs = 0;
+}
+
+bool US2066::setBusyPolling(bool on) {
+  _ready();
+  _poll = false;
+  if (!on) return true;
+  // Sanity check: park the address counter somewhere known and read it back.
+  const uint8_t probe = (uint8_t)(_ddramBase(0) + 5);
+  if (!_cmd(0x80 | probe)) return false;
+  delayMicroseconds(GUARD_SHORT_US);
+  uint8_t st = 0;
+  bool ok = _readStatus(st) && !(st & 0x80) && ((st & 0x7F) == probe);
+  _addrAC = ok ? probe : -1;
+  _poll = ok;
+  return ok;
+}
+
+bool US2066::_end() {
+  _stats.txns++;
+  const uint32_t t0 = micros();
+  const uint8_t rc = _wire->endTransmission();
+  Metrics::sample(Metrics::H_I2C, micros() - t0);
+  if (rc == 0) return true;
+  _stats.errors++;
+  return false;
+}
 
 bool US2066::_cmd(uint8_t c) {
+  _ready();
   _wire->beginTransmission(_addr);
   _wire->write(CB_CMD);
   _wire->write(c);
-  if (_wire->endTransmission() != 0) return false;
+  if (!_end()) return false;
   // Small guard; some commands need a short pause
-  _delayShort();
+  _settle(GUARD_SHORT_US);
   return true;
 }
 
 bool US2066::_cmd2(uint8_t c1, uint8_t c2) {
+  _ready();
   _wire->beginTransmission(_addr);
   _wire->write(CB_CMD);
   _wire->write(c1);
   _wire->write(c2);
-  if (_wire->endTransmission() != 0) return false;
-  _delayShort();
+  if (!_end()) return false;
+  _settle(GUARD_SHORT_US);
   return true;
 }
 
 bool US2066::_data(const uint8_t* b, size_t n) {
-  // Chunk writes to avoid long I2C bursts; 16 bytes is safe for most stacks
-  const size_t CHUNK = 16;
+  // Each transaction carries as much as the Wire TX buffer takes (write()
+  // returns what it accepted), optionally capped by setBurst().
   size_t off = 0;
   while (off < n) {
-    size_t cnt = (n - off > CHUNK) ? CHUNK : (n - off);
+    size_t want = n - off;
+    if (_burst && want > _burst) want = _burst;
+    _ready();
     _wire->beginTransmission(_addr);
     _wire->write(CB_DATA);
-    _wire->write(b + off, cnt);
-    if (_wire->endTransmission() != 0) return false;
+    const size_t cnt = _wire->write(b + off, want);
+    if (!_end() || cnt == 0) return false;
+    _stats.dataTxns++;
+    _stats.dataBytes += cnt;
     off += cnt;
   }
   return true;
 }
 
 bool US2066::_dataByte(uint8_t b) {
+  _ready();
   _wire->beginTransmission(_addr);
   _wire->write(CB_DATA);
   _wire->write(b);
-  return (_wire->endTransmission() == 0);
+  if (!_end()) return false;
+  _stats.dataTxns++;
+  _stats.dataBytes++;
+  return true;
 }
 
 bool US2066::_initSequence() {
@@ -85,7 +162,7 @@ bool US2066::_initSequence() {
   // Internal VDD regulator control via 0x71 then data 0x5C (per NHD app note)
   if (!_cmd(0x71)) return false;
   if (!_dataByte(0x5C)) return false; // function data
-  _delayShort();
+  _settle(GUARD_SHORT_US);
 
   // Function set (RE=0)
   if (!_cmd(0x28)) return false;
@@ -146,13 +223,24 @@ bool US2066::_initSequence() {
 }
 
 void US2066::clear() {
-  _cmd(0x01);
-  _delayLong();
+  if (_cmd(0x01)) {
+    _blank();
+    _addrAC = 0;
+  } else {
+    _shadowOk = false;
+  }
+  _settle(GUARD_LONG_US);
 }
 
 void US2066::home() {
-  _cmd(0x02);
-  _delayLong();
+  _addrAC = _cmd(0x02) ? 0 : -1;
+  _settle(GUARD_LONG_US);
+}
+
+void US2066::_blank() {
+  memset(_frame, ' ', sizeof(_frame));
+  memset(_shadow, ' ', sizeof(_shadow));
+  _shadowOk = true;
 }
 
 uint8_t US2066::_ddramBase(uint8_t row) const {
@@ -172,7 +260,7 @@ uint8_t US2066::_ddramBase(uint8_t row) const {
 void US2066::setCursor(uint8_t col, uint8_t row) {
   if (col >= _cols) col = _cols - 1;
   uint8_t addr = (uint8_t)(_ddramBase(row) + col);
-  _cmd(0x80 | addr); // Set DDRAM address
+  _addrAC = _cmd(0x80 | addr) ? addr : -1; // Set DDRAM address
 }
 
 void US2066::displayOn(bool on) {
@@ -196,9 +284,21 @@ void US2066::setContrast(uint8_t level) {
   _cmd(0x28);     // RE=0
 }
 
+// Immediate writes land at the address counter; keep the shadow (and the
+// frame, so the next flush() doesn't undo them) in step.
+void US2066::_track(uint8_t b) {
+  if (_addrAC < 0) { _shadowOk = false; return; }
+  for (uint8_t r = 0; r < _rows; ++r) {
+    const int col = _addrAC - _ddramBase(r);
+    if (col >= 0 && col < _cols) { _shadow[r][col] = _frame[r][col] = b; break; }
+  }
+  _addrAC = (_addrAC + 1) & 0x7F;
+}
+
 size_t US2066::write(uint8_t c) {
   // Basic ASCII; for UTF-8 callers, pre-convert to glyphs supported by CGROM.
-  if (_dataByte(c)) return 1;
+  if (_dataByte(c)) { _track(c); return 1; }
+  _shadowOk = false;
   return 0;
 }
 
@@ -206,7 +306,8 @@ size_t US2066::write(const char* s) {
   if (!s) return 0;
   size_t n = strlen(s);
   if (n == 0) return 0;
-  _data(reinterpret_cast<const uint8_t*>(s), n);
+  if (!_data(reinterpret_cast<const uint8_t*>(s), n)) { _shadowOk = false; _addrAC = -1; return n; }
+  for (size_t i = 0; i < n; ++i) _track((uint8_t)s[i]);
   return n;
 }
 
@@ -215,25 +316,58 @@ size_t US2066::write(const String& s) {
 }
 
 void US2066::writeLine(uint8_t row, const char* s, bool padToWidth) {
-  setCursor(0, row);
+  if (row >= _rows) row = _rows - 1;
   if (!s) s = "";
-  // Write up to _cols chars, then pad spaces if requested
-  for (uint8_t i=0; i<_cols; ++i) {
-    char ch = s[i];
-    if (ch == '\0') {
-      if (padToWidth) {
-        while (i++ < _cols) write(' ');
-      }
-      return;
-    }
-    write((uint8_t)ch);
-  }
+  // Up to _cols chars, then pad spaces if requested
+  uint8_t* line = _frame[row];
+  uint8_t i = 0;
+  for (; i < _cols && s[i]; ++i) line[i] = (uint8_t)s[i];
+  if (padToWidth) memset(line + i, ' ', _cols - i);
 }
 
 void US2066::clearLine(uint8_t row) {
-  setCursor(0, row);
-  for (uint8_t i=0; i<_cols; ++i) write(' ');
-  setCursor(0, row);
+  if (row >= _rows) row = _rows - 1;
+  memset(_frame[row], ' ', _cols);
+}
+
+void US2066::invalidate() { _shadowOk = false; }
+
+bool US2066::flush() {
+  Metrics::Scope m(Metrics::T_FLUSH);
+  Metrics::latFrame();
+  bool ok = true;
+  for (uint8_t r = 0; r < _rows; ++r) {
+    const uint8_t* want = _frame[r];
+    uint8_t*       have = _shadow[r];
+    int runStart = -1, runEnd = -1;     // inclusive column range of the open run
+
+    for (uint8_t c = 0; c <= _cols; ++c) {
+      const bool dirty = (c < _cols) && (!_shadowOk || want[c] != have[c]);
+      if (dirty) {
+        if (runStart < 0) runStart = c;
+        runEnd = c;
+        continue;
+      }
+      // close the run once the clean gap is too wide (or at end of line)
+      if (runStart >= 0 && (c == _cols || c - runEnd > MERGE_GAP)) {
+        const uint8_t addr = (uint8_t)(_ddramBase(r) + runStart);
+        const size_t  n    = (size_t)(runEnd - runStart + 1);
+        if (_addrAC != addr) setCursor((uint8_t)runStart, r);
+        if (_addrAC == addr && _data(want + runStart, n)) {
+          memcpy(have + runStart, want + runStart, n);
+          _addrAC = (int16_t)(addr + n);
+        } else {
+          _addrAC = -1;
+          ok = false;                   // leave the shadow stale; retried next flush
+        }
+        runStart = runEnd = -1;
+      }
+    }
+  }
+  // a full rewrite only counts once every line made it
+  if (!_shadowOk && ok) _shadowOk = true;
+  Metrics::latSent();
+  return ok;
 }
 
 void US2066::createChar(uint8_t idx, const uint8_t pattern[8]) {
@@ -244,4 +378,7 @@ void US2066::createChar(uint8_t idx, const uint8_t pattern[8]) {
     _dataByte(pattern ? (pattern[i] & 0x1F) : 0x00);
   }
   // restore DDRAM address (host should setCursor() after this)
+  _addrAC = -1;
 }
+
+#endif // TYPED_PANEL_US2066
@@ -6,6 +6,8 @@
 // - Default I2C address commonly 0x3C or 0x3D (depends on SA0 wiring).
 // - Provides HD44780-like API: clear, home, setCursor, print/write, displayOn, setContrast.
 // - Designed to be lightweight and safe on ESP32 (no Wire.begin() inside by default).
+// - writeLine()/clearLine() draw into a frame buffer; flush() diffs it against a
+//   shadow of DDRAM and sends only the changed runs, one burst write each.
 
 #ifndef US2066_DEFAULT_ADDR
 #define US2066_DEFAULT_ADDR 0x3C
@@ -33,33 +35,84 @@ public:
   void cursor();            // display ON, cursor ON, blink OFF
   void blink();             // display ON, cursor ON, blink ON
 
-  // Print helpers
+  // Print helpers (immediate, at the current cursor)
   size_t write(uint8_t c);
   size_t write(const char* s);
   size_t write(const String& s);
+
+  // Buffered line helpers; nothing reaches the panel until flush()
   void   writeLine(uint8_t row, const char* s, bool padToWidth = true); // write + pad/trim
   void   clearLine(uint8_t row);
+  bool   flush();               // send changed runs; false on I2C error (retried next flush)
+  void   invalidate();          // next flush() rewrites every line (e.g. after panel reset)
 
   // Custom glyphs (HD44780-style 5x8; idx 0..7), pattern[8] 5 LSBs used
   void createChar(uint8_t idx, const uint8_t pattern[8]);
 
+  // Busy-flag polling. Off: every command is followed by a fixed guard
+  // (40us, 2ms for clear/home). On: the guard is deferred to the next
+  // transaction and cut short by reading BF/AC. Returns false (and stays in
+  // fixed mode) if the module doesn't answer reads with a sane address counter.
+  bool setBusyPolling(bool on);
+  inline bool busyPolling() const { return _poll; }
+
+  // Data burst size per I2C transaction (after the 0x40 control byte).
+  // 0 = as much as the Wire TX buffer accepts, so a 20-char row goes out as
+  // one transaction; N caps bursts at N bytes (16 was the historic value).
+  void setBurst(uint8_t maxBytes) { _burst = maxBytes; }
+
+  // Bus stats (since begin() / resetStats())
+  struct Stats {
+    uint32_t txns      = 0;   // I2C transactions (commands + data)
+    uint32_t dataTxns  = 0;   // data transactions
+    uint32_t dataBytes = 0;   // payload bytes in data transactions
+    uint32_t errors    = 0;   // transactions that NACKed / failed
+    float bytesPerTxn() const { return dataTxns ? (float)dataBytes / dataTxns : 0.f; }
+  };
+  const Stats& stats() const { return _stats; }
+  void resetStats() { _stats = Stats(); }
+
   // Accessors
   inline uint8_t cols() const { return _cols; }
   inline uint8_t rows() const { return _rows; }
   inline uint8_t addr() const { return _addr; }
 
+  static constexpr uint8_t MAX_COLS = 40;
+  static constexpr uint8_t MAX_ROWS = 4;
+
 private:
   TwoWire* _wire;
   uint8_t  _addr;
   uint8_t  _cols, _rows;
 
+  // _frame: what the view wants; _shadow: what DDRAM holds (when _shadowOk)
+  uint8_t  _frame[MAX_ROWS][MAX_COLS];
+  uint8_t  _shadow[MAX_ROWS][MAX_COLS];
+  bool     _shadowOk = false;
+  uint8_t  _burst = 0;
+  Stats    _stats;
+  bool     _end();               // endTransmission + stats
+  int16_t  _addrAC = -1;         // DDRAM address counter, -1 = unknown
+
+  // Unchanged cells between two dirty runs cheaper to resend than to pay for
+  // another set-DDRAM command (+40us guard) and I2C transaction.
+  static constexpr uint8_t MERGE_GAP = 3;
+
+  void _blank();                 // frame + shadow = spaces (after 0x01)
+  void _track(uint8_t b);        // mirror an immediate data write into the shadow
+
   // I2C control bytes (US2066)
   static constexpr uint8_t CB_CMD  = 0x00; // next byte is command
   static constexpr uint8_t CB_DATA = 0x40; // next bytes are data
 
   // Timing helpers
-  static void _delayShort();  // ~30–50us
-  static void _delayLong();   // ~2ms (for clear/home)
+  static constexpr uint32_t GUARD_SHORT_US = 40;    // most commands
+  static constexpr uint32_t GUARD_LONG_US  = 2000;  // clear/home need >1.52ms
+  bool     _poll = false;
+  uint32_t _busyFrom = 0, _busyUs = 0;   // outstanding guard (micros)
+  void _settle(uint32_t us);  // guard after a command (fixed delay or deferred)
+  void _ready();              // wait out a deferred guard before the next transaction
+  bool _readStatus(uint8_t& bfac);        // BF (bit 7) | address counter
 
   // Low-level
   bool _cmd(uint8_t c);
@@ -3,13 +3,12 @@
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
-#include <Preferences.h>
-#include <WiFiClientSecure.h>
-#include <HTTPClient.h>
-#include <ArduinoJson.h>
 
 #include "us2066_view.h"
-#include "udp_typed.h"
+#include "typed_proto.h"
+#include "history.h"
+#include "panel.h"     // TYPED_PANEL_* build flags
+#if TYPED_PANEL_US2066
 
 // ================= helpers (same logic as display.cpp) =================
 static bool av_is_hd(int v){ v &= 0xFF; return (v==0x01)||(v==0x02)||((v&0x0E)==0x0A); }
@@ -54,101 +53,7 @@ static const char* encLabelFromRaw(int v){
   }
 }
 
-static const char* xboxVerFromCode(int v){
-  switch (v & 0xFF){
-    case 0: return "v1.0"; case 1: return "v1.1"; case 2: return "v1.2";
-    case 3: return "v1.3"; case 4: return "v1.4"; case 5: return "v1.5";
-    case 6: return "v1.6";
-    default: return "Not reported";
-  }
-}
-
-static bool parseSerialYWWFF(const String& s,int& Y,int& W,int& F){
-  int len=s.length(), run=0, end=-1;
-  for (int i=len-1;i>=0;--i){
-    if (isdigit((unsigned char)s[i])) { if (++run==5) { end=i+5; break; } }
-    else run=0;
-  }
-  if (end<0) return false;
-  int start=end-5;
-  Y=2000+(s[start]-'0');
-  W=(s[start+1]-'0')*10+(s[start+2]-'0');
-  F=(s[start+3]-'0')*10+(s[start+4]-'0');
-  return (W>=1 && W<=53);
-}
-
-static String versionFromYearWeek(int y,int w){
-  if (y==2001) return "v1.0";
-  if (y==2002){ if (w<=43) return "v1.0"; if (w<=47) return "v1.1"; return "v1.2"; }
-  if (y==2003){ if (w<=8)  return "v1.2"; if (w<=30) return "v1.3"; return "v1.4"; }
-  if (y==2004){ if (w<=10) return "v1.4"; if (w<=37) return "v1.6"; return "v1.6b"; }
-  if (y>=2005) return "v1.6b";
-  return "Not reported";
-}
-
-static String guessFromSerialAndEncoder(int encRaw,const String& serial){
-  int y=0,w=0,f=0; bool ok=parseSerialYWWFF(serial,y,w,f);
-  int enc=(encRaw&0xFF);
-  auto encSuggest=[&]()->String{ if(enc==0x70) return "v1.6"; if(enc==0x6A) return "v1.4"; if(enc==0x45) return "v1.0-1.3"; return ""; };
-  if (!ok){ String e=encSuggest(); return e.length()?e:"Not reported"; }
-  if (f==3) return "v1.0";
-  if (f==2) return (y<2002 || (y==2002 && w<44)) ? "v1.0" : "v1.1";
-  String yw=versionFromYearWeek(y,w);
-  if (enc==0x70) return (y>=2004 && w>=38) ? "v1.6b" : "v1.6";
-  if (enc==0x6A){ if (yw.startsWith("v1.0")||yw.startsWith("v1.1")||yw.startsWith("v1.2")||yw.startsWith("v1.3")) return "v1.4"; }
-  if (enc==0x45){ if (yw.startsWith("v1.4")||yw.startsWith("v1.6")) return "v1.3"; }
-  return yw;
-}
-
-// ---------- endian helpers ----------
-static inline int32_t bswap32(int32_t v){
-  uint32_t x = (uint32_t)v;
-  x = (x>>24) | ((x>>8)&0x0000FF00u) | ((x<<8)&0x00FF0000u) | (x<<24);
-  return (int32_t)x;
-}
-static inline bool sane_fan(int32_t v){ return v>=0 && v<=100; }
-static inline bool sane_temp(int32_t v){ return v>-50 && v<120; }
-static inline bool sane_resw(int32_t v){ return v>100 && v<4097; }
-static inline bool sane_resh(int32_t v){ return v>100 && v<2161; }
-static inline bool sane_av (int32_t v){ v&=0xFF; return v==0x00||v==0x01||v==0x02||v==0x03||v==0x04||v==0x06||v==0x07||((v&0x0E)==0x0A)||((v&0x0E)==0x0E)||((v&0x0E)==0x06)||((v&0x0E)==0x02); }
-static inline bool sane_xb (int32_t v){ return v>=0 && v<=6; }
-static inline bool sane_enc(int32_t v){ v&=0xFF; return v==0x45||v==0x6A||v==0x70; }
-
-// ================= Weather (SSD1309-style, local to US2066) =============
-static struct {
-  bool     enabled = false;
-  char     units   = 'F';       // 'F' or 'C'
-  double   lat     = NAN;
-  double   lon     = NAN;
-  uint32_t refresh_ms = 10UL*60UL*1000UL;
-  char     place[32] = {0};
-
-  // runtime
-  bool     ok = false;
-  float    temp = NAN;          // already in the selected units
-  int      rh = -1;             // %
-  int      code = -1;
-  uint32_t last_fetch = 0;
-} W;
-
-static void loadWeatherPrefsOnce(){
-  static bool loaded=false; if (loaded) return;
-  Preferences p;
-  if (!p.begin("weather", true)) return;
-  W.enabled = p.getBool("enabled", false);
-  String u  = p.getString("units", "F");
-  W.units   = (u.length() && (u[0]=='C'||u[0]=='c')) ? 'C' : 'F';
-  W.lat     = p.getDouble("lat", NAN);
-  W.lon     = p.getDouble("lon", NAN);
-  int refMin = p.getInt("refresh", 10);
-  if (refMin < 1) refMin = 1; if (refMin > 120) refMin = 120;
-  W.refresh_ms = (uint32_t)refMin * 60UL * 1000UL;
-  String nm = p.getString("name", "");
-  nm.toCharArray(W.place, sizeof(W.place));
-  p.end();
-  loaded = true;
-}
-
+// ================= Weather (data from the shared Weather service) =============
 static const char* labelForCode(int wmo){
   // minimal table (common codes). Fallback "—" keeps code size small.
   switch (wmo){
@@ -165,39 +70,6 @@ static const char* labelForCode(int wmo){
   return "—";
 }
 
-static bool fetchWeatherNow(){
-  if (!W.enabled) return false;
-  if (!WiFi.isConnected()) return false;
-  if (isnan(W.lat) || isnan(W.lon)) return false;
-
-  // Build Open-Meteo URL (same as SSD1309)
-  String url = "https://api.open-meteo.com/v1/forecast?latitude=" + String(W.lat, 5) +
-               "&longitude=" + String(W.lon, 5) +
-               "&current=temperature_2m,weather_code,relative_humidity_2m";
-  if (W.units == 'F') url += "&temperature_unit=fahrenheit";
-  else                url += "&temperature_unit=celsius";
-
-  WiFiClientSecure ssl; ssl.setInsecure();
-  HTTPClient http; http.setTimeout(4000);
-  if (!http.begin(ssl, url)) return false;
-  int code = http.GET();
-  if (code != 200){ http.end(); return false; }
-  String body = http.getString();
-  http.end();
-
-  StaticJsonDocument<768> doc;
-  if (deserializeJson(doc, body)) return false;
-  JsonObject cur = doc["current"];
-  if (cur.isNull()) return false;
-
-  W.temp = cur["temperature_2m"] | NAN;
-  W.rh   = cur["relative_humidity_2m"] | -1;
-  W.code = cur["weather_code"] | -1;
-  W.ok   = !isnan(W.temp) && (W.code >= 0);
-  W.last_fetch = millis();
-  return W.ok;
-}
-
 // ======================== Class =====================================
 US2066View::US2066View(){}
 
@@ -207,301 +79,196 @@ bool US2066View::attach(US2066* dev){
   if (!d_->ping()) return false;
   d_->clear();
   d_->displayOn(true);
-  // weather prefs read once (does not fetch yet)
-  loadWeatherPrefsOnce();
+  loadBarGlyphs();
+  if (telem_sub_ < 0) telem_sub_ = Telemetry::subscribe(&US2066View::onTelemetry, Telemetry::F_ALL, this);
   return true;
 }
 
-void US2066View::setStatus(const US2066_Status& s){ st_=s; }
+void US2066View::setStatus(const US2066_Status& s){ st_=s; stale_=ALL_PAGES; }
+
+uint8_t US2066View::streamsOnScreen() const {
+  switch (page_){
+    case PG_MAIN: return TypedProto::STREAM_MAIN | TypedProto::STREAM_EXT;   // AV + resolution
+    case PG_HW:   return TypedProto::STREAM_EXT | TypedProto::STREAM_EE;
+    case PG_TREND:return TypedProto::STREAM_MAIN;
+    default:      return 0;
+  }
+}
 
 void US2066View::setPagePeriod(uint32_t ms){ if(ms) page_ms_ = ms; }
-void US2066View::forcePage(uint8_t idx){ page_=idx%4; last_page_ms_=millis(); }
-void US2066View::clear(){ if(d_) d_->clear(); }
+void US2066View::forcePage(uint8_t idx){ page_=idx%PAGES; last_page_ms_=millis(); }
+// Blank through the shadow buffer: only lit cells are rewritten, and no
+// 2ms clear-display command.
+void US2066View::clear(){
+  if (!d_) return;
+  for (uint8_t r=0; r<d_->rows(); ++r) d_->clearLine(r);
+  d_->flush();
+  shown_ = -1;
+}
 
 void US2066View::splash(const char* l0,const char* l1,const char* l2,const char* l3){
   if (!d_) return;
-  d_->clear();
   d_->writeLine(0, l0?l0:"", true);
   d_->writeLine(1, l1?l1:"", true);
   d_->writeLine(2, l2?l2:"", true);
   d_->writeLine(3, l3?l3:"", true);
+  d_->flush();
+  shown_ = -1;   // next loop() puts its page back
 }
 
 void US2066View::loop(){
   if (!d_) return;
 
-  // Drive local weather fetch cadence (only if enabled + coords present)
-  loadWeatherPrefsOnce();
-  if (W.enabled && !isnan(W.lat) && !isnan(W.lon)) {
-    uint32_t now = millis();
-    const bool stale = (now - W.last_fetch) >= W.refresh_ms;
-    if (stale || !W.ok) {
-      fetchWeatherNow(); // non-blocking enough (4s timeout); small JSON
-    }
-  }
-
-  drainUdpAndMergeStatus();
-
-  static String ipStr;
-  if (WiFi.isConnected()){
-    ipStr = WiFi.localIP().toString();
-    st_.ip = ipStr.c_str();
-    st_.rssi_dbm = WiFi.RSSI();
-  } else {
-    st_.ip = nullptr;
-    st_.rssi_dbm = INT32_MIN;
-  }
-  st_.uptime_ms = millis();
+  mergeTelemetry();
+  pollInputs();
 
   uint32_t now=millis();
+  st_.uptime_ms = now;
   if (now - last_page_ms_ >= page_ms_){
-    uint8_t next=(page_+1)%4;
+    uint8_t next=(page_+1)%PAGES;
 
-    // Skip Weather page if disabled or never fetched ok
-    if (next==3 && !(W.enabled && W.ok)) next=0;
+    // Skip the pages with nothing to show (weather off / not fetched, no history)
+    while (next!=PG_MAIN && !pageShown(next)) next=(next+1)%PAGES;
+    if (next==0){ Telemetry::nextSender(); mergeTelemetry(); }   // next console, if several
 
     page_=next;
     last_page_ms_=now;
   }
+  const uint8_t p = (page_==PG_WX && !Weather::enabled()) ? PG_MAIN : page_;
+
+  if (stale_ & (1u << p)){
+    switch (p){
+      case PG_MAIN: fmtPageA(); break;
+      case PG_HW:   fmtPageB(); break;
+      case PG_NET:  fmtPage3(); break;
+      case PG_TREND:fmtPage5(); break;
+      default:      fmtPage4(); break; // Weather
+    }
+    stale_ &= ~(1u << p);
+    dirty_ = 0x0F;
+  }
+  if (p != shown_){ shown_ = (int8_t)p; dirty_ = 0x0F; }
 
-  switch (page_){
-    case 0: drawPageA(); break;
-    case 1: drawPageB(); break;
-    case 2: drawPage3(); break;
-    default: drawPage4(); break; // Weather
+  // single-line refreshes on the visible page
+  if (p==PG_MAIN && marquee_.length() && now - mq_ms_ >= 350){
+    mq_ms_ = now; mq_off_ = (mq_off_ + 1) % marquee_.length();
+    fmtTitle(lines_[PG_MAIN][0]); dirty_ |= 1u << 0;
+  }
+  if (p==PG_NET && now/1000 != up_s_){
+    fmtNetFooter(lines_[PG_NET][3]); dirty_ |= 1u << 3;
+  }
+  if (p==PG_WX && wx_ok_ && (now - wx_ts_)/60000UL != wx_min_){
+    fmtWxAge(lines_[PG_WX][3]); dirty_ |= 1u << 3;
   }
+
+  if (!dirty_) return;
+  for (uint8_t r=0; r<4; ++r) if (dirty_ & (1u << r)) d_->writeLine(r, lines_[p][r], true);
+  dirty_ = 0;
+  d_->flush();   // only cells that changed since the last frame go out
 }
 
-// ================= Ingest A/B/EE (text + binary, robust) =================
-void US2066View::drainUdpAndMergeStatus(){
-  struct MainCache { bool have=false; int32_t fan=INT32_MIN,cpu=INT32_MIN,amb=INT32_MIN; char app[33]={0}; } MAIN;
-  struct ExtCache  { bool have=false; int32_t tray=-1,av=-1,pic=-1,xb=-1,w=0,h=0,enc=-1; } EXT;
-  struct EECache   { bool have=false; String mac, serial, region; } EE;
-
-  static uint32_t pkt_total=0;
-
-  auto hexOrDec=[](const String& s)->int{ if(s.startsWith("0x")||s.startsWith("0X")) return (int)strtol(s.c_str(),nullptr,16); return s.toInt(); };
-  auto makeString=[](const char* p,size_t n)->String{ static char buf[512]; size_t L=(n<511)?n:511; memcpy(buf,p,L); buf[L]=0; String s(buf); s.trim(); return s; };
-
-  TypeDUDP::Packet pk;
-  while (TypeDUDP::next(pk)){
-    pkt_total++;
-    const size_t n = pk.rx_len;
-    const char* d  = pk.data;
-
-    // -------- EE text
-    if (n>=3 && d[0]=='E' && d[1]=='E' && d[2]==':'){
-      String s = makeString(d,n);
-      EE.have = true;
-      int pos=3;
-      while (pos < (int)s.length()){
-        int eq = s.indexOf('=', pos); if (eq<0) break;
-        String key = s.substring(pos, eq);
-        int bar = s.indexOf('|', eq+1);
-        String val = (bar<0) ? s.substring(eq+1) : s.substring(eq+1, bar);
-        key.trim(); val.trim();
-        if      (key.equalsIgnoreCase("SN") || key.equalsIgnoreCase("SER")) EE.serial = val;
-        else if (key.equalsIgnoreCase("MAC"))                                 EE.mac    = val;
-        else if (key.equalsIgnoreCase("REG"))                                 EE.region = val;
-        pos = (bar<0) ? s.length() : (bar+1);
-      }
-      continue;
+void US2066View::pollInputs(){
+  if (WiFi.isConnected()){
+    const int rssi = WiFi.RSSI();
+    const IPAddress ip = WiFi.localIP();
+    if ((uint32_t)ip != ip_u32_ || !st_.ip){
+      ip_u32_ = (uint32_t)ip;
+      ip_ = ip.toString();
+      st_.ip = ip_.c_str();
+      stale_ |= 1u << PG_NET;
     }
+    if (rssi != st_.rssi_dbm){ st_.rssi_dbm = rssi; stale_ |= 1u << PG_NET; }
+  } else if (st_.ip || st_.rssi_dbm != INT32_MIN){
+    st_.ip = nullptr;
+    st_.rssi_dbm = INT32_MIN;
+    ip_u32_ = 0;
+    stale_ |= 1u << PG_NET;
+  }
 
-    // -------- MAIN text
-    if (n>=2 && (d[0]=='A'||d[0]=='a') && (d[1]==','||d[1]==':')){
-      String s = makeString(d,n);
-      MAIN.have = true;
-      int p=2;
-      while (p < (int)s.length()){
-        int eq = s.indexOf('=', p); if (eq<0) break;
-        String key = s.substring(p, eq);
-        int sep = s.indexOf(',', eq+1);
-        String val = (sep<0) ? s.substring(eq+1) : s.substring(eq+1, sep);
-        key.trim(); val.trim();
-        if      (key.equalsIgnoreCase("fan")) MAIN.fan = constrain(val.toInt(), 0, 100);
-        else if (key.equalsIgnoreCase("cpu")) MAIN.cpu = val.toInt();
-        else if (key.equalsIgnoreCase("amb")) MAIN.amb = val.toInt();
-        else if (key.equalsIgnoreCase("app")) val.toCharArray(MAIN.app, 33);
-        p = (sep<0) ? s.length() : (sep+1);
-      }
-      continue;
-    }
+  const uint32_t wv = Weather::version();
+  if (wv != wx_ver_){ wx_ver_ = wv; stale_ |= 1u << PG_WX; }
 
-    // -------- EXT text
-    if (n>=2 && (d[0]=='B'||d[0]=='b') && (d[1]==','||d[1]==':')){
-      String s = makeString(d,n);
-      EXT.have = true;
-      int p=2;
-      while (p < (int)s.length()){
-        int eq = s.indexOf('=', p); if (eq<0) break;
-        String key = s.substring(p, eq);
-        int sep = s.indexOf(',', eq+1);
-        String val = (sep<0) ? s.substring(eq+1) : s.substring(eq+1, sep);
-        key.trim(); val.trim();
-        if      (key.equalsIgnoreCase("av"))  EXT.av  = hexOrDec(val);
-        else if (key.equalsIgnoreCase("w"))   EXT.w   = val.toInt();
-        else if (key.equalsIgnoreCase("h"))   EXT.h   = val.toInt();
-        else if (key.equalsIgnoreCase("xb"))  EXT.xb  = val.toInt();
-        else if (key.equalsIgnoreCase("enc")) EXT.enc = hexOrDec(val);
-        p = (sep<0) ? s.length() : (sep+1);
-      }
-      continue;
-    }
+  const uint32_t hv = History::version();
+  if (hv != hist_ver_){ hist_ver_ = hv; stale_ |= 1u << PG_TREND; }
+}
 
-    // -------- MAIN binary (tolerant size & endianness)
-    if (n >= 44){
-      int32_t fan, cpu, amb;
-      memcpy(&fan, d+0, 4); memcpy(&cpu, d+4, 4); memcpy(&amb, d+8, 4);
-      if (!sane_fan(fan) && sane_fan(bswap32(fan))) fan = bswap32(fan);
-      if (!sane_temp(cpu) && sane_temp(bswap32(cpu))) cpu = bswap32(cpu);
-      if (!sane_temp(amb) && sane_temp(bswap32(amb))) amb = bswap32(amb);
-
-      MAIN.have = true;
-      MAIN.fan = constrain(fan, 0, 100);
-      MAIN.cpu = cpu;
-      MAIN.amb = amb;
-
-      char app[33]={0};
-      memcpy(app, d+12, 32); app[32]=0;
-      for (int i=0;i<32;i++){ unsigned char u=(unsigned char)app[i]; if (u && (u<0x20 || u>0x7E)) app[i]=' '; }
-      strncpy(MAIN.app, app, 32);
-      continue;
-    }
+bool US2066View::pageShown(uint8_t p) const {
+  switch (p){
+    case PG_WX:    return Weather::enabled() && Weather::isReady();
+    case PG_TREND: return US2066_TREND_PAGE && History::count(History::T_1S) >= 2;
+    default:       return true;
+  }
+}
 
-    // -------- EXT binary (tolerant size & endianness)
-    if (n >= 28 && (n % 4) == 0){
-      // transmitter order: tray, av, pic, xb, w, h, enc
-      int32_t f[7]; memset(f,0,sizeof(f));
-      memcpy(f, d, 28);
-
-      auto fix=[&](int idx, bool (*ok)(int32_t))->int32_t{
-        int32_t v=f[idx]; if (ok(v)) return v;
-        int32_t s=bswap32(v); return ok(s)? s : v;
-      };
-      EXT.tray = fix(0, [](int32_t){return true;});
-      EXT.av   = fix(1, sane_av);
-      EXT.pic  = fix(2, [](int32_t){return true;});
-      EXT.xb   = fix(3, sane_xb);
-      EXT.w    = fix(4, sane_resw);
-      EXT.h    = fix(5, sane_resh);
-      EXT.enc  = fix(6, sane_enc);
-
-      EXT.have = true;
-
-      st_.av_raw       = EXT.av;
-      st_.res_w        = EXT.w;
-      st_.res_h        = EXT.h;
-      st_.enc_raw      = EXT.enc;
-      st_.xboxver_code = EXT.xb;
-
-      static char av_s[28], res_s[48], enc_s[16], xb_s[24];
-
-      snprintf(av_s, sizeof(av_s), "%s", avLabelFromRaw(EXT.av));
-      st_.av_mode = av_s;
-
-      if (EXT.w>0 && EXT.h>0){
-        String mode = modeFromRes(EXT.w, EXT.h, EXT.av);
-        if (mode.length() && (mode.startsWith("480") || mode.startsWith("576")))
-          mode += " " + sdSystemFromH(EXT.h);
-        if (mode.length()) snprintf(res_s,sizeof(res_s), "%dx%d (%s)", EXT.w, EXT.h, mode.c_str());
-        else               snprintf(res_s,sizeof(res_s), "%dx%d", EXT.w, EXT.h);
-        st_.resolution = res_s;
-      } else {
-        st_.resolution = nullptr;
-      }
+// ================= Telemetry merge (decoding lives in Telemetry) =================
+void US2066View::onTelemetry(const Telemetry::Snapshot&, uint32_t changed, void* user){
+  static_cast<US2066View*>(user)->pending_ |= changed;
+}
 
-      snprintf(enc_s, sizeof(enc_s), "%s", encLabelFromRaw(EXT.enc));
-      st_.encoder = enc_s;
+void US2066View::mergeTelemetry(){
+  const Telemetry::Snapshot& t = Telemetry::get();
+  st_.pkt_count = t.pkt_count;
 
-      if (sane_xb(EXT.xb)){
-        snprintf(xb_s, sizeof(xb_s), "%s", xboxVerFromCode(EXT.xb));
-      } else if (st_.serial && *st_.serial && EXT.enc >= 0){
-        String guess = guessFromSerialAndEncoder(EXT.enc, String(st_.serial));
-        snprintf(xb_s, sizeof(xb_s), "%s", guess.c_str());
-      } else {
-        int ecode=(EXT.enc & 0xFF);
-        if      (ecode==0x70) snprintf(xb_s, sizeof(xb_s), "v1.6");
-        else if (ecode==0x6A) snprintf(xb_s, sizeof(xb_s), "v1.4");
-        else if (ecode==0x45) snprintf(xb_s, sizeof(xb_s), "v1.0-1.3");
-        else                  snprintf(xb_s, sizeof(xb_s), "Not reported");
-      }
-      st_.xbox_ver = xb_s;
+  const uint32_t ch = pending_;
+  pending_ = 0;
+  if (!ch) return;
 
-      continue;
-    }
-  }
+  using namespace Telemetry;
+  if (ch & (F_MAIN | F_AV | F_RES))                       stale_ |= 1u << PG_MAIN;
+  if (ch & (F_ENC | F_EE | F_XBOXVER | F_XBOX_LBL))       stale_ |= 1u << PG_HW;
 
-  // ---- merge MAIN
-  if (MAIN.have){
-    static String s_title_store;
-    if (MAIN.app[0]) {
-      s_title_store = MAIN.app;
-      st_.title = s_title_store.c_str();
+  // ---- MAIN
+  if ((ch & Telemetry::F_MAIN) && t.haveMain){
+    if (t.app[0]) {
+      snprintf(title_, sizeof(title_), "%s", t.app);
+      st_.title = title_;
     } else if (!st_.title || !*st_.title) {
       st_.title = "Type-D";
     }
-
-    st_.cpu_temp_c  = MAIN.cpu;
-    st_.amb_temp_c  = MAIN.amb;
-    st_.fan_percent = (MAIN.fan==INT32_MIN) ? -1 : MAIN.fan;
+    st_.cpu_temp_c  = t.cpu;
+    st_.amb_temp_c  = t.amb;
+    st_.fan_percent = t.fan;
   }
 
-  // ---- merge EXT (in case only text path filled it)
-  if (EXT.have){
-    st_.av_raw       = EXT.av;
-    st_.res_w        = EXT.w;
-    st_.res_h        = EXT.h;
-    st_.enc_raw      = EXT.enc;
-    st_.xboxver_code = EXT.xb;
-
-    static char av_s2[28], res_s2[48], enc_s2[16], xb_s2[24];
-    snprintf(av_s2, sizeof(av_s2), "%s", avLabelFromRaw(EXT.av));
-    st_.av_mode = av_s2;
-
-    if (EXT.w>0 && EXT.h>0){
-      String mode = modeFromRes(EXT.w, EXT.h, EXT.av);
-      if (mode.length() && (mode.startsWith("480")||mode.startsWith("576")))
-        mode += " " + sdSystemFromH(EXT.h);
-      if (mode.length()) snprintf(res_s2,sizeof(res_s2), "%dx%d (%s)", EXT.w, EXT.h, mode.c_str());
-      else               snprintf(res_s2,sizeof(res_s2), "%dx%d", EXT.w, EXT.h);
-      st_.resolution = res_s2;
+  // ---- EXT
+  if ((ch & Telemetry::F_EXT) && t.haveExt){
+    st_.av_raw       = t.av;
+    st_.res_w        = t.width;
+    st_.res_h        = t.height;
+    st_.enc_raw      = t.enc;
+    st_.xboxver_code = t.xboxver;
+
+    if (ch & Telemetry::F_AV){
+      snprintf(av_s_, sizeof(av_s_), "%s", avLabelFromRaw(t.av));
+      st_.av_mode = av_s_;
     }
-
-    snprintf(enc_s2, sizeof(enc_s2), "%s", encLabelFromRaw(EXT.enc));
-    st_.encoder = enc_s2;
-
-    if (sane_xb(EXT.xb)){
-      snprintf(xb_s2, sizeof(xb_s2), "%s", xboxVerFromCode(EXT.xb));
-    } else if (st_.serial && *st_.serial && EXT.enc >= 0){
-      String guess = guessFromSerialAndEncoder(EXT.enc, String(st_.serial));
-      snprintf(xb_s2, sizeof(xb_s2), "%s", guess.c_str());
-    } else {
-      int ecode=(EXT.enc & 0xFF);
-      if      (ecode==0x70) snprintf(xb_s2, sizeof(xb_s2), "v1.6");
-      else if (ecode==0x6A) snprintf(xb_s2, sizeof(xb_s2), "v1.4");
-      else if (ecode==0x45) snprintf(xb_s2, sizeof(xb_s2), "v1.0-1.3");
-      else                  snprintf(xb_s2, sizeof(xb_s2), "Not reported");
+    if (ch & (Telemetry::F_RES | Telemetry::F_AV)){
+      if (t.width>0 && t.height>0){
+        String mode = modeFromRes(t.width, t.height, t.av);
+        if (mode.length() && (mode.startsWith("480") || mode.startsWith("576")))
+          mode += " " + sdSystemFromH(t.height);
+        if (mode.length()) snprintf(res_s_,sizeof(res_s_), "%dx%d (%s)", (int)t.width, (int)t.height, mode.c_str());
+        else               snprintf(res_s_,sizeof(res_s_), "%dx%d", (int)t.width, (int)t.height);
+        st_.resolution = res_s_;
+      } else {
+        st_.resolution = nullptr;
+      }
+    }
+    if (ch & Telemetry::F_ENC){
+      snprintf(enc_s_, sizeof(enc_s_), "%s", encLabelFromRaw(t.enc));
+      st_.encoder = enc_s_;
     }
-    st_.xbox_ver = xb_s2;
   }
 
-  // ---- merge EE
-  if (EE.have){
-    static String s_mac, s_serial, s_region;
-    if (EE.mac.length())    { s_mac    = EE.mac;    st_.mac    = s_mac.c_str(); }
-    if (EE.serial.length()) { s_serial = EE.serial; st_.serial = s_serial.c_str(); }
-    if (EE.region.length()) { s_region = EE.region; st_.region = s_region.c_str(); }
-
-    if ((!st_.xbox_ver || !*st_.xbox_ver) && st_.enc_raw>=0 && s_serial.length()){
-      static char xb_guess[24];
-      String guess = guessFromSerialAndEncoder(st_.enc_raw, s_serial);
-      snprintf(xb_guess, sizeof(xb_guess), "%s", guess.c_str());
-      st_.xbox_ver = xb_guess;
-    }
+  // ---- EE (snapshot storage is stable, point straight at it)
+  if ((ch & Telemetry::F_EE) && t.haveEE){
+    if (t.mac[0])    st_.mac    = t.mac;
+    if (t.serial[0]) st_.serial = t.serial;
+    if (t.region[0]) st_.region = t.region;
   }
 
-  st_.pkt_count = pkt_total;
+  // ---- Xbox version (SMC code, else serial/encoder guess)
+  if (t.haveExt || t.haveEE) st_.xbox_ver = t.xbox_ver;
 }
 
 // ================= formatting + pages =================
@@ -546,37 +313,32 @@ void US2066View::centerOrLeft(char* out,size_t cap,const char* src,bool center){
   padTrim(out, src ? src : "N/A", 20, center);
 }
 
+// Title row: centered when it fits, else a 20-char window into the marquee.
+void US2066View::fmtTitle(char* out){
+  if (!marquee_.length()) { centerOrLeft(out, 21, mq_src_.c_str(), true); return; }
+  char vis[21];
+  for (int i=0;i<20;++i) vis[i] = marquee_[(mq_off_ + i) % marquee_.length()];
+  vis[20] = 0;
+  padTrim(out, vis, 20, true);
+}
+
 // Page 0 — App title (marquee) + temps + AV + res
-void US2066View::drawPageA(){
-  char L0[21],L1[21],L2[21],L3[21];
+void US2066View::fmtPageA(){
+  char* L1 = lines_[PG_MAIN][1];
+  char* L2 = lines_[PG_MAIN][2];
+  char* L3 = lines_[PG_MAIN][3];
 
   // --- App title marquee (20-char window) ---
   const char* t = st_.title ? st_.title : "Type-D";
-  static String last_title;
-  static String marquee_buf;
-  static uint32_t last_ms = 0;
-  static int offset = 0;
-  const uint32_t step_ms = 350;
-
-  if (!last_title.equals(String(t))) {
-    last_title = String(t);
-    marquee_buf = last_title + "   " + last_title + "   ";
-    offset = 0;
-    last_ms = 0;
+  if (!mq_src_.equals(t)) {
+    mq_src_ = t;
+    marquee_ = (mq_src_.length() > 20) ? mq_src_ + "   " + mq_src_ + "   " : String();
+    mq_off_ = 0;
+    mq_ms_ = millis();
   }
+  fmtTitle(lines_[PG_MAIN][0]);
 
-  if ((int)last_title.length() <= 20) {
-    centerOrLeft(L0, sizeof(L0), t, true);
-  } else {
-    uint32_t now = millis();
-    if (now - last_ms >= step_ms) { last_ms = now; offset = (offset + 1) % marquee_buf.length(); }
-    char vis[21];
-    for (int i=0;i<20;++i) vis[i] = marquee_buf[(offset + i) % marquee_buf.length()];
-    vis[20] = 0;
-    padTrim(L0, vis, 20, true);
-  }
-
-  fmtTempsFan(L1,sizeof(L1), st_.cpu_temp_c, st_.amb_temp_c, st_.fan_percent);
+  fmtTempsFan(L1,21, st_.cpu_temp_c, st_.amb_temp_c, st_.fan_percent);
 
   const char* av_txt = st_.av_mode;
   char av_buf[28];
@@ -597,16 +359,14 @@ void US2066View::drawPageA(){
   char r3[64]; snprintf(r3,sizeof(r3), "Res:%s", (res_txt&&*res_txt)? res_txt : "N/A");
   const char* p=r3; size_t len=strlen(r3); if (len>20) p=r3+(len-20);
   padTrim(L3, p, 20, true);
-
-  d_->writeLine(0,L0,true);
-  d_->writeLine(1,L1,true);
-  d_->writeLine(2,L2,true);
-  d_->writeLine(3,L3,true);
 }
 
 // Page 1 — Encoder/Region/MAC/Serial/Xbox ver
-void US2066View::drawPageB(){
-  char L0[21],L1[21],L2[21],L3[21];
+void US2066View::fmtPageB(){
+  char* L0 = lines_[PG_HW][0];
+  char* L1 = lines_[PG_HW][1];
+  char* L2 = lines_[PG_HW][2];
+  char* L3 = lines_[PG_HW][3];
 
   const char* enc_txt = st_.encoder;
   char enc_buf[16];
@@ -616,7 +376,7 @@ void US2066View::drawPageB(){
   if (strlen(r0)>20) snprintf(r0,sizeof(r0),"%s %s", enc_txt?enc_txt:"N/A", reg);
   padTrim(L0, r0, 20, true);
 
-  fitMac(L1, sizeof(L1), st_.mac);
+  fitMac(L1, 21, st_.mac);
 
   char r2[28];
   if (st_.serial && *st_.serial) snprintf(r2,sizeof(r2),"SN:%s", st_.serial);
@@ -626,16 +386,22 @@ void US2066View::drawPageB(){
   const char* xb_txt = st_.xbox_ver;
   char r3[28]; snprintf(r3,sizeof(r3),"XBOX Ver:%s", (xb_txt&&*xb_txt)? xb_txt : "Not reported");
   padTrim(L3, r3, 20, true);
+}
 
-  d_->writeLine(0,L0,true);
-  d_->writeLine(1,L1,true);
-  d_->writeLine(2,L2,true);
-  d_->writeLine(3,L3,true);
+// Uptime + packet count; refreshed once a second on its own.
+void US2066View::fmtNetFooter(char* out){
+  up_s_ = millis() / 1000;
+  char up[20]; fmtUptime(up,sizeof(up),up_s_ * 1000UL); char b[28];
+  if (st_.pkt_count>0) snprintf(b,sizeof(b),"%s Pkts:%lu", up, (unsigned long)st_.pkt_count);
+  else                 snprintf(b,sizeof(b),"%s", up);
+  padTrim(out,b,20,true);
 }
 
 // Page 2 — WiFi/IP/Batt/Uptime
-void US2066View::drawPage3(){
-  char L0[21],L1[21],L2[21],L3[21];
+void US2066View::fmtPage3(){
+  char* L0 = lines_[PG_NET][0];
+  char* L1 = lines_[PG_NET][1];
+  char* L2 = lines_[PG_NET][2];
 
   { char b[24]; if (st_.rssi_dbm!=INT32_MIN) snprintf(b,sizeof(b),"WiFi:%d dBm", st_.rssi_dbm); else snprintf(b,sizeof(b),"WiFi:N/A"); padTrim(L0,b,20,true); }
   { char b[28]; if (st_.ip && *st_.ip) snprintf(b,sizeof(b),"IP:%s", st_.ip); else snprintf(b,sizeof(b),"IP:N/A"); padTrim(L1,b,20,true); }
@@ -650,27 +416,18 @@ void US2066View::drawPage3(){
     padTrim(L2," ",20,true);
   }
 
-  { char up[20]; fmtUptime(up,sizeof(up),st_.uptime_ms); char b[28];
-    if (st_.pkt_count>0) snprintf(b,sizeof(b),"%s Pkts:%lu", up, (unsigned long)st_.pkt_count);
-    else                 snprintf(b,sizeof(b),"%s", up);
-    padTrim(L3,b,20,true);
-  }
-
-  d_->writeLine(0,L0,true);
-  d_->writeLine(1,L1,true);
-  d_->writeLine(2,L2,true);
-  d_->writeLine(3,L3,true);
+  fmtNetFooter(lines_[PG_NET][3]);
 }
 
-void US2066View::drawPage4() {
-  loadWeatherPrefsOnce();
-  if (!W.enabled) { drawPageA(); return; }
-  if (!W.ok) fetchWeatherNow();
+void US2066View::fmtPage4() {
+  const Weather::Snapshot W = Weather::get();
 
-  char L0[21], L1[21], L2[21], L3[21];
+  char* L0 = lines_[PG_WX][0];
+  char* L1 = lines_[PG_WX][1];
+  char* L2 = lines_[PG_WX][2];
 
   // --------- Line 0: compact header with ellipsis (no marquee) ----------
-  const char* headCore = (W.place[0] ? W.place : (W.code >= 0 ? labelForCode(W.code) : "Weather"));
+  const char* headCore = (W.place.length() ? W.place.c_str() : (W.wmo >= 0 ? labelForCode(W.wmo) : "Weather"));
   char header[64];
   snprintf(header, sizeof(header), "%s", headCore);
   size_t hlen = strlen(header);
@@ -699,21 +456,83 @@ void US2066View::drawPage4() {
   padTrim(L1, l1, 20, true);
 
   // --------- Line 2: Humidity ----------
-  if (W.rh >= 0) { char l2[24]; snprintf(l2, sizeof(l2), "Humidity: %d%%", W.rh); padTrim(L2, l2, 20, true); }
+  if (W.humidity >= 0) { char l2[24]; snprintf(l2, sizeof(l2), "Humidity: %d%%", W.humidity); padTrim(L2, l2, 20, true); }
   else           { padTrim(L2, " ", 20, true); }
 
   // --------- Line 3: Updated age / Fetching ----------
+  wx_ok_ = W.ok;
+  wx_ts_ = W.ts;
+  fmtWxAge(lines_[PG_WX][3]);
+}
+
+// "Updated: Nm" only changes once a minute; refreshed on its own.
+void US2066View::fmtWxAge(char* out){
   uint32_t now = millis();
-  uint32_t age_ms = (now >= W.last_fetch) ? (now - W.last_fetch) : 0;
+  uint32_t age_ms = (now >= wx_ts_) ? (now - wx_ts_) : 0;
   uint32_t age_min = age_ms / 60000UL;
+  wx_min_ = age_min;
   char l3[24];
-  if (W.ok) { if (age_min < 1) snprintf(l3, sizeof(l3), "Updated: <1m"); else snprintf(l3, sizeof(l3), "Updated: %lum", (unsigned long)age_min); }
-  else      { snprintf(l3, sizeof(l3), "Fetching…"); }
-  padTrim(L3, l3, 20, true);
-
-  d_->writeLine(0, L0, true);
-  d_->writeLine(1, L1, true);
-  d_->writeLine(2, L2, true);
-  d_->writeLine(3, L3, true);
+  if (wx_ok_) { if (age_min < 1) snprintf(l3, sizeof(l3), "Updated: <1m"); else snprintf(l3, sizeof(l3), "Updated: %lum", (unsigned long)age_min); }
+  else        { snprintf(l3, sizeof(l3), "Fetching…"); }
+  padTrim(out, l3, 20, true);
+}
+
+// ================= trend page =================
+// CGRAM 1..7 are bars filling the bottom 2..8 pixel rows (1 rather than 0
+// so the codes survive in a C string); a space is the lowest level.
+static const uint8_t BAR_LEVELS = 8;
+static const uint8_t TREND_BARS = 13;   // 20 columns minus a 7-char label
+static const int16_t TREND_MIN_SPAN = 40;   // x10: 4 C / 4 %, keeps noise flat
+
+void US2066View::loadBarGlyphs(){
+  if (!US2066_TREND_PAGE) return;
+  for (uint8_t k=1; k<BAR_LEVELS; ++k){
+    uint8_t rows[8];
+    for (uint8_t r=0; r<8; ++r) rows[r] = (r >= 7 - k) ? 0x1F : 0x00;
+    d_->createChar(k, rows);
+  }
+}
+
+// Page 4 — last 13 x 10 s of CPU / ambient / fan as bars, each row scaled
+// to its own range.
+void US2066View::fmtPage5(){
+  static const History::Series series[3] = { History::S_CPU, History::S_AMB, History::S_FAN };
+  static const char* const     labels[3] = { "CPU", "AMB", "FAN" };
+  const History::Tier tier = History::count(History::T_10S) >= 2 ? History::T_10S : History::T_1S;
+
+  char head[24];
+  snprintf(head, sizeof(head), "Trend %us x%u", (unsigned)History::periodS(tier), (unsigned)TREND_BARS);
+  padTrim(lines_[PG_TREND][0], head, 20, true);
+
+  for (uint8_t i=0; i<3; ++i){
+    char* L = lines_[PG_TREND][i+1];
+    int16_t v[TREND_BARS];
+    const uint16_t n = History::read(tier, series[i], v, TREND_BARS);
+    const int16_t now = History::last(series[i]);
+
+    char lab[8];
+    if (now != History::GAP) snprintf(lab, sizeof(lab), "%s%3d%s", labels[i], (int)lroundf(now / 10.f), series[i]==History::S_FAN ? "%" : "C");
+    else                     snprintf(lab, sizeof(lab), "%s --", labels[i]);
+    padTrim(L, lab, 7);
+
+    int16_t lo = INT16_MAX, hi = INT16_MIN + 1;
+    for (uint16_t k=0; k<n; ++k){
+      if (v[k] == History::GAP) continue;
+      if (v[k] < lo) lo = v[k];
+      if (v[k] > hi) hi = v[k];
+    }
+    if (lo <= hi && hi - lo < TREND_MIN_SPAN){ lo = (int16_t)((lo + hi) / 2 - TREND_MIN_SPAN / 2); hi = lo + TREND_MIN_SPAN; }
+
+    // right-aligned, newest last; written past padTrim (it would blank codes < 0x20)
+    char* bars = L + 7;
+    memset(bars, ' ', TREND_BARS);
+    for (uint16_t k=0; k<n; ++k){
+      if (v[k] == History::GAP || lo > hi) continue;
+      const uint8_t lvl = (uint8_t)((int32_t)(v[k] - lo) * (BAR_LEVELS - 1) / (hi - lo));
+      bars[TREND_BARS - n + k] = lvl ? (char)lvl : ' ';
+    }
+    L[20] = '\0';
+  }
 }
 
+#endif // TYPED_PANEL_US2066
@@ -1,10 +1,17 @@
 #pragma once
 #include <Arduino.h>
 #include "us2066.h"
+#include "telemetry.h"
 
 // Weather (lightweight surface; the module does the heavy lifting)
 #include "weather.h"
 
+// Trend page: CPU / ambient / fan bars from History drawn with CGRAM glyphs
+// 1..7. Set to 0 to leave CGRAM alone and skip the page.
+#ifndef US2066_TREND_PAGE
+#define US2066_TREND_PAGE 1
+#endif
+
 struct US2066_Status {
   // Page 0 / 1
   const char* title       = nullptr;
@@ -50,6 +57,9 @@ public:
 
   void loop();
 
+  // TypedProto::STREAM_* bits the current page draws (reverse control)
+  uint8_t streamsOnScreen() const;
+
   void setPagePeriod(uint32_t ms);
   void forcePage(uint8_t idx);
   void clear();
@@ -64,14 +74,46 @@ private:
   uint32_t last_page_ms_ = 0;
   uint32_t page_ms_ = 4500;
 
-  // UDP ingest + merge into status
-  void drainUdpAndMergeStatus();
+  // Telemetry merge into status (only the groups that changed)
+  uint32_t pending_ = Telemetry::F_ALL;
+  int      telem_sub_ = -1;
+  char     title_[33] = {0};
+  char     av_s_[28] = {0}, res_s_[48] = {0}, enc_s_[16] = {0};
+  static void onTelemetry(const Telemetry::Snapshot& t, uint32_t changed, void* user);
+  void mergeTelemetry();
+  void pollInputs();          // WiFi / weather changes -> stale_
+
+  // Formatted 20-char lines per page. A page is re-formatted only when one of
+  // its inputs changed; the driver's shadow DDRAM sends only what differs.
+  enum : uint8_t { PG_MAIN, PG_HW, PG_NET, PG_WX, PG_TREND, PAGES };
+  static constexpr uint8_t ALL_PAGES = (1u << PAGES) - 1;
+  char     lines_[PAGES][4][21] = {};
+  uint8_t  stale_ = ALL_PAGES; // bit per page
+  int8_t   shown_ = -1;       // page currently in the driver's frame buffer
+  uint8_t  dirty_ = 0;        // lines of the shown page still to hand over
+
+  // inputs refreshed without re-formatting the whole page
+  String   mq_src_, marquee_; // long titles scroll through "title   title   "
+  uint16_t mq_off_ = 0;
+  uint32_t mq_ms_ = 0;
+  uint32_t up_s_ = UINT32_MAX;          // uptime second on the net page
+  uint32_t wx_ver_ = 0, wx_ts_ = 0, wx_min_ = UINT32_MAX;
+  bool     wx_ok_ = false;
+  uint32_t ip_u32_ = 0;
+  String   ip_;
+  uint32_t hist_ver_ = 0;
 
-  // pages
-  void drawPageA();  // App + temps + AV + res
-  void drawPageB();  // Encoder/region/MAC/Serial/Xbox ver
-  void drawPage3();  // WiFi/IP/Batt/Uptime
-  void drawPage4();  // Weather (if enabled & ready); else skipped
+  // pages (format into lines_[page])
+  void fmtPageA();   // App + temps + AV + res
+  void fmtPageB();   // Encoder/region/MAC/Serial/Xbox ver
+  void fmtPage3();   // WiFi/IP/Batt/Uptime
+  void fmtPage4();   // Weather (if enabled & ready); else skipped
+  void fmtPage5();   // Trend bars (if enabled & there is history); else skipped
+  bool pageShown(uint8_t p) const;
+  void loadBarGlyphs();
+  void fmtTitle(char* out);
+  void fmtNetFooter(char* out);
+  void fmtWxAge(char* out);
 
   // helpers
   static void padTrim(char* dst, const char* src, uint8_t width, bool center=false);
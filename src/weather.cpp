@@ -1,45 +1,43 @@
 #include "weather.h"
+#include "metrics.h"
+#include "settings.h"
+#include "http_pool.h"
 #include <WiFi.h>
-#include <WiFiClientSecure.h>
-#include <Preferences.h>
+#include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
 
 namespace Weather {
 
-static Preferences prefs;
 static Config cfg;
 static Snapshot snap;
 
-enum class Phase : uint8_t { IDLE, GEO_ASK, GEO_WAIT, WX_ASK, WX_WAIT };
-static Phase phase = Phase::IDLE;
+// cfg/snap are shared between the fetch task and readers on the loop task
+static SemaphoreHandle_t s_lock = nullptr;
+static TaskHandle_t      s_task = nullptr;
+static volatile bool     s_reload = false;
+static volatile bool     s_paused = false;
+static volatile bool     s_ready  = false;
+static volatile uint32_t s_ver    = 0;
+
+static Located         s_geo;              // guarded by s_lock
+static volatile bool   s_geoWanted = false;   // portal asked for locate()
 
-static uint32_t t_lastStep = 0;
 static uint32_t t_lastOK   = 0;
 static uint32_t t_backoff  = 0;
 
 static const uint32_t GEO_RETRY_MS  = 60 * 1000UL;
-static const uint32_t WX_MIN_MS     = 10 * 60 * 1000UL;  // refresh every 10 min
 static const uint32_t WX_RETRY_MS   = 30 * 1000UL;       // retry quickly on fail
+static const uint32_t HTTP_TIMEOUT_MS = 6000;
+static const uint32_t TASK_TICK_MS  = 1000;
 
-// -------------- tiny helpers --------------
-static inline bool strFindNum(const String& s, const char* key, float& out) {
-  int k = s.indexOf(key);
-  if (k < 0) return false;
-  k += strlen(key);
-  // skip separators ':', space
-  while (k < (int)s.length() && (s[k]==':' || s[k]==' ')) k++;
-  // read up to comma/brace
-  int e = k;
-  while (e < (int)s.length() && (s[e]=='.' || (s[e]>='0' && s[e]<='9') || s[e]=='-' )) e++;
-  out = s.substring(k, e).toFloat();
-  return true;
-}
-static inline bool strFindInt(const String& s, const char* key, int& out) {
-  float f;
-  if (!strFindNum(s, key, f)) return false;
-  out = (int)lroundf(f);
-  return true;
-}
+struct Lock {
+  Lock()  { if (s_lock) xSemaphoreTake(s_lock, portMAX_DELAY); }
+  ~Lock() { if (s_lock) xSemaphoreGive(s_lock); }
+};
 
+// -------------- tiny helpers --------------
 static String wmoToText(int code) {
   // Minimal WMO → text mapper
   // (0) Clear; (1..3) Mainly clear/partly cloudy/overcast; (45/48) Fog;
@@ -55,190 +53,273 @@ static String wmoToText(int code) {
 }
 
 // -------------- persistence --------------
+// The portal owns the "weather" namespace (enabled/units/lat/lon/refresh/name).
+// Older builds used en/al/f; read those only when the portal keys are absent.
+// Portal saves land through Settings; we hear about them via onSetting().
+static const char* NS = "weather";
+// Our own writes don't trigger a reload. Listeners run on the writer's task,
+// so only notifications from the task inside saveCfg() are ours; a portal
+// save landing meanwhile (web task) still reloads.
+static TaskHandle_t volatile s_savingTask = nullptr;
+
 static void saveCfg() {
-  prefs.begin("weather", false);
-  prefs.putBool("en",  cfg.enabled);
-  prefs.putBool("al",  cfg.autoLocate);
-  prefs.putDouble("lat", cfg.lat);
-  prefs.putDouble("lon", cfg.lon);
-  prefs.putBool("f",   cfg.useFahrenheit);
-  prefs.putString("key", cfg.apiKey);
-  prefs.end();
+  Config c;
+  { Lock l; c = cfg; }
+  s_savingTask = xTaskGetCurrentTaskHandle();
+  Settings::putBool(NS, "enabled", c.enabled);
+  Settings::putString(NS, "units", c.useFahrenheit ? "F" : "C");
+  if (!isnan(c.lat)) Settings::putDouble(NS, "lat", c.lat);
+  if (!isnan(c.lon)) Settings::putDouble(NS, "lon", c.lon);
+  Settings::putInt(NS, "refresh", c.refreshMin);
+  Settings::putString(NS, "name", c.place);
+  Settings::putBool(NS, "al",  c.autoLocate);
+  Settings::putString(NS, "key", c.apiKey);
+  s_savingTask = nullptr;
+}
+static void onSetting(const char*, const char*) {
+  if (s_savingTask != xTaskGetCurrentTaskHandle()) s_reload = true;
 }
 static void loadCfg() {
-  prefs.begin("weather", true);
-  cfg.enabled       = prefs.getBool("en", true);
-  cfg.autoLocate    = prefs.getBool("al", true);
-  cfg.lat           = prefs.getDouble("lat", NAN);
-  cfg.lon           = prefs.getDouble("lon", NAN);
-  cfg.useFahrenheit = prefs.getBool("f", true);
-  cfg.apiKey        = prefs.getString("key", "");
-  prefs.end();
+  Config c;
+  c.enabled       = Settings::isKey(NS, "enabled") ? Settings::getBool(NS, "enabled", false) : Settings::getBool(NS, "en", false);
+  if (Settings::isKey(NS, "units")) {
+    String u = Settings::getString(NS, "units", "F");
+    c.useFahrenheit = !(u.length() && (u[0]=='C' || u[0]=='c'));
+  } else {
+    c.useFahrenheit = Settings::getBool(NS, "f", true);
+  }
+  c.lat           = Settings::getDouble(NS, "lat", NAN);
+  c.lon           = Settings::getDouble(NS, "lon", NAN);
+  c.autoLocate    = Settings::getBool(NS, "al", true);
+  int refMin      = Settings::getInt(NS, "refresh", 10);
+  if (refMin < 1) refMin = 1; if (refMin > 120) refMin = 120;
+  c.refreshMin    = (uint16_t)refMin;
+  c.place         = Settings::getString(NS, "name");
+  c.apiKey        = Settings::getString(NS, "key");
+
+  Lock l;
+  cfg = c;
+  // labels are usable before the first fetch lands
+  snap.units = c.useFahrenheit ? 'F' : 'C';
+  snap.place = c.place;
+  snap.lat   = c.lat;
+  snap.lon   = c.lon;
+}
+
+// -------------- HTTP(S) GET (runs on the fetch task only) --------------
+// Optional CA pin: drop a weather_ca.h defining WEATHER_CA_PEM (the root that
+// signs api.open-meteo.com) next to this file; otherwise TLS is unauthenticated.
+#if defined(__has_include)
+#if __has_include("weather_ca.h")
+#include "weather_ca.h"
+#endif
+#endif
+
+// The document is parsed straight off the socket in one pass; with a filter
+// only the wanted members are ever stored, and no body buffer exists.
+struct JsonJob { JsonDocument* doc; const JsonDocument* filter; bool ok; };
+
+static bool parseBody(Stream& body, void* ctx) {
+  JsonJob& j = *static_cast<JsonJob*>(ctx);
+  DeserializationError err = j.filter
+    ? deserializeJson(*j.doc, body, DeserializationOption::Filter(*j.filter))
+    : deserializeJson(*j.doc, body);
+  j.ok = !err;
+  return j.ok;
 }
 
-// -------------- HTTP(S) GET --------------
-static bool httpsGET(const char* host, const String& path, String& out, uint16_t port = 443) {
-  WiFiClientSecure cli;
-  cli.setInsecure();                 // keep it simple (no CA)
-  cli.setTimeout(6000);
-  if (!cli.connect(host, port)) return false;
-
-  String req = String("GET ") + path + " HTTP/1.1\r\n" +
-               "Host: " + host + "\r\n" +
-               "User-Agent: TypeD-WD/1.0\r\n" +
-               "Connection: close\r\n\r\n";
-  if (cli.print(req) == 0) return false;
-
-  // skip headers
-  if (!cli.find("\r\n\r\n")) return false;
-
-  out = "";
-  char buf[256];
-  while (true) {
-    int n = cli.read((uint8_t*)buf, sizeof(buf));
-    if (n <= 0) break;
-    out.concat(String(buf).substring(0, n));
-    if (out.length() > 8192) break; // hard cap
+static bool httpGetJSON(const String& url, JsonDocument& doc, const JsonDocument* filter) {
+  JsonJob j{ &doc, filter, false };
+  return HttpPool::get(url, HTTP_TIMEOUT_MS, parseBody, &j) == 200 && j.ok;
+}
+
+// -------------- flow --------------
+// Both fetches block this task (never a web or UI one) until done.
+static bool geolocate(uint32_t now) {
+  StaticJsonDocument<384> doc;
+  bool ok = httpGetJSON("http://ip-api.com/json/?fields=status,lat,lon,city,regionName", doc, nullptr);
+  // Expect: {"status":"success","lat":..,"lon":..,"city":"..","regionName":".."}
+  ok = ok && String((const char*)(doc["status"] | "")) == "success" &&
+       doc["lat"].is<float>() && doc["lon"].is<float>();
+  Located g;
+  g.ok = ok;
+  g.at = now ? now : 1;
+  if (ok) {
+    g.lat = doc["lat"].as<double>();
+    g.lon = doc["lon"].as<double>();
+    const String city = doc["city"] | "", region = doc["regionName"] | "";
+    g.name = city.length() && region.length() ? city + ", " + region : city;
   }
-  return out.length() > 0;
+  Lock l;
+  g.pending = s_geoWanted;
+  s_geo = g;
+  return ok;
 }
 
-static bool httpGET(const char* host, const String& path, String& out, uint16_t port = 80) {
-  WiFiClient cli;
-  cli.setTimeout(6000);
-  if (!cli.connect(host, port)) return false;
-
-  String req = String("GET ") + path + " HTTP/1.1\r\n" +
-               "Host: " + host + "\r\n" +
-               "User-Agent: TypeD-WD/1.0\r\n" +
-               "Connection: close\r\n\r\n";
-  if (cli.print(req) == 0) return false;
-
-  if (!cli.find("\r\n\r\n")) return false;
-
-  out = "";
-  char buf[256];
-  while (true) {
-    int n = cli.read((uint8_t*)buf, sizeof(buf));
-    if (n <= 0) break;
-    out.concat(String(buf).substring(0, n));
-    if (out.length() > 4096) break;
+// Auto-locate: the coordinates are kept in the config.
+static void geoStep(uint32_t now) {
+  if (geolocate(now)) {
+    {
+      Lock l;
+      cfg.lat = s_geo.lat;
+      cfg.lon = s_geo.lon;
+    }
+    saveCfg();
+    t_backoff = 0;                // next tick will request weather
+  } else {
+    t_backoff = now + GEO_RETRY_MS;
   }
-  return out.length() > 0;
 }
 
-// -------------- flow --------------
-static void requestGeo() {
-  phase = Phase::GEO_ASK;
-  t_lastStep = millis();
+static void wxStep(uint32_t now) {
+  Config c;
+  { Lock l; c = cfg; }
+  if (isnan(c.lat) || isnan(c.lon)) return;
+
+  char url[320];
+  snprintf(url, sizeof(url),
+    "https://api.open-meteo.com/v1/forecast?latitude=%.4f&longitude=%.4f"
+    "&current=temperature_2m,weather_code,relative_humidity_2m,wind_speed_10m"
+    "&temperature_unit=%s&windspeed_unit=%s&timeformat=unixtime",
+    c.lat, c.lon, c.useFahrenheit ? "fahrenheit" : "celsius", c.useFahrenheit ? "mph" : "kmh");
+
+  // Only the four values we show; "current_units", time and the rest of the
+  // envelope are skipped by the parser without being stored.
+  StaticJsonDocument<128> filter;
+  JsonObject want = filter.createNestedObject("current");
+  want["temperature_2m"]       = true;
+  want["weather_code"]         = true;
+  want["relative_humidity_2m"] = true;
+  want["wind_speed_10m"]       = true;
+  StaticJsonDocument<256> doc;
+  const bool ok = httpGetJSON(String(url), doc, &filter);
+
+  JsonObject cur = doc["current"];
+  if (ok && !cur.isNull() && cur["temperature_2m"].is<float>() && cur["weather_code"].is<int>()) {
+    const float temp = cur["temperature_2m"].as<float>();
+    Snapshot n;
+    n.ok       = true;
+    n.ts       = now;
+    n.temp     = temp;
+    n.units    = c.useFahrenheit ? 'F' : 'C';
+    n.tempC    = c.useFahrenheit ? ((temp - 32.0f) * 5.0f/9.0f) : temp;
+    n.wind     = cur["wind_speed_10m"] | NAN;
+    n.wmo      = cur["weather_code"].as<int>();
+    n.humidity = cur["relative_humidity_2m"] | -1;
+    n.lat      = c.lat;
+    n.lon      = c.lon;
+    n.place    = c.place;
+    n.text     = wmoToText(n.wmo);
+    {
+      Lock l;
+      n.version = snap.version + 1;
+      snap = n;
+    }
+    s_ver   = n.version;
+    s_ready = true;
+    t_lastOK  = now;
+    t_backoff = now + (uint32_t)c.refreshMin * 60UL * 1000UL;
+  } else {
+    t_backoff = now + WX_RETRY_MS;
+  }
+}
+
+static void step() {
+  if (s_paused) return;
+  if (s_reload) {
+    s_reload = false;
+    loadCfg();
+    t_lastOK = 0;               // settings changed: refetch now
+    t_backoff = 0;
+  }
+
+  if (WiFi.status() != WL_CONNECTED) return;
+  uint32_t now = millis();
+
+  // the portal's auto-detect works with weather off too
+  if (s_geoWanted) {
+    s_geoWanted = false;
+    Metrics::Scope m(Metrics::T_WEATHER_FETCH);
+    geolocate(now);
+    return;
+  }
+
+  Config c;
+  { Lock l; c = cfg; }
+  if (!c.enabled) return;
+  if (t_backoff && (int32_t)(now - t_backoff) < 0) return;
+
+  const bool needGeo = c.autoLocate && (isnan(c.lat) || isnan(c.lon));
+  const bool stale   = (t_lastOK == 0) || (now - t_lastOK >= (uint32_t)c.refreshMin * 60UL * 1000UL);
+  if (!needGeo && !stale) return;
+  Metrics::Scope m(Metrics::T_WEATHER_FETCH);
+  if (needGeo) geoStep(now);
+  else         wxStep(now);
 }
-static void requestWx() {
-  phase = Phase::WX_ASK;
-  t_lastStep = millis();
+
+static void fetchTask(void*) {
+  for (;;) {
+    step();
+    vTaskDelay(pdMS_TO_TICKS(TASK_TICK_MS));
+  }
 }
 
 void begin() {
+  if (!s_lock) s_lock = xSemaphoreCreateMutex();
+#ifdef WEATHER_CA_PEM
+  HttpPool::pin("api.open-meteo.com", WEATHER_CA_PEM);
+#endif
+  static bool subscribed = false;
+  if (!subscribed) { Settings::subscribe(NS, onSetting); subscribed = true; }
+  {
+    Lock l;
+    snap = Snapshot();
+  }
   loadCfg();
-  snap = Snapshot();
-  phase = Phase::IDLE;
+  s_ready = false;
+  s_ver = 0;
   t_lastOK = 0;
   t_backoff = 0;
+  if (!s_task) {
+    // TLS handshakes need a roomy stack; keep it off the UI core
+    xTaskCreatePinnedToCore(fetchTask, "weather", 8192, nullptr, 1, &s_task, 0);
+  }
+}
+
+void loop() {
+  // fetches happen on the weather task
 }
 
+void setPaused(bool paused) { s_paused = paused; }
+
 void setConfig(const Config& c) {
-  cfg = c;
+  {
+    Lock l;
+    cfg = c;
+  }
   saveCfg();
   // restart cycle immediately
-  phase = Phase::IDLE;
-  t_lastOK = 0;
-  t_backoff = 0;
+  s_reload = true;
 }
 
-Config getConfig() { return cfg; }
+void reload() { s_reload = true; }
 
-bool isReady() { return snap.ok; }
-Snapshot get() { return snap; }
+Config getConfig() { Lock l; return cfg; }
 
-void loop() {
-  if (!cfg.enabled) return;
-  if (WiFi.status() != WL_CONNECTED) return;
+bool enabled() { Lock l; return cfg.enabled; }
 
-  uint32_t now = millis();
+bool isReady() { return s_ready; }
 
-  // Decide what to do next
-  if (phase == Phase::IDLE) {
-    bool needGeo = cfg.autoLocate && (isnan(cfg.lat) || isnan(cfg.lon));
-    bool stale   = (t_lastOK == 0) || (now - t_lastOK >= WX_MIN_MS);
-    if (needGeo) {
-      requestGeo();
-    } else if (stale && now - t_backoff >= 1) {
-      requestWx();
-    }
-    return;
-  }
+uint32_t version() { return s_ver; }
 
-  // GEO query (ip-api)
-  if (phase == Phase::GEO_ASK || phase == Phase::GEO_WAIT) {
-    String body;
-    bool ok = httpGET("ip-api.com", "/json/?fields=status,lat,lon", body);
-    if (!ok) { t_backoff = now + GEO_RETRY_MS; phase = Phase::IDLE; return; }
-
-    // Expect: {"status":"success","lat":..,"lon":..}
-    int okpos = body.indexOf("\"success\"");
-    float lat=0, lon=0;
-    bool haveLat = strFindNum(body, "\"lat\":", lat);
-    bool haveLon = strFindNum(body, "\"lon\":", lon);
-
-    if (okpos >= 0 && haveLat && haveLon) {
-      cfg.lat = lat; cfg.lon = lon;
-      saveCfg();
-      phase = Phase::IDLE;        // next loop will request weather
-      t_backoff = 0;
-    } else {
-      t_backoff = now + GEO_RETRY_MS;
-      phase = Phase::IDLE;
-    }
-    return;
-  }
-
-  // Weather query (Open-Meteo)
-  if (phase == Phase::WX_ASK || phase == Phase::WX_WAIT) {
-    if (isnan(cfg.lat) || isnan(cfg.lon)) { phase = Phase::IDLE; return; }
-
-    char path[256];
-    // unit selection
-    const char* unit = cfg.useFahrenheit ? "fahrenheit" : "celsius";
-    snprintf(path, sizeof(path),
-      "/v1/forecast?latitude=%.4f&longitude=%.4f&current=temperature_2m,weather_code,relative_humidity_2m"
-      "&temperature_unit=%s&forecast_days=1&timeformat=unixtime&timezone=auto",
-      cfg.lat, cfg.lon, unit);
-
-    String body;
-    bool ok = httpsGET("api.open-meteo.com", String(path), body);
-    if (!ok) { t_backoff = now + WX_RETRY_MS; phase = Phase::IDLE; return; }
-
-    // Parse minimal current fields
-    float temp=0; int wmo=0, rh=0;
-    bool a = strFindNum(body, "\"temperature_2m\":", temp);
-    bool b = strFindInt(body, "\"weather_code\":", wmo);
-    bool c = strFindInt(body, "\"relative_humidity_2m\":", rh);
-
-    if (a && b) {
-      snap.ok = true;
-      snap.ts = now;
-      snap.tempC = cfg.useFahrenheit ? ((temp - 32.0f) * 5.0f/9.0f) : temp;
-      snap.wmo = wmo;
-      snap.humidity = c ? rh : -1;
-      snap.text = wmoToText(wmo);
-      t_lastOK = now;
-      t_backoff = now + WX_MIN_MS;
-    } else {
-      t_backoff = now + WX_RETRY_MS;
-    }
+Snapshot get() { Lock l; return snap; }
 
-    phase = Phase::IDLE;
-    return;
-  }
+void locate() {
+  Lock l;
+  s_geoWanted = true;
+  s_geo.pending = true;
 }
 
+Located located() { Lock l; return s_geo; }
+
 } // namespace Weather
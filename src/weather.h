@@ -1,31 +1,59 @@
 #pragma once
 #include <Arduino.h>
 
+// Weather service shared by both display back-ends.
+// Fetching runs on a background task; views only ever read get().
+
 namespace Weather {
 
 struct Config {
-  bool   enabled        = true;     // toggle weather on/off
-  bool   autoLocate     = true;     // true = geolocate via IP, false = use lat/lon
+  bool   enabled        = false;    // toggle weather on/off (portal "enabled")
+  bool   autoLocate     = true;     // true = geolocate via IP when lat/lon are unset
   double lat            = NAN;      // used if autoLocate == false
   double lon            = NAN;      // used if autoLocate == false
   bool   useFahrenheit  = true;     // true = °F, false = °C
+  uint16_t refreshMin   = 10;       // refresh cadence, minutes (1..120)
+  String place;                     // optional label shown instead of coords
   String apiKey;                    // reserved (not required for Open-Meteo)
 };
 
 struct Snapshot {
   bool     ok = false;
+  uint32_t version = 0;   // bumps on every published refresh
   uint32_t ts = 0;        // millis() when refreshed
   float    tempC = NAN;   // current temperature in °C
+  float    temp  = NAN;   // current temperature in the configured units
+  char     units = 'F';   // 'F' or 'C' (wind is mph / km/h accordingly)
+  float    wind  = NAN;   // wind speed at 10 m
   int      wmo = -1;      // WMO weather code
   int      humidity = -1; // %
+  double   lat = NAN;     // coordinates the data is for
+  double   lon = NAN;
+  String   place;         // label from config (may be empty)
   String   text;          // short condition text
 };
 
-void   begin();
-void   loop();
+// IP geolocation (ip-api.com), as the portal's "auto-detect" shows it.
+struct Located {
+  bool     pending = false;   // a locate() the task hasn't run yet
+  bool     ok = false;
+  uint32_t at = 0;            // millis() of the last attempt, 0 = never
+  double   lat = NAN;
+  double   lon = NAN;
+  String   name;              // "City, Region" (may be empty)
+};
+
+void   begin();                        // loads prefs and starts the fetch task
+void   loop();                         // no-op; kept for sketch compatibility
 void   setConfig(const Config& c);     // apply and persist
+void   reload();                       // re-read prefs (portal saved new settings)
+void   setPaused(bool paused);         // hold off new fetches (e.g. during OTA)
 Config getConfig();
+bool   enabled();
 bool   isReady();                      // snapshot available
+uint32_t version();                    // snapshot version (cheap change check)
 Snapshot get();                        // latest snapshot
+void   locate();                       // ask the task to geolocate (returns at once)
+Located located();                     // newest geolocation result
 
 } // namespace Weather
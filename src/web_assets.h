@@ -0,0 +1,344 @@
+#pragma once
+// Generated by web/build_web_assets.py from web/*.html - do not edit.
+#include <Arduino.h>
+
+// portal.html: 10568 B -> 3176 B gzip
+static const char PORTAL_HTML_ETAG[] = "\"900fd65843103225\"";
+static const size_t PORTAL_HTML_GZ_LEN = 3176;
+static const uint8_t PORTAL_HTML_GZ[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xb5,0x5a,0xeb,0x72,0xdb,0xb8,
+  0x15,0xfe,0x9f,0xa7,0x40,0x94,0x69,0x48,0xd6,0x12,0x75,0x49,0xec,0x6c,0x24,0x51,
+  0x9e,0xc4,0x97,0x5d,0x77,0xb2,0x6b,0x4f,0x9c,0x4c,0xda,0x5f,0x19,0x88,0x84,0x2c,
+  0xd8,0x14,0xc0,0x90,0x90,0x65,0xad,0xe2,0x77,0xea,0x33,0xf4,0xc9,0x7a,0x0e,0x00,
+  0x52,0xa4,0x6c,0x5d,0xec,0x76,0x67,0x27,0x11,0x09,0x02,0x1f,0xce,0xf5,0xc3,0xc1,
+  0xd9,0xf4,0x5f,0x1e,0x9f,0x1f,0x7d,0xf9,0xd7,0xc5,0x09,0x19,0xab,0x49,0x3c,0x78,
+  0xd1,0xcf,0x7f,0x18,0x8d,0x06,0x2f,0x08,0xe9,0x2b,0xae,0x62,0x36,0xf8,0x32,0x4f,
+  0x18,0x39,0x26,0xdf,0x78,0xca,0x62,0x96,0x65,0xe4,0x98,0x67,0x49,0x4c,0xe7,0xe4,
+  0x92,0xa9,0x69,0xd2,0x6f,0x9a,0x49,0x38,0x7d,0xc2,0x14,0x25,0x82,0x4e,0x58,0x50,
+  0xbb,0xe5,0x6c,0x96,0xc8,0x54,0xd5,0x48,0x28,0x85,0x62,0x42,0x05,0xb5,0x19,0x8f,
+  0xd4,0x38,0x78,0x73,0xd0,0xaa,0x73,0xc1,0x15,0xa7,0x71,0x23,0x0b,0x69,0xcc,0x82,
+  0x76,0x4d,0x2f,0xce,0xd4,0xdc,0xc0,0x10,0x32,0x94,0xd1,0x7c,0x31,0xa4,0xe1,0xcd,
+  0x55,0x2a,0xa7,0x22,0xea,0xbe,0x6a,0xb7,0xdb,0xbd,0x50,0xc6,0x32,0xed,0xbe,0x3a,
+  0x39,0x39,0xe9,0x8d,0x00,0xb2,0x31,0xa2,0x13,0x1e,0xcf,0xbb,0x19,0x15,0x59,0x23,
+  0x63,0x29,0x1f,0xdd,0xeb,0xb5,0x3e,0xee,0x47,0xb9,0x60,0xe9,0x62,0x42,0xef,0x1a,
+  0x7a,0xd3,0x2e,0x6c,0x9a,0xdc,0xf5,0x26,0x34,0xbd,0xe2,0xa2,0xdb,0x79,0x9b,0xdc,
+  0x11,0x3a,0x55,0xb2,0x57,0xde,0xa2,0xd3,0xe9,0xf4,0x12,0x1a,0x45,0x5c,0x5c,0x75,
+  0xdb,0x7e,0x87,0x4d,0x48,0xdb,0x7f,0xcb,0x26,0xbd,0xa1,0x4c,0x23,0x96,0x36,0x52,
+  0x1a,0xf1,0x69,0xd6,0x6d,0x23,0xce,0x50,0xde,0x35,0xb2,0x31,0x8d,0xe4,0xac,0xdb,
+  0x22,0x2d,0xd2,0x3e,0x00,0xbc,0x57,0xad,0x56,0xeb,0x17,0x23,0xc1,0xb8,0xb3,0xb0,
+  0x3b,0x69,0x98,0x16,0xf1,0x0f,0xf0,0xc7,0x7c,0xe4,0x22,0x99,0xaa,0x7a,0x06,0x86,
+  0x0c,0x55,0x7d,0x38,0x55,0x4a,0x8a,0x85,0x91,0xb1,0xdd,0x6a,0xfd,0xcd,0x40,0xf3,
+  0x3f,0x51,0x08,0xbb,0x31,0x8c,0xe4,0x82,0xfb,0xfb,0x88,0x53,0x48,0xe9,0xef,0xc3,
+  0xbb,0xb1,0x05,0x2c,0x61,0x20,0x75,0x6b,0xff,0x81,0xc0,0x07,0x5a,0x5e,0x1c,0xe9,
+  0xb6,0x41,0xcc,0x4c,0xc6,0x3c,0x22,0xaf,0xf6,0xf7,0xf7,0x7b,0xeb,0xed,0x6b,0x0d,
+  0x99,0xca,0xd9,0x22,0x32,0xae,0xee,0x8e,0x62,0x76,0xd7,0xbb,0xa2,0x89,0x96,0x61,
+  0xf9,0x9d,0x0c,0xc8,0xdf,0x17,0xf8,0xad,0xdb,0xb6,0x83,0x43,0x25,0x1a,0x49,0xca,
+  0x41,0xe2,0xaa,0x07,0x3b,0xef,0xdf,0xd3,0x4e,0x68,0x37,0x99,0x8d,0xb9,0x62,0xa5,
+  0x05,0x11,0x15,0x57,0xe0,0xaf,0xf2,0x7c,0x0a,0xee,0x78,0x38,0x39,0xa4,0x69,0x54,
+  0x0d,0x0c,0x8a,0xff,0x3d,0xa2,0xe1,0x9b,0x37,0x6f,0x1e,0x73,0x5d,0xe1,0xe1,0x65,
+  0x3c,0x34,0x94,0x4c,0xba,0x6d,0x88,0x09,0xbb,0x07,0x17,0x31,0x44,0x4f,0x55,0x73,
+  0x1a,0xf3,0x2b,0xd1,0x00,0x39,0x26,0x59,0x37,0x84,0x60,0x66,0xa9,0x31,0xc6,0xdb,
+  0xc2,0x18,0x99,0xa2,0x6a,0x9a,0x2d,0x4a,0x90,0xe8,0xf5,0x92,0x77,0xfc,0xf7,0x85,
+  0xe5,0xb2,0x09,0x8d,0xe3,0x85,0x4c,0x68,0xc8,0xd5,0xbc,0xeb,0xbf,0xdb,0x37,0xc3,
+  0x74,0x61,0x5d,0xf0,0x0b,0x0d,0x47,0x23,0x1d,0xce,0xfd,0xa6,0xcd,0x8a,0x7e,0xd3,
+  0xe4,0x64,0x1f,0x53,0x43,0xa7,0x4b,0xc4,0x6f,0x49,0x18,0xd3,0x2c,0x0b,0x6a,0x45,
+  0xc4,0xd7,0x4c,0xfa,0xf4,0xc7,0x9d,0x6d,0x39,0x0b,0x33,0xcc,0xd4,0x32,0x0c,0x18,
+  0xd7,0x22,0xc0,0x87,0x98,0x0e,0x59,0x3c,0xf8,0xc6,0x1b,0xa7,0x9c,0xfc,0xc1,0xd4,
+  0x4c,0xa6,0x37,0xfd,0xa6,0x19,0xcc,0xa7,0x98,0x28,0x26,0x3c,0x0a,0x6a,0x59,0xc6,
+  0xa3,0xe3,0x54,0x26,0x90,0x13,0xa2,0x36,0xe8,0xcb,0x44,0x71,0x29,0xc8,0x2d,0x8d,
+  0xa7,0xc0,0x05,0xb5,0xc1,0x45,0xcc,0x68,0xc6,0x88,0x5d,0x00,0x1c,0x91,0x03,0x9a,
+  0x89,0x03,0xd0,0x53,0x7f,0x2a,0xa0,0x75,0x9a,0x10,0x05,0x4a,0x04,0x35,0xc5,0xee,
+  0x80,0x46,0xf2,0x5d,0x6a,0x04,0xf4,0x08,0xd9,0x58,0xc6,0xe0,0xdb,0xa0,0x76,0x79,
+  0x79,0x76,0xbc,0x2a,0xf4,0x05,0xa8,0x03,0xf0,0xd1,0xaa,0xbc,0x65,0xd0,0xc4,0xce,
+  0x31,0xc0,0xf8,0xb6,0x02,0x6c,0x34,0xcf,0xa1,0x96,0x5b,0x98,0x9c,0xb5,0x28,0xe6,
+  0xa5,0x46,0xa4,0x08,0x63,0x1e,0xde,0x80,0x84,0xf4,0x96,0x7d,0xe3,0x23,0xee,0x7a,
+  0xb5,0xdc,0xac,0xa5,0x8c,0xa8,0x0d,0x8e,0xa4,0x10,0x68,0x82,0xd7,0xe4,0x12,0x66,
+  0xf6,0x9b,0x06,0x60,0x47,0xf0,0x91,0x4c,0xaf,0x98,0x5a,0x81,0x36,0xb9,0x53,0x1b,
+  0x9c,0xea,0x8f,0x44,0x8b,0xfd,0x00,0xb7,0xe4,0x65,0x13,0xa8,0xd6,0x9e,0xe6,0x79,
+  0x70,0xa9,0x7f,0xbb,0xc4,0xf7,0xfd,0x7e,0x13,0xe6,0x2e,0x3d,0x8c,0x91,0x3a,0xe8,
+  0x53,0x32,0x4e,0xd9,0x28,0xa8,0x35,0xa5,0xa2,0xb5,0xc1,0xf9,0x97,0x0f,0xe4,0x6b,
+  0x12,0x51,0x05,0xf2,0xd3,0x01,0x69,0x04,0x0d,0xb2,0x9c,0x31,0x9a,0x81,0x28,0x3c,
+  0x9d,0xcc,0x68,0xca,0x80,0xec,0x46,0x12,0xe7,0x80,0x7b,0x35,0x90,0x09,0x39,0xb3,
+  0x43,0x11,0xa9,0xdf,0x18,0x55,0x63,0x96,0xee,0x1c,0x93,0xf9,0x27,0x93,0xa7,0x10,
+  0x6c,0x65,0xb7,0x86,0x63,0x16,0xde,0x00,0x65,0x1a,0xfd,0x66,0xdf,0x99,0xa0,0xc3,
+  0x98,0x01,0x04,0x39,0xd1,0x4f,0x64,0x66,0x76,0x23,0x59,0x98,0x32,0x26,0x56,0x23,
+  0xa4,0xb4,0x33,0xb0,0x5b,0xb1,0x71,0x35,0xd6,0x67,0xdf,0xa7,0x70,0x7e,0x65,0xa5,
+  0xaf,0xf0,0xbd,0x1a,0xf1,0xa7,0xb5,0xc1,0x57,0x9c,0xd3,0x25,0xa7,0x14,0x0c,0x23,
+  0xc6,0x8c,0x2b,0xe2,0xfe,0xe7,0xdf,0xa7,0x5e,0x11,0xf2,0xeb,0x17,0x1f,0x15,0x8b,
+  0x8f,0x58,0x9c,0x01,0x75,0xe1,0xca,0xa3,0x47,0x56,0xae,0x66,0xcd,0x4a,0x88,0x8b,
+  0xe9,0x64,0x08,0x91,0x61,0x65,0x06,0xf7,0xa4,0x2c,0x1b,0xd7,0xc8,0x84,0x8b,0xa0,
+  0xd6,0x86,0x5f,0x7a,0x07,0xbf,0x9d,0x56,0x2d,0xdf,0xb7,0x0d,0x8f,0x99,0x62,0x89,
+  0xfe,0x5a,0xc9,0x85,0xcf,0x66,0x2d,0x71,0x61,0xad,0xb7,0x74,0x47,0x25,0x54,0x1e,
+  0xcf,0xd8,0xd9,0x77,0x2c,0x07,0x56,0xe0,0x3e,0xc9,0x90,0x6a,0x85,0xf1,0x1b,0x71,
+  0x8d,0x5a,0x34,0x2e,0x21,0xaf,0xf7,0xc3,0xba,0x6d,0x62,0xaa,0x56,0x77,0x81,0x3d,
+  0xd4,0x34,0x62,0x84,0xf9,0x57,0x3e,0x79,0xdb,0xf2,0xdf,0xb5,0x3b,0xbf,0xec,0x04,
+  0x85,0x49,0xb7,0x22,0xb0,0xb8,0x2a,0x61,0x35,0xde,0xbd,0xf5,0x5b,0xad,0x83,0xd6,
+  0x1a,0x4b,0xac,0x17,0x7e,0x73,0x7a,0x63,0x49,0x02,0xa6,0x81,0xfc,0x1e,0x7c,0x80,
+  0xc7,0x46,0xc4,0x14,0x86,0xdc,0x70,0x4e,0xce,0x2e,0x56,0x33,0x7a,0x37,0x22,0x32,
+  0xb1,0xbe,0x8e,0x8b,0x90,0x81,0x48,0x91,0x7d,0x2b,0x8c,0xf1,0x40,0x23,0x63,0x9b,
+  0x9c,0x3d,0xaa,0x64,0x32,0x78,0x8c,0x35,0xbe,0x31,0x32,0x05,0xce,0x3f,0x4f,0x98,
+  0x68,0xfc,0x0e,0xaa,0x48,0xe2,0x0a,0x49,0x3e,0x5c,0x9c,0x91,0x1b,0x36,0xf7,0x7c,
+  0x52,0xd6,0x11,0x26,0x66,0x84,0x27,0x0d,0x9a,0x70,0xa8,0xdf,0x26,0xfe,0x46,0xc2,
+  0xb0,0x47,0xd9,0xee,0x84,0x01,0xbc,0x19,0xd4,0xa2,0xef,0x13,0x19,0x01,0x5d,0x7c,
+  0x08,0x15,0x07,0xbd,0x0b,0x90,0xb5,0x47,0x5a,0xbe,0xe0,0xc5,0x9a,0x34,0xcd,0xb2,
+  0xa8,0xfd,0xa6,0xf5,0x1e,0xf8,0xf0,0xd3,0xc9,0x31,0x81,0xd8,0xba,0x3b,0x78,0x4b,
+  0xdc,0xcb,0xcb,0x63,0x1c,0xf5,0x48,0x83,0x44,0x6c,0x44,0xa7,0xb1,0x7a,0x24,0x6f,
+  0xab,0x40,0xd3,0xac,0xd3,0x3a,0x38,0x80,0xb3,0x61,0x4c,0x53,0x1a,0x42,0x6d,0x41,
+  0x34,0x62,0xa7,0x75,0x07,0x78,0x5f,0x2f,0xf1,0xe3,0x83,0xe4,0x7f,0x70,0x60,0x1a,
+  0x7b,0x9d,0x8b,0x78,0x0e,0x31,0xc0,0x88,0xad,0x5e,0x48,0x48,0x05,0x19,0x32,0x42,
+  0xb5,0xd2,0x7e,0xee,0x6d,0xc2,0x33,0x92,0xdd,0xf0,0x24,0x61,0x11,0xcc,0x26,0x66,
+  0x8f,0xaa,0xd1,0x57,0x8d,0x97,0xc8,0x19,0x9e,0x32,0x17,0xf8,0x43,0x2e,0x52,0x39,
+  0xe2,0x31,0xdb,0x68,0x3c,0xbb,0x60,0x9d,0xd2,0x90,0xaf,0x4c,0x84,0x10,0x85,0x9f,
+  0xa0,0x8a,0xb4,0x2f,0x4f,0xb0,0xd9,0x90,0xc6,0x54,0x84,0x48,0xec,0x1f,0xed,0xd3,
+  0x0e,0x4b,0x14,0xd8,0x76,0x8e,0x2b,0xf4,0x03,0x71,0x23,0x3e,0xc9,0x72,0x4b,0x6d,
+  0xb7,0x70,0xc5,0x1c,0x43,0x8c,0xfa,0xbc,0xa6,0xfa,0x38,0xcd,0x36,0x9a,0x42,0x4f,
+  0x5e,0x27,0x16,0x66,0x7d,0x35,0xe1,0x77,0xb7,0x02,0x5c,0x42,0x52,0xb4,0xc1,0xa5,
+  0xfe,0x25,0xee,0xaf,0x17,0x67,0xe7,0xe4,0xa0,0xf9,0xae,0x0e,0x74,0xd7,0x22,0x37,
+  0xbf,0xfd,0xe9,0x6d,0x87,0x60,0x09,0x44,0x9d,0x82,0x38,0xbf,0xb4,0x4f,0xc4,0xc5,
+  0xa2,0xb1,0x5d,0x27,0x23,0x9a,0x61,0x30,0x86,0xb1,0x0c,0x6f,0x76,0x0d,0x40,0x30,
+  0x05,0x09,0xc7,0x58,0x92,0x64,0x84,0x26,0x09,0x44,0x23,0x1d,0x21,0x08,0x25,0x29,
+  0x1b,0x4a,0xa9,0x1e,0x04,0xd9,0x73,0xc9,0x12,0xf9,0xcd,0xda,0x7f,0x23,0xbf,0x15,
+  0x79,0xbe,0x89,0xdf,0x2a,0xae,0x85,0x6a,0x1a,0xee,0x10,0x4c,0xd7,0x6a,0xf8,0xb0,
+  0xd1,0xb5,0xf9,0x64,0x14,0x4c,0xab,0x0d,0xb5,0x24,0x17,0x76,0xa5,0xeb,0x6d,0x73,
+  0xfb,0x67,0x28,0xa8,0xc0,0xe2,0x6a,0x0c,0xd7,0x99,0xab,0x31,0x89,0x91,0x99,0x2c,
+  0x64,0xb6,0x3e,0x0e,0x1e,0xd8,0x3e,0xe7,0xe7,0x42,0x9e,0x1d,0x19,0x9a,0xab,0x31,
+  0xd4,0xe4,0xb7,0x2c,0xa5,0x31,0xf9,0x27,0x54,0x4d,0xb0,0x69,0xc6,0x04,0x5e,0x90,
+  0xea,0x20,0xd3,0x92,0x45,0xb2,0xb1,0x9c,0x65,0x9a,0x57,0x92,0xa2,0x74,0x22,0xe1,
+  0x3c,0x84,0x7a,0x6a,0x2a,0xf4,0xf5,0x02,0x94,0x16,0x2c,0xda,0xc6,0xdb,0xf4,0x4a,
+  0xc8,0x4c,0xf1,0x30,0xdb,0x85,0xbb,0x9f,0x1b,0x19,0x21,0x4d,0x5c,0x07,0xd4,0x4e,
+  0x55,0xd0,0x76,0x3c,0x5d,0xdc,0xa6,0x0a,0x88,0x30,0x51,0xd3,0x94,0x3d,0xf9,0x1c,
+  0xb5,0x68,0x32,0xc9,0xc1,0x64,0xf2,0x6c,0xac,0xd8,0xd6,0x3d,0xbe,0xae,0x95,0x9d,
+  0xe6,0x34,0x4a,0x9a,0x16,0xcb,0x1f,0x72,0xe1,0x00,0xa3,0xc0,0xf5,0x29,0x96,0x34,
+  0xda,0x7e,0x1c,0x3f,0xc7,0x32,0x29,0x43,0x5d,0x12,0xc6,0x22,0xa3,0xcc,0x67,0xa6,
+  0xbd,0xdb,0xbe,0x7b,0xb2,0x26,0x65,0xa4,0xd6,0xeb,0x58,0xe6,0xe6,0xc9,0x11,0x5b,
+  0x77,0xc4,0xc5,0x51,0xef,0x99,0xc8,0x55,0x7b,0xa7,0x6c,0x7b,0x0a,0xe7,0x29,0x10,
+  0x3e,0xa5,0x44,0xf9,0xcc,0x42,0xb8,0xdb,0x41,0xe5,0x21,0xa0,0xe8,0x80,0xa8,0x27,
+  0x5f,0x8f,0x2f,0xc8,0x28,0x85,0xaa,0x14,0xd8,0x4b,0x44,0x58,0x04,0xce,0x33,0xcc,
+  0x84,0x09,0xc1,0xa6,0x03,0xcc,0x53,0xb2,0x92,0x18,0x09,0x4f,0x18,0xde,0x42,0x1e,
+  0x0d,0xfc,0x65,0x06,0xf4,0x21,0x65,0x78,0x02,0xf9,0x3a,0x9a,0x8a,0x50,0xb3,0x40,
+  0x06,0x07,0xb3,0xeb,0x91,0x05,0x4c,0x1a,0x31,0x15,0x8e,0x5d,0xa7,0x89,0x43,0x8e,
+  0xe7,0x03,0xbc,0x70,0xd3,0x60,0x90,0xfa,0xd7,0x99,0x84,0x39,0x76,0xe4,0x3a,0x18,
+  0x2c,0x34,0x78,0x0c,0x97,0xbc,0x28,0x0a,0x22,0x19,0x4e,0x27,0x4c,0x28,0x1f,0x2e,
+  0x7d,0x27,0x31,0xc3,0xc7,0x8f,0xf3,0xb3,0x08,0x6c,0x57,0xba,0x89,0x3b,0x5e,0x4f,
+  0xd3,0x89,0x82,0x92,0x0b,0xea,0xfa,0x28,0xf2,0x35,0xfb,0xf4,0x00,0xc0,0xc7,0x84,
+  0x4d,0x7f,0xfb,0xf2,0xfb,0xa7,0xc0,0x71,0x7a,0x4b,0x64,0x08,0xcc,0x02,0x1a,0xf2,
+  0x1c,0xd8,0xc9,0xa2,0xbb,0x8e,0x21,0x21,0xc4,0x84,0x59,0x06,0x09,0xd7,0xea,0x37,
+  0xac,0x9f,0x03,0xf7,0xda,0xb7,0x17,0xfb,0xcc,0x8f,0x99,0xb8,0x52,0xe3,0x9f,0x3f,
+  0x5f,0x5e,0xfb,0xa8,0x98,0x00,0xeb,0x7a,0x87,0xce,0x9a,0x3e,0x80,0xd3,0x75,0x2e,
+  0xed,0x24,0xb8,0x82,0x3a,0x5a,0x3e,0x38,0x3d,0x80,0x8a,0x8e,0xc6,0x3c,0x8e,0x5c,
+  0xd8,0xc1,0x33,0x32,0x96,0x76,0x00,0xba,0x3e,0xa1,0x60,0x39,0x01,0x96,0xd1,0xb2,
+  0xcb,0x1d,0x24,0x97,0x56,0x6e,0xe1,0xa3,0x9d,0xf0,0x5d,0x4b,0x6e,0x5e,0xf7,0x1c,
+  0xe2,0x3a,0x7b,0xc2,0x4f,0xe1,0x05,0x9e,0xa3,0x8f,0x13,0x67,0xcf,0x15,0xbe,0x04,
+  0x41,0x0e,0x9d,0x3a,0xc1,0x5f,0x90,0xd4,0xf1,0xf6,0x1c,0xef,0xa1,0x8c,0x12,0xd0,
+  0xef,0xad,0x94,0xb9,0xa1,0x03,0x34,0x7b,0x31,0x54,0x1c,0x11,0x79,0x14,0xb8,0xde,
+  0x82,0x6c,0xf4,0x23,0x84,0x83,0xc1,0x59,0x7a,0xee,0x1e,0xe1,0xee,0x3d,0x1f,0x98,
+  0x04,0x74,0x77,0xbd,0xe7,0x86,0xc5,0xda,0x08,0x78,0x8a,0x15,0xd1,0xfb,0xd6,0x82,
+  0xda,0x81,0x50,0x32,0x40,0x59,0x18,0x3d,0x6a,0x1c,0x2d,0x76,0xef,0xc5,0xfd,0x8b,
+  0x8c,0xa9,0x33,0xec,0xa0,0x01,0x84,0x8b,0xa1,0x51,0x27,0xfb,0xad,0x56,0x0b,0x50,
+  0x67,0x5c,0x80,0x74,0x60,0x26,0x64,0x40,0x12,0x10,0xad,0x9c,0xcd,0x94,0x1e,0xc1,
+  0xc1,0xe2,0x42,0x63,0x5e,0x8b,0xf3,0xdf,0xbc,0xda,0x53,0x37,0xc3,0x77,0x30,0x53,
+  0x29,0xd9,0x8a,0xa6,0x0c,0xda,0x0a,0x95,0x44,0x6b,0x04,0x3b,0x99,0xbe,0x67,0x57,
+  0x60,0x87,0x68,0xfd,0x0a,0xfc,0x5a,0x5e,0x51,0xe4,0x34,0xec,0xec,0xd4,0x17,0x13,
+  0xa6,0xc6,0x32,0xea,0x3a,0x17,0xe7,0x97,0x5f,0x9c,0x3a,0x76,0xf2,0x58,0x9a,0x75,
+  0x17,0xce,0x91,0x69,0x8d,0x37,0xb0,0x59,0x07,0x91,0x85,0x05,0x13,0x37,0x47,0x44,
+  0x13,0x93,0xdf,0xb9,0xaf,0x63,0xbb,0xaf,0xfb,0x8f,0xcb,0xf3,0x3f,0xfc,0x4c,0xa5,
+  0x90,0x1e,0x7c,0x34,0x77,0x17,0x28,0x5f,0x17,0xff,0xaa,0xe3,0xbe,0x5d,0xfc,0xeb,
+  0xde,0xbb,0xf7,0x2c,0xb7,0x95,0x18,0x04,0x3d,0x53,0x30,0x88,0x42,0x6b,0xae,0xd7,
+  0x59,0xd3,0x24,0xe8,0xa0,0xa3,0xe2,0x0b,0xba,0x54,0xf5,0xac,0xc7,0x0a,0x43,0xe6,
+  0x0d,0xa8,0x32,0x6d,0x99,0xb1,0x0a,0x71,0x3d,0xd8,0xd6,0x64,0xc0,0x93,0xb6,0xde,
+  0xb2,0xa4,0x9c,0x1c,0x79,0xf4,0xee,0xe4,0x1d,0x3b,0xdb,0x28,0xb6,0xd4,0xac,0x12,
+  0x5d,0x65,0xf5,0x6c,0xbf,0xa8,0xb9,0xaa,0xe3,0xe3,0xe4,0xbc,0x56,0x84,0xa2,0x13,
+  0x05,0x20,0xba,0x47,0xc5,0x30,0xc2,0x5f,0x02,0x3b,0xda,0xf1,0xde,0xb6,0xf5,0xba,
+  0xe7,0x94,0x6b,0x01,0x6b,0xaf,0x7d,0x3d,0x42,0x7e,0xfe,0x24,0xce,0xa9,0xb3,0x75,
+  0xb9,0x6d,0xff,0x54,0x00,0xec,0x18,0x42,0xb4,0x5b,0x5b,0x11,0xb0,0x59,0x53,0x59,
+  0xae,0xbb,0x37,0xb8,0xfd,0xf6,0xdd,0xe1,0x82,0x57,0x5a,0x0a,0xe7,0x04,0x0c,0x04,
+  0x81,0x98,0xc6,0xf1,0xa1,0xe3,0x74,0xf5,0xab,0xb7,0x1d,0x04,0xc9,0xa7,0x02,0x22,
+  0x45,0x05,0x44,0x0a,0xef,0x21,0x3b,0xae,0x84,0x70,0xa5,0x2f,0xb2,0x28,0x92,0x7b,
+  0x6e,0x39,0xc7,0xb8,0xd1,0xfa,0xa4,0xfb,0x24,0x7f,0xd6,0xf5,0xd2,0xa9,0xe9,0xdc,
+  0xed,0xea,0x48,0xb3,0xc8,0x3a,0xa2,0x0b,0x82,0xa4,0x19,0x03,0x76,0x74,0x77,0xf7,
+  0xe4,0xcf,0x9f,0x4e,0xbb,0xe5,0xd4,0xdb,0x2d,0xcf,0x60,0xa1,0x57,0xba,0xbb,0xfa,
+  0x11,0x16,0x3b,0x66,0x19,0x78,0xc0,0x6e,0x7f,0x0a,0xa6,0xd8,0x28,0x40,0xc9,0x99,
+  0x76,0x4f,0xb0,0xfc,0xce,0x8b,0x97,0x4e,0x44,0xc2,0xba,0xef,0x3d,0x92,0x6b,0x7f,
+  0x09,0x6b,0x5a,0x1f,0xe7,0x3c,0xf9,0x3c,0x96,0xcc,0x1b,0x60,0x5b,0x78,0x32,0xef,
+  0xe4,0xfd,0x80,0x6b,0x54,0xca,0x59,0xa6,0x03,0x4d,0x3f,0x41,0x88,0x99,0x5f,0xc8,
+  0x1b,0x9d,0x72,0x4f,0xdb,0xca,0x39,0xd6,0x2d,0x82,0xbc,0x4e,0x7a,0xc4,0x76,0xb8,
+  0x35,0xdc,0x33,0xa0,0x70,0xf9,0x81,0xce,0xf5,0xb6,0x73,0x16,0x1f,0x41,0x2a,0x25,
+  0xe6,0xda,0xe7,0x2d,0xec,0x21,0x02,0x83,0x5a,0xce,0x7e,0xa7,0xe5,0x41,0xb9,0xa6,
+  0xbe,0xf0,0x09,0x93,0x53,0xa5,0x53,0x2a,0xd7,0xce,0x39,0x4c,0x64,0x1c,0x43,0x9d,
+  0x6e,0xb5,0xdc,0x6b,0x7b,0x75,0x20,0x12,0x3c,0xcb,0x2d,0x0a,0x8b,0xa1,0xd8,0x7b,
+  0xa2,0x86,0xe5,0x4e,0x88,0x29,0x27,0x7c,0xcb,0x2f,0xf7,0x1a,0x4e,0x8b,0x2b,0x6f,
+  0xca,0x92,0x6a,0xfe,0x78,0xa9,0x99,0xc0,0xdb,0x91,0x85,0x02,0xbd,0xa6,0x57,0xc1,
+  0x90,0x62,0x17,0x8c,0x65,0xfc,0x06,0x7a,0x4d,0x05,0x03,0x73,0xcb,0x5b,0xec,0x9a,
+  0x7d,0x81,0x59,0x00,0xe1,0x63,0x31,0x9e,0x15,0x0c,0x2b,0x06,0x5a,0x3c,0x0f,0x6b,
+  0x83,0xd9,0x1f,0x50,0xea,0xff,0x05,0x3b,0x3f,0x82,0x9b,0x4d,0x12,0x04,0x01,0x39,
+  0x32,0xf7,0x60,0xd2,0xb4,0xb7,0x3d,0x1c,0x5c,0x26,0x14,0xdc,0x92,0x2f,0xc7,0x72,
+  0xe6,0x5e,0x6b,0xb7,0xaf,0xdd,0x3e,0x7c,0x64,0x7b,0x12,0x68,0x2d,0xc0,0x39,0xe6,
+  0xaa,0x0d,0x51,0x7e,0xe8,0x1c,0xe5,0x8f,0xc0,0x1f,0x67,0x51,0x0c,0x1e,0x21,0x7b,
+  0xc4,0x21,0x0d,0xf8,0xb3,0x07,0x27,0x9b,0xbd,0x02,0xe2,0x90,0x79,0xac,0xdb,0x0f,
+  0xc3,0xb9,0xb2,0xe3,0x1f,0x61,0x20,0x07,0x36,0x12,0x23,0xb0,0x8b,0x18,0xc5,0x2b,
+  0xde,0x26,0xf2,0xaf,0x0c,0x6f,0x17,0x19,0x48,0xea,0x39,0x1e,0xde,0x21,0x2a,0x7c,
+  0x81,0x4d,0x86,0x1f,0x10,0x37,0x79,0x32,0x97,0x1a,0x03,0x87,0xce,0xde,0x8f,0xb5,
+  0x39,0x6c,0xcd,0xb2,0x7a,0xde,0x91,0x12,0x34,0xde,0xa7,0x57,0xa1,0x8d,0x44,0xcf,
+  0x44,0xce,0x1d,0x96,0x37,0x3f,0xb1,0x49,0x4e,0xc6,0x2c,0x4e,0x80,0x9c,0xab,0x4e,
+  0xab,0x94,0xe8,0xe5,0x9a,0xca,0xde,0x9e,0xff,0xd7,0x9a,0xca,0x34,0xe8,0x2b,0x25,
+  0x49,0x7e,0x2f,0xc7,0xaa,0xc4,0xf6,0xe7,0xb7,0x15,0x27,0xb6,0x53,0x5d,0x81,0xd1,
+  0x23,0x1a,0xc4,0x76,0xa6,0xb7,0x83,0x0c,0xa7,0xd5,0xe2,0x0c,0xde,0x35,0x00,0x92,
+  0xa5,0xb3,0x53,0x55,0x52,0x31,0x15,0x56,0x25,0xb7,0x00,0xb4,0xab,0xf2,0xab,0x0a,
+  0xeb,0xaa,0x66,0xf3,0xfa,0xaa,0xda,0xab,0xca,0x22,0xc0,0x70,0x33,0x40,0x59,0xe5,
+  0x8a,0xaa,0xab,0x7e,0xfe,0x6b,0x6e,0x41,0xf9,0x3f,0xd0,0xb8,0xad,0x6b,0x4d,0xba,
+  0x49,0x1d,0x04,0xea,0x0e,0xef,0x77,0x38,0xe1,0x69,0xcc,0x52,0xe5,0x2a,0xef,0x11,
+  0x97,0x14,0x7c,0x94,0x77,0x61,0x5d,0x6c,0x7b,0x66,0x82,0x26,0xd9,0x58,0x2a,0xd3,
+  0xff,0x84,0xb3,0x92,0xa5,0x5e,0x35,0xd8,0xb1,0x45,0x5a,0x5c,0x40,0xaf,0x0b,0x1f,
+  0x6e,0xba,0x92,0x17,0xdd,0xda,0x35,0xf7,0x71,0x5c,0x4f,0x77,0xb8,0x8d,0xd3,0xfc,
+  0x66,0x63,0x1c,0x00,0xef,0xe6,0x46,0xbe,0x5b,0x73,0xf9,0xe1,0x65,0x9d,0xea,0xf3,
+  0xfb,0xda,0xcf,0xe7,0x16,0x9d,0x96,0xf0,0x39,0x9d,0x96,0xd0,0xe7,0x49,0xd1,0x25,
+  0xc0,0x97,0x3d,0x37,0xc4,0xed,0x0c,0x57,0x3a,0x7b,0xfa,0x45,0x53,0xa2,0xfe,0x80,
+  0x52,0x62,0x39,0xef,0x10,0xf7,0xc7,0x94,0x33,0xa4,0xcb,0x0d,0xad,0x16,0x3e,0x42,
+  0xfe,0x35,0xcd,0x67,0xf2,0xfa,0x35,0x79,0x59,0x92,0x3a,0x93,0x13,0x86,0x22,0xe3,
+  0x9e,0x41,0x90,0xcf,0xf2,0x3c,0xf2,0x74,0x1d,0xf2,0xc5,0x85,0x1e,0xf9,0x00,0x76,
+  0x8c,0x04,0x84,0x05,0x04,0x73,0x1a,0xad,0x6b,0x0a,0xbd,0x58,0x36,0x84,0x0c,0xbb,
+  0x18,0x71,0x2b,0x29,0xb3,0x3d,0x48,0x1e,0x3b,0xd4,0x4a,0xda,0x9a,0x7e,0x9b,0x3e,
+  0x9a,0xec,0x98,0x9b,0x79,0x46,0x2e,0x3c,0xba,0xc0,0x4a,0x18,0xa1,0xc2,0x58,0x1d,
+  0x1f,0xf1,0x7c,0xc2,0xe3,0x49,0x0f,0x3f,0x3c,0x92,0xaa,0x0d,0x95,0xe5,0xf9,0x51,
+  0x92,0x66,0x0d,0x71,0x97,0x33,0x61,0xd3,0xc9,0x54,0xfe,0xff,0x24,0x05,0xe5,0xed,
+  0x94,0x2d,0x9b,0x38,0x27,0x97,0xef,0x10,0xe0,0x03,0x67,0x0f,0xf8,0x0c,0x68,0xf2,
+  0xeb,0xe7,0xb3,0x23,0x39,0x49,0x20,0x93,0xc1,0xbf,0xb7,0xde,0xb3,0x44,0x07,0xe3,
+  0xf4,0x9b,0x79,0x1f,0xb7,0xdf,0xd4,0xff,0x0e,0xab,0xdf,0x34,0xff,0x60,0xf2,0xbf,
+  0x5a,0xf1,0xb0,0x73,0x48,0x29,0x00,0x00,
+};
+
+// ota.html: 4987 B -> 2071 B gzip
+static const char OTA_HTML_ETAG[] = "\"103202b87bacdf06\"";
+static const size_t OTA_HTML_GZ_LEN = 2071;
+static const uint8_t OTA_HTML_GZ[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xb5,0x58,0x6d,0x73,0xdb,0xb8,
+  0x11,0xfe,0xae,0x5f,0x81,0xd0,0x93,0x23,0x79,0x96,0xa8,0x97,0xd8,0x6e,0x43,0x89,
+  0xca,0xdc,0x25,0xce,0xe4,0x3a,0xc9,0x25,0x4d,0x9c,0x69,0x3b,0xd7,0x7c,0x00,0x49,
+  0x50,0x42,0x4c,0x11,0x0c,0x00,0x5a,0xd6,0xe9,0xf4,0xdf,0xbb,0x0b,0x80,0x7a,0x4b,
+  0x22,0xb7,0x9d,0x76,0x32,0xb1,0x49,0x60,0xf7,0x59,0xec,0xcb,0xb3,0x58,0x7a,0xf2,
+  0xe8,0xc5,0xdb,0xe7,0x37,0xff,0x78,0x77,0x4d,0xe6,0x7a,0x51,0x4e,0x27,0xee,0x27,
+  0xa3,0xf9,0xb4,0x33,0x59,0x30,0x4d,0x49,0x45,0x17,0x2c,0xf1,0xee,0x38,0x5b,0xd6,
+  0x42,0x6a,0x8f,0x64,0xa2,0xd2,0xac,0xd2,0x89,0xb7,0xe4,0xb9,0x9e,0x27,0x39,0xbb,
+  0xe3,0x19,0xeb,0x99,0x97,0x2e,0xaf,0xb8,0xe6,0xb4,0xec,0xa9,0x8c,0x96,0x2c,0x19,
+  0x7a,0x80,0xa1,0xb9,0x2e,0xd9,0xf4,0x66,0x55,0x33,0xf2,0x82,0xbc,0xbd,0xf9,0x69,
+  0xd2,0xb7,0x2b,0x9d,0x89,0xd2,0x2b,0xfc,0x9d,0x8a,0x7c,0xb5,0x4e,0x69,0x76,0x3b,
+  0x93,0xa2,0xa9,0xf2,0xf8,0x6c,0x38,0x1c,0x8e,0x33,0x51,0x0a,0x19,0x9f,0x5d,0x5f,
+  0x5f,0x8f,0x0b,0xb0,0xd7,0x2b,0xe8,0x82,0x97,0xab,0x58,0xd1,0x4a,0xf5,0x14,0x93,
+  0xbc,0x18,0x2f,0xa8,0x9c,0xf1,0x2a,0x1e,0x5d,0xd4,0xf7,0x9b,0x4e,0x94,0x51,0x99,
+  0xaf,0x17,0xf4,0xde,0x9e,0x23,0xbe,0x18,0x0d,0xea,0xfb,0x56,0x84,0x36,0x5a,0x8c,
+  0x0f,0x0c,0x50,0xfc,0x37,0x4e,0x85,0xcc,0x99,0x8c,0x87,0xf5,0x3d,0x51,0xa2,0xe4,
+  0x39,0x39,0x7b,0xf2,0xe4,0x89,0x5b,0xed,0x49,0x9a,0xf3,0x46,0xc5,0x43,0xc4,0xa9,
+  0x69,0x9e,0xf3,0x6a,0x16,0x0f,0x8d,0xad,0xb4,0xd1,0x5a,0x54,0xe0,0x6a,0xdd,0xe8,
+  0xdf,0x34,0xf8,0x95,0xa8,0x26,0x5d,0x70,0xfd,0xe9,0xc0,0x89,0xd1,0xd3,0xa7,0x74,
+  0x94,0xb5,0x7e,0x14,0x45,0xd1,0x9a,0x1b,0x1c,0x59,0xb8,0xda,0x33,0x10,0x5d,0xb1,
+  0x05,0x19,0xb2,0xc5,0xa6,0xb3,0x87,0x5e,0xf0,0x92,0x7d,0x5a,0x5b,0xbf,0x86,0x83,
+  0xc1,0xe3,0xd6,0x2d,0x23,0x3c,0x38,0x10,0xd5,0xec,0x5e,0x1f,0x88,0xa6,0xe2,0xbe,
+  0xa7,0xf8,0xef,0x88,0xed,0xac,0xc2,0xca,0x16,0xe0,0x02,0x01,0x76,0xc6,0x2f,0xd0,
+  0x70,0x24,0xc5,0x72,0x9d,0x73,0x55,0x97,0x74,0x15,0x17,0x25,0xbb,0x1f,0xcf,0x68,
+  0x1d,0x47,0x97,0xb0,0x87,0x5b,0xd3,0x1f,0xd7,0xb8,0x18,0x0f,0x41,0x32,0xa7,0xd5,
+  0x8c,0xc9,0x03,0xaf,0xe9,0x68,0xb4,0xe9,0xa8,0x05,0x2d,0xcb,0xb5,0xa8,0x69,0xc6,
+  0xf5,0x2a,0x8e,0xfe,0x74,0xb9,0xe9,0xd0,0xb5,0x0b,0xc4,0x9f,0x69,0x06,0xb1,0xd8,
+  0x74,0x6a,0x29,0x66,0x92,0x29,0xb5,0x7f,0xd8,0x39,0xe3,0xb3,0xb9,0x8e,0x87,0x18,
+  0x11,0x5a,0xd7,0x8c,0x4a,0x5a,0x65,0x2c,0xae,0x44,0xc5,0xc6,0xbd,0x25,0x4b,0x6f,
+  0xb9,0xee,0x1d,0xaf,0x1f,0x84,0x7c,0x34,0xfa,0x46,0x4e,0x2f,0x2e,0x2e,0xbe,0x8e,
+  0xf8,0xa6,0x73,0x96,0x52,0xb9,0x94,0xb4,0x5e,0x1f,0x45,0xf3,0x4c,0xdc,0xb6,0x67,
+  0xbd,0x2c,0xf2,0x27,0x97,0x70,0xd6,0x33,0x26,0xe5,0x7a,0x9b,0xc8,0xab,0xf4,0x2a,
+  0xdd,0x74,0x26,0x7d,0x5b,0xbd,0x93,0xbe,0xa1,0xca,0x04,0x8b,0x18,0x4a,0x3a,0xe7,
+  0x77,0x24,0x2b,0xa9,0x52,0x89,0x87,0x15,0x09,0xf5,0x4f,0xc8,0x64,0x3e,0x9a,0x42,
+  0xdd,0x93,0x8f,0x75,0x4e,0x35,0x03,0x85,0x91,0x59,0x2d,0x84,0x5c,0x10,0x9e,0x27,
+  0x5e,0x61,0xa4,0x60,0xc5,0x24,0x92,0x98,0x44,0x7a,0x98,0x74,0xcf,0x51,0xaf,0xe0,
+  0x72,0xb1,0xa4,0x12,0xde,0x8d,0xf8,0xd2,0x23,0x34,0xcb,0x58,0x0d,0x0c,0x8c,0x52,
+  0x5e,0x75,0xf1,0x47,0x34,0xfb,0xdd,0x23,0x92,0x7d,0x69,0xb8,0x64,0xf9,0x37,0xe0,
+  0xb0,0x30,0xac,0xba,0x9a,0x53,0x8f,0x40,0x72,0x33,0x36,0x17,0x25,0x04,0x25,0xf1,
+  0x3e,0xbc,0xfa,0xa9,0x37,0xba,0xbc,0x22,0x81,0xa8,0x35,0x17,0x15,0x2d,0xbb,0xe4,
+  0x0e,0x19,0xc6,0x59,0x4e,0x52,0x06,0xc7,0x64,0x40,0xf9,0x05,0x14,0x78,0xd8,0x1e,
+  0x14,0xbd,0x44,0x2c,0x17,0x42,0x8f,0x98,0x58,0x24,0x5e,0x5b,0x36,0x98,0x19,0x27,
+  0x0b,0xd2,0x6d,0xaa,0x8d,0x4a,0x9d,0x7a,0x04,0x68,0x9a,0x78,0x90,0x71,0x8f,0xdc,
+  0xd1,0xb2,0x01,0xbd,0x81,0x07,0x71,0x6c,0xc5,0xb6,0x7a,0xad,0x95,0x3a,0xd3,0xde,
+  0x74,0xf0,0x78,0xd2,0x87,0x05,0x77,0x80,0xbd,0xc7,0xbd,0x88,0x43,0x79,0xee,0xac,
+  0xee,0x7b,0x6f,0xf9,0xb9,0x35,0xf7,0xb1,0x2e,0x05,0xcd,0xc9,0x0f,0xe4,0x25,0xe8,
+  0xcd,0x77,0x2a,0x96,0xd8,0x4e,0xc7,0xbe,0x78,0x44,0x54,0x59,0xc9,0xb3,0x5b,0x40,
+  0x67,0xa9,0x10,0x3a,0x08,0xbd,0xd6,0x9c,0x2d,0x7f,0x6f,0xfa,0xde,0x6c,0x4c,0xfa,
+  0x56,0xe3,0xe8,0x84,0x93,0x3e,0xe6,0xb9,0x2d,0x83,0x97,0x52,0x2c,0xc8,0xc7,0xf7,
+  0xaf,0xbf,0x2e,0x82,0xc6,0x3b,0x99,0xb5,0x46,0x96,0x47,0x59,0x9b,0x6b,0x5d,0x07,
+  0x2a,0x8c,0xfb,0xfd,0xb9,0x50,0xba,0xdf,0xd6,0x08,0x16,0xc3,0x03,0x50,0x27,0x2a,
+  0xa0,0xad,0xa0,0xf0,0x5b,0x10,0x47,0x51,0x7c,0x21,0x96,0xd5,0x57,0x71,0xdc,0x73,
+  0xb7,0x4d,0x9f,0xc2,0xe4,0xb6,0xd1,0x30,0xad,0x61,0xfa,0xa1,0x81,0xfa,0x55,0xea,
+  0xd1,0xa3,0x47,0xc4,0x06,0x0f,0xda,0x4f,0x04,0x8c,0x32,0x9b,0x28,0x56,0x4f,0x27,
+  0x94,0xcc,0x25,0x2b,0x12,0xaf,0x0f,0xea,0x3d,0xf2,0x33,0xd0,0x9c,0x68,0x41,0x3e,
+  0x30,0xdd,0xd4,0x93,0x3e,0xc5,0x7a,0x01,0xba,0x59,0xdc,0x89,0xca,0x24,0xaf,0xf5,
+  0xb4,0x03,0x37,0x93,0xd2,0x44,0x91,0x84,0xe4,0x22,0x6b,0x16,0x70,0x49,0x45,0x33,
+  0xa6,0xaf,0x4b,0x86,0x8f,0x3f,0xaf,0x7e,0xc9,0x03,0x5f,0xf9,0xe1,0xd8,0xc9,0xd5,
+  0xe9,0x29,0xc1,0x3a,0xdd,0x93,0xcc,0xf4,0x49,0xd1,0x4c,0xef,0x64,0x1d,0x27,0x4e,
+  0xc9,0x3b,0x11,0xd4,0xe9,0x14,0x4d,0x95,0x21,0xeb,0x08,0x64,0xe5,0xaf,0x01,0xcf,
+  0xc3,0x35,0xf8,0x6f,0x91,0xee,0x4e,0x60,0x80,0x60,0x64,0xf2,0x10,0x69,0xc9,0x17,
+  0x01,0x20,0x11,0xa0,0xbf,0x6e,0x64,0x05,0x6a,0xcf,0x08,0xf8,0x39,0xa7,0x90,0xd1,
+  0xc4,0x27,0xe7,0x84,0x55,0x99,0xc8,0xd9,0xc7,0xf7,0xbf,0x3c,0x17,0x8b,0x1a,0x98,
+  0x59,0xe9,0xe0,0x2e,0x0c,0x49,0x4c,0x7c,0x7f,0xdc,0xd9,0x74,0x3a,0xfd,0x3e,0x96,
+  0x24,0xa9,0x9b,0xb2,0x54,0xc4,0x56,0x39,0x41,0x1a,0x40,0x3b,0x96,0x04,0x92,0x3c,
+  0x26,0x8d,0x21,0x8c,0x22,0x54,0xdd,0x12,0xc8,0x2f,0xe1,0x28,0x90,0x31,0x52,0x60,
+  0xde,0x59,0xbe,0x73,0xa2,0x16,0x65,0x19,0x58,0x69,0xe3,0x48,0xc1,0x74,0x36,0x0f,
+  0xfc,0xbe,0xd0,0x14,0xfa,0x25,0xd5,0x0d,0x84,0x3f,0x02,0xe0,0x2a,0x90,0xc9,0x54,
+  0x46,0x9f,0x95,0xa8,0x82,0xd0,0xad,0x7c,0x4e,0xa6,0x6b,0x53,0x74,0x2e,0xe6,0xe0,
+  0xfd,0xe7,0x48,0x83,0x66,0x09,0x0e,0xbd,0xa1,0x7a,0x1e,0x2d,0x78,0x15,0x40,0xdb,
+  0xe8,0xda,0x37,0xd3,0xf4,0x83,0xcf,0x51,0xba,0xd2,0x4c,0xfd,0x08,0xeb,0x7d,0x27,
+  0x6e,0x7c,0x1b,0x8c,0x0d,0x56,0x9d,0xda,0x30,0x01,0x58,0x3d,0xc6,0x3c,0x46,0x48,
+  0x84,0xe7,0x76,0x82,0x39,0xb0,0x10,0xd4,0x10,0x2a,0xff,0xb1,0x8f,0xca,0x2d,0x2a,
+  0xae,0x10,0xf3,0xe4,0x87,0x16,0x8f,0x17,0xb8,0x89,0xae,0x00,0x64,0x92,0x10,0x3f,
+  0x87,0x80,0x82,0xce,0xda,0xf5,0x10,0x15,0xf1,0xaa,0x62,0xf2,0xd5,0xcd,0x9b,0xd7,
+  0x80,0xee,0x4f,0x54,0x4d,0x2b,0xc3,0x02,0x71,0xeb,0x4d,0x5f,0xda,0x70,0x41,0x76,
+  0xce,0x9d,0x81,0x73,0x07,0xdf,0x25,0x36,0x5f,0x04,0x77,0xec,0xe3,0x39,0x44,0x6a,
+  0x8f,0x1d,0x11,0xf2,0x03,0xc0,0xa6,0xfe,0xd8,0x99,0xc2,0xa3,0xb8,0x50,0x13,0xc5,
+  0xf4,0x0d,0x5f,0x30,0xd1,0xe8,0x20,0x08,0x21,0xb2,0xae,0x55,0x75,0xc9,0x68,0x30,
+  0x18,0x84,0x63,0xc2,0x4a,0xc5,0x8e,0x85,0x4a,0x91,0x51,0x4c,0x5a,0x24,0x19,0x82,
+  0xa0,0xf4,0x95,0x91,0x76,0xf8,0xb6,0x9c,0xec,0xdb,0xe6,0xdb,0xce,0x17,0x14,0x6e,
+  0xa9,0x1c,0xdd,0xff,0xbe,0xe3,0x70,0x77,0x7a,0x53,0x7b,0xf5,0x11,0x2b,0x1f,0x1b,
+  0x2f,0x61,0x5d,0xc8,0x73,0x7f,0xeb,0x55,0x6b,0xcf,0xd9,0x3a,0x3a,0xec,0x7e,0x61,
+  0x75,0xc9,0xa5,0x3b,0xe6,0x26,0x84,0xb9,0x0f,0x2b,0x0c,0x45,0x4e,0x6a,0x0c,0xd1,
+  0xb3,0xd0,0x94,0xfb,0x77,0x69,0xd9,0x40,0xc4,0x61,0x14,0xba,0xbe,0x83,0x95,0xd7,
+  0x5c,0x41,0x85,0x30,0x09,0x44,0x32,0x5d,0xcf,0xef,0x92,0x80,0x85,0xb6,0x42,0x59,
+  0x54,0x4b,0x86,0x42,0x2f,0x58,0x41,0x9b,0x52,0x5b,0xf6,0xd9,0xaa,0x85,0x3e,0x7d,
+  0x8a,0xf9,0xb0,0xed,0x7f,0x4d,0x5c,0x5e,0x04,0x8f,0x60,0x27,0x7c,0x28,0x8a,0xd7,
+  0x50,0xb5,0x92,0x50,0xc3,0x56,0xe8,0xf7,0x4a,0x47,0xdf,0x8e,0x1e,0xe2,0x99,0x76,
+  0xe2,0x63,0xaf,0xf7,0xc3,0x7f,0x13,0x18,0x58,0x48,0xf8,0x82,0xce,0xd8,0x3f,0x7d,
+  0x45,0xdc,0x95,0xf0,0x1d,0x0b,0xd6,0xd9,0x2f,0x08,0x05,0x07,0xff,0x5e,0x97,0x41,
+  0x9f,0x90,0x42,0x3f,0xe0,0xfe,0xfe,0x81,0xd0,0x69,0xd7,0x04,0x23,0x33,0x3a,0x44,
+  0x6e,0x72,0x48,0xfc,0x14,0xca,0xf2,0x16,0xac,0xb5,0xc4,0x4d,0x06,0x5f,0xd1,0x36,
+  0xf1,0x07,0x8f,0x0d,0x0b,0xd4,0xe1,0x6a,0x7b,0x21,0x59,0xba,0x18,0x89,0xfd,0xfe,
+  0x83,0xb1,0xef,0x92,0x35,0x7c,0xd2,0xcc,0x45,0x1e,0xfb,0xef,0xde,0x7e,0xb8,0x81,
+  0x77,0x9c,0xde,0x98,0x54,0xf1,0xda,0x77,0x38,0x3d,0xfc,0x52,0xf1,0x63,0x1f,0x06,
+  0x4d,0xb8,0xf7,0x0d,0x43,0xfa,0xf0,0x55,0xb1,0x5c,0xf6,0xf0,0x66,0xeb,0x01,0x8a,
+  0xf5,0x34,0xf7,0x37,0x5d,0x82,0x53,0x5f,0xfc,0x65,0x13,0x9a,0x92,0xdd,0x36,0xb6,
+  0xb5,0x61,0x8a,0x8c,0xc4,0x6d,0x68,0x3b,0x62,0x41,0x81,0x7f,0x2d,0x0d,0xa5,0x39,
+  0x75,0xe0,0xba,0x9e,0x46,0xf1,0xd3,0xd9,0x79,0x2e,0x9a,0x32,0x27,0x15,0x74,0x65,
+  0xa0,0x9e,0xd4,0x48,0x9f,0x40,0x47,0xe6,0x59,0xfd,0x8d,0x6b,0xf0,0x6f,0x0d,0x14,
+  0x7c,0x46,0xfc,0xb4,0x51,0x2b,0x1f,0xda,0x97,0x0e,0xcf,0xfd,0xbd,0xc4,0x6d,0x42,
+  0xfc,0x6f,0x8f,0xb8,0xa3,0xcb,0x43,0x56,0x7f,0x65,0x7a,0x29,0xe4,0x2d,0x31,0x3c,
+  0x3d,0x44,0xeb,0x6c,0x0e,0x6e,0xae,0xb6,0xdb,0xac,0x8f,0x53,0x82,0xa8,0xfb,0x1d,
+  0xec,0x20,0x25,0x56,0xcb,0xef,0x1e,0x26,0xe4,0x80,0xd1,0x96,0xe4,0x0f,0xb7,0xad,
+  0x91,0xed,0x07,0xa7,0xb8,0x5d,0xfc,0x0f,0xb8,0x8d,0x23,0xf9,0x29,0x72,0x17,0x4b,
+  0x30,0x82,0x42,0xea,0xb7,0xc1,0xa7,0x96,0xd7,0xf8,0xfe,0x20,0xff,0x9e,0xcf,0x85,
+  0x80,0xca,0xa0,0xd6,0xc4,0xf7,0xa9,0xfd,0x7f,0xa1,0x8d,0x9d,0x86,0xb7,0x19,0xda,
+  0xb9,0x9b,0xc3,0x49,0x2b,0xb6,0x24,0x2f,0xa1,0xee,0x5f,0x50,0x4d,0x21,0x16,0xb0,
+  0x18,0xe1,0x17,0x58,0x85,0xee,0xba,0x89,0x13,0xc2,0x67,0x9c,0xdc,0x05,0xea,0x7e,
+  0x2e,0x9d,0xea,0xdf,0xdf,0xbc,0x7e,0x05,0x73,0xea,0x7b,0x18,0x2b,0x99,0x72,0xc1,
+  0x84,0xdd,0x48,0x00,0x44,0xe0,0x28,0x68,0xd8,0x89,0x1d,0x22,0xb0,0x2d,0xc2,0x74,
+  0x08,0x2c,0xe7,0x67,0xbb,0xb6,0x61,0xd7,0x70,0x62,0xc1,0x26,0xee,0x40,0x6c,0x73,
+  0x8f,0x44,0xb5,0xfd,0xc0,0x48,0x20,0x91,0x77,0x61,0x3b,0x47,0x40,0xf8,0xd9,0x5d,
+  0x04,0x74,0x9d,0xe9,0x39,0x36,0xa5,0x46,0xd3,0x14,0x93,0xe1,0xee,0xb7,0xdd,0x98,
+  0xb1,0x37,0x4e,0x18,0x0d,0x40,0x65,0x79,0x1f,0x9e,0xec,0x38,0x81,0xb3,0xc5,0xf6,
+  0x56,0x7c,0x68,0xa0,0x70,0x53,0xc4,0xee,0xda,0xdc,0x98,0xf3,0xc2,0x8c,0x35,0x1a,
+  0x8c,0xe2,0x5d,0x8f,0x25,0x1c,0xbe,0x87,0x20,0xa9,0x66,0x84,0x82,0xe0,0x43,0x0c,
+  0x2b,0x0e,0xd3,0x01,0xae,0x1a,0xa9,0xdd,0x87,0x6d,0x1b,0x33,0x3b,0x6d,0x83,0x8f,
+  0x7b,0x1e,0x92,0x00,0xb7,0xec,0x68,0x65,0xee,0x64,0xb0,0x62,0xaf,0xe3,0x23,0x1e,
+  0xbe,0x74,0x76,0x4c,0x92,0x6d,0x57,0xd2,0xb2,0xc1,0xa6,0x74,0x78,0xef,0x96,0x4c,
+  0x93,0xe5,0x7c,0x05,0x2a,0x08,0x0c,0x51,0x85,0x5e,0xae,0xd8,0x0d,0x80,0x91,0x3f,
+  0xfe,0x80,0xc9,0xe5,0xd5,0xcd,0xcd,0x3b,0x82,0x89,0xd9,0xd9,0x75,0xb1,0xd1,0x72,
+  0x05,0x86,0x6d,0x54,0x3f,0x83,0xfe,0x5f,0x3e,0xbc,0xfd,0x35,0xaa,0xa9,0x54,0x2c,
+  0x00,0x40,0x30,0x64,0x61,0xdd,0xcd,0x6f,0xd0,0x8e,0xce,0x7e,0x31,0x78,0xba,0xdf,
+  0xc6,0xdc,0xa8,0x81,0xdd,0x8b,0xd8,0xa6,0x00,0xc9,0x73,0xd3,0xc1,0x7f,0x34,0x6d,
+  0xc0,0x69,0xd1,0x36,0x24,0xe6,0x60,0x88,0xda,0x6c,0x2b,0x09,0xae,0x2b,0x73,0x26,
+  0x17,0xdb,0xff,0xb6,0x33,0x6e,0xf1,0x14,0x12,0xa4,0xc8,0x5d,0xa7,0x04,0x09,0xf7,
+  0x7d,0x02,0xdf,0x88,0xf8,0x67,0x02,0xf8,0xfa,0xc3,0x3f,0xb2,0x75,0xfe,0x05,0x7c,
+  0x6f,0x2e,0xea,0x7b,0x13,0x00,0x00,
+};
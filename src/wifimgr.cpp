@@ -1,14 +1,25 @@
 #include "wifimgr.h"
 #include <WiFi.h>
 #include <ESPAsyncWebServer.h>
-#include <Preferences.h>
+#include "settings.h"
 #include <DNSServer.h>
 #include "led_stat.h"
+#include "weather.h"
+#include "metrics.h"
+#include "display.h"
+#include "panel.h"       // TYPED_PANEL_* build flags
+#include "udp_typed.h"
+#include "telemetry.h"
+#include "web_assets.h"   // generated: python web/build_web_assets.py
 #include <vector>
+#include <algorithm>   // std::sort (scan cache)
 #include "esp_wifi.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include <math.h>        // isnan()
-#include <HTTPClient.h>  // for /weather/autoloc
-#include <Update.h>      // OTA
+#include "ota_mgr.h"      // OTA
+#include "live.h"         // /live (SSE)
+#include "history.h"      // /history
 
 // ===== Server (shared) =====
 static AsyncWebServer server(80);
@@ -16,133 +27,204 @@ static AsyncWebServer server(80);
 namespace WiFiMgr {
 
 static String ssid, password;
-static Preferences prefs;           // used for wifi creds, weather config, and UI/display
 static DNSServer dnsServer;
-static std::vector<String> lastScanResults;
+
+// ===== Scan cache =====
+// Async scans run from loop(): every SCAN_EVERY_MS while the portal is up,
+// or when /scan finds the cache stale. One entry per SSID (strongest BSS),
+// strongest first; /scan only ever reads the cache. loop() swaps a new
+// result in while /scan (async_tcp task) may be walking it, hence ScanLock.
+struct ScanEntry { String ssid; int8_t rssi; uint8_t channel; bool open; };
+static std::vector<ScanEntry> scanCache;
+static SemaphoreHandle_t scanMtx = nullptr;
+static portMUX_TYPE      scanInitMux = portMUX_INITIALIZER_UNLOCKED;
+
+struct ScanLock {
+  ScanLock() {
+    if (!scanMtx) {
+      SemaphoreHandle_t m = xSemaphoreCreateMutex();
+      portENTER_CRITICAL(&scanInitMux);
+      if (!scanMtx) { scanMtx = m; m = nullptr; }
+      portEXIT_CRITICAL(&scanInitMux);
+      if (m) vSemaphoreDelete(m);
+    }
+    xSemaphoreTake(scanMtx, portMAX_DELAY);
+  }
+  ~ScanLock() { xSemaphoreGive(scanMtx); }
+};
+static uint32_t scanAt = 0;                   // millis() of the cached result (0 = none)
+static bool     scanBusy = false;
+static volatile bool scanWanted = false;
+static const uint32_t SCAN_EVERY_MS   = 15000;
+static const uint32_t SCAN_DWELL_MS   = 120;  // per channel; short so the AP isn't starved
 
 enum class State { IDLE, CONNECTING, CONNECTED, PORTAL };
 static State state = State::PORTAL;
 
 static int connectAttempts = 0;
 static const int maxAttempts = 10;
-static unsigned long lastAttempt = 0;
+static unsigned long nextAttemptAt = 0;
 static unsigned long retryDelay = 3000;
 
+// ===== Link events =====
+// The WiFi event task only records the newest edge; loop() acts on it.
+// Reconnects are ours (auto-reconnect is off), so our own disconnects
+// (ASSOC_LEAVE) are not treated as failed attempts.
+static volatile int8_t evLink = 0;           // +1 got IP, -1 lost, 0 nothing new
+static volatile bool   evAttemptFailed = false;
+static bool linkUp = false;
+static const uint8_t MAX_LINK_CBS = 4;
+static LinkCallback linkCbs[MAX_LINK_CBS];
+static uint8_t nLinkCbs = 0;
+static const unsigned long RETRY_AFTER_FAIL_MS = 500;
+static const uint8_t REASON_ASSOC_LEAVE = 8;
+
+// ===== Fast connect =====
+// BSSID + channel of the last good association skip the scan on the first
+// attempt after boot or a drop; that attempt gets FAST_CONNECT_MS before we
+// fall back to a normal scan. With WIFI_FAST_STATIC_IP the last DHCP lease
+// is reused as a static config on that attempt too (skips DHCP; only safe
+// where the router pins the address).
+#ifndef WIFI_FAST_STATIC_IP
+#define WIFI_FAST_STATIC_IP 0
+#endif
+struct FastConnect { uint8_t bssid[6]; uint8_t channel; uint32_t ip, gw, mask, dns; };
+static FastConnect fc = {};
+static bool fcValid = false;
+static bool fcAttempt = false;               // the attempt in flight uses the cache
+static const unsigned long FAST_CONNECT_MS = 1500;
+
+static unsigned long rebootAt = 0;            // deferred ESP.restart() (lets the reply flush)
+static const uint32_t AUTOLOC_FRESH_MS = 10 * 60 * 1000UL;   // /weather/autoloc reuses a lookup this new
+
+static void startConnect();
+static void scanJson(String& json);
+
+// JSON string body: quote and backslash escaped, control characters as \u00XX
+static void jsonEscape(String& out, const char* s) {
+  for (; *s; ++s) {
+    const uint8_t c = (uint8_t)*s;
+    if (c == '"' || c == '\\') { out += '\\'; out += (char)c; }
+    else if (c < 0x20) {
+      char u[7];
+      snprintf(u, sizeof(u), "\\u%04X", c);
+      out += u;
+    }
+    else out += (char)c;
+  }
+}
+
 AsyncWebServer& getServer() { return server; }
 
 // ===== NEW: Display selection (persisted) =====
 static String dispMode = "ssd1309";   // "ssd1309" (default) or "us2066"
 
 static void loadDisplayPref() {
-  prefs.begin("ui", true);
-  dispMode = prefs.getString("display", "ssd1309");
-  prefs.end();
+  dispMode = Settings::getString("ui", "display", "ssd1309");
   if (dispMode != "us2066") dispMode = "ssd1309"; // clamp to known values
 }
 static void saveDisplayPref(const String& m) {
   String v = (m == "us2066") ? "us2066" : "ssd1309";
-  prefs.begin("ui", false);
-  prefs.putString("display", v);
-  prefs.end();
+  Settings::putString("ui", "display", v);
   dispMode = v;
 }
 // Public helpers (declare in .h)
 String getDisplay() { return dispMode; }
 bool   isUS2066Selected() { return dispMode == "us2066"; }
 
-// ===== OTA HTML (progress + client-driven reboot) =====
-static const char OTA_PAGE[] PROGMEM = R"html(
-<!DOCTYPE html><html><head>
-<meta name="viewport" content="width=device-width,initial-scale=1">
-<title>Type D OTA</title>
-<style>
-body{background:#111;color:#EEE;font-family:sans-serif;margin:24px}
-.card{max-width:420px;margin:auto;background:#1a1a1a;border:1px solid #333;border-radius:10px;padding:14px}
-button,input[type=submit]{background:#299a2c;color:#fff;border:0;border-radius:6px;padding:.6em 1em}
-input[type=file]{width:100%;margin:.6em 0}
-.row{display:flex;gap:.5em}.row>*{flex:1}
-.danger{background:#a22}
-small{opacity:.75}
-a{color:#8acfff}
-progress{width:100%;height:16px;appearance:none;-webkit-appearance:none;background:#222;border:1px solid #444;border-radius:6px}
-#barwrap{margin:.6em 0}
-#ok{color:#5fd35f}
-#err{color:#ff6b6b}
-</style></head><body>
-<div class="card">
-  <h2>OTA Update</h2>
-  <form id="f">
-    <input type="file" name="firmware" id="fw" accept=".bin,.bin.gz" required>
-    <div id="barwrap" style="display:none">
-      <progress id="pb" max="100" value="0"></progress>
-      <div id="pct">0%</div>
-    </div>
-    <div class="row">
-      <input type="submit" value="Upload & Flash">
-      <button type="button" onclick="reboot()" class="danger">Reboot</button>
-    </div>
-  </form>
-  <div id="s"></div>
-  <small>Success!!! Rebooting.</small>
-  <p><a href="/"><- Back to Setup</a></p>
-</div>
-<script>
-const s = document.getElementById('s');
-const pb = document.getElementById('pb');
-const pct = document.getElementById('pct');
-const barwrap = document.getElementById('barwrap');
-
-function reboot(){
-  s.textContent = 'Rebooting...';
-  fetch('/reboot',{method:'POST'}).catch(()=>0);
-  setTimeout(()=>location.reload(), 2500);
-}
-
-document.getElementById('f').addEventListener('submit', (e)=>{
-  e.preventDefault();
-  const file = document.getElementById('fw').files[0];
-  if(!file){ s.innerHTML = '<span id="err">Choose a file first.</span>'; return; }
-
-  barwrap.style.display='block'; pb.value=0; pct.textContent='0%';
-  s.textContent='Uploading...';
-
-  const fd = new FormData(); fd.append('firmware', file);
-  const xhr = new XMLHttpRequest();
-  xhr.open('POST','/ota');
-
-  xhr.upload.onprogress = (ev)=>{
-    if(ev.lengthComputable){
-      const p = Math.round((ev.loaded/ev.total)*100);
-      pb.value = p; pct.textContent = p + '%';
-    }
-  };
+// ===== Power profile (persisted with the display choice) =====
+static PowerProfile powerProfile = PowerProfile::LowLatency;
+static const uint32_t POWER_IDLE_MS  = 30000;  // no telemetry this long = idle
+static const uint32_t POWER_CHECK_MS = 1000;
+static uint32_t powerCheckedAt = 0;
+static int8_t   powerApplied = -1;             // applied sleep level, -1 = none yet
 
-  xhr.onload = ()=>{
-    try {
-      const j = JSON.parse(xhr.responseText||'{}');
-      if (xhr.status === 200 && j.ok) {
-        s.innerHTML = '<span id="ok">Update uploaded successfully ('+(j.bytes||0)+' bytes). Rebooting in 2s...</span>';
-        setTimeout(()=>reboot(), 2000);
-      } else {
-        s.innerHTML = '<span id="err">Update failed.</span>';
-      }
-    } catch(e){
-      if (xhr.status === 200) {
-        s.innerHTML = '<span id="ok">Update uploaded. Rebooting in 2s...</span>';
-        setTimeout(()=>reboot(), 2000);
-      } else {
-        s.innerHTML = '<span id="err">Upload error.</span>';
-      }
-    }
-  };
+static const char* powerName(PowerProfile p) {
+  return p == PowerProfile::Battery ? "battery" : p == PowerProfile::Balanced ? "balanced" : "latency";
+}
+static PowerProfile powerFromName(const String& v) {
+  if (v == "battery")  return PowerProfile::Battery;
+  if (v == "balanced") return PowerProfile::Balanced;
+  return PowerProfile::LowLatency;
+}
+static void loadPowerPref() {
+  powerProfile = powerFromName(Settings::getString("ui", "power", "latency"));
+}
+static void savePowerPref(const String& v) {
+  powerProfile = powerFromName(v);
+  Settings::putString("ui", "power", powerName(powerProfile));
+  powerApplied = -1;                           // re-apply on the next check
+}
+PowerProfile getPowerProfile() { return powerProfile; }
 
-  xhr.onerror = ()=>{ s.innerHTML = '<span id="err">Network error.</span>'; };
+// ===== Display bus (persisted; applies on the next boot) =====
+static DisplayBus displayBus = DisplayBus::Auto;
 
-  xhr.send(fd);
-});
-</script>
-</body></html>
-)html";
+static const char* busName(DisplayBus b) {
+  return b == DisplayBus::Shared ? "shared" : b == DisplayBus::Separate ? "separate" : "auto";
+}
+static DisplayBus busFromName(const String& v) {
+  if (v == "shared")   return DisplayBus::Shared;
+  if (v == "separate") return DisplayBus::Separate;
+  return DisplayBus::Auto;
+}
+static void loadBusPref() {
+  displayBus = busFromName(Settings::getString("ui", "bus", "auto"));
+}
+static void saveBusPref(const String& v) {
+  displayBus = busFromName(v);
+  Settings::putString("ui", "bus", busName(displayBus));
+}
+
+// ===== Console pin (persisted; "" = rotate through live consoles) =====
+static void loadConsolePref() {
+  IPAddress ip;
+  const String v = Settings::getString("ui", "console");
+  Telemetry::setPinned(v.length() && ip.fromString(v) ? (uint32_t)ip : 0);
+}
+static void saveConsolePref(const String& v) {
+  IPAddress ip;
+  const bool pin = v.length() && v != "auto" && ip.fromString(v);
+  Telemetry::setPinned(pin ? (uint32_t)ip : 0);
+  if (pin) Settings::putString("ui", "console", ip.toString());
+  else     Settings::remove("ui", "console");
+}
+DisplayBus getDisplayBus() { return displayBus; }
+
+// Sleep level = profile, one deeper while idle (capped at max modem).
+static void applyPower(bool idle) {
+  static const wifi_ps_type_t PS[3] = { WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM };
+  static const int8_t         TX[3] = { 78, 60, 44 };   // 0.25 dBm: 19.5 / 15 / 11 dBm
+  const uint8_t p = (uint8_t)powerProfile;
+  // modem sleep needs STA-only: LowLatency keeps its AP, so it only takes
+  // the idle step once the AP is down
+  const bool lowLat = powerProfile == PowerProfile::LowLatency;
+  const bool step = idle && (!lowLat || WiFi.getMode() == WIFI_STA);
+  const int8_t level = (int8_t)min<uint8_t>(2, p + (step ? 1 : 0));
+  if (level == powerApplied) return;
+  // the AP is not needed once joined anyway
+  if (!lowLat) WiFi.mode(WIFI_STA);
+  esp_wifi_set_ps(PS[level]);
+  esp_wifi_set_max_tx_power(TX[p]);
+  Serial.printf("[WiFiMgr] power %s%s -> ps=%d\n", powerName(powerProfile), idle ? " (idle)" : "", (int)level);
+  powerApplied = level;
+}
+
+// ===== Static pages (web/*.html, gzip'd into web_assets.h) =====
+// Strong ETag from the compressed bytes: a revalidation costs a 304, a
+// firmware with a changed page gets a new tag.
+static void sendAsset(AsyncWebServerRequest* req, const uint8_t* gz, size_t len, const char* etag) {
+  const AsyncWebHeader* inm = req->getHeader("If-None-Match");
+  if (inm && inm->value() == etag) {
+    req->send(304);
+    return;
+  }
+  AsyncWebServerResponse* r = req->beginResponse_P(200, "text/html", gz, len);
+  r->addHeader("Content-Encoding", "gzip");
+  r->addHeader("ETag", etag);
+  r->addHeader("Cache-Control", "public, max-age=86400");
+  req->send(r);
+}
 
 // ===== AP config =====
 static void setAPConfig() {
@@ -154,36 +236,54 @@ static void setAPConfig() {
 
 // ===== WiFi creds =====
 void loadCreds() {
-  prefs.begin("wifi", true);
-  ssid     = prefs.getString("ssid", "");
-  password = prefs.getString("pass", "");
-  prefs.end();
+  ssid     = Settings::getString("wifi", "ssid");
+  password = Settings::getString("wifi", "pass");
 }
 
 void saveCreds(const String& s, const String& p) {
-  prefs.begin("wifi", false);
-  prefs.putString("ssid", s);
-  prefs.putString("pass", p);
-  prefs.end();
+  Settings::putString("wifi", "ssid", s);
+  Settings::putString("wifi", "pass", p);
 }
 
 void clearCreds() {
-  prefs.begin("wifi", false);
-  prefs.remove("ssid");
-  prefs.remove("pass");
-  prefs.end();
+  Settings::remove("wifi", "ssid");
+  Settings::remove("wifi", "pass");
+  Settings::remove("wifi", "fc");
+  Settings::remove("wifi", "fc_ssid");
+  fcValid = false;
+}
+
+static void loadFastConnect() {
+  fcValid = Settings::getString("wifi", "fc_ssid") == ssid && ssid.length() &&
+            Settings::getBytes("wifi", "fc", &fc, sizeof(fc)) == sizeof(fc) && fc.channel;
+}
+
+// Only written when the association or lease actually changed (NVS wear).
+static void saveFastConnect() {
+  FastConnect now = {};
+  const uint8_t* b = WiFi.BSSID();
+  if (!b) return;
+  memcpy(now.bssid, b, 6);
+  now.channel = (uint8_t)WiFi.channel();
+  now.ip   = (uint32_t)WiFi.localIP();
+  now.gw   = (uint32_t)WiFi.gatewayIP();
+  now.mask = (uint32_t)WiFi.subnetMask();
+  now.dns  = (uint32_t)WiFi.dnsIP();
+  if (fcValid && !memcmp(&now, &fc, sizeof(fc))) return;
+  fc = now;
+  fcValid = true;
+  Settings::putBytes("wifi", "fc", &fc, sizeof(fc));
+  Settings::putString("wifi", "fc_ssid", ssid);
 }
 
-// ===== Weather helpers (Preferences-backed; no ArduinoJson to keep binary small) =====
+// ===== Weather helpers (Settings-backed; no ArduinoJson to keep binary small) =====
 static void loadWeatherJSON(String& out) {
-  prefs.begin("weather", true);
-  bool   enabled = prefs.getBool("enabled", false);
-  String units   = prefs.getString("units", "F");     // "F" or "C"
-  double lat     = prefs.getDouble("lat", NAN);
-  double lon     = prefs.getDouble("lon", NAN);
-  int    refresh = prefs.getInt("refresh", 10);       // minutes
-  String name    = prefs.getString("name", "");       // label to show
-  prefs.end();
+  bool   enabled = Settings::getBool("weather", "enabled", false);
+  String units   = Settings::getString("weather", "units", "F");    // "F" or "C"
+  double lat     = Settings::getDouble("weather", "lat", NAN);
+  double lon     = Settings::getDouble("weather", "lon", NAN);
+  int    refresh = Settings::getInt("weather", "refresh", 10);      // minutes
+  String name    = Settings::getString("weather", "name");          // label to show
 
   out.reserve(160);
   out = "{";
@@ -206,86 +306,92 @@ static void registerOTARoutes() {
 
   // OTA page
   server.on("/ota", HTTP_GET, [](AsyncWebServerRequest* req){
-    req->send_P(200, "text/html", OTA_PAGE);
+    sendAsset(req, OTA_HTML_GZ, OTA_HTML_GZ_LEN, OTA_HTML_ETAG);
   });
 
-  // OTA upload/flash (streamed)
+  // OTA upload: chunks go to OtaMgr's writer task through its buffer.
+  // Optional ?sha256=<hex> makes the commit conditional on the digest.
+  // Nothing here waits for flash: the reply only says the image was taken
+  // (202), clients follow /ota/status and call /reboot once it is done.
+  // Only the request that began the upload feeds it; others get 409.
   server.on(
     "/ota",
     HTTP_POST,
-    // When upload finishes: send JSON and DO NOT reboot here
     [](AsyncWebServerRequest* request){
-      bool ok = !Update.hasError();
-      String msg;
-      if (ok) {
-        msg = "{\"ok\":true,\"bytes\":" + String(Update.progress()) + "}";
-        request->send(200, "application/json", msg);
-        Serial.println("[OTA] Update uploaded OK; client will reboot device.");
-      } else {
-        msg = "{\"ok\":false}";
-        request->send(500, "application/json", msg);
-        Serial.println("[OTA] Update failed.");
+      const String sha = request->hasParam("sha256") ? request->getParam("sha256")->value() : String();
+      if (sha.length() && !OtaMgr::validSha256(sha.c_str())) {
+        request->send(400, "text/plain", "sha256 must be 64 hex digits");
+        return;
       }
-      // Do not reboot here; the client JS calls /reboot after showing success.
+      const OtaMgr::Status st = OtaMgr::status();
+      String out; OtaMgr::statusJson(out);
+      const int code = !OtaMgr::ownsUpload(request) ? 409 : st.state == OtaMgr::State::Failed ? 500 : 202;
+      request->send(code, "application/json", out);
     },
-    // Upload handler (stream chunks to flash)
+    // Upload handler (stream chunks to the writer)
     [](AsyncWebServerRequest* request, String filename, size_t index, uint8_t* data, size_t len, bool final){
       if (index == 0) {
         Serial.printf("[OTA] Starting: %s\n", filename.c_str());
-        LedStat::setStatus(LedStatus::Booting);  // optional: show "busy"
-        if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
-          Update.printError(Serial);
-        }
-      }
-      if (len) {
-        if (Update.write(data, len) != len) {
-          Update.printError(Serial);
-        }
-      }
-      if (final) {
-        if (!Update.end(true)) {
-          Update.printError(Serial);
-        } else {
-          Serial.printf("[OTA] Finished: %u bytes\n", (unsigned)(index + len));
-        }
+        const String sha = request->hasParam("sha256") ? request->getParam("sha256")->value() : String();
+        if (sha.length() && !OtaMgr::validSha256(sha.c_str())) return;   // 400 from the handler above
+        if (OtaMgr::beginUpload(sha.c_str(), (uint32_t)request->contentLength(), request))
+          request->onDisconnect([request](){ OtaMgr::dropUpload(request); });
+        else
+          Serial.println("[OTA] busy, upload refused");
       }
+      if (len) OtaMgr::writeUpload(request, data, len);
+      if (final) OtaMgr::endUpload(request);
     }
   );
 
+  // Pull an image from a URL: POST url=http(s)://...&sha256=<hex>. The
+  // digest is required: the TLS peer isn't verified, so it is what says the
+  // image is the one meant.
+  server.on("/ota/url", HTTP_POST, [](AsyncWebServerRequest* req){
+    if (!req->hasParam("url", true)) { req->send(400, "text/plain", "url missing"); return; }
+    const String sha = req->hasParam("sha256", true) ? req->getParam("sha256", true)->value() : String();
+    if (!OtaMgr::validSha256(sha.c_str())) { req->send(400, "text/plain", "sha256 (64 hex digits) required"); return; }
+    const String url = req->getParam("url", true)->value();
+    if (!url.startsWith("http://") && !url.startsWith("https://")) { req->send(400, "text/plain", "bad url"); return; }
+    const bool started = OtaMgr::beginUrl(url, sha.c_str());
+    String out; OtaMgr::statusJson(out);
+    req->send(started ? 202 : 409, "application/json", out);
+  });
+  server.on("/ota/status", HTTP_GET, [](AsyncWebServerRequest* req){
+    String out; OtaMgr::statusJson(out);
+    req->send(200, "application/json", out);
+  });
+  server.on("/ota/abort", HTTP_GET, [](AsyncWebServerRequest* req){
+    OtaMgr::abort();
+    req->send(200, "text/plain", "Aborting");
+  });
+
   // Reboot helper (client calls this after success)
   server.on("/reboot", HTTP_POST, [](AsyncWebServerRequest* req){
     req->send(200, "text/plain", "Rebooting...");
     Serial.println("[OTA] Reboot requested");
     LedStat::setStatus(LedStatus::Booting);
-    // tiny delay so response flushes
-    auto t = millis() + 300;
-    while (millis() < t) { delay(1); }
-    ESP.restart();
+    rebootAt = millis() + 300;   // loop() restarts once the response has flushed
   });
   server.on("/reboot", HTTP_GET, [](AsyncWebServerRequest* req){
     req->send(200, "text/plain", "Rebooting...");
     Serial.println("[OTA] Reboot requested (GET)");
     LedStat::setStatus(LedStatus::Booting);
-    auto t = millis() + 300;
-    while (millis() < t) { delay(1); }
-    ESP.restart();
+    rebootAt = millis() + 300;
   });
 }
 
 // ===== Portal =====
 void startPortal() {
   WiFi.disconnect(true);
-  delay(100);
   setAPConfig();
-  WiFi.mode(WIFI_AP_STA);  // AP+STA (ESP32-S3 friendly)
-  delay(100);
+  WiFi.mode(WIFI_AP_STA);  // AP+STA (ESP32-S3 friendly); mode switch is synchronous
 
   // Use a standard channel for best compatibility
   bool apok = WiFi.softAP("Type D Wireless Display Setup", "", 6, 0);
   esp_wifi_set_max_tx_power(20);
   LedStat::setStatus(LedStatus::Portal);
   Serial.printf("[WiFiMgr] softAP result: %d, IP: %s\n", apok, WiFi.softAPIP().toString().c_str());
-  delay(200);
 
   IPAddress apIP = WiFi.softAPIP();
   dnsServer.start(53, "*", apIP);
@@ -296,159 +402,7 @@ void startPortal() {
   registerOTARoutes();
 
   server.on("/", HTTP_GET, [](AsyncWebServerRequest *request){
-    String page = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-  <title>Type D Wireless Display Setup</title>
-  <meta name="viewport" content="width=360,initial-scale=1">
-  <style>
-    body{background:#111;color:#EEE;font-family:sans-serif}
-    .container{max-width:360px;margin:24px auto;background:#222;padding:1.2em 1.4em;border-radius:10px;box-shadow:0 0 16px #0008}
-    h2{margin:.2em 0 .6em 0}
-    input,select,button{width:100%;box-sizing:border-box;margin:.5em 0;padding:.55em;font-size:1.05em;border-radius:6px;border:1px solid #555;background:#111;color:#EEE}
-    .row{display:flex;gap:.5em}
-    .row > *{flex:1}
-    .btn-primary{background:#299a2c;color:white}
-    .btn-danger{background:#a22;color:white}
-    .card{background:#1a1a1a;border:1px solid #333;border-radius:10px;padding:10px;margin-top:14px}
-    .inline{display:flex;align-items:center;gap:.4em}
-    .status{margin-top:.6em;font-size:.95em}
-    small{opacity:.75}
-    a{color:#8acfff}
-  </style>
-</head>
-<body>
-  <div class="container">
-    <h2>Type D Wireless Display Setup</h2>
-    <div class="card">
-      <label>Wi-Fi Network</label>
-      <select id="ssidDropdown"><option value="">Please select a network</option></select>
-      <input type="text" id="ssid" placeholder="SSID">
-      <label>Password</label>
-      <input type="password" id="pass" placeholder="Wi-Fi Password">
-      <button type="button" onclick="saveWifi()" class="btn-primary">Connect & Save</button>
-      <button type="button" onclick="forget()" class="btn-danger">Forget Wi-Fi</button>
-      <div class="status" id="status">Status: ...</div>
-      <small><a href="/ota">OTA Update</a> -=- <a href="/fw">Firmware info</a></small>
-    </div>
-
-    <h2>Weather</h2>
-    <div class="card">
-      <label class="inline"><input type="checkbox" id="w_enabled"> Enable weather screen</label>
-      <div class="row">
-        <select id="w_units">
-          <option value="F">Units: Fahrenheit (°F)</option>
-          <option value="C">Units: Celsius (°C)</option>
-        </select>
-        <input type="number" id="w_refresh" min="1" max="120" value="10" step="1" placeholder="Refresh (min)">
-      </div>
-      <input type="text" id="w_name" placeholder="Location name (optional)">
-      <div class="row">
-        <input type="text" id="w_lat" placeholder="Latitude e.g. 40.7128">
-        <input type="text" id="w_lon" placeholder="Longitude e.g. -74.0060">
-      </div>
-      <div class="row">
-        <button type="button" onclick="autoLoc()">Auto-detect by IP</button>
-        <button type="button" onclick="saveWeather()" class="btn-primary">Save Weather</button>
-      </div>
-      <div id="w_status" class="status"></div>
-      <small>We use Open-Meteo (no API key). Auto-detect uses ip-api.com.</small>
-    </div>
-
-    <h2>Display</h2>
-    <div class="card">
-      <label for="d_mode">Active Display</label>
-      <select id="d_mode">
-        <option value="ssd1309">OLED 128x64 (SSD1309) - default</option>
-        <option value="us2066">Character OLED 20x4 (US2066)</option>
-      </select>
-      <small>Only one display can be active. Weather is skipped on US2066.</small>
-      <div class="row">
-        <button type="button" onclick="saveDisplay()" class="btn-primary">Save Display</button>
-      </div>
-    </div>
-  </div>
-
-<script>
-function scan() {
-  fetch('/scan').then(r=>r.json()).then(list=>{
-    let dd=document.getElementById('ssidDropdown'); dd.innerHTML='';
-    let def=document.createElement('option'); def.value=''; def.text='Please select a network'; dd.appendChild(def);
-    list.forEach(s=>{ let o=document.createElement('option'); o.value=s; o.text=s; dd.appendChild(o); });
-    dd.onchange=function(){ document.getElementById('ssid').value=dd.value; };
-  }).catch(()=>{
-    let dd=document.getElementById('ssidDropdown'); dd.innerHTML='';
-    let o=document.createElement('option'); o.value=''; o.text='Scan failed'; dd.appendChild(o);
-  });
-}
-setInterval(scan, 2000); window.onload = ()=>{ scan(); loadWeather(); loadDisplay(); };
-
-function saveWifi(){
-  let ssid=document.getElementById('ssid').value;
-  let pass=document.getElementById('pass').value;
-  fetch('/save',{method:'POST',headers:{'Content-Type':'application/json'},body:JSON.stringify({ssid:ssid,pass:pass})})
-      .then(r=>r.text()).then(t=>{ document.getElementById('status').innerText=t; });
-}
-function forget(){
-  fetch('/forget').then(r=>r.text()).then(t=>{
-    document.getElementById('status').innerText=t;
-    document.getElementById('ssid').value='';
-    document.getElementById('pass').value='';
-  });
-}
-
-function loadWeather(){
-  fetch('/weather/get').then(r=>r.json()).then(j=>{
-    document.getElementById('w_enabled').checked = !!j.enabled;
-    document.getElementById('w_units').value = j.units || 'F';
-    document.getElementById('w_refresh').value = j.refresh || 10;
-    document.getElementById('w_name').value = j.name || '';
-    document.getElementById('w_lat').value = (j.lat==null?'':j.lat);
-    document.getElementById('w_lon').value = (j.lon==null?'':j.lon);
-  }).catch(()=>{});
-}
-function saveWeather(){
-  let payload = {
-    enabled: document.getElementById('w_enabled').checked,
-    units: document.getElementById('w_units').value,
-    refresh: parseInt(document.getElementById('w_refresh').value||'10',10),
-    name: document.getElementById('w_name').value||'',
-    lat: parseFloat(document.getElementById('w_lat').value),
-    lon: parseFloat(document.getElementById('w_lon').value)
-  };
-  fetch('/weather/save',{method:'POST',headers:{'Content-Type':'application/json'},body:JSON.stringify(payload)})
-    .then(r=>r.text()).then(t=>{ document.getElementById('w_status').innerText=t; });
-}
-function autoLoc(){
-  document.getElementById('w_status').innerText='Detecting...';
-  fetch('/weather/autoloc').then(r=>r.json()).then(j=>{
-    if(j.ok){
-      if(j.lat!=null) document.getElementById('w_lat').value=j.lat;
-      if(j.lon!=null) document.getElementById('w_lon').value=j.lon;
-      if(j.name){ document.getElementById('w_name').value=j.name; }
-      document.getElementById('w_status').innerText='Detected.';
-    }else{
-      document.getElementById('w_status').innerText='Auto-detect failed.';
-    }
-  }).catch(()=>{ document.getElementById('w_status').innerText='Auto-detect failed.'; });
-}
-
-// === Display mode helpers ===
-function loadDisplay(){
-  fetch('/display/get').then(r=>r.json()).then(j=>{
-    document.getElementById('d_mode').value = j.display || 'ssd1309';
-  }).catch(()=>{});
-}
-function saveDisplay(){
-  let v = document.getElementById('d_mode').value || 'ssd1309';
-  fetch('/display/save',{method:'POST',headers:{'Content-Type':'application/json'},body:JSON.stringify({display:v})})
-    .then(r=>r.text()).then(t=>alert(t)).catch(()=>{});
-}
-</script>
-</body></html>
-    )rawliteral";
-    request->send(200, "text/html", page);
+    sendAsset(request, PORTAL_HTML_GZ, PORTAL_HTML_GZ_LEN, PORTAL_HTML_ETAG);
   });
 
   // ===== Weather endpoints =====
@@ -486,65 +440,51 @@ function saveDisplay(){
       double lon     = findNum("lon", true);
       String name    = findStr("name");
 
-      prefs.begin("weather", false);
-      prefs.putBool("enabled", enabled);
-      prefs.putString("units", units);
-      prefs.putInt("refresh", refresh);
-      if (!isnan(lat)) prefs.putDouble("lat", lat);
-      if (!isnan(lon)) prefs.putDouble("lon", lon);
-      prefs.putString("name", name);
-      prefs.end();
+      // Weather listens on the "weather" namespace and re-reads on change
+      Settings::putBool("weather", "enabled", enabled);
+      Settings::putString("weather", "units", units);
+      Settings::putInt("weather", "refresh", refresh);
+      if (!isnan(lat)) Settings::putDouble("weather", "lat", lat);
+      if (!isnan(lon)) Settings::putDouble("weather", "lon", lon);
+      Settings::putString("weather", "name", name);
 
       req->send(200, "text/plain", "Weather settings saved.");
     }
   );
 
-  // GET geolocate via IP (ip-api.com), no key required
+  // GET geolocate via IP (ip-api.com), no key required. The weather task does
+  // the lookup: a fresh result is returned as is, else one is asked for and
+  // the reply is 202 {"pending":true}; ?poll=1 then waits without asking again.
   server.on("/weather/autoloc", HTTP_GET, [](AsyncWebServerRequest* req){
     if (WiFi.status() != WL_CONNECTED) {
       req->send(200, "application/json", "{\"ok\":false,\"err\":\"wifi\"}");
       return;
     }
-    HTTPClient http;
-    http.setTimeout(4000);
-    if (!http.begin("http://ip-api.com/json")) {
-      req->send(200, "application/json", "{\"ok\":false}");
+    Weather::Located g = Weather::located();
+    const bool fresh = g.ok && g.at && millis() - g.at < AUTOLOC_FRESH_MS;
+    if (!req->hasParam("poll") && !g.pending && !fresh) {
+      Weather::locate();
+      g.pending = true;
+    }
+    if (g.pending || !g.at) {
+      req->send(202, "application/json", "{\"pending\":true}");
       return;
     }
-    int code = http.GET();
-    if (code!=200) { http.end(); req->send(200, "application/json", "{\"ok\":false}"); return; }
-    String body = http.getString(); http.end();
-
-    // crude extract lat/lon/city/region
-    auto pickStr=[&](const char* key)->String{
-      String k=String("\"")+key+"\":\""; int s=body.indexOf(k); if(s<0) return "";
-      s += k.length(); int e=body.indexOf("\"", s); if(e<0) return ""; return body.substring(s,e);
-    };
-    auto pickNum=[&](const char* key)->String{
-      String k=String("\"")+key+"\":";
-      int s=body.indexOf(k); if(s<0) return "";
-      s += k.length(); int e=s;
-      while (e<(int)body.length() && String("0123456789+-.").indexOf(body[e])>=0) e++;
-      return body.substring(s,e);
-    };
-
-    String lat = pickNum("lat"), lon = pickNum("lon");
-    String city = pickStr("city"), region = pickStr("regionName");
-    String name = city.length()? (region.length()? city+", "+region:city) : "";
-
     String out = "{\"ok\":";
-    out += (lat.length() && lon.length() ? "true" : "false");
-    if (lat.length())  { out += ",\"lat\":"+lat; }
-    if (lon.length())  { out += ",\"lon\":"+lon; }
-    if (name.length()) { out += ",\"name\":\""+name+"\""; }
-    out += "}";
-
+    out += g.ok ? "true" : "false";
+    if (g.ok) {
+      out += ",\"lat\":"; out += String(g.lat, 4);
+      out += ",\"lon\":"; out += String(g.lon, 4);
+      if (g.name.length()) { out += ",\"name\":\""; jsonEscape(out, g.name.c_str()); out += '"'; }
+    }
+    out += '}';
     req->send(200, "application/json", out);
   });
 
   // ===== NEW: Display mode endpoints =====
   server.on("/display/get", HTTP_GET, [](AsyncWebServerRequest* req){
-    String json = "{\"display\":\"" + dispMode + "\"}";
+    String json = "{\"display\":\"" + dispMode + "\",\"power\":\"" + powerName(powerProfile) +
+                  "\",\"bus\":\"" + busName(displayBus) + "\"}";
     req->send(200, "application/json", json);
   });
 
@@ -564,10 +504,115 @@ function saveDisplay(){
         if (ke > ks) v = body.substring(ks, ke);
       }
       saveDisplayPref(v);
-      req->send(200, "text/plain", "Display saved: " + dispMode);
+      // optional "power":"latency|balanced|battery" (applies without a reboot)
+      int ps = body.indexOf("\"power\":\"");
+      if (ps >= 0) {
+        ps += 9;
+        int pe = body.indexOf("\"", ps);
+        if (pe > ps) savePowerPref(body.substring(ps, pe));
+      }
+      // optional "bus":"auto|shared|separate" (next boot, like the display)
+      int bs = body.indexOf("\"bus\":\"");
+      if (bs >= 0) {
+        bs += 7;
+        int be = body.indexOf("\"", bs);
+        if (be > bs) saveBusPref(body.substring(bs, be));
+      }
+      req->send(200, "text/plain", "Display saved: " + dispMode + " (power: " + powerName(powerProfile) +
+                                   ", bus: " + busName(displayBus) + ")");
     }
   );
 
+  // ===== Consoles heard (see Telemetry); ?pin=<ip>|auto sets the one shown =====
+  server.on("/consoles", HTTP_GET, [](AsyncWebServerRequest* req){
+    if (req->hasParam("pin")) saveConsolePref(req->getParam("pin")->value());
+    // one copy of the table: the loop task keeps decoding meanwhile
+    std::vector<Telemetry::Snapshot> tab(TELEMETRY_MAX_SENDERS);
+    uint32_t shown = 0;
+    tab.resize(Telemetry::senders(tab.data(), (uint8_t)tab.size(), &shown));
+    const uint32_t now = millis();
+    String out = "{\"pinned\":\"";
+    if (Telemetry::pinned()) out += IPAddress(Telemetry::pinned()).toString();
+    out += "\",\"shown\":\"";
+    if (shown) out += IPAddress(shown).toString();
+    out += "\",\"consoles\":[";
+    for (size_t i = 0; i < tab.size(); ++i) {
+      const Telemetry::Snapshot& t = tab[i];
+      if (i) out += ',';
+      out += "{\"ip\":\""; out += IPAddress(t.ip).toString();
+      out += "\",\"app\":\""; jsonEscape(out, t.app);
+      out += "\",\"age_ms\":"; out += t.last_rx_ms ? now - t.last_rx_ms : 0;
+      out += ",\"alive\":";     out += Telemetry::senderAlive(t) ? "true" : "false";
+      out += '}';
+    }
+    out += "]}";
+    req->send(200, "application/json", out);
+  });
+
+  // ===== Profiling counters (see metrics.h); ?reset=1 clears ticks/histograms,
+  // ?bench=N queues a render benchmark (results in a later /metrics) =====
+  server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest* req){
+#if TYPED_PANEL_U8G2
+    if (req->hasParam("bench"))
+      TypeDDisplay::requestBench((uint16_t)req->getParam("bench")->value().toInt());
+#endif
+    String out;
+    Metrics::json(out);
+    if (req->hasParam("reset")) Metrics::reset();
+    req->send(200, "application/json", out);
+  });
+
+  // ===== Telemetry history (see History) =====
+  // /history?tier=1s|10s|1m (default 10s); values are oldest first, null = no data
+  server.on("/history", HTTP_GET, [](AsyncWebServerRequest* req){
+    History::Tier t = History::T_10S;
+    if (req->hasParam("tier")) {
+      const String v = req->getParam("tier")->value();
+      if (v == "1s") t = History::T_1S;
+      else if (v == "1m") t = History::T_1M;
+    }
+    String out;
+    History::json(out, t);
+    req->send(200, "application/json", out);
+  });
+
+  // ===== UDP capture / replay (see TypeDUDP) =====
+  // /udp/capture?start=1[&kb=N] | ?stop=1, /udp/replay?speed=X[&loop=1] | ?stop=1;
+  // all answer with the capture state. /udp/capture.bin downloads the trace.
+  static auto captureJson = [](AsyncWebServerRequest* req){
+    String out = "{\"capturing\":";
+    out += TypeDUDP::capturing() ? "true" : "false";
+    out += ",\"replaying\":"; out += TypeDUDP::replaying() ? "true" : "false";
+    out += ",\"frames\":";    out += TypeDUDP::captureFrames();
+    out += ",\"bytes\":";     out += (uint32_t)TypeDUDP::captureSize();
+    out += ",\"replayed\":";  out += TypeDUDP::replayedCount();
+    out += '}';
+    req->send(200, "application/json", out);
+  };
+  server.on("/udp/capture", HTTP_GET, [](AsyncWebServerRequest* req){
+    if (req->hasParam("start")) {
+      const long kb = req->hasParam("kb") ? req->getParam("kb")->value().toInt() : 0;
+      TypeDUDP::captureStart(kb > 0 ? (size_t)kb * 1024 : UDP_TYPED_CAPTURE_BYTES);
+    }
+    if (req->hasParam("stop")) TypeDUDP::captureStop();
+    captureJson(req);
+  });
+  server.on("/udp/capture.bin", HTTP_GET, [](AsyncWebServerRequest* req){
+    TypeDUDP::captureStop();           // the ring must not move under the download
+    AsyncWebServerResponse* r = req->beginResponse("application/octet-stream", TypeDUDP::captureSize(),
+      [](uint8_t* buf, size_t maxLen, size_t index) -> size_t {
+        return TypeDUDP::captureRead(index, buf, maxLen);
+      });
+    r->addHeader("Content-Disposition", "attachment; filename=typed_capture.bin");
+    req->send(r);
+  });
+  server.on("/udp/replay", HTTP_GET, [](AsyncWebServerRequest* req){
+    if (req->hasParam("stop")) TypeDUDP::replayStop();
+    else if (req->hasParam("speed"))
+      TypeDUDP::replayStart((uint16_t)req->getParam("speed")->value().toInt(), req->hasParam("loop"));
+    captureJson(req);
+  });
+
   // ===== Existing endpoints =====
 
   server.on("/status", HTTP_GET, [](AsyncWebServerRequest *request){
@@ -589,46 +634,15 @@ function saveDisplay(){
     saveCreds(ss, pw);
     ssid = ss;
     password = pw;
-    state = State::CONNECTING;
-    connectAttempts = 1;
-    WiFi.mode(WIFI_AP_STA);
-    delay(100);
-    WiFi.begin(ssid.c_str(), password.c_str());
+    startConnect();
     request->send(200, "text/plain", "Connecting to: " + ssid);
   });
 
-  // cached scan endpoint for reliability
+  // cached scan results (refreshed in the background by scanStep())
   server.on("/scan", HTTP_GET, [](AsyncWebServerRequest *request){
-    int n = WiFi.scanComplete();
-    if (n == -2) {
-      WiFi.scanNetworks(true, true);
-      String json = "[";
-      for (size_t i = 0; i < lastScanResults.size(); ++i) {
-        if (i) json += ",";
-        json += "\"" + lastScanResults[i] + "\"";
-      }
-      json += "]";
-      request->send(200, "application/json", json);
-      return;
-    } else if (n == -1) {
-      String json = "[";
-      for (size_t i = 0; i < lastScanResults.size(); ++i) {
-        if (i) json += ",";
-        json += "\"" + lastScanResults[i] + "\"";
-      }
-      json += "]";
-      request->send(200, "application/json", json);
-      return;
-    }
-    lastScanResults.clear();
-    for (int i = 0; i < n; ++i) lastScanResults.push_back(WiFi.SSID(i));
-    WiFi.scanDelete();
-    String json = "[";
-    for (size_t i = 0; i < lastScanResults.size(); ++i) {
-      if (i) json += ",";
-      json += "\"" + lastScanResults[i] + "\"";
-    }
-    json += "]";
+    if (!scanAt || millis() - scanAt >= SCAN_EVERY_MS) scanWanted = true;
+    String json;
+    scanJson(json);
     request->send(200, "application/json", json);
   });
 
@@ -668,9 +682,7 @@ function saveDisplay(){
       saveCreds(newSsid, newPass);
       ssid = newSsid;
       password = newPass;
-      state = State::CONNECTING;
-      connectAttempts = 1;
-      WiFi.begin(newSsid.c_str(), newPass.c_str());
+      startConnect();
       request->send(200, "text/plain", "Connecting to: " + newSsid);
       Serial.printf("[WiFiMgr] Received new creds. SSID: %s\n", newSsid.c_str());
     }
@@ -686,44 +698,206 @@ function saveDisplay(){
   server.on("/captiveportal", HTTP_GET, cp);
   server.onNotFound(cp);
 
+  Live::attach(server);
   server.begin();
   state = State::PORTAL;
 }
 
 void stopPortal() { dnsServer.stop(); }
 
-void tryConnect() {
-  if (ssid.length() > 0) {
-    WiFi.mode(WIFI_AP_STA);
-    delay(100);
-    WiFi.begin(ssid.c_str(), password.c_str());
-    state = State::CONNECTING;
-    connectAttempts = 1;
-    lastAttempt = millis();
+static void scanAbsorb(int n) {
+  std::vector<ScanEntry> found;
+  found.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    String s = WiFi.SSID(i);
+    if (!s.length()) continue;                     // hidden
+    const int8_t rssi = (int8_t)WiFi.RSSI(i);
+    bool dup = false;
+    for (auto& e : found) {
+      if (e.ssid != s) continue;
+      if (rssi > e.rssi) { e.rssi = rssi; e.channel = (uint8_t)WiFi.channel(i); }
+      dup = true;
+      break;
+    }
+    if (!dup) found.push_back({ s, rssi, (uint8_t)WiFi.channel(i), WiFi.encryptionType(i) == WIFI_AUTH_OPEN });
+  }
+  std::sort(found.begin(), found.end(), [](const ScanEntry& a, const ScanEntry& b){ return a.rssi > b.rssi; });
+  {
+    ScanLock lock;
+    scanCache.swap(found);
+    scanAt = millis();
+    if (!scanAt) scanAt = 1;
+  }
+  // the old entries are freed here, outside the lock
+}
+
+static void scanStep() {
+  if (scanBusy) {
+    const int n = WiFi.scanComplete();
+    if (n == WIFI_SCAN_RUNNING) return;
+    if (n >= 0) scanAbsorb(n);
+    WiFi.scanDelete();
+    scanBusy = false;
+    return;
+  }
+  // never while associating: the scan would hold the radio off-channel
+  if (state == State::CONNECTING) return;
+  const bool due = (state == State::PORTAL) && (!scanAt || millis() - scanAt >= SCAN_EVERY_MS);
+  if (!due && !scanWanted) return;
+  scanWanted = false;
+  scanBusy = WiFi.scanNetworks(/*async=*/true, /*hidden=*/false, /*passive=*/false, SCAN_DWELL_MS) == WIFI_SCAN_RUNNING;
+}
+
+// {"age_ms":N,"scanning":b,"networks":[{"ssid":..,"rssi":..,"ch":..,"open":b},...]}
+static void scanJson(String& json) {
+  ScanLock lock;
+  json.reserve(48 + scanCache.size() * 56);
+  json = "{\"age_ms\":";
+  json += scanAt ? (uint32_t)(millis() - scanAt) : 0;
+  json += ",\"scanning\":"; json += scanBusy ? "true" : "false";
+  json += ",\"networks\":[";
+  for (size_t i = 0; i < scanCache.size(); ++i) {
+    const ScanEntry& e = scanCache[i];
+    if (i) json += ',';
+    json += "{\"ssid\":\""; jsonEscape(json, e.ssid.c_str());
+    json += "\",\"rssi\":"; json += (int)e.rssi;
+    json += ",\"ch\":";      json += (int)e.channel;
+    json += ",\"open\":";    json += e.open ? "true" : "false";
+    json += '}';
+  }
+  json += "]}";
+}
+
+// One association attempt; the first one after boot/drop goes straight to
+// the cached BSSID/channel.
+static void beginAttempt() {
+  fcAttempt = fcValid && connectAttempts <= 1;
+  if (fcAttempt) {
+#if WIFI_FAST_STATIC_IP
+    if (fc.ip) WiFi.config(IPAddress(fc.ip), IPAddress(fc.gw), IPAddress(fc.mask), IPAddress(fc.dns));
+#endif
+    WiFi.begin(ssid.c_str(), password.c_str(), fc.channel, fc.bssid);
   } else {
-    startPortal();
+#if WIFI_FAST_STATIC_IP
+    WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);   // back to DHCP
+#endif
+    WiFi.begin(ssid.c_str(), password.c_str());
   }
+  evAttemptFailed = false;
+  nextAttemptAt = millis() + (fcAttempt ? FAST_CONNECT_MS : retryDelay);
 }
 
-void begin() {
-  LedStat::setStatus(LedStatus::Booting);
+static void startConnect() {
+  WiFi.mode(WIFI_AP_STA);
+  loadFastConnect();                  // cache is per SSID
+  state = State::CONNECTING;
+  connectAttempts = 1;
+  beginAttempt();
+}
+
+void tryConnect() {
+  if (ssid.length() > 0) startConnect();
+  else startPortal();
+}
+
+static void onWiFiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+  switch (event) {
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+      evLink = 1;
+      break;
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+      if (info.wifi_sta_disconnected.reason != REASON_ASSOC_LEAVE) evAttemptFailed = true;
+      evLink = -1;
+      break;
+    case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+      evLink = -1;
+      break;
+    default:
+      break;
+  }
+}
+
+static void setLink(bool up) {
+  if (up == linkUp) return;
+  linkUp = up;
+  for (uint8_t i = 0; i < nLinkCbs; ++i) linkCbs[i](up);
+}
+
+void onLink(LinkCallback cb) {
+  if (!cb || nLinkCbs >= MAX_LINK_CBS) return;
+  linkCbs[nLinkCbs++] = cb;
+  if (linkUp) cb(true);
+}
+
+static bool prefsLoaded = false;
+static volatile bool started = false;   // begin() finished; loop() waits for it
+
+void loadPrefs() {
+  if (prefsLoaded) return;
   loadCreds();
   loadDisplayPref(); // NEW: load persisted display selection
+  loadPowerPref();
+  loadBusPref();
+  loadConsolePref();
+  prefsLoaded = true;
+}
+
+void begin() {
+  LedStat::setStatus(LedStatus::Booting);
+  loadPrefs();
+  WiFi.onEvent(onWiFiEvent);
+  WiFi.setAutoReconnect(false);       // reconnects go through beginAttempt()
   startPortal();
   if (ssid.length() > 0) tryConnect();
+  started = true;
 }
 
+bool isStarted() { return started; }
+
 void loop() {
+  if (!started) return;
   dnsServer.processNextRequest();
-  if (state == State::CONNECTING) {
-    if (WiFi.status() == WL_CONNECTED) {
+  if (rebootAt && (long)(millis() - rebootAt) >= 0) { Settings::flush(); ESP.restart(); }
+
+  const int8_t ev = evLink;
+  if (ev) {
+    evLink = 0;
+    if (ev > 0 && state != State::CONNECTED) {
       state = State::CONNECTED;
       dnsServer.stop();
-      Serial.println("[WiFiMgr] WiFi connected.");
+      Serial.printf("[WiFiMgr] WiFi connected%s.\n", fcAttempt ? " (fast)" : "");
       Serial.print("[WiFiMgr] IP Address: ");
       Serial.println(WiFi.localIP());
       LedStat::setStatus(LedStatus::WifiConnected);
-    } else if (millis() - lastAttempt > retryDelay) {
+      saveFastConnect();
+      powerApplied = -1;
+      setLink(true);
+    } else if (ev < 0) {
+      setLink(false);
+      if (state == State::CONNECTED) {
+        Serial.println("[WiFiMgr] WiFi lost, reconnecting.");
+        state = State::CONNECTING;
+        connectAttempts = 1;
+        beginAttempt();
+      }
+    }
+  }
+
+  scanStep();
+
+  if (state == State::CONNECTED && millis() - powerCheckedAt >= POWER_CHECK_MS) {
+    powerCheckedAt = millis();
+    applyPower(!TypeDUDP::isAlive(POWER_IDLE_MS));
+  }
+
+  if (state == State::CONNECTING) {
+    const unsigned long now = millis();
+    // a failed attempt retries right away instead of waiting out its window
+    if (evAttemptFailed && (long)(nextAttemptAt - now) > (long)RETRY_AFTER_FAIL_MS) {
+      nextAttemptAt = now + RETRY_AFTER_FAIL_MS;
+      evAttemptFailed = false;
+    }
+    if ((long)(now - nextAttemptAt) >= 0) {
       connectAttempts++;
       if (connectAttempts >= maxAttempts) {
         state = State::PORTAL;
@@ -731,8 +905,7 @@ void loop() {
         LedStat::setStatus(LedStatus::WifiFailed);
       } else {
         WiFi.disconnect();
-        WiFi.begin(ssid.c_str(), password.c_str());
-        lastAttempt = millis();
+        beginAttempt();
       }
     }
   }
@@ -745,7 +918,7 @@ void forgetWiFi() {
   startPortal();
 }
 
-bool isConnected() { return WiFi.status() == WL_CONNECTED; }
+bool isConnected() { return linkUp; }
 
 String getStatus() {
   if (isConnected()) return "Connected to: " + ssid;
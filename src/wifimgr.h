@@ -6,11 +6,22 @@ namespace WiFiMgr {
 
     AsyncWebServer& getServer(); // keep commented if you don't expose it
 
+    // Persisted settings only (credentials, display, power, bus): cheap, so
+    // setup() can pick the display before begin() runs. begin() calls it too.
+    void loadPrefs();
+    // Radio, portal and connect. May run on its own task while the display
+    // initializes; loop() does nothing until it has finished.
     void begin();
+    bool isStarted();
     void loop();
     void restartPortal();
     void forgetWiFi();
     bool isConnected();
+
+    // Link up/down (got IP / lost it), delivered from loop(). A callback
+    // registered while the link is up gets an immediate "up".
+    typedef void (*LinkCallback)(bool up);
+    void onLink(LinkCallback cb);
     String getStatus();
 
     // NEW: persisted display selection
@@ -19,4 +30,22 @@ namespace WiFiMgr {
 
     // Convenience: true when the US2066 20x4 display is selected
     bool   isUS2066Selected();
+
+    // Persisted radio power profile ("ui" namespace, next to the display).
+    //  LowLatency: no modem sleep, full TX power, setup AP stays up.
+    //  Balanced:   min modem sleep (wakes every DTIM), AP off once joined.
+    //  Battery:    max modem sleep, reduced TX power, AP off; the sketch
+    //              also dims the panel.
+    // While no telemetry arrives Balanced and Battery step down one sleep
+    // level and step back up on the next packet. LowLatency stays awake
+    // while its AP is up (modem sleep is STA-only).
+    enum class PowerProfile : uint8_t { LowLatency = 0, Balanced, Battery };
+    PowerProfile getPowerProfile();
+
+    // Persisted display bus ("ui" namespace, read at boot).
+    //  Auto:     use Wire1 if the display answers there, else the shared Wire.
+    //  Shared:   display, gauge and probe all on Wire.
+    //  Separate: prefer Wire1 (falls back to Wire if nothing answers).
+    enum class DisplayBus : uint8_t { Auto = 0, Shared, Separate };
+    DisplayBus getDisplayBus();
 }
@@ -0,0 +1,17 @@
+// Counts every heap allocation the firmware makes through operator new.
+#include "fw_fakes.h"
+#include <new>
+#include <stdlib.h>
+
+namespace fakes { uint64_t allocs = 0; }
+
+void* operator new(size_t n) {
+  fakes::allocs++;
+  if (void* p = malloc(n ? n : 1)) return p;
+  throw std::bad_alloc();
+}
+void* operator new[](size_t n) { return operator new(n); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
@@ -0,0 +1,13 @@
+#pragma once
+#include <stdio.h>
+
+// Minimal assertions for the host tests: report every failure, exit non-zero.
+static int g_failures = 0;
+
+#define CHECK(cond) \
+  do { if (!(cond)) { fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); g_failures++; } } while (0)
+#define CHECK_EQ(a, b) \
+  do { if (!((a) == (b))) { fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s): %lld vs %lld\n", __FILE__, __LINE__, \
+       #a, #b, (long long)(a), (long long)(b)); g_failures++; } } while (0)
+
+#define TEST_MAIN_RESULT() (g_failures ? (fprintf(stderr, "%d failure(s)\n", g_failures), 1) : 0)
@@ -0,0 +1,70 @@
+# make_session.py
+# Writes session.tdcap, the telemetry trace the host render tests replay
+# - Same format as the display's /udp/capture.bin download, so a trace
+#   recorded from a real console can replace it (re-run the render tests
+#   with --update afterwards)
+# - 90 s from one console: legacy binary MAIN every second and EXT every
+#   5 s, EE as text, then a v2 frame with every record near the end
+#
+# Usage: python test/host/fixtures/make_session.py
+
+import os
+import struct
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+OUT = os.path.join(HERE, "session.tdcap")
+
+PORT_MAIN, PORT_EXT, PORT_EE = 50504, 50505, 50506
+APP = b"Halo 2"
+
+
+# legacy (pre-v2) frames
+def main_bin(fan, cpu, amb, app):
+    return struct.pack("<iii32s", fan, cpu, amb, app)
+
+
+def ext_bin(tray, av, pic, xb, enc, w, h):
+    return struct.pack("<7i", tray, av, pic, xb, enc, w, h)
+
+
+# TypedProto v2 (src/typed_proto.h): header + MAIN, EXT (tray, av, pic, xb,
+# w, h, enc) and the three EE strings
+def v2(seq, ts, fan, cpu, amb, app, ext, serial, mac, region):
+    hdr = b"TD" + bytes([2, 0]) + struct.pack("<II", seq, ts)
+    recs = [
+        (0x01, struct.pack("<iii32s", fan, cpu, amb, app)),
+        (0x02, struct.pack("<7i", *ext)),
+        (0x10, serial),
+        (0x11, mac),
+        (0x12, region),
+    ]
+    return hdr + b"".join(bytes([t, len(v)]) + v for t, v in recs)
+
+
+def frames():
+    yield 0, PORT_EE, b"EE:SN=112233420503|MAC=00:50:F2:4C:19:A7|REG=NTSC-U"
+    for s in range(88):
+        t = s * 1000
+        cpu = 46 + (s * 7 % 11) - (s // 30)
+        amb = 29 + (s // 20)
+        fan = 38 + (s * 3 % 9)
+        yield t + 20, PORT_MAIN, main_bin(fan, cpu, amb, APP)
+        if s % 5 == 0:
+            yield t + 520, PORT_EXT, ext_bin(0, 0x06, 0, 3, 0x45, 640, 480)
+    # a v2 sender takes over: progressive output, new EE strings
+    yield 88500, PORT_MAIN, v2(1, 123456, 52, 58, 33, APP,
+                               (1, 0x01, 0, 3, 720, 480, 0x45),
+                               b"112233420503", b"00:50:F2:4C:19:A7", b"PAL")
+
+
+def build():
+    out = bytearray(b"TDCAP\x01\x00\x00")
+    for t, port, data in frames():
+        out += struct.pack("<IHH", t, port, len(data)) + data
+    with open(OUT, "wb") as f:
+        f.write(out)
+    return len(out)
+
+
+if __name__ == "__main__":
+    print("wrote %s (%d B)" % (OUT, build()))
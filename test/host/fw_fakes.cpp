@@ -0,0 +1,135 @@
+// Host replacements for the firmware modules the render path calls but
+// whose work is hardware or network bound: UDP intake (fed from a recorded
+// trace), weather, fuel gauge, metrics, the OLED bus queue and the heap
+// regions.
+#include "fw_fakes.h"
+#include "udp_typed.h"
+#include "metrics.h"
+#include "mem.h"
+#include "oled_async.h"
+#include "weather.h"
+#include "fuel_gauge.h"
+#include <vector>
+
+// ---------------- TypeDUDP: trace replay ----------------
+namespace {
+struct TraceFrame { uint32_t ts; uint16_t port; std::vector<char> data; };
+std::vector<TraceFrame> s_trace;
+size_t   s_next = 0;
+uint32_t s_t0 = 0, s_ts0 = 0;
+bool     s_peeked = false;
+TypeDUDP::PacketView s_view;
+
+uint32_t rd32(const uint8_t* p) { return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24; }
+uint16_t rd16(const uint8_t* p) { return (uint16_t)(p[0] | p[1] << 8); }
+}
+
+namespace fakes {
+
+bool loadTrace(const char* path) {
+  s_trace.clear();
+  s_next = 0;
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  std::vector<uint8_t> b;
+  uint8_t chunk[4096];
+  for (size_t n; (n = fread(chunk, 1, sizeof(chunk), f)) > 0;) b.insert(b.end(), chunk, chunk + n);
+  fclose(f);
+  if (b.size() < 8 || memcmp(b.data(), "TDCAP\x01", 6) != 0) return false;
+  for (size_t p = 8; p + 8 <= b.size();) {
+    TraceFrame fr;
+    fr.ts = rd32(&b[p]);
+    fr.port = rd16(&b[p + 4]);
+    const uint16_t len = rd16(&b[p + 6]);
+    p += 8;
+    if (p + len > b.size()) return false;
+    fr.data.assign((const char*)&b[p], (const char*)&b[p] + len);
+    fr.data.push_back(0);
+    p += len;
+    s_trace.push_back(std::move(fr));
+  }
+  return !s_trace.empty();
+}
+
+void startTrace() {
+  s_next = 0;
+  s_t0 = millis();
+  s_ts0 = s_trace.empty() ? 0 : s_trace.front().ts;
+}
+
+bool traceDone() { return s_next >= s_trace.size(); }
+uint32_t traceSpanMs() { return s_trace.empty() ? 0 : s_trace.back().ts - s_trace.front().ts; }
+
+Weather::Snapshot weather;
+float batteryPct = NAN;
+
+} // namespace fakes
+
+namespace TypeDUDP {
+
+const PacketView* peek() {
+  if (s_next >= s_trace.size()) return nullptr;
+  const TraceFrame& fr = s_trace[s_next];
+  if (millis() - s_t0 < fr.ts - s_ts0) return nullptr;   // not due yet
+  s_view = PacketView();
+  s_view.ts_ms = millis();
+  s_view.ts_us = micros();
+  s_view.ip = IPAddress(127, 0, 0, 1);                   // as replayStart() injects them
+  s_view.dst_port = fr.port;
+  s_view.rx_len = fr.data.size() - 1;
+  s_view.data = fr.data.data();
+  s_view.seq = (uint32_t)s_next + 1;
+  s_peeked = true;
+  return &s_view;
+}
+
+void release() {
+  if (s_peeked) { s_peeked = false; s_next++; }
+}
+
+bool sendControl(const IPAddress&, const uint8_t*, size_t) { return true; }
+
+// the trace was recorded on the default sockets
+uint16_t portA() { return UDP_TYPED_DEFAULT_PORT_A; }
+uint16_t portB() { return UDP_TYPED_DEFAULT_PORT_B; }
+uint16_t portC() { return UDP_TYPED_DEFAULT_PORT_C; }
+
+} // namespace TypeDUDP
+
+// ---------------- Weather / FuelGauge ----------------
+namespace Weather {
+bool enabled() { return true; }
+bool isReady() { return fakes::weather.ok; }
+uint32_t version() { return fakes::weather.version; }
+Snapshot get() { return fakes::weather; }
+}
+
+namespace FuelGauge {
+bool  present() { return !isnan(fakes::batteryPct); }
+float percent() { return fakes::batteryPct; }
+}
+
+// ---------------- Metrics ----------------
+namespace Metrics {
+void record(Tick, uint32_t) {}
+void sample(Hist, uint32_t) {}
+uint32_t percentile(Hist, uint8_t) { return 0; }
+void latChanged(uint32_t) {}
+void latFrame() {}
+void latSent() {}
+void latSender(uint32_t, uint32_t) {}
+Scope::~Scope() {}
+void addSection(Section) {}
+}
+
+namespace OledAsync {
+void frameEnd() {}
+}
+
+// ---------------- Mem: no PSRAM on the host ----------------
+namespace Mem {
+void* bulkAlloc(size_t n) { fakes::allocs++; return malloc(n); }
+void* bulkRealloc(void* p, size_t n) { fakes::allocs++; return realloc(p, n); }
+void  bulkFree(void* p) { free(p); }
+void* hotAlloc(size_t n) { fakes::allocs++; return malloc(n); }
+}
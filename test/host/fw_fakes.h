@@ -0,0 +1,21 @@
+#pragma once
+// Test-side controls of the host fakes (fw_fakes.cpp, alloc_count.cpp).
+#include <Arduino.h>
+#include "weather.h"
+
+namespace fakes {
+
+// UDP intake: a TDCAP trace (the /udp/capture.bin download format) played
+// back against the fake clock from startTrace() on.
+bool loadTrace(const char* path);
+void startTrace();
+bool traceDone();
+uint32_t traceSpanMs();
+
+extern Weather::Snapshot weather;     // what Weather::get() returns
+extern float batteryPct;              // FuelGauge::percent(); NAN = no gauge
+
+// Heap allocations (operator new and Mem::bulk*) since start.
+extern uint64_t allocs;
+
+} // namespace fakes
@@ -0,0 +1,81 @@
+#include "golden.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace golden {
+
+static std::string s_fixtures, s_golden, s_out = ".";
+static bool s_update = false;
+
+bool init(int argc, char** argv) {
+  int pos = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--update")) s_update = true;
+    else if (!strcmp(argv[i], "--out") && i + 1 < argc) s_out = argv[++i];
+    else if (pos == 0) { s_fixtures = argv[i]; pos++; }
+    else if (pos == 1) { s_golden = argv[i]; pos++; }
+  }
+  if (pos < 2) {
+    fprintf(stderr, "usage: %s <fixtures> <golden> [--update] [--out <dir>]\n", argv[0]);
+    return false;
+  }
+  return true;
+}
+
+const std::string& fixtures() { return s_fixtures; }
+
+static bool readFile(const std::string& path, std::string& out) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) return false;
+  char buf[4096];
+  out.clear();
+  for (size_t n; (n = fread(buf, 1, sizeof(buf), f)) > 0;) out.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+static bool writeFile(const std::string& path, const std::string& data) {
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) { fprintf(stderr, "cannot write %s\n", path.c_str()); return false; }
+  fwrite(data.data(), 1, data.size(), f);
+  fclose(f);
+  return true;
+}
+
+static bool check(const char* name, const std::string& actual, const char* what) {
+  const std::string path = s_golden + "/" + name;
+  if (s_update) {
+    printf("  updated %s\n", path.c_str());
+    return writeFile(path, actual);
+  }
+  std::string want;
+  if (!readFile(path, want)) {
+    fprintf(stderr, "FAIL %s: no golden (run with --update)\n", path.c_str());
+    writeFile(s_out + "/" + name, actual);
+    return false;
+  }
+  if (want == actual) return true;
+  const std::string got = s_out + "/" + name;
+  writeFile(got, actual);
+  fprintf(stderr, "FAIL %s: %s differs from the golden, actual written to %s\n", name, what, got.c_str());
+  return false;
+}
+
+bool checkPbm(const char* name, const uint8_t* pages) {
+  std::string pbm = "P4\n128 64\n";
+  for (int y = 0; y < 64; ++y) {
+    for (int xb = 0; xb < 16; ++xb) {
+      uint8_t v = 0;
+      for (int k = 0; k < 8; ++k)
+        if (pages[(y >> 3) * 128 + xb * 8 + k] & (1u << (y & 7))) v |= (uint8_t)(0x80u >> k);
+      pbm += (char)v;
+    }
+  }
+  return check(name, pbm, "frame");
+}
+
+bool checkText(const char* name, const std::string& text) {
+  return check(name, text, "text");
+}
+
+} // namespace golden
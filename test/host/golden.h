@@ -0,0 +1,17 @@
+#pragma once
+// Golden files for the render tests. A mismatch writes the actual output
+// next to the build (<out>/<name>) and fails; --update rewrites the golden.
+#include <stdint.h>
+#include <string>
+
+namespace golden {
+
+// argv: <fixtures> <golden> [--update] [--out <dir>]
+bool init(int argc, char** argv);
+const std::string& fixtures();
+
+// 128x64 page-major frame buffer (U8g2 layout) as a binary PBM, lit = 1.
+bool checkPbm(const char* name, const uint8_t* pages);
+bool checkText(const char* name, const std::string& text);
+
+} // namespace golden
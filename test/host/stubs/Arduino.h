@@ -0,0 +1,231 @@
+#pragma once
+// Host stand-in for the parts of the Arduino-ESP32 core the firmware uses.
+// Time is a fake clock the test advances (host::advance()); nothing sleeps.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+#define PROGMEM
+#define HEX 16
+#define DEC 10
+#define IRAM_ATTR
+
+using std::min;
+using std::max;
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+namespace host {
+extern uint64_t nowUs;                 // the fake clock
+inline void advance(uint32_t ms) { nowUs += (uint64_t)ms * 1000u; }
+extern bool verbose;                   // Serial goes to stdout when set
+}
+
+inline uint32_t millis() { return (uint32_t)(host::nowUs / 1000u); }
+inline uint32_t micros() { return (uint32_t)host::nowUs; }
+inline void delay(uint32_t ms) { host::nowUs += (uint64_t)ms * 1000u; }
+inline void delayMicroseconds(uint32_t us) { host::nowUs += us; }
+inline void yield() {}
+
+void randomSeed(uint32_t seed);
+long random(long howbig);
+long random(long lo, long hi);
+
+// ---------------- String ----------------
+class String {
+ public:
+  String() {}
+  String(const char* s) : s_(s ? s : "") {}
+  String(const std::string& s) : s_(s) {}
+  explicit String(char c) : s_(1, c) {}
+  explicit String(int v, unsigned char base = 10)           { fmtInt((long long)v, base); }
+  explicit String(unsigned v, unsigned char base = 10)      { fmtUns(v, base); }
+  explicit String(long v, unsigned char base = 10)          { fmtInt(v, base); }
+  explicit String(unsigned long v, unsigned char base = 10) { fmtUns(v, base); }
+  explicit String(float v, unsigned char dec = 2)           { fmtDbl(v, dec); }
+  explicit String(double v, unsigned char dec = 2)          { fmtDbl(v, dec); }
+
+  unsigned int length() const { return (unsigned int)s_.size(); }
+  bool isEmpty() const { return s_.empty(); }
+  const char* c_str() const { return s_.c_str(); }
+  bool reserve(unsigned int n) { s_.reserve(n); return true; }
+
+  char  operator[](unsigned int i) const { return i < s_.size() ? s_[i] : 0; }
+  char& operator[](unsigned int i) { return s_[i]; }
+  char  charAt(unsigned int i) const { return (*this)[i]; }
+  void  setCharAt(unsigned int i, char c) { if (i < s_.size()) s_[i] = c; }
+
+  String& operator+=(const String& o) { s_ += o.s_; return *this; }
+  String& operator+=(const char* o)   { if (o) s_ += o; return *this; }
+  String& operator+=(char c)          { s_ += c; return *this; }
+  String& operator+=(unsigned char v) { return *this += String((unsigned)v); }
+  String& operator+=(int v)           { return *this += String(v); }
+  String& operator+=(unsigned v)      { return *this += String(v); }
+  String& operator+=(long v)          { return *this += String(v); }
+  String& operator+=(unsigned long v) { return *this += String(v); }
+  String& operator+=(float v)         { return *this += String(v); }
+  String& operator+=(double v)        { return *this += String(v); }
+  template <class T> bool concat(const T& v) { *this += v; return true; }
+  bool concat(const char* p, unsigned int n) { s_.append(p, n); return true; }
+
+  bool operator==(const String& o) const { return s_ == o.s_; }
+  bool operator==(const char* o) const   { return s_ == (o ? o : ""); }
+  bool operator!=(const String& o) const { return !(*this == o); }
+  bool operator!=(const char* o) const   { return !(*this == o); }
+  bool operator<(const String& o) const  { return s_ < o.s_; }
+  bool operator>(const String& o) const  { return s_ > o.s_; }
+  bool equals(const String& o) const     { return *this == o; }
+  bool equalsIgnoreCase(const String& o) const { return strcasecmp(c_str(), o.c_str()) == 0; }
+  int  compareTo(const String& o) const  { return s_.compare(o.s_); }
+
+  bool startsWith(const String& p) const { return s_.compare(0, p.s_.size(), p.s_) == 0; }
+  bool startsWith(const String& p, unsigned int off) const { return off <= s_.size() && s_.compare(off, p.s_.size(), p.s_) == 0; }
+  bool endsWith(const String& p) const {
+    return p.s_.size() <= s_.size() && s_.compare(s_.size() - p.s_.size(), p.s_.size(), p.s_) == 0;
+  }
+  int indexOf(char c, unsigned int from = 0) const { return pos(s_.find(c, from)); }
+  int indexOf(const String& t, unsigned int from = 0) const { return pos(s_.find(t.s_, from)); }
+  int indexOf(const char* t, unsigned int from = 0) const { return pos(s_.find(t, from)); }
+  int lastIndexOf(char c) const { return pos(s_.rfind(c)); }
+  int lastIndexOf(const String& t) const { return pos(s_.rfind(t.s_)); }
+  String substring(unsigned int a) const { return a < s_.size() ? String(s_.substr(a)) : String(); }
+  String substring(unsigned int a, unsigned int b) const {
+    if (a > b) std::swap(a, b);
+    if (a >= s_.size()) return String();
+    return String(s_.substr(a, std::min<size_t>(b, s_.size()) - a));
+  }
+
+  void toLowerCase() { for (auto& c : s_) c = (char)tolower((unsigned char)c); }
+  void toUpperCase() { for (auto& c : s_) c = (char)toupper((unsigned char)c); }
+  void trim() {
+    size_t a = 0, b = s_.size();
+    while (a < b && isspace((unsigned char)s_[a])) ++a;
+    while (b > a && isspace((unsigned char)s_[b - 1])) --b;
+    s_ = s_.substr(a, b - a);
+  }
+  void replace(const String& from, const String& to) {
+    if (from.s_.empty()) return;
+    for (size_t p = 0; (p = s_.find(from.s_, p)) != std::string::npos; p += to.s_.size()) s_.replace(p, from.s_.size(), to.s_);
+  }
+  void replace(char from, char to) { for (auto& c : s_) if (c == from) c = to; }
+  void remove(unsigned int i) { if (i < s_.size()) s_.erase(i); }
+  void remove(unsigned int i, unsigned int n) { if (i < s_.size()) s_.erase(i, n); }
+  long  toInt() const { return strtol(c_str(), nullptr, 10); }
+  float toFloat() const { return (float)strtod(c_str(), nullptr); }
+  double toDouble() const { return strtod(c_str(), nullptr); }
+
+ private:
+  static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+  void fmtInt(long long v, unsigned char base) {
+    if (base == 10) { char b[24]; snprintf(b, sizeof(b), "%lld", v); s_ = b; }
+    else fmtUns((unsigned long long)v, base);
+  }
+  void fmtUns(unsigned long long v, unsigned char base) {
+    char b[72]; int i = (int)sizeof(b) - 1; b[i] = 0;
+    do { const int d = (int)(v % base); b[--i] = (char)(d < 10 ? '0' + d : 'A' + d - 10); v /= base; } while (v);
+    s_ = b + i;
+  }
+  void fmtDbl(double v, unsigned char dec) { char b[48]; snprintf(b, sizeof(b), "%.*f", (int)dec, v); s_ = b; }
+  std::string s_;
+};
+
+template <class T> inline String operator+(String a, const T& b) { a += b; return a; }
+inline String operator+(String a, const char* b) { a += b; return a; }
+inline String operator+(const char* a, const String& b) { String s(a); s += b; return s; }
+
+// ---------------- Print / Stream ----------------
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* b, size_t n) { size_t k = 0; while (n--) k += write(*b++); return k; }
+  size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+  size_t print(const char* s)   { return write(s); }
+  size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+  size_t print(char c)          { return write((uint8_t)c); }
+  size_t print(int v)           { return print(String(v)); }
+  size_t print(unsigned v)      { return print(String(v)); }
+  size_t print(long v)          { return print(String(v)); }
+  size_t print(unsigned long v) { return print(String(v)); }
+  size_t print(double v, int d = 2) { return print(String(v, (unsigned char)d)); }
+  template <class T> size_t println(const T& v) { return print(v) + print("\n"); }
+  size_t println() { return print("\n"); }
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char b[512];
+    va_list ap; va_start(ap, fmt); const int n = vsnprintf(b, sizeof(b), fmt, ap); va_end(ap);
+    return n > 0 ? write((const uint8_t*)b, std::min<size_t>((size_t)n, sizeof(b) - 1)) : 0;
+  }
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  void setTimeout(unsigned long) {}
+  size_t readBytes(uint8_t* b, size_t n) {
+    size_t k = 0; int c;
+    while (k < n && (c = read()) >= 0) b[k++] = (uint8_t)c;
+    return k;
+  }
+  size_t readBytes(char* b, size_t n) { return readBytes((uint8_t*)b, n); }
+};
+
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override { if (host::verbose) fputc(c, stdout); return 1; }
+  using Print::write;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+// ---------------- IPAddress ----------------
+class IPAddress {
+ public:
+  IPAddress() {}
+  IPAddress(uint32_t v) : v_(v) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : v_((uint32_t)a | (uint32_t)b << 8 | (uint32_t)c << 16 | (uint32_t)d << 24) {}
+  operator uint32_t() const { return v_; }
+  uint8_t operator[](int i) const { return (uint8_t)(v_ >> (8 * i)); }
+  bool operator==(const IPAddress& o) const { return v_ == o.v_; }
+  bool operator!=(const IPAddress& o) const { return v_ != o.v_; }
+  String toString() const {
+    char b[16]; snprintf(b, sizeof(b), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(b);
+  }
+  bool fromString(const char* s) {
+    unsigned a, b, c, d;
+    if (!s || sscanf(s, "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 || b > 255 || c > 255 || d > 255) return false;
+    *this = IPAddress((uint8_t)a, (uint8_t)b, (uint8_t)c, (uint8_t)d);
+    return true;
+  }
+ private:
+  uint32_t v_ = 0;
+};
+
+// ---------------- ESP ----------------
+class EspClass {
+ public:
+  uint32_t getFreeHeap() { return 187 * 1024; }
+  uint32_t getMinFreeHeap() { return 150 * 1024; }
+  uint32_t getMaxAllocHeap() { return 110 * 1024; }
+  uint32_t getPsramSize() { return 0; }
+  uint32_t getFreePsram() { return 0; }
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint32_t getCycleCount() { return (uint32_t)(host::nowUs * 240u); }
+  void restart() { abort(); }
+};
+extern EspClass ESP;
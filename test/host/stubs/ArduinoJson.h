@@ -0,0 +1,147 @@
+#pragma once
+// The slice of the ArduinoJson 6 API the firmware parses with, on a plain
+// node tree. deserializeJson() reads exactly one value from the stream and
+// leaves the next character unread, as the real parser does; capacity is
+// not enforced.
+#include <Arduino.h>
+#include <string>
+#include <vector>
+#include <utility>
+
+struct JsonNode {
+  enum Type : uint8_t { Null, Bool, Int, Float, Str, Obj, Arr } type = Null;
+  bool        b = false;
+  long long   i = 0;
+  double      f = 0;
+  std::string s;
+  std::vector<std::pair<std::string, JsonNode>> obj;
+  std::vector<JsonNode> arr;
+};
+
+class JsonVariant;
+class JsonObject;
+class JsonArray;
+
+struct JsonString {
+  const std::string* s;
+  const char* c_str() const { return s->c_str(); }
+};
+
+class JsonVariant {
+ public:
+  JsonVariant(const JsonNode* n = nullptr) : n_(n) {}
+  bool isNull() const { return !n_ || n_->type == JsonNode::Null; }
+  template <class T> T as() const;
+  template <class T> bool is() const;
+  JsonVariant operator[](const String& key) const;
+  JsonVariant operator[](const char* key) const { return (*this)[String(key)]; }
+  JsonVariant operator[](int idx) const;
+  const JsonNode* node() const { return n_; }
+ private:
+  const JsonNode* n_;
+};
+
+class JsonPair {
+ public:
+  explicit JsonPair(const std::pair<std::string, JsonNode>* p) : p_(p) {}
+  JsonString  key() const { return JsonString{ &p_->first }; }
+  JsonVariant value() const { return JsonVariant(&p_->second); }
+ private:
+  const std::pair<std::string, JsonNode>* p_;
+};
+
+class JsonObject {
+ public:
+  JsonObject(const JsonNode* n = nullptr) : n_(n && n->type == JsonNode::Obj ? n : nullptr) {}
+  JsonVariant operator[](const String& key) const { return JsonVariant(n_).operator[](key); }
+  size_t size() const { return n_ ? n_->obj.size() : 0; }
+  struct iterator {
+    const std::pair<std::string, JsonNode>* p;
+    JsonPair operator*() const { return JsonPair(p); }
+    iterator& operator++() { ++p; return *this; }
+    bool operator!=(const iterator& o) const { return p != o.p; }
+  };
+  iterator begin() const { return { n_ && size() ? n_->obj.data() : nullptr }; }
+  iterator end() const   { return { n_ && size() ? n_->obj.data() + size() : nullptr }; }
+ private:
+  const JsonNode* n_;
+};
+
+class JsonArray {
+ public:
+  JsonArray(const JsonNode* n = nullptr) : n_(n && n->type == JsonNode::Arr ? n : nullptr) {}
+  size_t size() const { return n_ ? n_->arr.size() : 0; }
+  JsonVariant operator[](int i) const { return JsonVariant(n_).operator[](i); }
+  struct iterator {
+    const JsonNode* p;
+    JsonVariant operator*() const { return JsonVariant(p); }
+    iterator& operator++() { ++p; return *this; }
+    bool operator!=(const iterator& o) const { return p != o.p; }
+  };
+  iterator begin() const { return { n_ && size() ? n_->arr.data() : nullptr }; }
+  iterator end() const   { return { n_ && size() ? n_->arr.data() + size() : nullptr }; }
+ private:
+  const JsonNode* n_;
+};
+
+inline JsonVariant JsonVariant::operator[](const String& key) const {
+  if (!n_ || n_->type != JsonNode::Obj) return JsonVariant();
+  for (const auto& kv : n_->obj) if (kv.first == key.c_str()) return JsonVariant(&kv.second);
+  return JsonVariant();
+}
+inline JsonVariant JsonVariant::operator[](int idx) const {
+  if (!n_ || n_->type != JsonNode::Arr || idx < 0 || (size_t)idx >= n_->arr.size()) return JsonVariant();
+  return JsonVariant(&n_->arr[(size_t)idx]);
+}
+
+void jsonSerialize(const JsonNode& n, std::string& out);
+
+template <> inline const char* JsonVariant::as<const char*>() const {
+  return n_ && n_->type == JsonNode::Str ? n_->s.c_str() : nullptr;
+}
+template <> inline String JsonVariant::as<String>() const {
+  if (isNull()) return String("null");
+  if (n_->type == JsonNode::Str) return String(n_->s);
+  std::string s; jsonSerialize(*n_, s);
+  return String(s);
+}
+template <> inline JsonObject JsonVariant::as<JsonObject>() const { return JsonObject(n_); }
+template <> inline JsonArray  JsonVariant::as<JsonArray>() const  { return JsonArray(n_); }
+template <> inline JsonVariant JsonVariant::as<JsonVariant>() const { return *this; }
+template <> inline bool JsonVariant::is<JsonObject>() const { return n_ && n_->type == JsonNode::Obj; }
+template <> inline bool JsonVariant::is<JsonArray>() const  { return n_ && n_->type == JsonNode::Arr; }
+
+class JsonDocument {
+ public:
+  explicit JsonDocument(size_t capacity = 0) : cap_(capacity) {}
+  void clear() { root_ = JsonNode(); }
+  void set(const String& v) { root_ = JsonNode(); root_.type = JsonNode::Str; root_.s = v.c_str(); }
+  template <class T> T as() const { return JsonVariant(&root_).as<T>(); }
+  size_t capacity() const { return cap_; }
+  JsonNode& root() { return root_; }
+ private:
+  size_t   cap_;
+  JsonNode root_;
+};
+
+template <class Allocator> class BasicJsonDocument : public JsonDocument {
+ public:
+  explicit BasicJsonDocument(size_t capacity) : JsonDocument(capacity) {}
+};
+class DynamicJsonDocument : public JsonDocument {
+ public:
+  explicit DynamicJsonDocument(size_t capacity) : JsonDocument(capacity) {}
+};
+
+class DeserializationError {
+ public:
+  enum Code { Ok, InvalidInput, IncompleteInput };
+  DeserializationError(Code c = Ok) : c_(c) {}
+  explicit operator bool() const { return c_ != Ok; }
+  const char* c_str() const { return c_ == Ok ? "Ok" : c_ == InvalidInput ? "InvalidInput" : "IncompleteInput"; }
+ private:
+  Code c_;
+};
+
+DeserializationError deserializeJson(JsonDocument& doc, Stream& s);
+DeserializationError deserializeJson(JsonDocument& doc, const String& s);
@@ -0,0 +1,28 @@
+#pragma once
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+// GETs are answered from files: everything from "/data/" on in the URL is
+// looked up under host::httpRoot. Missing files answer 404.
+namespace host {
+extern String   httpRoot;
+extern uint32_t httpRequests;
+}
+
+class HTTPClient {
+ public:
+  void setReuse(bool) {}
+  void setConnectTimeout(int32_t) {}
+  void setTimeout(uint16_t) {}
+  bool begin(WiFiClient&, const String& url) { url_ = url; return true; }
+  void collectHeaders(const char* const*, size_t) {}
+  void addHeader(const String&, const String&) {}
+  String header(const char*) { return String(); }
+  int GET();
+  String getString() { return body_; }
+  int getSize() { return (int)body_.length(); }
+  void end() { body_ = String(); }
+
+ private:
+  String url_, body_;
+};
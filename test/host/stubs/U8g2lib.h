@@ -0,0 +1,81 @@
+#pragma once
+// U8G2 with a real 128x64 page buffer (page-major, LSB = top row, as the
+// SSD1309 full-buffer driver keeps it) and the drawing primitives the
+// screens use. A second buffer is the "glass": sendBuffer() and
+// updateDisplayArea() copy tiles onto it, so tests see what reached the
+// panel, not just what was drawn.
+//
+// Fonts: only the 23-byte U8g2 font header is read (cell width, ascent,
+// descent), so the stock u8g2_font_* names and generated subsets both work.
+// Every glyph is a fixed pattern derived from its code filling the cell;
+// goldens pin layout (positions, widths, clipping), not typography.
+#include <Arduino.h>
+
+#define U8G2_FONT_SECTION(name)
+#define U8X8_PIN_NONE 255
+
+extern const uint8_t u8g2_font_5x8_tf[];
+extern const uint8_t u8g2_font_6x12_tf[];
+extern const uint8_t u8g2_font_7x13B_tf[];
+extern const uint8_t u8g2_font_logisoso16_tf[];
+extern const uint8_t u8g2_font_logisoso20_tf[];
+extern const uint8_t u8g2_font_logisoso24_tf[];
+
+struct u8x8_t { uint8_t i2c_address = 0x78; };
+#define u8x8_GetI2CAddress(u8x8) ((u8x8)->i2c_address)
+
+class U8G2 : public Print {
+ public:
+  static constexpr int W = 128, H = 64, BYTES = W * H / 8;
+
+  U8G2() { clearBuffer(); memset(glass_, 0, sizeof(glass_)); }
+  bool begin() { return true; }
+
+  uint8_t* getBufferPtr() { return buf_; }
+  uint8_t  getBufferTileWidth() const { return W / 8; }
+  uint8_t  getBufferTileHeight() const { return H / 8; }
+  u8x8_t*  getU8x8() { return &u8x8_; }
+
+  void clearBuffer() { memset(buf_, 0, sizeof(buf_)); }
+  void sendBuffer();
+  void updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+  void setPowerSave(uint8_t on) { powerSave_ = on != 0; }
+  void setContrast(uint8_t v) { contrast_ = v; }
+
+  void drawPixel(int x, int y);
+  void drawHLine(int x, int y, int w) { for (int i = 0; i < w; ++i) drawPixel(x + i, y); }
+  void drawVLine(int x, int y, int h) { for (int i = 0; i < h; ++i) drawPixel(x, y + i); }
+  void drawBox(int x, int y, int w, int h) { for (int j = 0; j < h; ++j) drawHLine(x, y + j, w); }
+  void drawFrame(int x, int y, int w, int h);
+  void drawLine(int x0, int y0, int x1, int y1);
+
+  void setFont(const uint8_t* f) { font_ = f; }
+  void setCursor(int x, int y) { tx_ = x; ty_ = y; }
+  int  getAscent() const;
+  int  getDescent() const;
+  int  getStrWidth(const char* s) const;
+  int  drawUTF8(int x, int y, const char* s);
+  int  drawStr(int x, int y, const char* s);
+  size_t write(uint8_t c) override { tx_ += drawGlyph(tx_, ty_, c); return 1; }
+  using Print::write;
+
+  // test side
+  const uint8_t* glass() const { return glass_; }
+  bool     powerSave() const { return powerSave_; }
+  uint8_t  contrast() const { return contrast_; }
+  uint32_t tilesSent() const { return tiles_; }
+  uint32_t transfers() const { return transfers_; }
+
+ private:
+  int cellW() const;
+  int drawGlyph(int x, int y, uint32_t cp);
+
+  uint8_t  buf_[BYTES];
+  uint8_t  glass_[BYTES];
+  const uint8_t* font_ = nullptr;
+  int      tx_ = 0, ty_ = 0;
+  bool     powerSave_ = false;
+  uint8_t  contrast_ = 255;
+  uint32_t tiles_ = 0, transfers_ = 0;
+  u8x8_t   u8x8_;
+};
@@ -0,0 +1,8 @@
+#pragma once
+#include <Arduino.h>
+
+class WiFiClient {
+ public:
+  void stop() {}
+  bool connected() { return false; }
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <Arduino.h>
+
+// I2C bus with pluggable devices. A transaction is collected between
+// beginTransmission() and endTransmission() and handed to the device at that
+// address in one go; addresses with no device NACK (endTransmission() == 2).
+struct HostI2cDevice {
+  virtual ~HostI2cDevice() {}
+  virtual void   transfer(const uint8_t* b, size_t n) = 0;
+  virtual size_t read(uint8_t* b, size_t n) = 0;
+};
+
+class TwoWire : public Stream {
+ public:
+  static const size_t TX_MAX = 128;          // the ESP32 core's I2C buffer
+
+  void attach(uint8_t addr, HostI2cDevice* d) { dev_[addr & 0x7F] = d; }
+  bool begin(int = -1, int = -1, uint32_t = 0) { return true; }
+  void setClock(uint32_t hz) { hz_ = hz; }
+  uint32_t getClock() { return hz_; }
+
+  void beginTransmission(uint8_t addr) { addr_ = addr & 0x7F; n_ = 0; }
+  size_t write(uint8_t c) override { if (n_ >= TX_MAX) return 0; tx_[n_++] = c; return 1; }
+  size_t write(const uint8_t* b, size_t n) override { size_t k = 0; while (k < n && write(b[k])) ++k; return k; }
+  using Print::write;
+  uint8_t endTransmission(bool = true) {
+    HostI2cDevice* d = dev_[addr_];
+    if (!d) return 2;
+    d->transfer(tx_, n_);
+    n_ = 0;
+    return 0;
+  }
+  uint8_t requestFrom(uint8_t addr, uint8_t n) {
+    HostI2cDevice* d = dev_[addr & 0x7F];
+    rxN_ = rxPos_ = 0;
+    if (d) rxN_ = d->read(rx_, std::min<size_t>(n, sizeof(rx_)));
+    return (uint8_t)rxN_;
+  }
+  int available() override { return (int)(rxN_ - rxPos_); }
+  int read() override { return rxPos_ < rxN_ ? rx_[rxPos_++] : -1; }
+  int peek() override { return rxPos_ < rxN_ ? rx_[rxPos_] : -1; }
+
+ private:
+  HostI2cDevice* dev_[128] = {};
+  uint8_t  addr_ = 0;
+  uint8_t  tx_[TX_MAX];
+  size_t   n_ = 0;
+  uint8_t  rx_[32];
+  size_t   rxN_ = 0, rxPos_ = 0;
+  uint32_t hz_ = 100000;
+};
+extern TwoWire Wire;
+extern TwoWire Wire1;
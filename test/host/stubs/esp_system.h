@@ -0,0 +1,7 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Deterministic stand-in: the same sequence on every run.
+uint32_t esp_random();
+void esp_fill_random(void* buf, size_t len);
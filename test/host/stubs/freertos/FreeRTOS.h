@@ -0,0 +1,15 @@
+#pragma once
+#include <stdint.h>
+
+// Single-threaded host build: critical sections and locks are no-ops.
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(m) ((void)(m))
+#define portEXIT_CRITICAL(m)  ((void)(m))
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) (ms)
+#define pdTRUE  1
+#define pdFALSE 0
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef void* TaskHandle_t;
@@ -0,0 +1,3 @@
+#pragma once
+#include "FreeRTOS.h"
+typedef void* SemaphoreHandle_t;
@@ -0,0 +1,29 @@
+#include <Arduino.h>
+#include <WiFi.h>
+#include <Wire.h>
+#include <esp_system.h>
+
+namespace host {
+uint64_t nowUs = 1000000;     // boot + 1 s: 0 means "never" to several modules
+bool     verbose = false;
+}
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+TwoWire Wire, Wire1;
+
+// xorshift32: fixed seed, so every run draws the same quotes and slides
+static uint32_t s_rng = 0x2545F491u;
+uint32_t esp_random() {
+  s_rng ^= s_rng << 13; s_rng ^= s_rng >> 17; s_rng ^= s_rng << 5;
+  return s_rng;
+}
+void esp_fill_random(void* buf, size_t len) {
+  uint8_t* p = (uint8_t*)buf;
+  while (len--) *p++ = (uint8_t)esp_random();
+}
+
+void randomSeed(uint32_t) {}
+long random(long howbig) { return howbig > 0 ? (long)(esp_random() % (uint32_t)howbig) : 0; }
+long random(long lo, long hi) { return hi > lo ? lo + random(hi - lo) : lo; }
@@ -0,0 +1,23 @@
+#include <HTTPClient.h>
+#include <string>
+
+namespace host {
+String   httpRoot;
+uint32_t httpRequests = 0;
+}
+
+int HTTPClient::GET() {
+  host::httpRequests++;
+  body_ = String();
+  const int at = url_.indexOf("/data/");
+  if (at < 0 || !host::httpRoot.length()) return 404;
+  const String path = host::httpRoot + url_.substring((unsigned)at);
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) return 404;
+  std::string s;
+  char buf[4096];
+  for (size_t n; (n = fread(buf, 1, sizeof(buf), f)) > 0;) s.append(buf, n);
+  fclose(f);
+  body_ = String(s);
+  return 200;
+}
@@ -0,0 +1,176 @@
+#include <ArduinoJson.h>
+
+namespace {
+
+struct Reader {
+  Stream& s;
+  int peekWs() {
+    for (;;) {
+      const int c = s.peek();
+      if (c == ' ' || c == '\n' || c == '\r' || c == '\t') { s.read(); continue; }
+      return c;
+    }
+  }
+};
+
+static void putUtf8(std::string& o, uint32_t cp) {
+  if (cp < 0x80) { o += (char)cp; return; }
+  if (cp < 0x800) { o += (char)(0xC0 | cp >> 6); o += (char)(0x80 | (cp & 0x3F)); return; }
+  if (cp < 0x10000) {
+    o += (char)(0xE0 | cp >> 12); o += (char)(0x80 | ((cp >> 6) & 0x3F)); o += (char)(0x80 | (cp & 0x3F));
+    return;
+  }
+  o += (char)(0xF0 | cp >> 18); o += (char)(0x80 | ((cp >> 12) & 0x3F));
+  o += (char)(0x80 | ((cp >> 6) & 0x3F)); o += (char)(0x80 | (cp & 0x3F));
+}
+
+static int hex4(Stream& s) {
+  int v = 0;
+  for (int k = 0; k < 4; ++k) {
+    const int c = s.read();
+    if (c < 0 || !isxdigit(c)) return -1;
+    v = v * 16 + (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
+  }
+  return v;
+}
+
+static DeserializationError::Code str(Reader& r, std::string& out) {
+  r.s.read();   // opening quote
+  for (;;) {
+    int c = r.s.read();
+    if (c < 0) return DeserializationError::IncompleteInput;
+    if (c == '"') return DeserializationError::Ok;
+    if (c != '\\') { out += (char)c; continue; }
+    c = r.s.read();
+    switch (c) {
+      case '"': case '\\': case '/': out += (char)c; break;
+      case 'b': out += '\b'; break;
+      case 'f': out += '\f'; break;
+      case 'n': out += '\n'; break;
+      case 'r': out += '\r'; break;
+      case 't': out += '\t'; break;
+      case 'u': {
+        int cp = hex4(r.s);
+        if (cp < 0) return DeserializationError::InvalidInput;
+        if (cp >= 0xD800 && cp < 0xDC00 && r.s.peek() == '\\') {
+          r.s.read();
+          if (r.s.read() != 'u') return DeserializationError::InvalidInput;
+          const int lo = hex4(r.s);
+          if (lo < 0xDC00 || lo >= 0xE000) return DeserializationError::InvalidInput;
+          cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+        }
+        putUtf8(out, (uint32_t)cp);
+        break;
+      }
+      default: return c < 0 ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+    }
+  }
+}
+
+static DeserializationError::Code value(Reader& r, JsonNode& n, int depth) {
+  if (depth > 20) return DeserializationError::InvalidInput;
+  const int c = r.peekWs();
+  if (c < 0) return DeserializationError::IncompleteInput;
+  if (c == '"') { n.type = JsonNode::Str; return str(r, n.s); }
+  if (c == '{' || c == '[') {
+    const bool obj = c == '{';
+    n.type = obj ? JsonNode::Obj : JsonNode::Arr;
+    r.s.read();
+    if (r.peekWs() == (obj ? '}' : ']')) { r.s.read(); return DeserializationError::Ok; }
+    for (;;) {
+      JsonNode* slot;
+      if (obj) {
+        if (r.peekWs() != '"') return DeserializationError::InvalidInput;
+        std::string key;
+        if (auto e = str(r, key)) return e;
+        if (r.peekWs() != ':') return DeserializationError::InvalidInput;
+        r.s.read();
+        n.obj.emplace_back(std::move(key), JsonNode());
+        slot = &n.obj.back().second;
+      } else {
+        n.arr.emplace_back();
+        slot = &n.arr.back();
+      }
+      if (auto e = value(r, *slot, depth + 1)) return e;
+      const int d = r.peekWs();
+      if (d < 0) return DeserializationError::IncompleteInput;
+      r.s.read();
+      if (d == ',') continue;
+      return d == (obj ? '}' : ']') ? DeserializationError::Ok : DeserializationError::InvalidInput;
+    }
+  }
+  // literal or number: up to the next delimiter, which stays in the stream
+  std::string t;
+  for (int d; (d = r.s.peek()) >= 0 && !strchr(",}] \n\r\t", d);) t += (char)r.s.read();
+  if (t == "null")  { n.type = JsonNode::Null; return DeserializationError::Ok; }
+  if (t == "true")  { n.type = JsonNode::Bool; n.b = true;  return DeserializationError::Ok; }
+  if (t == "false") { n.type = JsonNode::Bool; n.b = false; return DeserializationError::Ok; }
+  char* end = nullptr;
+  const bool isFloat = t.find_first_of(".eE") != std::string::npos;
+  if (isFloat) { n.type = JsonNode::Float; n.f = strtod(t.c_str(), &end); }
+  else         { n.type = JsonNode::Int;   n.i = strtoll(t.c_str(), &end, 10); }
+  return (!t.empty() && end && !*end) ? DeserializationError::Ok : DeserializationError::InvalidInput;
+}
+
+class StringReader : public Stream {
+ public:
+  explicit StringReader(const String& s) : s_(s) {}
+  int available() override { return (int)(s_.length() - pos_); }
+  int read() override { return pos_ < s_.length() ? (uint8_t)s_[pos_++] : -1; }
+  int peek() override { return pos_ < s_.length() ? (uint8_t)s_[pos_] : -1; }
+  size_t write(uint8_t) override { return 0; }
+ private:
+  const String& s_;
+  unsigned pos_ = 0;
+};
+
+} // namespace
+
+void jsonSerialize(const JsonNode& n, std::string& out) {
+  char b[40];
+  switch (n.type) {
+    case JsonNode::Null:  out += "null"; break;
+    case JsonNode::Bool:  out += n.b ? "true" : "false"; break;
+    case JsonNode::Int:   snprintf(b, sizeof(b), "%lld", n.i); out += b; break;
+    case JsonNode::Float: snprintf(b, sizeof(b), "%.9g", n.f); out += b; break;
+    case JsonNode::Str: {
+      out += '"';
+      for (const char c : n.s) {
+        if (c == '"' || c == '\\') { out += '\\'; out += c; }
+        else if ((uint8_t)c < 0x20) { snprintf(b, sizeof(b), "\\u%04x", (unsigned)(uint8_t)c); out += b; }
+        else out += c;
+      }
+      out += '"';
+      break;
+    }
+    case JsonNode::Obj:
+      out += '{';
+      for (size_t k = 0; k < n.obj.size(); ++k) {
+        if (k) out += ',';
+        JsonNode key; key.type = JsonNode::Str; key.s = n.obj[k].first;
+        jsonSerialize(key, out);
+        out += ':';
+        jsonSerialize(n.obj[k].second, out);
+      }
+      out += '}';
+      break;
+    case JsonNode::Arr:
+      out += '[';
+      for (size_t k = 0; k < n.arr.size(); ++k) { if (k) out += ','; jsonSerialize(n.arr[k], out); }
+      out += ']';
+      break;
+  }
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, Stream& s) {
+  doc.clear();
+  Reader r{ s };
+  const DeserializationError::Code e = value(r, doc.root(), 0);
+  if (e) doc.clear();
+  return DeserializationError(e);
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const String& s) {
+  StringReader r(s);
+  return deserializeJson(doc, r);
+}
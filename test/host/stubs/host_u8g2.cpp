@@ -0,0 +1,109 @@
+#include <U8g2lib.h>
+#include <stdlib.h>
+
+// Font headers only (see U8g2lib.h): glyph count, then the size fields the
+// stub reads: [9] max char width, [10] max char height, [13] ascent of 'A',
+// [14] descent of 'g' (signed). Cell sizes follow the stock fonts.
+#define HOST_FONT(name, w, h, asc, desc) \
+  const uint8_t name[23] = { 0xE0, 0, 0, 0, 0, 0, 0, 0, 0, w, h, 0, 0, asc, (uint8_t)(desc), asc, (uint8_t)(desc), 0, 0, 0, 0, 0, 0 }
+HOST_FONT(u8g2_font_5x8_tf,          5,  8,  6, -2);
+HOST_FONT(u8g2_font_6x12_tf,         6, 12,  8, -2);
+HOST_FONT(u8g2_font_7x13B_tf,        7, 13,  9, -2);
+HOST_FONT(u8g2_font_logisoso16_tf,  10, 23, 16, -4);
+HOST_FONT(u8g2_font_logisoso20_tf,  12, 27, 20, -5);
+HOST_FONT(u8g2_font_logisoso24_tf,  14, 32, 24, -6);
+
+void U8G2::sendBuffer() {
+  memcpy(glass_, buf_, sizeof(buf_));
+  tiles_ += (W / 8) * (H / 8);
+  transfers_++;
+}
+
+void U8G2::updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+  for (int r = ty; r < ty + th && r < H / 8; ++r) {
+    const int c0 = tx * 8, c1 = std::min(W, (tx + tw) * 8);
+    if (c1 > c0) memcpy(glass_ + r * W + c0, buf_ + r * W + c0, (size_t)(c1 - c0));
+  }
+  tiles_ += (uint32_t)tw * th;
+  transfers_++;
+}
+
+void U8G2::drawPixel(int x, int y) {
+  if (x < 0 || x >= W || y < 0 || y >= H) return;
+  buf_[(y >> 3) * W + x] |= (uint8_t)(1u << (y & 7));
+}
+
+void U8G2::drawFrame(int x, int y, int w, int h) {
+  if (w <= 0 || h <= 0) return;
+  drawHLine(x, y, w);
+  drawHLine(x, y + h - 1, w);
+  drawVLine(x, y, h);
+  drawVLine(x + w - 1, y, h);
+}
+
+void U8G2::drawLine(int x0, int y0, int x1, int y1) {
+  const int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+  const int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+  int err = dx + dy;
+  for (;;) {
+    drawPixel(x0, y0);
+    if (x0 == x1 && y0 == y1) break;
+    const int e2 = 2 * err;
+    if (e2 >= dy) { err += dy; x0 += sx; }
+    if (e2 <= dx) { err += dx; y0 += sy; }
+  }
+}
+
+int U8G2::cellW() const { return font_ ? font_[9] : 0; }
+int U8G2::getAscent() const { return font_ ? font_[13] : 0; }
+int U8G2::getDescent() const { return font_ ? (int8_t)font_[14] : 0; }
+
+// Advance of a glyph; codes the fonts don't carry draw nothing and take no room.
+static bool inFont(uint32_t cp) { return cp >= 0x20 && cp <= 0xFF; }
+
+int U8G2::drawGlyph(int x, int y, uint32_t cp) {
+  if (!font_ || !inFont(cp)) return 0;
+  const int w = cellW();
+  if (cp == ' ' || cp == 0xA0) return w;
+  const int top = y - getAscent(), bot = y - getDescent();   // descent is <= 0
+  uint32_t h = cp * 2654435761u;
+  for (int c = 0; c < w - 1; ++c) {
+    for (int r = top; r < bot; ++r) {
+      h ^= h << 13; h ^= h >> 17; h ^= h << 5;
+      if (h & 1) drawPixel(x + c, r);
+    }
+  }
+  return w;
+}
+
+int U8G2::getStrWidth(const char* s) const {
+  if (!font_ || !s) return 0;
+  const int w = cellW();
+  int total = 0, last = 0;
+  for (; *s; ++s) {
+    const uint8_t c = (uint8_t)*s;
+    if (!inFont(c)) continue;
+    total += w;
+    last = (c == ' ' || c == 0xA0) ? 0 : w - 1;
+  }
+  return total ? total - w + last : 0;
+}
+
+int U8G2::drawStr(int x, int y, const char* s) {
+  int w = 0;
+  for (; s && *s; ++s) w += drawGlyph(x + w, y, (uint8_t)*s);
+  return w;
+}
+
+int U8G2::drawUTF8(int x, int y, const char* s) {
+  int w = 0;
+  const uint8_t* p = (const uint8_t*)s;
+  while (p && *p) {
+    uint32_t cp = *p++;
+    int more = cp >= 0xF0 ? 3 : cp >= 0xE0 ? 2 : cp >= 0xC0 ? 1 : 0;
+    if (more) cp &= 0x3F >> more;
+    while (more-- && (*p & 0xC0) == 0x80) cp = (cp << 6) | (*p++ & 0x3F);
+    w += drawGlyph(x + w, y, cp);
+  }
+  return w;
+}
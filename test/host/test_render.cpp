@@ -0,0 +1,118 @@
+// SSD1309 screens on the host: a recorded telemetry trace is replayed
+// through Telemetry -> History -> TypeDDisplay (and Insignia, fed from the
+// fixture server) on the fake clock. What reached the panel is compared
+// with golden PBMs at fixed points of the carousel, and heap allocations
+// are counted per screen.
+#include "display.h"
+#include "telemetry.h"
+#include "history.h"
+#include "oled_damage.h"
+#include <U8g2lib.h>
+#include <HTTPClient.h>
+#include "fw_fakes.h"
+#include "golden.h"
+#include "check.h"
+
+static U8G2 u8;
+static uint32_t t0 = 0;                  // trace start on the fake clock
+
+// The sketch's scheduled tasks, 10 ms apart (net, history, render).
+static void runTo(uint32_t at) {
+  while (millis() - t0 < at) {
+    host::advance(10);
+    Telemetry::loop();
+    History::loop();
+    TypeDDisplay::loop();
+  }
+}
+
+struct Window { const char* screen; uint32_t from, to; uint64_t maxAllocs; };
+
+int main(int argc, char** argv) {
+  if (!golden::init(argc, argv)) return 2;
+  host::httpRoot = String(golden::fixtures().c_str()) + "/insignia";
+  CHECK(fakes::loadTrace((golden::fixtures() + "/session.tdcap").c_str()));
+
+  fakes::batteryPct = 76.f;
+  fakes::weather.ok = true;
+  fakes::weather.version = 1;
+  fakes::weather.temp = 71.6f;
+  fakes::weather.units = 'F';
+  fakes::weather.wind = 6.f;
+  fakes::weather.wmo = 2;
+  fakes::weather.humidity = 45;
+  fakes::weather.place = "North Shore";
+
+  Telemetry::begin();
+  TypeDDisplay::setDebug(false);
+  TypeDDisplay::begin(&u8);
+  TypeDDisplay::setHoldTimes(15000, 5000);
+  TypeDDisplay::showBootLogo();
+  CHECK(golden::checkPbm("logo.pbm", u8.glass()));
+
+  fakes::startTrace();
+  t0 = millis();
+
+  // Carousel from the first MAIN frame: MAIN 15 s, SECOND 5 s, GRAPH 7 s,
+  // HEALTH 5 s, INSIGNIA 12 s, WEATHER 7 s. Shots sit mid-hold; "slide" is
+  // halfway through the MAIN -> SECOND transition.
+  static const struct { uint32_t at; const char* name; } shots[] = {
+    { 10000, "main.pbm" },     { 15170, "slide.pbm" },  { 18000, "second.pbm" },
+    { 25000, "graph.pbm" },    { 30000, "health.pbm" }, { 38000, "insignia.pbm" },
+    { 48000, "weather.pbm" },  { 89500, "main_v2.pbm" },
+  };
+  // Steady stretches (no slide): allocations over the whole window, at most.
+  // Telemetry keeps arriving (MAIN every second), so these cover ingest too;
+  // budgets are the measured counts plus headroom for other C++ libraries.
+  static const Window windows[] = {
+    { "main",     2000, 14000, 32 },
+    { "second",  16000, 19500, 24 },
+    { "graph",   21000, 26500, 12 },
+    { "health",  28000, 31500, 12 },
+    { "insignia",33000, 43500, 12 },
+    { "weather", 45000, 50500, 12 },
+  };
+
+  size_t shot = 0;
+  for (const Window& w : windows) {
+    for (; shot < sizeof(shots) / sizeof(shots[0]) && shots[shot].at <= w.from; ++shot) {
+      runTo(shots[shot].at);
+      CHECK(golden::checkPbm(shots[shot].name, u8.glass()));
+    }
+    runTo(w.from);
+    const uint64_t a0 = fakes::allocs;
+    const uint32_t f0 = OledDamage::framesFlushed();
+    // shots inside the window are taken without touching the counters
+    for (; shot < sizeof(shots) / sizeof(shots[0]) && shots[shot].at < w.to; ++shot) {
+      runTo(shots[shot].at);
+      CHECK(golden::checkPbm(shots[shot].name, u8.glass()));
+    }
+    runTo(w.to);
+    const uint64_t n = fakes::allocs - a0;
+    printf("%-9s %5.1f s: %4llu allocations, %4u frames\n", w.screen, (w.to - w.from) / 1000.f,
+           (unsigned long long)n, (unsigned)(OledDamage::framesFlushed() - f0));
+    if (n > w.maxAllocs) {
+      fprintf(stderr, "FAIL %s: %llu allocations (budget %llu)\n", w.screen,
+              (unsigned long long)n, (unsigned long long)w.maxAllocs);
+      g_failures++;
+    }
+  }
+  for (; shot < sizeof(shots) / sizeof(shots[0]); ++shot) {
+    runTo(shots[shot].at);
+    CHECK(golden::checkPbm(shots[shot].name, u8.glass()));
+  }
+
+  // silence: logo after 2 min, dimmed saver after 5, panel off after 30
+  runTo(fakes::traceSpanMs() + 130000);
+  CHECK(golden::checkPbm("idle_logo.pbm", u8.glass()));
+  runTo(fakes::traceSpanMs() + 301000);
+  CHECK(golden::checkPbm("saver.pbm", u8.glass()));
+  CHECK(u8.contrast() < 255);
+  CHECK(TypeDDisplay::idle());
+  runTo(fakes::traceSpanMs() + 1801000);
+  CHECK(u8.powerSave());
+
+  CHECK(fakes::traceDone());
+  CHECK(host::httpRequests > 0);          // Insignia went through the fixture server
+  return TEST_MAIN_RESULT();
+}
@@ -0,0 +1,186 @@
+// TypedProto v2 encode/decode round trips and malformed-frame handling.
+#include "typed_proto.h"
+#include "check.h"
+#include <string.h>
+
+using namespace TypedProto;
+
+static Frame sample() {
+  Frame f;
+  f.flags = 0;
+  f.seq = 0x01020304;
+  f.sender_ts = 0xA0B0C0D0;
+  f.have = HAVE_MAIN | HAVE_EXT | HAVE_SERIAL | HAVE_MAC | HAVE_REGION;
+  f.main.fan = 55; f.main.cpu = -12; f.main.amb = 31;
+  strcpy(f.main.app, "Halo 2 - Multiplayer Map Pack XX");   // 32 chars: fills the field
+  f.ext.tray = 1; f.ext.av = 6; f.ext.pic = 2; f.ext.xb = 5;
+  f.ext.w = 720; f.ext.h = 480; f.ext.enc = 0x7FFFFFFF;
+  strcpy(f.ee.serial, "123456789012");
+  strcpy(f.ee.mac, "00:50:F2:12:34:56");
+  strcpy(f.ee.region, "NTSC-U");
+  return f;
+}
+
+static void checkSame(const Frame& a, const Frame& b) {
+  CHECK_EQ(a.seq, b.seq);
+  CHECK_EQ(a.sender_ts, b.sender_ts);
+  CHECK_EQ(a.have, b.have);
+  if (a.have & HAVE_MAIN) {
+    CHECK_EQ(a.main.fan, b.main.fan);
+    CHECK_EQ(a.main.cpu, b.main.cpu);
+    CHECK_EQ(a.main.amb, b.main.amb);
+    CHECK(!strcmp(a.main.app, b.main.app));
+  }
+  if (a.have & HAVE_EXT) {
+    CHECK_EQ(a.ext.tray, b.ext.tray); CHECK_EQ(a.ext.av, b.ext.av);
+    CHECK_EQ(a.ext.pic, b.ext.pic);   CHECK_EQ(a.ext.xb, b.ext.xb);
+    CHECK_EQ(a.ext.w, b.ext.w);       CHECK_EQ(a.ext.h, b.ext.h);
+    CHECK_EQ(a.ext.enc, b.ext.enc);
+  }
+  if (a.have & HAVE_SERIAL) CHECK(!strcmp(a.ee.serial, b.ee.serial));
+  if (a.have & HAVE_MAC)    CHECK(!strcmp(a.ee.mac, b.ee.mac));
+  if (a.have & HAVE_REGION) CHECK(!strcmp(a.ee.region, b.ee.region));
+}
+
+static void roundTripAll() {
+  const Frame f = sample();
+  uint8_t buf[256];
+  const size_t n = encode(f, buf, sizeof(buf));
+  CHECK_EQ(n, HEADER_LEN + (2 + 44) + (2 + 28) + (2 + 12) + (2 + 17) + (2 + 6));
+  CHECK(isV2(buf, n));
+  Frame d;
+  CHECK(decode(buf, n, d));
+  CHECK_EQ(d.version, VERSION);
+  checkSame(f, d);
+}
+
+static void roundTripEach() {
+  const uint8_t bits[] = { HAVE_MAIN, HAVE_EXT, HAVE_SERIAL, HAVE_MAC, HAVE_REGION, HAVE_MAIN | HAVE_REGION };
+  for (uint8_t have : bits) {
+    Frame f = sample();
+    f.have = have;
+    uint8_t buf[256];
+    const size_t n = encode(f, buf, sizeof(buf));
+    CHECK(n > HEADER_LEN);
+    Frame d;
+    CHECK(decode(buf, n, d));
+    checkSame(f, d);
+  }
+}
+
+static void emptyFrame() {
+  Frame f;
+  f.seq = 7;
+  uint8_t buf[HEADER_LEN];
+  CHECK_EQ(encode(f, buf, sizeof(buf)), HEADER_LEN);
+  Frame d;
+  CHECK(decode(buf, sizeof(buf), d));
+  CHECK_EQ(d.have, 0);
+  CHECK_EQ(d.seq, 7u);
+}
+
+static void truncated() {
+  const Frame f = sample();
+  uint8_t buf[256];
+  const size_t n = encode(f, buf, sizeof(buf));
+  Frame d;
+
+  // short header: not a v2 frame
+  for (size_t cut = 0; cut < HEADER_LEN; ++cut) CHECK(!decode(buf, cut, d));
+
+  // cut inside the EXT record: MAIN survives, EXT and the EE strings don't
+  const size_t inExt = HEADER_LEN + 2 + 44 + 10;
+  CHECK(decode(buf, inExt, d));
+  CHECK_EQ(d.have, HAVE_MAIN);
+  CHECK_EQ(d.main.cpu, f.main.cpu);
+
+  // every prefix decodes to a subset of the records, never more
+  for (size_t cut = HEADER_LEN; cut <= n; ++cut) {
+    Frame p;
+    CHECK(decode(buf, cut, p));
+    CHECK_EQ(p.have & ~f.have, 0);
+  }
+}
+
+static void badHeader() {
+  const Frame f = sample();
+  uint8_t buf[256];
+  const size_t n = encode(f, buf, sizeof(buf));
+  Frame d;
+
+  uint8_t bad[256];
+  memcpy(bad, buf, n); bad[0] = 'X';
+  CHECK(!isV2(bad, n));
+  CHECK(!decode(bad, n, d));
+  memcpy(bad, buf, n); bad[1] = 'd';
+  CHECK(!decode(bad, n, d));
+  memcpy(bad, buf, n); bad[2] = VERSION + 1;
+  CHECK(!decode(bad, n, d));
+  CHECK(!decode(nullptr, n, d));
+
+  // legacy 44 B MAIN frame (no magic) is left to the legacy decoders
+  uint8_t legacy[44] = { 55, 0, 0, 0 };
+  CHECK(!decode(legacy, sizeof(legacy), d));
+}
+
+static void unknownRecordSkipped() {
+  Frame f = sample();
+  f.have = HAVE_MAIN;
+  uint8_t buf[256];
+  size_t n = encode(f, buf, sizeof(buf));
+  // splice an unknown record in front of MAIN
+  uint8_t spliced[256];
+  memcpy(spliced, buf, HEADER_LEN);
+  const uint8_t unk[] = { 0x7E, 3, 1, 2, 3 };
+  memcpy(spliced + HEADER_LEN, unk, sizeof(unk));
+  memcpy(spliced + HEADER_LEN + sizeof(unk), buf + HEADER_LEN, n - HEADER_LEN);
+  n += sizeof(unk);
+  Frame d;
+  CHECK(decode(spliced, n, d));
+  checkSame(f, d);
+}
+
+static void encodeCapacity() {
+  const Frame f = sample();
+  uint8_t buf[256];
+  const size_t n = encode(f, buf, sizeof(buf));
+  CHECK_EQ(encode(f, buf, n - 1), 0u);
+  CHECK_EQ(encode(f, buf, HEADER_LEN - 1), 0u);
+  CHECK_EQ(encode(f, nullptr, sizeof(buf)), 0u);
+  CHECK_EQ(encode(f, buf, n), n);
+}
+
+static void controlRoundTrip() {
+  Control c;
+  c.main_ms = 100; c.ext_ms = RATE_OFF; c.ee_ms = RATE_DEFAULT; c.ttl_s = 45;
+  uint8_t buf[CONTROL_LEN];
+  CHECK_EQ(encodeControl(c, 9, 1234, buf, sizeof(buf)), CONTROL_LEN);
+  CHECK_EQ(encodeControl(c, 9, 1234, buf, sizeof(buf) - 1), 0u);
+  Control d;
+  CHECK(decodeControl(buf, sizeof(buf), d));
+  CHECK(d == c);
+  CHECK(!decodeControl(buf, sizeof(buf) - 1, d));   // truncated rate record
+
+  // a telemetry decoder sees the header and skips the record
+  Frame f;
+  CHECK(decode(buf, sizeof(buf), f));
+  CHECK_EQ(f.have, 0);
+  CHECK(f.flags & FLAG_CONTROL);
+
+  // and a telemetry frame is not control
+  uint8_t tel[256];
+  const size_t n = encode(sample(), tel, sizeof(tel));
+  CHECK(!decodeControl(tel, n, d));
+}
+
+int main() {
+  roundTripAll();
+  roundTripEach();
+  emptyFrame();
+  truncated();
+  badHeader();
+  unknownRecordSkipped();
+  encodeCapacity();
+  controlRoundTrip();
+  return TEST_MAIN_RESULT();
+}
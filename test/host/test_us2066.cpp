@@ -0,0 +1,157 @@
+// US2066 20x4 pages on the host: the same telemetry trace as test_render is
+// replayed through Telemetry -> History -> US2066View, and the driver talks
+// I2C to an emulated controller. The DDRAM the emulator ends up with is
+// compared with golden text per page; allocations are counted too.
+#include "us2066.h"
+#include "us2066_view.h"
+#include "telemetry.h"
+#include "history.h"
+#include <Wire.h>
+#include "fw_fakes.h"
+#include "golden.h"
+#include "check.h"
+
+// Just enough of the controller for what the driver sends: RE/SD instruction
+// set switches, the two-byte OLED commands, function data after 0x71/0x72,
+// DDRAM/CGRAM addressing with auto-increment, and BF/AC reads (never busy).
+struct Us2066Emu : HostI2cDevice {
+  uint8_t ddram[0x80];
+  uint8_t cgram[64] = {};
+  uint8_t ac = 0;
+  bool    cg = false;            // address counter points into CGRAM
+  bool    re = false, sd = false, on = false;
+  uint8_t contrast = 0;
+  uint8_t fnPending = 0;         // 0x71 / 0x72 waiting for its data byte
+  uint32_t badCmds = 0;
+
+  Us2066Emu() { memset(ddram, ' ', sizeof(ddram)); }
+
+  void transfer(const uint8_t* b, size_t n) override {
+    if (!n) return;                                  // address probe
+    if (b[0] == 0x40) { for (size_t i = 1; i < n; ++i) data(b[i]); return; }
+    if (b[0] != 0x00) { badCmds++; return; }
+    for (size_t i = 1; i < n; ++i) {
+      const uint8_t c = b[i];
+      if (sd && (c == 0x81 || c == 0xD5 || c == 0xDA || c == 0xDC || c == 0xD9 || c == 0xDB)) {
+        if (i + 1 >= n) { badCmds++; return; }
+        if (c == 0x81) contrast = b[i + 1];
+        ++i;
+        continue;
+      }
+      cmd(c);
+    }
+  }
+  size_t read(uint8_t* b, size_t n) override {
+    if (!n) return 0;
+    b[0] = ac & 0x7F;                                // BF = 0
+    return 1;
+  }
+
+  void cmd(uint8_t c) {
+    if (c & 0x80) { ac = c & 0x7F; cg = false; return; }
+    if (re && (c == 0x71 || c == 0x72)) { fnPending = c; return; }
+    if (re && (c == 0x78 || c == 0x79)) { sd = c & 1; return; }
+    if (!re && (c & 0x40)) { ac = c & 0x3F; cg = true; return; }
+    if ((c & 0xE0) == 0x20) { re = c & 0x02; return; }
+    if (c == 0x01) { memset(ddram, ' ', sizeof(ddram)); ac = 0; cg = false; return; }
+    if (c == 0x02) { ac = 0; cg = false; return; }
+    if (!re && (c & 0xF8) == 0x08) { on = c & 0x04; return; }
+    // entry mode, extended function set, ...: no effect on what's shown
+  }
+  void data(uint8_t v) {
+    if (fnPending) { fnPending = 0; return; }
+    if (cg) { cgram[ac & 0x3F] = v; ac = (ac + 1) & 0x3F; return; }
+    ddram[ac & 0x7F] = v;
+    ac = (ac + 1) & 0x7F;
+  }
+
+  // The 4x20 window; CGRAM glyphs and anything outside ASCII as \xNN.
+  std::string screen() const {
+    static const uint8_t base[4] = { 0x00, 0x20, 0x40, 0x60 };
+    std::string s;
+    char hex[5];
+    for (uint8_t r = 0; r < 4; ++r) {
+      s += '|';
+      for (uint8_t c = 0; c < 20; ++c) {
+        const uint8_t v = ddram[base[r] + c];
+        if (v >= 0x20 && v < 0x7F && v != '\\') s += (char)v;
+        else { snprintf(hex, sizeof(hex), "\\x%02X", v); s += hex; }
+      }
+      s += "|\n";
+    }
+    return s;
+  }
+};
+
+static Us2066Emu emu;
+static US2066 dev;
+static US2066View view;
+static uint32_t t0 = 0;
+
+static void runTo(uint32_t at) {
+  while (millis() - t0 < at) {
+    host::advance(10);
+    Telemetry::loop();
+    History::loop();
+    view.loop();
+  }
+}
+
+int main(int argc, char** argv) {
+  if (!golden::init(argc, argv)) return 2;
+  CHECK(fakes::loadTrace((golden::fixtures() + "/session.tdcap").c_str()));
+  fakes::batteryPct = 76.f;
+  fakes::weather.ok = true;
+  fakes::weather.version = 1;
+  fakes::weather.temp = 71.6f;
+  fakes::weather.units = 'F';
+  fakes::weather.wind = 6.f;
+  fakes::weather.wmo = 2;
+  fakes::weather.humidity = 45;
+  fakes::weather.place = "North Shore";
+
+  Wire.attach(0x3C, &emu);
+  Telemetry::begin();
+  CHECK(dev.begin(&Wire, 0x3C, 20, 4));
+  CHECK(dev.setBusyPolling(true));
+  CHECK(view.attach(&dev));
+  CHECK(emu.on);
+  CHECK_EQ(emu.contrast, 0x7F);
+
+  fakes::startTrace();
+  t0 = millis();
+
+  // Pages turn every 4.5 s: MAIN, HW, NET, WX, TREND (once History has two
+  // 1 s samples). Each shot sits 2 s into its page; the last one is MAIN
+  // again after the v2 frame (progressive 720x480, new temperatures).
+  static const struct { uint32_t at; const char* name; } shots[] = {
+    {  2000, "us2066_main.txt" }, {  6500, "us2066_hw.txt" },  { 11000, "us2066_net.txt" },
+    { 15500, "us2066_wx.txt" },   { 20000, "us2066_trend.txt" },
+  };
+  for (const auto& s : shots) {
+    runTo(s.at);
+    CHECK(golden::checkText(s.name, emu.screen()));
+  }
+
+  // One full carousel turn, steady state: allocations and bus traffic.
+  runTo(27000);
+  dev.resetStats();
+  const uint64_t a0 = fakes::allocs;
+  runTo(49500);
+  const uint64_t n = fakes::allocs - a0;
+  const US2066::Stats& st = dev.stats();
+  printf("carousel  22.5 s: %4llu allocations, %lu I2C transactions, %.1f B/data txn\n",
+         (unsigned long long)n, (unsigned long)st.txns, st.bytesPerTxn());
+  if (n > 4) {
+    fprintf(stderr, "FAIL carousel: %llu allocations (budget 4)\n", (unsigned long long)n);
+    g_failures++;
+  }
+  CHECK_EQ(st.errors, 0);
+
+  runTo(92000);
+  CHECK(golden::checkText("us2066_main_v2.txt", emu.screen()));
+
+  CHECK(fakes::traceDone());
+  CHECK_EQ(emu.badCmds, 0);
+  return TEST_MAIN_RESULT();
+}
@@ -0,0 +1,60 @@
+# build_web_assets.py
+# Packs the portal/OTA pages into src/web_assets.h as gzip'd PROGMEM arrays
+# - Run after editing anything in web/ (the Arduino build has no pre-build hook,
+#   so the generated header is committed)
+# - Output is deterministic (gzip mtime 0), so unchanged pages keep their ETag
+#
+# Usage: python web/build_web_assets.py
+
+import gzip
+import hashlib
+import os
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+OUT = os.path.join(HERE, "..", "src", "web_assets.h")
+
+# (source file, C symbol prefix)
+ASSETS = [
+    ("portal.html", "PORTAL_HTML"),
+    ("ota.html",    "OTA_HTML"),
+]
+
+
+def pack(path):
+    with open(path, "rb") as f:
+        raw = f.read()
+    gz = gzip.compress(raw, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(gz).hexdigest()[:16]
+    return raw, gz, etag
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + ",".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    out = [
+        "#pragma once",
+        "// Generated by web/build_web_assets.py from web/*.html - do not edit.",
+        "#include <Arduino.h>",
+        "",
+    ]
+    for name, sym in ASSETS:
+        raw, gz, etag = pack(os.path.join(HERE, name))
+        out.append("// %s: %u B -> %u B gzip" % (name, len(raw), len(gz)))
+        out.append("static const char %s_ETAG[] = \"\\\"%s\\\"\";" % (sym, etag))
+        out.append("static const size_t %s_GZ_LEN = %u;" % (sym, len(gz)))
+        out.append("static const uint8_t %s_GZ[] PROGMEM = {" % sym)
+        out.append(c_array(gz))
+        out.append("};")
+        out.append("")
+        print("%-12s %6u -> %5u B  etag %s" % (name, len(raw), len(gz), etag))
+    with open(OUT, "w", newline="\n") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()